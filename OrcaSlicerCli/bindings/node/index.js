@@ -3,6 +3,7 @@
 // Try to load the addon from prebuilt/artifact and common build locations.
 const path = require("path");
 const fs = require("fs");
+const { Readable } = require("stream");
 const tryRequire = (p) => { try { return require(p); } catch (_) { return null; } };
 const log = (...a) => { try { console.error("DEBUG: [addon-js]", ...a); } catch (_) {} };
 
@@ -14,10 +15,44 @@ function wrapAsMiddleware(native) {
     const d = Object.getOwnPropertyDescriptor(native, k);
     try { Object.defineProperty(mw, k, d); } catch {}
   }
+  if (typeof native.sliceChunks === "function") mw.sliceStream = (params) => sliceStream(native, params);
   log("exporting middleware wrapper with API names:", Object.getOwnPropertyNames(native));
   return mw;
 }
 
+// sliceStream(params): the output as a Readable over native.sliceChunks(). The engine pauses while the
+// stream is over its highWaterMark; destroying the stream (or params.signal) cancels the slice.
+// With params.trace the trace file is announced by a 'trace' event (its path) before 'end'.
+function sliceStream(native, params) {
+  const ac = new AbortController();
+  const outer = params && params.signal;
+  let resume = null;
+  const stream = new Readable({
+    highWaterMark: 1 << 20,
+    read() { if (resume) { const r = resume; resume = null; r(); } },
+    destroy(err, cb) { ac.abort(); cb(err); },
+  });
+  if (outer) {
+    if (outer.aborted) ac.abort();
+    else outer.addEventListener("abort", () => stream.destroy(outer.reason), { once: true });
+  }
+  const onData = (chunk, more) => {
+    if (stream.destroyed) return false;
+    if (stream.push(chunk)) return true;
+    resume = more;
+    return false;
+  };
+  native.sliceChunks({ ...params, signal: ac.signal }, onData).then(
+    (result) => {
+      if (stream.destroyed) return;
+      if (result && result.tracePath) stream.emit("trace", result.tracePath);
+      stream.push(null);
+    },
+    (err) => { if (!stream.destroyed) stream.destroy(err); }
+  );
+  return stream;
+}
+
 log("__dirname=", __dirname, "node=", process.versions && process.versions.node);
 
 // 0) Prefer prebuilt artifact bundled in npm: prebuilds/<platform>-<arch>/orcaslicer_node.node
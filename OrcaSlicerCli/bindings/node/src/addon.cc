@@ -4,6 +4,13 @@
 #include <vector>
 #include <memory>
 #include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <atomic>
+#include <unordered_map>
 
 #include <cstdlib>
 
@@ -15,9 +22,18 @@
   #include <dlfcn.h>
 #endif
 #include <cstdio>
+#include <iostream>
 
-// Thin addon will dlopen the engine library at runtime; no direct core linkage.
-static std::mutex g_mutex; // serialize heavy operations
+#include "utils/Logger.hpp"
+
+using OrcaSlicerCli::Logger;
+using OrcaSlicerCli::LogLevel;
+
+// Thin addon will dlopen the engine library at runtime; no direct core linkage. The one core source it
+// compiles in is utils/Logger.cpp, so the addon has its own Logger singleton, separate from the engine's:
+// both read ORCACLI_LOG_LEVEL/ORCACLI_QUIET, but setLogLevel() here (initialize({ verbose })) and the
+// stderr redirect below only affect "[addon]" lines.
+static std::mutex g_load_mutex; // guards dlopen/symbol resolution
 
 #define NAPI_CALL(env, call)                                                     \
   do {                                                                           \
@@ -51,7 +67,14 @@ typedef struct { bool success; const char* message; const char* error_details; }
 typedef struct { const char* filename; uint32_t object_count; uint32_t triangle_count; double volume; const char* bounding_box; bool is_valid; } orcacli_model_info;
 // key/value override
 typedef struct { const char* key; const char* value; } orcacli_kv;
-typedef struct { const char* input_file; const char* output_file; const char* config_file; const char* preset_name; const char* printer_profile; const char* filament_profile; const char* process_profile; int32_t plate_index; bool verbose; bool dry_run; const orcacli_kv* overrides; int32_t overrides_count; } orcacli_slice_params;
+typedef struct { uint64_t hits; uint64_t misses; uint64_t evictions; uint32_t entries; uint32_t capacity; } orcacli_cache_stats;
+typedef struct { int32_t apply_status; uint32_t steps_run; } orcacli_reslice_info;
+typedef struct { uint64_t slices; uint64_t slice_failures; uint64_t bytes_in; uint64_t bytes_out; orcacli_cache_stats config_cache; orcacli_cache_stats project_cache; orcacli_cache_stats result_cache; uint64_t rss_bytes; } orcacli_stats;
+#define ORCACLI_STEP_COUNT 8
+typedef struct { uint64_t load_model_ns; uint64_t presets_ns; uint64_t apply_ns; uint64_t process_ns; uint64_t step_ns[ORCACLI_STEP_COUNT]; uint32_t step_count[ORCACLI_STEP_COUNT]; uint64_t export_gcode_ns; uint64_t package_ns; uint64_t total_ns; uint32_t objects; uint32_t layers; bool cached; } orcacli_slice_timings;
+typedef struct { const uint8_t* data; uint64_t size; void* opaque; } orcacli_buffer;
+typedef struct { const char* input_file; const char* output_file; const char* config_file; const char* preset_name; const char* printer_profile; const char* filament_profile; const char* process_profile; int32_t plate_index; bool verbose; bool dry_run; const orcacli_kv* overrides; int32_t overrides_count; uint64_t job_id; int32_t timeout_ms; const uint8_t* input_data; uint64_t input_size; const char* input_format; int32_t compression_level; const char* output_format; const char* trace_file; } orcacli_slice_params;
+#define ORCACLI_COMPRESSION_STORE (-1)
 
 typedef orcacli_handle       (*PF_orcacli_create)();
 typedef void                 (*PF_orcacli_destroy)(orcacli_handle);
@@ -67,6 +90,20 @@ typedef orcacli_operation_result (*PF_orcacli_load_vendor)(orcacli_handle, const
 typedef orcacli_operation_result (*PF_orcacli_load_printer_profile)(orcacli_handle, const char*);
 typedef orcacli_operation_result (*PF_orcacli_load_filament_profile)(orcacli_handle, const char*);
 typedef orcacli_operation_result (*PF_orcacli_load_process_profile)(orcacli_handle, const char*);
+typedef orcacli_operation_result (*PF_orcacli_save_snapshot)(orcacli_handle, const char*);
+typedef orcacli_operation_result (*PF_orcacli_load_snapshot)(orcacli_handle, const char*);
+typedef orcacli_cache_stats  (*PF_orcacli_get_config_cache_stats)(orcacli_handle);
+typedef orcacli_operation_result (*PF_orcacli_session_open)(orcacli_handle, const char*, int32_t, uint64_t*);
+typedef orcacli_operation_result (*PF_orcacli_session_reslice)(orcacli_handle, uint64_t, const orcacli_slice_params*, orcacli_reslice_info*);
+typedef void                 (*PF_orcacli_session_close)(orcacli_handle, uint64_t);
+typedef void                 (*PF_orcacli_cancel)(orcacli_handle, uint64_t);
+typedef orcacli_operation_result (*PF_orcacli_slice_to_buffer)(orcacli_handle, const orcacli_slice_params*, orcacli_buffer*);
+typedef void                 (*PF_orcacli_free_buffer)(orcacli_buffer*);
+typedef orcacli_operation_result (*PF_orcacli_load_model_from_memory)(orcacli_handle, const uint8_t*, uint64_t, const char*, const char*);
+typedef int (*orcacli_write_fn)(void*, const uint8_t*, uint64_t);
+typedef orcacli_operation_result (*PF_orcacli_slice_to_stream)(orcacli_handle, const orcacli_slice_params*, orcacli_write_fn, void*);
+typedef orcacli_slice_timings (*PF_orcacli_get_last_timings)(orcacli_handle);
+typedef orcacli_stats        (*PF_orcacli_get_stats)(orcacli_handle);
 
 struct FFI {
   void* lib = nullptr;
@@ -85,12 +122,45 @@ struct FFI {
   PF_orcacli_load_printer_profile load_printer_profile = nullptr;
   PF_orcacli_load_filament_profile load_filament_profile = nullptr;
   PF_orcacli_load_process_profile load_process_profile = nullptr;
-  // state
-  orcacli_handle inst = nullptr;
+  PF_orcacli_save_snapshot save_snapshot = nullptr;
+  PF_orcacli_load_snapshot load_snapshot = nullptr;
+  PF_orcacli_get_config_cache_stats get_config_cache_stats = nullptr;
+  PF_orcacli_session_open session_open = nullptr;
+  PF_orcacli_session_reslice session_reslice = nullptr;
+  PF_orcacli_session_close session_close = nullptr;
+  PF_orcacli_cancel cancel = nullptr;
+  PF_orcacli_slice_to_buffer slice_to_buffer = nullptr;
+  PF_orcacli_free_buffer free_buffer = nullptr;
+  PF_orcacli_slice_to_stream slice_to_stream = nullptr;
+  PF_orcacli_load_model_from_memory load_model_from_memory = nullptr;
+  PF_orcacli_get_last_timings get_last_timings = nullptr;
+  PF_orcacli_get_stats get_stats = nullptr;
 };
 
 static FFI g_ffi;
 
+// Engine pool: N independent engine instances (each with its own CliCore, presets, Model and Print).
+// slice()/getModelInfo() lease one idle engine; initialize/vendor/profile loads are broadcast to
+// every engine under an exclusive lease so all instances stay interchangeable.
+// An engine holding a re-slice session is pinned: reslice() must run on it, and generic leases only
+// take it (ending the session, since they load another model) when no session-free engine is idle.
+// The engines live in one process and share libslic3r's globals: the TBB worker pool, data/resources/
+// temporary dirs, the log level and the C locale. They slice concurrently but compete for the same cores.
+struct EngineSlot { orcacli_handle inst = nullptr; bool busy = false; uint64_t session = 0; };
+static std::mutex g_pool_mutex;             // guards everything below
+static std::condition_variable g_pool_cv;   // signalled whenever a lease is released
+static std::vector<EngineSlot> g_engines;
+static bool g_pool_exclusive = false;       // a broadcast/shutdown owns every engine
+static size_t g_pool_exclusive_waiters = 0; // pending broadcasts; new leases yield to them
+static size_t g_pool_size = 0;              // 0 = resolve from ORCACLI_ENGINES (default 1) on first use
+static void sched_set_max_depth(size_t depth); // slicing scheduler (defined with SliceWork)
+
+static size_t default_pool_size() {
+  const char* e = std::getenv("ORCACLI_ENGINES");
+  if (e && *e) { long n = std::strtol(e, nullptr, 10); if (n > 0) return (size_t)n; }
+  return 1;
+}
+
 static std::string module_dir_path() {
 #if defined(_WIN32)
   HMODULE hMod = nullptr;
@@ -115,8 +185,9 @@ static std::string module_dir_path() {
 }
 
 static bool ensure_engine_loaded(std::string* err_out) {
+  std::lock_guard<std::mutex> lk(g_load_mutex);
   if (g_ffi.lib) return true;
-  fprintf(stderr, "DEBUG: [addon] ensure_engine_loaded: begin\n"); fflush(stderr);
+  LOG_DEBUG_STREAM("[addon] ensure_engine_loaded: begin");
   const char* override = std::getenv("ORCACLI_ENGINE_PATH");
   std::vector<std::string> candidates;
   if (override && *override) candidates.emplace_back(override);
@@ -145,12 +216,12 @@ static bool ensure_engine_loaded(std::string* err_out) {
   for (const auto& p : candidates) {
 #if defined(_WIN32)
     g_ffi.lib = (void*)LoadLibraryA(p.c_str());
-    fprintf(stderr, "DEBUG: [addon] ensure_engine_loaded: try '%s' => %p (win)\n", p.c_str(), g_ffi.lib); fflush(stderr);
+    LOG_DEBUG_STREAM("[addon] ensure_engine_loaded: try '" << p.c_str() << "' => " << g_ffi.lib << " (win)");
     if (g_ffi.lib) break;
     last_err = nullptr; last_path = p;
 #else
     g_ffi.lib = dlopen(p.c_str(), RTLD_NOW);
-    fprintf(stderr, "DEBUG: [addon] ensure_engine_loaded: try '%s' => %p\n", p.c_str(), g_ffi.lib); fflush(stderr);
+    LOG_DEBUG_STREAM("[addon] ensure_engine_loaded: try '" << p.c_str() << "' => " << g_ffi.lib);
     if (g_ffi.lib) break;
     last_err = dlerror(); last_path = p;
 #endif
@@ -162,7 +233,7 @@ static bool ensure_engine_loaded(std::string* err_out) {
       if (last_err) { msg += " — "; msg += last_err; }
       *err_out = msg;
     }
-    fprintf(stderr, "DEBUG: [addon] ensure_engine_loaded: failed: %s\n", err_out?err_out->c_str():"(no err_out)"); fflush(stderr);
+    LOG_DEBUG_STREAM("[addon] ensure_engine_loaded: failed: " << (err_out?err_out->c_str():"(no err_out)"));
     return false;
   }
 #if defined(_WIN32)
@@ -184,6 +255,19 @@ static bool ensure_engine_loaded(std::string* err_out) {
   g_ffi.load_printer_profile = reinterpret_cast<PF_orcacli_load_printer_profile>(load_sym(g_ffi.lib, "orcacli_load_printer_profile"));
   g_ffi.load_filament_profile = reinterpret_cast<PF_orcacli_load_filament_profile>(load_sym(g_ffi.lib, "orcacli_load_filament_profile"));
   g_ffi.load_process_profile = reinterpret_cast<PF_orcacli_load_process_profile>(load_sym(g_ffi.lib, "orcacli_load_process_profile"));
+  g_ffi.save_snapshot  = reinterpret_cast<PF_orcacli_save_snapshot>(load_sym(g_ffi.lib, "orcacli_save_snapshot"));
+  g_ffi.load_snapshot  = reinterpret_cast<PF_orcacli_load_snapshot>(load_sym(g_ffi.lib, "orcacli_load_snapshot"));
+  g_ffi.get_config_cache_stats = reinterpret_cast<PF_orcacli_get_config_cache_stats>(load_sym(g_ffi.lib, "orcacli_get_config_cache_stats"));
+  g_ffi.session_open   = reinterpret_cast<PF_orcacli_session_open>(load_sym(g_ffi.lib, "orcacli_session_open"));
+  g_ffi.session_reslice= reinterpret_cast<PF_orcacli_session_reslice>(load_sym(g_ffi.lib, "orcacli_session_reslice"));
+  g_ffi.session_close  = reinterpret_cast<PF_orcacli_session_close>(load_sym(g_ffi.lib, "orcacli_session_close"));
+  g_ffi.cancel         = reinterpret_cast<PF_orcacli_cancel>(load_sym(g_ffi.lib, "orcacli_cancel"));
+  g_ffi.slice_to_buffer= reinterpret_cast<PF_orcacli_slice_to_buffer>(load_sym(g_ffi.lib, "orcacli_slice_to_buffer"));
+  g_ffi.free_buffer    = reinterpret_cast<PF_orcacli_free_buffer>(load_sym(g_ffi.lib, "orcacli_free_buffer"));
+  g_ffi.slice_to_stream= reinterpret_cast<PF_orcacli_slice_to_stream>(load_sym(g_ffi.lib, "orcacli_slice_to_stream"));
+  g_ffi.load_model_from_memory = reinterpret_cast<PF_orcacli_load_model_from_memory>(load_sym(g_ffi.lib, "orcacli_load_model_from_memory"));
+  g_ffi.get_last_timings = reinterpret_cast<PF_orcacli_get_last_timings>(load_sym(g_ffi.lib, "orcacli_get_last_timings"));
+  g_ffi.get_stats      = reinterpret_cast<PF_orcacli_get_stats>(load_sym(g_ffi.lib, "orcacli_get_stats"));
   // Relaxed symbol requirements: require core create/destroy; others optional for dev
   if (!g_ffi.create || !g_ffi.destroy) {
     if (err_out) *err_out = "Missing required core symbols in engine library (create/destroy)";
@@ -194,9 +278,9 @@ static bool ensure_engine_loaded(std::string* err_out) {
 #endif
     return false;
   }
-  fprintf(stderr, "DEBUG: [addon] ensure_engine_loaded: symbols loaded create=%p init=%p slice=%p version=%p free_result=%p\n", (void*)g_ffi.create, (void*)g_ffi.initialize, (void*)g_ffi.slice, (void*)g_ffi.version, (void*)g_ffi.free_result); fflush(stderr);
+  LOG_DEBUG_STREAM("[addon] ensure_engine_loaded: symbols loaded create=" << (void*)g_ffi.create << " init=" << (void*)g_ffi.initialize << " slice=" << (void*)g_ffi.slice << " version=" << (void*)g_ffi.version << " free_result=" << (void*)g_ffi.free_result);
   // Log optional missing symbols for diagnostics (do not fail)
-  auto log_missing = [&](const char* name, void* p){ if (!p) { fprintf(stderr, "DEBUG: [addon] engine missing optional symbol: %s\n", name); fflush(stderr); } };
+  auto log_missing = [&](const char* name, void* p){ if (!p) { LOG_DEBUG_STREAM("[addon] engine missing optional symbol: " << name); } };
   log_missing("orcacli_initialize", (void*)g_ffi.initialize);
   log_missing("orcacli_load_model", (void*)g_ffi.load_model);
   log_missing("orcacli_get_model_info", (void*)g_ffi.get_model_info);
@@ -209,16 +293,140 @@ static bool ensure_engine_loaded(std::string* err_out) {
   log_missing("orcacli_load_printer_profile", (void*)g_ffi.load_printer_profile);
   log_missing("orcacli_load_filament_profile", (void*)g_ffi.load_filament_profile);
   log_missing("orcacli_load_process_profile", (void*)g_ffi.load_process_profile);
-  fprintf(stderr, "DEBUG: [addon] ensure_engine_loaded: calling create()...\n"); fflush(stderr);
-  g_ffi.inst = g_ffi.create();
-  fprintf(stderr, "DEBUG: [addon] ensure_engine_loaded: create() => %p\n", g_ffi.inst); fflush(stderr);
-  if (!g_ffi.inst) {
-    if (err_out) *err_out = "Failed to create engine instance";
-#if defined(_WIN32)
-    FreeLibrary((HMODULE)g_ffi.lib); g_ffi = FFI{}; return false;
-#else
-    dlclose(g_ffi.lib); g_ffi = FFI{}; return false;
-#endif
+  log_missing("orcacli_save_snapshot", (void*)g_ffi.save_snapshot);
+  log_missing("orcacli_load_snapshot", (void*)g_ffi.load_snapshot);
+  log_missing("orcacli_get_config_cache_stats", (void*)g_ffi.get_config_cache_stats);
+  log_missing("orcacli_session_open", (void*)g_ffi.session_open);
+  log_missing("orcacli_session_reslice", (void*)g_ffi.session_reslice);
+  log_missing("orcacli_session_close", (void*)g_ffi.session_close);
+  log_missing("orcacli_cancel", (void*)g_ffi.cancel);
+  log_missing("orcacli_slice_to_buffer", (void*)g_ffi.slice_to_buffer);
+  log_missing("orcacli_free_buffer", (void*)g_ffi.free_buffer);
+  log_missing("orcacli_slice_to_stream", (void*)g_ffi.slice_to_stream);
+  log_missing("orcacli_load_model_from_memory", (void*)g_ffi.load_model_from_memory);
+  log_missing("orcacli_get_last_timings", (void*)g_ffi.get_last_timings);
+  log_missing("orcacli_get_stats", (void*)g_ffi.get_stats);
+  return true;
+}
+
+// Creates the configured number of engine instances on first use. Requires g_pool_mutex held.
+static bool ensure_engine_pool(std::string* err_out) {
+  if (!g_engines.empty()) return true;
+  if (g_pool_size == 0) g_pool_size = default_pool_size();
+  LOG_DEBUG_STREAM("[addon] ensure_engine_pool: creating " << g_pool_size << " engine(s)");
+  for (size_t i = 0; i < g_pool_size; ++i) {
+    orcacli_handle h = g_ffi.create();
+    LOG_DEBUG_STREAM("[addon] ensure_engine_pool: create() #" << i << " => " << h);
+    if (!h) {
+      for (auto& s : g_engines) { try { g_ffi.destroy(s.inst); } catch (...) {} }
+      g_engines.clear();
+      if (err_out) *err_out = "Failed to create engine instance";
+      return false;
+    }
+    g_engines.push_back(EngineSlot{h, false});
+  }
+  return true;
+}
+
+// Dispatcher: leases one idle engine for the lifetime of the object (blocks while all are busy).
+class EngineLease {
+public:
+  EngineLease() = default;
+  EngineLease(const EngineLease&) = delete;
+  EngineLease& operator=(const EngineLease&) = delete;
+  ~EngineLease() {
+    if (!inst_) return;
+    { std::lock_guard<std::mutex> lk(g_pool_mutex); if (idx_ < g_engines.size() && g_engines[idx_].inst == inst_) g_engines[idx_].busy = false; }
+    g_pool_cv.notify_all();
+  }
+  bool acquire(std::string* err_out) {
+    if (!ensure_engine_loaded(err_out)) return false;
+    std::unique_lock<std::mutex> lk(g_pool_mutex);
+    for (;;) {
+      if (!g_pool_exclusive && g_pool_exclusive_waiters == 0) {
+        if (!ensure_engine_pool(err_out)) return false;
+        size_t pick = g_engines.size();
+        for (size_t i = 0; i < g_engines.size(); ++i) {
+          if (g_engines[i].busy) continue;
+          if (g_engines[i].session == 0) { pick = i; break; }
+          if (pick == g_engines.size()) pick = i;
+        }
+        if (pick < g_engines.size()) {
+          auto& slot = g_engines[pick];
+          slot.busy = true; slot.session = 0; idx_ = pick; inst_ = slot.inst; return true;
+        }
+      }
+      g_pool_cv.wait(lk);
+    }
+  }
+  // Leases the engine that holds `session` (blocks while it is busy); fails once the session is gone.
+  bool acquire_session(size_t index, uint64_t session, std::string* err_out) {
+    if (!ensure_engine_loaded(err_out)) return false;
+    std::unique_lock<std::mutex> lk(g_pool_mutex);
+    for (;;) {
+      if (index >= g_engines.size() || session == 0 || g_engines[index].session != session) {
+        if (err_out) *err_out = "Session not open (closed, or its engine was reused for another job)";
+        return false;
+      }
+      if (!g_pool_exclusive && g_pool_exclusive_waiters == 0 && !g_engines[index].busy) {
+        g_engines[index].busy = true; idx_ = index; inst_ = g_engines[index].inst; return true;
+      }
+      g_pool_cv.wait(lk);
+    }
+  }
+  // Pins (session != 0) or unpins the leased engine; called before the lease is released.
+  void set_session(uint64_t session) {
+    std::lock_guard<std::mutex> lk(g_pool_mutex);
+    if (idx_ < g_engines.size() && g_engines[idx_].inst == inst_) g_engines[idx_].session = session;
+  }
+  orcacli_handle get() const { return inst_; }
+  size_t index() const { return idx_; }
+private:
+  orcacli_handle inst_ = nullptr;
+  size_t idx_ = 0;
+};
+
+// Exclusive access to every engine: waits for in-flight leases to drain, blocks new ones.
+class PoolExclusive {
+public:
+  PoolExclusive() = default;
+  PoolExclusive(const PoolExclusive&) = delete;
+  PoolExclusive& operator=(const PoolExclusive&) = delete;
+  ~PoolExclusive() {
+    if (!held_) return;
+    { std::lock_guard<std::mutex> lk(g_pool_mutex); g_pool_exclusive = false; }
+    g_pool_cv.notify_all();
+  }
+  // create_engines=false only takes the lock (used by shutdown, which must not spin up engines).
+  bool acquire(std::string* err_out, bool create_engines = true) {
+    if (create_engines && !ensure_engine_loaded(err_out)) return false;
+    std::unique_lock<std::mutex> lk(g_pool_mutex);
+    ++g_pool_exclusive_waiters;
+    g_pool_cv.wait(lk, []{
+      if (g_pool_exclusive) return false;
+      for (const auto& s : g_engines) if (s.busy) return false;
+      return true;
+    });
+    --g_pool_exclusive_waiters;
+    g_pool_exclusive = true; held_ = true;
+    if (create_engines && !ensure_engine_pool(err_out)) return false; // released by the destructor
+    return true;
+  }
+private:
+  bool held_ = false;
+};
+
+// Runs an engine call on every pooled instance (caller holds PoolExclusive). Stops at the first failure.
+template <typename Fn>
+static bool broadcast_engines(Fn&& call, const char* what, std::string* err_out) {
+  for (auto& slot : g_engines) {
+    auto r = call(slot.inst);
+    if (!r.success) {
+      if (err_out) *err_out = r.message ? r.message : (std::string(what) + " failed");
+      if (g_ffi.free_result) g_ffi.free_result(&r);
+      return false;
+    }
+    if (g_ffi.free_result) g_ffi.free_result(&r);
   }
   return true;
 }
@@ -240,17 +448,18 @@ static bool get_bool(napi_env env, napi_value v, bool* out) {
   bool b=false; if (napi_get_value_bool(env, v, &b) != napi_ok) return false; *out=b; return true;
 }
 
-// initialize({ resourcesPath?: string, verbose?: boolean, strict?: boolean, vendors?: string[], printerProfiles?: string[], filamentProfiles?: string[], processProfiles?: string[] })
+// initialize({ resourcesPath?: string, verbose?: boolean, strict?: boolean, engines?: number, vendors?: string[], printerProfiles?: string[], filamentProfiles?: string[], processProfiles?: string[] })
 static napi_value Initialize(napi_env env, napi_callback_info info) {
 
   // log para debug
-  fprintf(stderr, "DEBUG: [addon] Initialize 4 ()\n"); fflush(stderr);
+  LOG_DEBUG_STREAM("[addon] Initialize 4 ()");
   size_t argc = 1; napi_value args[1]; napi_value thisArg; void* data;
   NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, &thisArg, &data));
 
   std::string resourcesPath;
   bool verbose = false;
   bool strict = true; // API-only: default to strict no-autoload
+  size_t engines_requested = 0; // 0 = keep current/default pool size
   std::vector<std::string> vendors_requested;
   std::vector<std::string> printer_profiles_requested;
   std::vector<std::string> filament_profiles_requested;
@@ -268,6 +477,18 @@ static napi_value Initialize(napi_env env, napi_callback_info info) {
       if (has) { NAPI_CALL(env, napi_get_named_property(env, args[0], "verbose", &v)); (void)get_bool(env, v, &verbose); }
       NAPI_CALL(env, napi_has_named_property(env, args[0], "strict", &has));
       if (has) { NAPI_CALL(env, napi_get_named_property(env, args[0], "strict", &v)); (void)get_bool(env, v, &strict); }
+      NAPI_CALL(env, napi_has_named_property(env, args[0], "engines", &has));
+      if (has) {
+        NAPI_CALL(env, napi_get_named_property(env, args[0], "engines", &v));
+        napi_valuetype et; NAPI_CALL(env, napi_typeof(env, v, &et));
+        if (et == napi_number) { double d = 0; NAPI_CALL(env, napi_get_value_double(env, v, &d)); if (d >= 1) engines_requested = (size_t)d; }
+      }
+      NAPI_CALL(env, napi_has_named_property(env, args[0], "queueDepth", &has));
+      if (has) {
+        NAPI_CALL(env, napi_get_named_property(env, args[0], "queueDepth", &v));
+        napi_valuetype qt; NAPI_CALL(env, napi_typeof(env, v, &qt));
+        if (qt == napi_number) { double d = 0; NAPI_CALL(env, napi_get_value_double(env, v, &d)); if (d >= 0) sched_set_max_depth((size_t)d); }
+      }
       // Pre-scan vendors/presets to decide strict mode before core initialize
       // Collect arrays of strings from options into target vectors
       auto collect_into = [&](const char* prop, std::vector<std::string>& target){
@@ -296,132 +517,535 @@ static napi_value Initialize(napi_env env, napi_callback_info info) {
       has_vendors = !vendors_requested.empty();
     }
   }
+  if (verbose) Logger::getInstance().setLogLevel(LogLevel::Debug);
+
   // DEBUG: dump requested vendors and profiles
-  if (!vendors_requested.empty()) {
-    fprintf(stderr, "DEBUG: [addon] requested vendors (%zu):\n", vendors_requested.size()); fflush(stderr);
-    for (const auto &s : vendors_requested) { fprintf(stderr, "  - %s\n", s.c_str()); fflush(stderr); }
-  }
-  if (!printer_profiles_requested.empty()) {
-    fprintf(stderr, "DEBUG: [addon] requested printerProfiles (%zu):\n", printer_profiles_requested.size()); fflush(stderr);
-    for (const auto &s : printer_profiles_requested) { fprintf(stderr, "  - %s\n", s.c_str()); fflush(stderr); }
-  }
-  if (!filament_profiles_requested.empty()) {
-    fprintf(stderr, "DEBUG: [addon] requested filamentProfiles (%zu):\n", filament_profiles_requested.size()); fflush(stderr);
-    for (const auto &s : filament_profiles_requested) { fprintf(stderr, "  - %s\n", s.c_str()); fflush(stderr); }
-  }
-  if (!process_profiles_requested.empty()) {
-    fprintf(stderr, "DEBUG: [addon] requested processProfiles (%zu):\n", process_profiles_requested.size()); fflush(stderr);
-    for (const auto &s : process_profiles_requested) { fprintf(stderr, "  - %s\n", s.c_str()); fflush(stderr); }
-  }
+  auto log_requested = [](const char* what, const std::vector<std::string>& names) {
+    if (names.empty() || !Logger::isEnabled(LogLevel::Debug)) return;
+    std::string listing;
+    for (const auto &s : names) listing += "\n  - " + s;
+    LOG_DEBUG_STREAM("[addon] requested " << what << " (" << names.size() << "):" << listing);
+  };
+  log_requested("vendors", vendors_requested);
+  log_requested("printerProfiles", printer_profiles_requested);
+  log_requested("filamentProfiles", filament_profiles_requested);
+  log_requested("processProfiles", process_profiles_requested);
 
 
 
   // API-only control: do not read or modify environment for autoload behavior.
   // Respect the 'strict' flag from initialize() only. Currently, strict is enforced in core.
-  fprintf(stderr, "DEBUG: [addon] initialize options: strict=%d, vendors=%zu, printers=%zu, filaments=%zu, processes=%zu\n",
-          (int)strict, vendors_requested.size(), printer_profiles_requested.size(), filament_profiles_requested.size(), process_profiles_requested.size()); fflush(stderr);
+  LOG_DEBUG_STREAM("[addon] initialize options: strict=" << (int)strict << ", vendors=" << vendors_requested.size()
+                   << ", printers=" << printer_profiles_requested.size() << ", filaments=" << filament_profiles_requested.size()
+                   << ", processes=" << process_profiles_requested.size());
 
-  fprintf(stderr, "DEBUG: [addon] before ensure_engine_loaded()\n"); fflush(stderr);
-  std::lock_guard<std::mutex> lk(g_mutex);
+  LOG_DEBUG_STREAM("[addon] before ensure_engine_loaded()");
   std::string err;
   if (!ensure_engine_loaded(&err)) { napi_throw_error(env, nullptr, err.c_str()); return nullptr; }
-  fprintf(stderr, "DEBUG: [addon] after ensure_engine_loaded()\n"); fflush(stderr);
-  // Initialize the engine with the provided resourcesPath (if any)
+  LOG_DEBUG_STREAM("[addon] after ensure_engine_loaded()");
+  if (engines_requested > 0) {
+    std::lock_guard<std::mutex> lk(g_pool_mutex);
+    if (g_engines.empty()) g_pool_size = engines_requested;
+    else if (g_engines.size() != engines_requested) {
+      LOG_DEBUG_STREAM("[addon] engine pool already has " << g_engines.size() << " engine(s); ignoring engines=" << engines_requested << " (call shutdown() first)");
+    }
+  }
+  PoolExclusive pool;
+  if (!pool.acquire(&err)) { napi_throw_error(env, nullptr, err.c_str()); return nullptr; }
+  LOG_DEBUG_STREAM("[addon] engine pool ready: " << g_engines.size() << " engine(s)");
+  // Initialize every engine with the provided resourcesPath (if any)
 
   if (g_ffi.initialize) {
     const char* rp = resourcesPath.empty() ? nullptr : resourcesPath.c_str();
-    fprintf(stderr, "DEBUG: [addon] about to call g_ffi.initialize(rp=%s) init=%p free_result=%p\n", rp?rp:"(null)", (void*)g_ffi.initialize, (void*)g_ffi.free_result); fflush(stderr);
-    auto r = g_ffi.initialize(g_ffi.inst, rp);
-    fprintf(stderr, "DEBUG: [addon] g_ffi.initialize returned success=%d msg_ptr=%p details_ptr=%p\n", (int)r.success, (void*)r.message, (void*)r.error_details); fflush(stderr);
-    if (!r.success) {
-      std::string msg = r.message ? r.message : "initialize failed";
-      if (r.error_details) { msg += " — "; msg += r.error_details; }
-      // TEST ONLY: temporarily do NOT free the initialize result to avoid suspected double-free in engine/free_result.
-      // if (g_ffi.free_result) { g_ffi.free_result(&r); }
-      napi_throw_error(env, nullptr, msg.c_str());
+    for (auto& slot : g_engines) {
+      LOG_DEBUG_STREAM("[addon] about to call g_ffi.initialize(inst=" << slot.inst << ", rp=" << (rp?rp:"(null)") << ") init=" << (void*)g_ffi.initialize << " free_result=" << (void*)g_ffi.free_result);
+      auto r = g_ffi.initialize(slot.inst, rp);
+      LOG_DEBUG_STREAM("[addon] g_ffi.initialize returned success=" << (int)r.success << " msg_ptr=" << (void*)r.message << " details_ptr=" << (void*)r.error_details);
+      if (!r.success) {
+        std::string msg = r.message ? r.message : "initialize failed";
+        if (r.error_details) { msg += " — "; msg += r.error_details; }
+        if (g_ffi.free_result) g_ffi.free_result(&r);
+        napi_throw_error(env, nullptr, msg.c_str());
 
-      return nullptr;
+        return nullptr;
+      }
+      if (g_ffi.free_result) g_ffi.free_result(&r);
     }
-    // TEST ONLY: temporarily do NOT free the initialize result to avoid suspected double-free in engine/free_result.
-    // if (g_ffi.free_result) { g_ffi.free_result(&r); }
   }
 
   // Optionally load vendors passed (via 'vendors' or 'presets')
-  if (!vendors_requested.empty()) {
-    for (const auto& v : vendors_requested) {
-      fprintf(stderr, "DEBUG: [addon] calling load_vendor('%s')\n", v.c_str()); fflush(stderr);
+  for (const auto& v : vendors_requested) {
+    LOG_DEBUG_STREAM("[addon] calling load_vendor('" << v.c_str() << "')");
+    if (!broadcast_engines([&](orcacli_handle h){ return g_ffi.load_vendor(h, v.c_str()); }, "loadVendor", &err)) {
+      napi_throw_error(env, nullptr, err.c_str()); return nullptr;
+    }
+  }
+  // Optionally load specific profiles passed (only these will be loaded by the addon)
+  for (const auto& name : printer_profiles_requested) {
+    LOG_DEBUG_STREAM("[addon] calling load_printer_profile('" << name.c_str() << "')");
+    if (!broadcast_engines([&](orcacli_handle h){ return g_ffi.load_printer_profile(h, name.c_str()); }, "loadPrinterProfile", &err)) {
+      napi_throw_error(env, nullptr, err.c_str()); return nullptr;
+    }
+  }
+  for (const auto& name : filament_profiles_requested) {
+    LOG_DEBUG_STREAM("[addon] calling load_filament_profile('" << name.c_str() << "')");
+    if (!broadcast_engines([&](orcacli_handle h){ return g_ffi.load_filament_profile(h, name.c_str()); }, "loadFilamentProfile", &err)) {
+      napi_throw_error(env, nullptr, err.c_str()); return nullptr;
+    }
+  }
+  for (const auto& name : process_profiles_requested) {
+    LOG_DEBUG_STREAM("[addon] calling load_process_profile('" << name.c_str() << "')");
+    if (!broadcast_engines([&](orcacli_handle h){ return g_ffi.load_process_profile(h, name.c_str()); }, "loadProcessProfile", &err)) {
+      napi_throw_error(env, nullptr, err.c_str()); return nullptr;
+    }
+  }
+  napi_value undef; NAPI_CALL(env, napi_get_undefined(env, &undef)); return undef;
+}
+
+// version(): string
+static napi_value Version(napi_env env, napi_callback_info info) {
+  std::string err;
+  if (!ensure_engine_loaded(&err)) { napi_throw_error(env, nullptr, err.c_str()); return nullptr; }
+  const char* v = g_ffi.version();
+  napi_value js; NAPI_CALL(env, napi_create_string_utf8(env, v?v:"", NAPI_AUTO_LENGTH, &js)); return js;
+}
 
-      auto lr = g_ffi.load_vendor(g_ffi.inst, v.c_str());
-      if (!lr.success) {
+// sliceChunks(): the engine thread hands output to JS through a few fixed chunk slots. It blocks while
+// all slots are in flight or the consumer paused (Readable backpressure), so memory stays at
+// kSlots * chunk size whatever the G-code size. Shared by the job, the threadsafe function and resume().
+struct StreamRing {
+  static constexpr size_t kSlots = 4;
+  std::mutex m; std::condition_variable cv;
+  std::vector<uint8_t> slots[kSlots];
+  size_t head = 0, tail = 0, filled = 0;
+  bool paused = false, stop = false, closed = false; // closed: job freed, the refs below are gone
+  bool expired = false; // params.timeoutMs ran out while the consumer kept the engine paused
+  std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+  uint64_t bytes = 0;
+  napi_threadsafe_function tsfn = nullptr;
+  napi_ref on_data = nullptr, resume = nullptr;
+};
 
+// What a scheduled job runs on its engine: a slice/reslice, or getModelInfo()/openSession(), which take an engine too
+enum JobKind { kJobSlice, kJobModelInfo, kJobSessionOpen };
 
-        std::string msg = lr.message ? lr.message : "loadVendor failed";
-        if (g_ffi.free_result) g_ffi.free_result(&lr);
-        napi_throw_error(env, nullptr, msg.c_str());
-        return nullptr;
-      }
-      if (g_ffi.free_result) g_ffi.free_result(&lr);
-    }
+// slice(params): Promise<{output: string}>; params.signal (AbortSignal) / params.timeoutMs stop the job
+struct SliceWork {
+  napi_async_work work; napi_deferred deferred;
+  JobKind kind = kJobSlice;
+  struct {
+    std::string input_file; std::string output_file;
+    std::string printer_profile; std::string filament_profile; std::string process_profile;
+    int plate_index=1; bool verbose=false; bool dry_run=false;
+    int compression_level=-1; // params.compressionLevel (zlib 0-9); -1 = engine default
+    std::string output_format; // params.outputFormat ("gcode.gz", "bgcode", ...); empty = from the output extension
+    std::string trace_file; // params.trace: Chrome trace JSON of the job, returned as result.tracePath; empty = off
+  } p;
+  // store options as strings and build C array for FFI
+  std::vector<std::pair<std::string,std::string>> opts;
+  std::vector<orcacli_kv> kvs;
+  std::string err;
+  // reslice(): run on the engine pinned to the session instead of any idle one
+  size_t session_engine = 0; uint64_t session = 0;
+  orcacli_reslice_info reslice_info{-1, 0u};
+  orcacli_slice_timings timings{}; bool has_timings = false;
+  int priority = 0; // SlicePriority
+  std::chrono::steady_clock::time_point submitted, started;
+  // Cancellation: params.signal (AbortSignal) and params.timeoutMs, measured from submission
+  uint64_t job_id = 0; int timeout_ms = 0;
+  napi_ref signal = nullptr, on_abort = nullptr;
+  std::atomic<bool> aborted{false};
+  orcacli_handle running_on = nullptr; // engine running the job (guarded by g_pool_mutex)
+  // sliceToBuffer(): output stays in engine memory until the ArrayBuffer is collected (also set for sliceChunks:
+  // no output file, params.output only picks the kind)
+  bool to_buffer = false;
+  orcacli_buffer buffer{nullptr, 0, nullptr};
+  // sliceChunks(): output goes to the consumer chunk by chunk
+  std::shared_ptr<StreamRing> stream;
+  // params.input as Buffer/Uint8Array/ArrayBuffer: sliced from memory; the reference keeps the bytes alive
+  napi_ref input_ref = nullptr;
+  const uint8_t* input_data = nullptr; size_t input_size = 0;
+  std::string input_format;
+  // getModelInfo() result / openSession() handle
+  struct { std::string filename; uint32_t object_count=0; uint32_t triangle_count=0; double volume=0; std::string bounding_box; bool is_valid=false; } info;
+  std::string session_handle;
+};
+
+// Slicing scheduler: every job that leases an engine (slice()/reslice(), getModelInfo(), openSession())
+// waits here, not in libuv's thread pool, until an engine is free. The wait queue is bounded (full =>
+// fast rejection with a retry-after hint), interactive jobs are dequeued before batch jobs, and
+// queue-wait/total latency is sampled per priority. A reslice() is pinned to its session's engine: it is
+// not started while another job of the same session runs (it would only park a thread in EngineLease),
+// and jobs queued behind it may start first.
+// All state is touched only from the JS thread (submit in the API calls, finish in SliceComplete).
+enum SlicePriority { kPriorityInteractive = 0, kPriorityBatch = 1, kPriorityCount = 2 };
+static const char* const kPriorityNames[kPriorityCount] = {"interactive", "batch"};
+
+struct LatencyRing {
+  std::vector<double> samples; size_t next = 0;
+  void add(double ms) { if (samples.size() < 1024) samples.push_back(ms); else { samples[next] = ms; next = (next + 1) % samples.size(); } }
+  double percentile(double p) const {
+    if (samples.empty()) return 0;
+    std::vector<double> sorted(samples); std::sort(sorted.begin(), sorted.end());
+    size_t i = (size_t)std::ceil(p * sorted.size()); return sorted[i == 0 ? 0 : i - 1];
   }
-  // Optionally load specific profiles passed (only these will be loaded by the addon)
-  if (!printer_profiles_requested.empty()) {
-    for (const auto& name : printer_profiles_requested) {
-      fprintf(stderr, "DEBUG: [addon] calling load_printer_profile('%s')\n", name.c_str()); fflush(stderr);
+};
+struct PriorityStats { uint64_t submitted = 0, rejected = 0, completed = 0, failed = 0, aborted = 0; LatencyRing wait, total; };
+struct SliceScheduler {
+  std::deque<SliceWork*> queues[kPriorityCount];
+  size_t running = 0;
+  size_t max_depth = 0; bool depth_resolved = false; // ORCACLI_QUEUE_DEPTH or initialize({ queueDepth }), default 64
+  double avg_service_ms = 0;                          // EWMA of engine time per job, for retry-after
+  std::vector<size_t> pinned;                         // running reslice() jobs per engine index
+  PriorityStats stats[kPriorityCount];
+};
+static SliceScheduler g_sched;
 
-      auto r = g_ffi.load_printer_profile(g_ffi.inst, name.c_str());
+static void sched_set_max_depth(size_t depth) { g_sched.max_depth = depth; g_sched.depth_resolved = true; }
 
-      if (!r.success) { std::string msg = r.message ? r.message : "loadPrinterProfile failed"; if (g_ffi.free_result) g_ffi.free_result(&r); napi_throw_error(env, nullptr, msg.c_str()); return nullptr; }
-      if (g_ffi.free_result) g_ffi.free_result(&r);
+static size_t sched_max_depth() {
+  if (!g_sched.depth_resolved) {
+    g_sched.max_depth = 64;
+    const char* e = std::getenv("ORCACLI_QUEUE_DEPTH");
+    if (e && *e) { long n = std::strtol(e, nullptr, 10); if (n >= 0) g_sched.max_depth = (size_t)n; }
+    g_sched.depth_resolved = true;
+  }
+  return g_sched.max_depth;
+}
+
+// Concurrent slices = engines in the pool (more would only park libuv threads in EngineLease)
+static size_t sched_capacity() {
+  std::lock_guard<std::mutex> lk(g_pool_mutex);
+  if (!g_engines.empty()) return g_engines.size();
+  return g_pool_size ? g_pool_size : default_pool_size();
+}
+
+static size_t sched_queued() { return g_sched.queues[kPriorityInteractive].size() + g_sched.queues[kPriorityBatch].size(); }
+
+static double ms_between(std::chrono::steady_clock::time_point a, std::chrono::steady_clock::time_point b) {
+  return std::chrono::duration<double, std::milli>(b - a).count();
+}
+
+// A session job can start once no other job of its engine's session is running
+static bool sched_ready(const SliceWork* w) {
+  return !w->session || w->session_engine >= g_sched.pinned.size() || g_sched.pinned[w->session_engine] == 0;
+}
+
+static void sched_start(napi_env env, SliceWork* w) {
+  w->started = std::chrono::steady_clock::now();
+  g_sched.stats[w->priority].wait.add(ms_between(w->submitted, w->started));
+  ++g_sched.running;
+  if (w->session) {
+    if (g_sched.pinned.size() <= w->session_engine) g_sched.pinned.resize(w->session_engine + 1, 0);
+    ++g_sched.pinned[w->session_engine];
+  }
+  napi_queue_async_work(env, w->work);
+}
+
+// Starts the job now, queues it, or returns false (queue full) with a retry-after estimate.
+// sched_finish() starts queued jobs as soon as they can run, so none that could is waiting here.
+static bool sched_submit(napi_env env, SliceWork* w, double* retry_after_ms) {
+  w->submitted = std::chrono::steady_clock::now();
+  auto& st = g_sched.stats[w->priority];
+  ++st.submitted;
+  const size_t capacity = sched_capacity();
+  if (g_sched.running < capacity && sched_ready(w)) { sched_start(env, w); return true; }
+  if (sched_queued() >= sched_max_depth()) {
+    ++st.rejected;
+    const double service = g_sched.avg_service_ms > 0 ? g_sched.avg_service_ms : 1000.0;
+    *retry_after_ms = std::max(100.0, service * (double)(sched_queued() + g_sched.running) / (double)std::max<size_t>(capacity, 1));
+    return false;
+  }
+  g_sched.queues[w->priority].push_back(w);
+  return true;
+}
+
+static napi_value make_error(napi_env env, const char* code, const std::string& text);
+static void slice_work_delete(napi_env env, SliceWork* w);
+
+static void sched_finish(napi_env env, SliceWork* w, bool ok) {
+  const auto now = std::chrono::steady_clock::now();
+  auto& st = g_sched.stats[w->priority];
+  if (ok) ++st.completed; else ++st.failed;
+  st.total.add(ms_between(w->submitted, now));
+  const double service = ms_between(w->started, now);
+  g_sched.avg_service_ms = g_sched.avg_service_ms > 0 ? 0.8 * g_sched.avg_service_ms + 0.2 * service : service;
+  if (g_sched.running > 0) --g_sched.running;
+  if (w->session && w->session_engine < g_sched.pinned.size() && g_sched.pinned[w->session_engine] > 0) --g_sched.pinned[w->session_engine];
+  const size_t capacity = sched_capacity();
+  while (g_sched.running < capacity) {
+    // Oldest job of the highest priority that can run now
+    SliceWork* next = nullptr;
+    for (auto& q : g_sched.queues) {
+      auto it = std::find_if(q.begin(), q.end(), sched_ready);
+      if (it != q.end()) { next = *it; q.erase(it); break; }
     }
+    if (!next) break;
+    // params.timeoutMs ran out in the queue: reject here instead of taking an engine slot for it
+    if (next->timeout_ms > 0 && ms_between(next->submitted, now) >= next->timeout_ms) {
+      auto& nst = g_sched.stats[next->priority];
+      ++nst.failed;
+      nst.total.add(ms_between(next->submitted, now));
+      napi_reject_deferred(env, next->deferred, make_error(env, "ORCACLI_DEADLINE_EXCEEDED", "Slicing deadline exceeded"));
+      slice_work_delete(env, next);
+      continue;
+    }
+    sched_start(env, next);
   }
+}
 
-  if (!filament_profiles_requested.empty()) {
-    for (const auto& name : filament_profiles_requested) {
-      fprintf(stderr, "DEBUG: [addon] calling load_filament_profile('%s')\n", name.c_str()); fflush(stderr);
+// Jobs with an AbortSignal listener, by job id (JS thread only)
+static std::unordered_map<uint64_t, SliceWork*> g_live_jobs;
+static uint64_t g_next_job_id = 0;
 
-      auto r = g_ffi.load_filament_profile(g_ffi.inst, name.c_str());
+static napi_value make_error(napi_env env, const char* code, const std::string& text) {
+  napi_value c, msg, err;
+  napi_create_string_utf8(env, code, NAPI_AUTO_LENGTH, &c);
+  napi_create_string_utf8(env, text.c_str(), NAPI_AUTO_LENGTH, &msg);
+  napi_create_error(env, c, msg, &err);
+  return err;
+}
 
-      if (!r.success) { std::string msg = r.message ? r.message : "loadFilamentProfile failed"; if (g_ffi.free_result) g_ffi.free_result(&r); napi_throw_error(env, nullptr, msg.c_str()); return nullptr; }
+// Same shape as the AbortError of fetch()/timers/promises: name 'AbortError', code 'ABORT_ERR'
+static napi_value make_abort_error(napi_env env) {
+  napi_value err = make_error(env, "ABORT_ERR", "The operation was aborted"), name;
+  napi_create_string_utf8(env, "AbortError", NAPI_AUTO_LENGTH, &name); napi_set_named_property(env, err, "name", name);
+  return err;
+}
 
-      if (g_ffi.free_result) g_ffi.free_result(&r);
+// Removes the abort listener and frees the job (its promise must be settled already)
+static void slice_work_delete(napi_env env, SliceWork* w) {
+  if (w->signal) {
+    napi_value signal, fn, remove, type;
+    if (napi_get_reference_value(env, w->signal, &signal) == napi_ok && signal &&
+        napi_get_reference_value(env, w->on_abort, &fn) == napi_ok && fn &&
+        napi_get_named_property(env, signal, "removeEventListener", &remove) == napi_ok) {
+      napi_create_string_utf8(env, "abort", NAPI_AUTO_LENGTH, &type);
+      napi_value argv[2] = {type, fn};
+      napi_call_function(env, signal, remove, 2, argv, nullptr);
     }
+    napi_delete_reference(env, w->signal);
+    napi_delete_reference(env, w->on_abort);
+    g_live_jobs.erase(w->job_id);
   }
-  if (!process_profiles_requested.empty()) {
+  if (w->buffer.opaque && g_ffi.free_buffer) g_ffi.free_buffer(&w->buffer); // not handed to JS (failure/abort)
+  if (w->stream) {
+    {
+      std::lock_guard<std::mutex> lk(w->stream->m);
+      w->stream->closed = true; w->stream->stop = true;
+    }
+    w->stream->cv.notify_all();
+    if (w->stream->on_data) napi_delete_reference(env, w->stream->on_data);
+    if (w->stream->resume) napi_delete_reference(env, w->stream->resume);
+    if (w->stream->tsfn) napi_release_threadsafe_function(w->stream->tsfn, napi_tsfn_abort);
+  }
+  if (w->input_ref) napi_delete_reference(env, w->input_ref);
+  if (w->work) napi_delete_async_work(env, w->work);
+  delete w;
+}
 
-    for (const auto& name : process_profiles_requested) {
-      fprintf(stderr, "DEBUG: [addon] calling load_process_profile('%s')\n", name.c_str()); fflush(stderr);
+static void finalize_engine_buffer(napi_env env, void* data, void* hint) {
+  (void)env; (void)data;
+  orcacli_buffer* buf = static_cast<orcacli_buffer*>(hint);
+  if (g_ffi.free_buffer) g_ffi.free_buffer(buf);
+  delete buf;
+}
 
-      auto r = g_ffi.load_process_profile(g_ffi.inst, name.c_str());
+// Wraps the engine's output bytes in an ArrayBuffer without copying; the engine buffer is freed by the GC
+static napi_value take_engine_buffer(napi_env env, orcacli_buffer* src) {
+  napi_value ab = nullptr;
+  if (src->size > 0) {
+    auto* owned = new orcacli_buffer(*src);
+    if (napi_create_external_arraybuffer(env, const_cast<uint8_t*>(owned->data), (size_t)owned->size, finalize_engine_buffer, owned, &ab) == napi_ok) {
+      *src = orcacli_buffer{nullptr, 0, nullptr};
+      return ab;
+    }
+    delete owned; // runtimes without external buffers (V8 sandbox): fall back to one copy
+  }
+  void* bytes = nullptr;
+  napi_create_arraybuffer(env, (size_t)src->size, &bytes, &ab);
+  if (src->size > 0 && bytes) std::memcpy(bytes, src->data, (size_t)src->size);
+  if (g_ffi.free_buffer) g_ffi.free_buffer(src);
+  return ab;
+}
 
+// 'abort' listener: a queued job is dropped and rejected now; a running one is canceled in the engine
+// and rejects with AbortError as soon as the engine gives up (next cancellation point)
+static napi_value OnSliceAbort(napi_env env, napi_callback_info info) {
+  void* data = nullptr; NAPI_CALL(env, napi_get_cb_info(env, info, nullptr, nullptr, nullptr, &data));
+  auto it = g_live_jobs.find((uint64_t)(uintptr_t)data);
+  if (it == g_live_jobs.end()) return nullptr;
+  SliceWork* w = it->second;
+  w->aborted = true;
+  auto& q = g_sched.queues[w->priority];
+  auto queued = std::find(q.begin(), q.end(), w);
+  if (queued != q.end()) {
+    q.erase(queued);
+    ++g_sched.stats[w->priority].aborted;
+    napi_reject_deferred(env, w->deferred, make_abort_error(env));
+    slice_work_delete(env, w);
+    return nullptr;
+  }
+  if (w->stream) { // the engine may be blocked on a full ring, not at a cancellation point
+    { std::lock_guard<std::mutex> lk(w->stream->m); w->stream->stop = true; }
+    w->stream->cv.notify_all();
+  }
+  std::lock_guard<std::mutex> lk(g_pool_mutex);
+  if (w->running_on && g_ffi.cancel) g_ffi.cancel(w->running_on, w->job_id);
+  return nullptr;
+}
 
-      if (!r.success) { std::string msg = r.message ? r.message : "loadProcessProfile failed"; if (g_ffi.free_result) g_ffi.free_result(&r); napi_throw_error(env, nullptr, msg.c_str()); return nullptr; }
-      if (g_ffi.free_result) g_ffi.free_result(&r);
+// Engine thread: waits for a free slot (and no pause), then queues the chunk for the JS thread. Non-zero stops the slice.
+static int stream_write(void* user, const uint8_t* data, uint64_t size) {
+  auto* ring = static_cast<StreamRing*>(user);
+  {
+    std::unique_lock<std::mutex> lk(ring->m);
+    if (!ring->cv.wait_until(lk, ring->deadline, [ring] { return ring->stop || (!ring->paused && ring->filled < StreamRing::kSlots); })) {
+      ring->expired = ring->stop = true;
+      return 1;
     }
+    if (ring->stop) return 1;
+    ring->slots[ring->head].assign(data, data + size);
+    ring->head = (ring->head + 1) % StreamRing::kSlots;
+    ++ring->filled; ring->bytes += size;
   }
-  napi_value undef; NAPI_CALL(env, napi_get_undefined(env, &undef)); return undef;
+  if (napi_call_threadsafe_function(ring->tsfn, nullptr, napi_tsfn_nonblocking) == napi_ok) return 0;
+  { std::lock_guard<std::mutex> lk(ring->m); ring->stop = true; }
+  ring->cv.notify_all();
+  return 1;
 }
 
-// version(): string
-static napi_value Version(napi_env env, napi_callback_info info) {
-  std::lock_guard<std::mutex> lk(g_mutex);
-  std::string err;
-  if (!ensure_engine_loaded(&err)) { napi_throw_error(env, nullptr, err.c_str()); return nullptr; }
-  const char* v = g_ffi.version();
-  napi_value js; NAPI_CALL(env, napi_create_string_utf8(env, v?v:"", NAPI_AUTO_LENGTH, &js)); return js;
+// JS thread: copies the oldest slot into a Buffer, frees the slot and calls onData(chunk, resume).
+// onData returning false pauses the engine until resume() is called.
+static void stream_deliver(napi_env env, napi_value, void* context, void*) {
+  auto* ring = static_cast<std::shared_ptr<StreamRing>*>(context)->get();
+  if (!env) return;
+  napi_value chunk = nullptr;
+  {
+    std::lock_guard<std::mutex> lk(ring->m);
+    if (ring->filled == 0) return;
+    auto& slot = ring->slots[ring->tail];
+    if (!ring->closed) napi_create_buffer_copy(env, slot.size(), slot.data(), nullptr, &chunk);
+    ring->tail = (ring->tail + 1) % StreamRing::kSlots;
+    --ring->filled;
+  }
+  ring->cv.notify_all();
+  if (!chunk) return;
+  napi_value fn, resume, global, ret;
+  napi_get_reference_value(env, ring->on_data, &fn);
+  napi_get_reference_value(env, ring->resume, &resume);
+  napi_get_global(env, &global);
+  napi_value argv[2] = {chunk, resume};
+  if (napi_call_function(env, global, fn, 2, argv, &ret) != napi_ok) {
+    napi_value e; napi_get_and_clear_last_exception(env, &e); // a throwing consumer ends the stream
+    { std::lock_guard<std::mutex> lk(ring->m); ring->stop = true; }
+    ring->cv.notify_all();
+    return;
+  }
+  bool more = true; napi_valuetype vt;
+  if (napi_typeof(env, ret, &vt) == napi_ok && vt == napi_boolean) napi_get_value_bool(env, ret, &more);
+  if (!more) { std::lock_guard<std::mutex> lk(ring->m); ring->paused = true; }
 }
 
-// getModelInfo(file): Promise<ModelInfo>
-struct InfoWork { napi_async_work work; napi_deferred deferred; std::string file; struct { std::string filename; uint32_t object_count=0; uint32_t triangle_count=0; double volume=0; std::string bounding_box; bool is_valid=false; } info; std::string err; };
+static void stream_finalize(napi_env, void* data, void*) { delete static_cast<std::shared_ptr<StreamRing>*>(data); }
 
-static void InfoExecute(napi_env env, void* data) {
-  InfoWork* w = static_cast<InfoWork*>(data);
-  std::lock_guard<std::mutex> lk(g_mutex);
-  std::string err;
-  if (!ensure_engine_loaded(&err)) { w->err = err; return; }
-  auto r = g_ffi.load_model(g_ffi.inst, w->file.c_str());
+static napi_value OnStreamResume(napi_env env, napi_callback_info info) {
+  void* data = nullptr; NAPI_CALL(env, napi_get_cb_info(env, info, nullptr, nullptr, nullptr, &data));
+  auto* ring = static_cast<std::shared_ptr<StreamRing>*>(data)->get();
+  { std::lock_guard<std::mutex> lk(ring->m); ring->paused = false; }
+  ring->cv.notify_all();
+  return nullptr;
+}
+
+// Wires onData to a fresh ring; resume() may outlive the job, so it holds its own reference to the ring
+static bool attach_stream(napi_env env, napi_value on_data, SliceWork* w) {
+  auto ring = std::make_shared<StreamRing>();
+  napi_value resume, name;
+  auto* resume_ref = new std::shared_ptr<StreamRing>(ring);
+  if (napi_create_function(env, "resume", NAPI_AUTO_LENGTH, OnStreamResume, resume_ref, &resume) != napi_ok) { delete resume_ref; return false; }
+  napi_add_finalizer(env, resume, resume_ref, stream_finalize, nullptr, nullptr);
+  napi_create_string_utf8(env, "sliceChunks", NAPI_AUTO_LENGTH, &name);
+  auto* tsfn_ref = new std::shared_ptr<StreamRing>(ring);
+  if (napi_create_threadsafe_function(env, nullptr, nullptr, name, 0, 1, tsfn_ref, stream_finalize, tsfn_ref, stream_deliver, &ring->tsfn) != napi_ok) {
+    delete tsfn_ref; return false;
+  }
+  napi_create_reference(env, on_data, 1, &ring->on_data);
+  napi_create_reference(env, resume, 1, &ring->resume);
+  w->stream = ring;
+  return true;
+}
+
+// Reads params.signal; false if it is already aborted (the job must not start)
+static bool attach_abort_signal(napi_env env, napi_value params, SliceWork* w) {
+  w->job_id = ++g_next_job_id;
+  bool has = false; napi_value signal; napi_valuetype vt;
+  if (napi_has_named_property(env, params, "signal", &has) != napi_ok || !has) return true;
+  if (napi_get_named_property(env, params, "signal", &signal) != napi_ok || napi_typeof(env, signal, &vt) != napi_ok || vt != napi_object) return true;
+  napi_value v; bool aborted = false;
+  if (napi_get_named_property(env, signal, "aborted", &v) == napi_ok) get_bool(env, v, &aborted);
+  if (aborted) return false;
+  napi_value add, fn, type;
+  if (napi_get_named_property(env, signal, "addEventListener", &add) != napi_ok || napi_typeof(env, add, &vt) != napi_ok || vt != napi_function) return true;
+  napi_create_function(env, "onSliceAbort", NAPI_AUTO_LENGTH, OnSliceAbort, (void*)(uintptr_t)w->job_id, &fn);
+  napi_create_string_utf8(env, "abort", NAPI_AUTO_LENGTH, &type);
+  napi_value argv[2] = {type, fn};
+  if (napi_call_function(env, signal, add, 2, argv, nullptr) != napi_ok) return true;
+  napi_create_reference(env, signal, 1, &w->signal);
+  napi_create_reference(env, fn, 1, &w->on_abort);
+  g_live_jobs[w->job_id] = w;
+  return true;
+}
+
+// Rejects a job refused by admission control: Error{ code: 'ORCACLI_QUEUE_FULL', retryAfterMs }
+static void sched_reject(napi_env env, SliceWork* w, double retry_after_ms) {
+  napi_value ra;
+  std::string text = "Slicing queue full (" + std::to_string(sched_queued()) + " waiting); retry after " + std::to_string((long)retry_after_ms) + " ms";
+  napi_value err = make_error(env, "ORCACLI_QUEUE_FULL", text);
+  napi_create_double(env, std::ceil(retry_after_ms), &ra); napi_set_named_property(env, err, "retryAfterMs", ra);
+  napi_reject_deferred(env, w->deferred, err);
+  slice_work_delete(env, w);
+}
+
+// Stage timings of the job that just ran; the lease is still held, so no other job has run on the engine since
+static void read_timings(orcacli_handle engine, SliceWork* w) {
+  if (!g_ffi.get_last_timings) return;
+  w->timings = g_ffi.get_last_timings(engine);
+  w->has_timings = true;
+}
+
+// result.timings: nanoseconds per stage and per process step (steps: { slice: { ns, count }, ... })
+static napi_value make_timings(napi_env env, const orcacli_slice_timings& t) {
+  static const char* const step_names[ORCACLI_STEP_COUNT] = {"slice", "perimeters", "prepare_infill", "infill", "ironing", "support_material", "wipe_tower", "skirt_brim"};
+  napi_value obj, steps, v;
+  napi_create_object(env, &obj);
+  auto set_num = [&](napi_value target, const char* key, double value) { napi_create_double(env, value, &v); napi_set_named_property(env, target, key, v); };
+  set_num(obj, "loadModelNs", (double)t.load_model_ns);
+  set_num(obj, "presetsNs", (double)t.presets_ns);
+  set_num(obj, "applyNs", (double)t.apply_ns);
+  set_num(obj, "processNs", (double)t.process_ns);
+  set_num(obj, "exportGcodeNs", (double)t.export_gcode_ns);
+  set_num(obj, "packageNs", (double)t.package_ns);
+  set_num(obj, "totalNs", (double)t.total_ns);
+  napi_create_object(env, &steps);
+  for (int i = 0; i < ORCACLI_STEP_COUNT; ++i) {
+    napi_value step; napi_create_object(env, &step);
+    set_num(step, "ns", (double)t.step_ns[i]);
+    set_num(step, "count", (double)t.step_count[i]);
+    napi_set_named_property(env, steps, step_names[i], step);
+  }
+  napi_set_named_property(env, obj, "steps", steps);
+  set_num(obj, "objects", (double)t.objects);
+  set_num(obj, "layers", (double)t.layers);
+  napi_get_boolean(env, t.cached, &v); napi_set_named_property(env, obj, "cached", v);
+  return obj;
+}
+
+// getModelInfo(): loads the file on the leased engine and reads its summary
+static void run_model_info(EngineLease& engine, SliceWork* w) {
+  auto r = g_ffi.load_model(engine.get(), w->p.input_file.c_str());
   if (!r.success) { w->err = r.message ? r.message : "loadModel failed"; if (g_ffi.free_result) g_ffi.free_result(&r); return; }
   if (g_ffi.free_result) g_ffi.free_result(&r);
-  auto mi = g_ffi.get_model_info(g_ffi.inst);
+  auto mi = g_ffi.get_model_info(engine.get());
   if (mi.filename) w->info.filename = mi.filename;
   w->info.object_count = mi.object_count;
   w->info.triangle_count = mi.triangle_count;
@@ -431,65 +1055,55 @@ static void InfoExecute(napi_env env, void* data) {
   if (g_ffi.free_model_info) g_ffi.free_model_info(&mi);
 }
 
-static void InfoComplete(napi_env env, napi_status status, void* data) {
-  InfoWork* w = static_cast<InfoWork*>(data);
-  if (status != napi_ok) { napi_value e; napi_create_string_utf8(env, "Async failure", NAPI_AUTO_LENGTH, &e); napi_reject_deferred(env, w->deferred, e); }
-  else if (!w->err.empty()) { napi_value e; napi_create_string_utf8(env, w->err.c_str(), NAPI_AUTO_LENGTH, &e); napi_reject_deferred(env, w->deferred, e); }
-  else {
-    napi_value obj; napi_create_object(env, &obj);
-    napi_value v;
-    napi_create_string_utf8(env, w->info.filename.c_str(), NAPI_AUTO_LENGTH, &v); napi_set_named_property(env, obj, "filename", v);
-    napi_create_uint32(env, (uint32_t)w->info.object_count, &v); napi_set_named_property(env, obj, "objectCount", v);
-    napi_create_uint32(env, (uint32_t)w->info.triangle_count, &v); napi_set_named_property(env, obj, "triangleCount", v);
-    napi_create_double(env, w->info.volume, &v); napi_set_named_property(env, obj, "volume", v);
-    napi_create_string_utf8(env, w->info.bounding_box.c_str(), NAPI_AUTO_LENGTH, &v); napi_set_named_property(env, obj, "boundingBox", v);
-    napi_get_boolean(env, w->info.is_valid, &v); napi_set_named_property(env, obj, "isValid", v);
-    napi_resolve_deferred(env, w->deferred, obj);
-  }
-  napi_delete_async_work(env, w->work); delete w;
-}
-
-static napi_value GetModelInfo(napi_env env, napi_callback_info info) {
-  size_t argc = 1; napi_value args[1]; napi_value thisArg; void* data; NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, &thisArg, &data));
-  if (argc < 1) { napi_throw_type_error(env, nullptr, "file path is required"); return nullptr; }
-  std::string file = get_string(env, args[0]);
-
-  auto* work = new InfoWork(); work->file = std::move(file);
-  napi_value promise; NAPI_CALL(env, napi_create_promise(env, &work->deferred, &promise));
-  napi_value resource_name; napi_create_string_utf8(env, "getModelInfo", NAPI_AUTO_LENGTH, &resource_name);
-  NAPI_CALL(env, napi_create_async_work(env, nullptr, resource_name, InfoExecute, InfoComplete, work, &work->work));
-  NAPI_CALL(env, napi_queue_async_work(env, work->work));
-  return promise;
+// openSession(): loads the model and pins the leased engine to the new session
+static void run_session_open(EngineLease& engine, SliceWork* w) {
+  if (!g_ffi.session_open) { w->err = "Engine library does not support sessions (orcacli_session_open missing)"; return; }
+  uint64_t id = 0;
+  auto r = g_ffi.session_open(engine.get(), w->p.input_file.c_str(), w->p.plate_index, &id);
+  if (!r.success) w->err = r.message ? r.message : "openSession failed";
+  if (g_ffi.free_result) g_ffi.free_result(&r);
+  if (!w->err.empty()) return;
+  engine.set_session(id);
+  w->session_handle = std::to_string(engine.index()) + ":" + std::to_string(id);
 }
 
-// slice(params): Promise<{output: string}>
-struct SliceWork {
-  napi_async_work work; napi_deferred deferred;
-  struct {
-    std::string input_file; std::string output_file;
-    std::string printer_profile; std::string filament_profile; std::string process_profile;
-    int plate_index=1; bool verbose=false; bool dry_run=false;
-  } p;
-  // store options as strings and build C array for FFI
-  std::vector<std::pair<std::string,std::string>> opts;
-  std::vector<orcacli_kv> kvs;
-  std::string err;
-};
-
 static void SliceExecute(napi_env env, void* data) {
   SliceWork* w = static_cast<SliceWork*>(data);
-  std::lock_guard<std::mutex> lk(g_mutex);
+  EngineLease engine;
   std::string err;
-  if (!ensure_engine_loaded(&err)) { w->err = err; return; }
+  if (!(w->session ? engine.acquire_session(w->session_engine, w->session, &err) : engine.acquire(&err))) { w->err = err; return; }
+  if (w->kind == kJobModelInfo) { run_model_info(engine, w); return; }
+  if (w->kind == kJobSessionOpen) { run_session_open(engine, w); return; }
+  int timeout_ms = 0;
+  if (w->timeout_ms > 0) {
+    timeout_ms = w->timeout_ms - (int)ms_between(w->submitted, std::chrono::steady_clock::now());
+    if (timeout_ms <= 0) { w->err = "Slicing deadline exceeded"; return; } // spent waiting in the queue
+  }
+  {
+    std::lock_guard<std::mutex> lk(g_pool_mutex);
+    if (w->aborted) { w->err = "Slicing canceled"; return; }
+    w->running_on = engine.get(); // from here an abort goes to g_ffi.cancel
+  }
+  struct RunningReset { SliceWork* w; ~RunningReset() { std::lock_guard<std::mutex> lk(g_pool_mutex); w->running_on = nullptr; } } running_reset{w};
   orcacli_slice_params p{};
-  p.input_file = w->p.input_file.c_str();
-  p.output_file = w->p.output_file.c_str();
+  p.input_file = w->p.input_file.empty() && w->input_data ? nullptr : w->p.input_file.c_str();
+  if (w->input_data) {
+    p.input_data = w->input_data;
+    p.input_size = w->input_size;
+    p.input_format = w->input_format.c_str();
+  }
+  p.output_file = w->p.output_file.empty() && w->to_buffer ? nullptr : w->p.output_file.c_str();
   p.printer_profile = w->p.printer_profile.empty()?nullptr:w->p.printer_profile.c_str();
   p.filament_profile = w->p.filament_profile.empty()?nullptr:w->p.filament_profile.c_str();
   p.process_profile = w->p.process_profile.empty()?nullptr:w->p.process_profile.c_str();
   p.plate_index = w->p.plate_index;
   p.verbose = w->p.verbose;
   p.dry_run = w->p.dry_run;
+  p.job_id = w->job_id;
+  p.timeout_ms = timeout_ms;
+  p.output_format = w->p.output_format.empty() ? nullptr : w->p.output_format.c_str();
+  p.trace_file = w->p.trace_file.empty() ? nullptr : w->p.trace_file.c_str();
+  if (w->p.compression_level >= 0) p.compression_level = w->p.compression_level == 0 ? ORCACLI_COMPRESSION_STORE : std::min(9, w->p.compression_level);
   // Build overrides array (pointers valid due to storage in w->opts)
   if (!w->opts.empty()) {
     w->kvs.clear(); w->kvs.reserve(w->opts.size());
@@ -503,27 +1117,100 @@ static void SliceExecute(napi_env env, void* data) {
     p.overrides = nullptr;
     p.overrides_count = 0;
   }
-  if (w->p.verbose) { fprintf(stderr, "DEBUG: [addon] calling g_ffi.slice input='%s' plate=%d overrides=%d\n", p.input_file ? p.input_file : "(null)", p.plate_index, p.overrides_count); fflush(stderr); }
-  auto r = g_ffi.slice(g_ffi.inst, &p);
-  if (w->p.verbose) { fprintf(stderr, "DEBUG: [addon] returned from g_ffi.slice (success=%d)\n", (int)r.success); fflush(stderr); }
+  if (w->p.verbose) { LOG_INFO_STREAM("[addon] calling g_ffi.slice engine=" << engine.index() << " input='" << (p.input_file ? p.input_file : "(null)") << "' (" << w->input_size << " bytes in memory) plate=" << p.plate_index << " overrides=" << p.overrides_count); }
+  if (w->session) {
+    auto r = g_ffi.session_reslice(engine.get(), w->session, &p, &w->reslice_info);
+    read_timings(engine.get(), w);
+    if (w->p.verbose) { LOG_INFO_STREAM("[addon] returned from g_ffi.session_reslice (success=" << (int)r.success << " steps=0x" << std::hex << w->reslice_info.steps_run << ")"); }
+    if (!r.success) w->err = r.message ? r.message : "reslice failed";
+    if (g_ffi.free_result) g_ffi.free_result(&r);
+    return;
+  }
+  if (w->stream) {
+    if (timeout_ms > 0) w->stream->deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    auto r = g_ffi.slice_to_stream(engine.get(), &p, stream_write, w->stream.get());
+    read_timings(engine.get(), w);
+    bool expired;
+    {
+      // every chunk reaches onData before the promise settles
+      std::unique_lock<std::mutex> lk(w->stream->m);
+      w->stream->cv.wait(lk, [w] { return w->stream->stop || w->stream->filled == 0; });
+      expired = w->stream->expired;
+    }
+    if (expired) w->err = "Slicing deadline exceeded";
+    else if (!r.success) w->err = r.message ? r.message : "slice failed";
+    if (g_ffi.free_result) g_ffi.free_result(&r);
+    return;
+  }
+  auto r = w->to_buffer ? g_ffi.slice_to_buffer(engine.get(), &p, &w->buffer) : g_ffi.slice(engine.get(), &p);
+  read_timings(engine.get(), w);
+  if (w->p.verbose) { LOG_INFO_STREAM("[addon] returned from g_ffi.slice (success=" << (int)r.success << ")"); }
   if (!r.success) w->err = r.message ? r.message : "slice failed";
   if (g_ffi.free_result) g_ffi.free_result(&r);
 }
 
 static void SliceComplete(napi_env env, napi_status status, void* data) {
   SliceWork* w = static_cast<SliceWork*>(data);
+  sched_finish(env, w, status == napi_ok && w->err.empty() && !w->aborted);
+  if (w->aborted) ++g_sched.stats[w->priority].aborted;
   if (status != napi_ok) { napi_value e; napi_create_string_utf8(env, "Async failure", NAPI_AUTO_LENGTH, &e); napi_reject_deferred(env, w->deferred, e); }
+  else if (w->aborted) napi_reject_deferred(env, w->deferred, make_abort_error(env)); // even if the engine finished first
+  else if (w->err == "Slicing deadline exceeded") napi_reject_deferred(env, w->deferred, make_error(env, "ORCACLI_DEADLINE_EXCEEDED", w->err));
   else if (!w->err.empty()) { napi_value e; napi_create_string_utf8(env, w->err.c_str(), NAPI_AUTO_LENGTH, &e); napi_reject_deferred(env, w->deferred, e); }
-  else { napi_value obj, v; napi_create_object(env, &obj); napi_create_string_utf8(env, w->p.output_file.c_str(), NAPI_AUTO_LENGTH, &v); napi_set_named_property(env, obj, "output", v); napi_resolve_deferred(env, w->deferred, obj);}
-  napi_delete_async_work(env, w->work); delete w;
+  else if (w->kind == kJobModelInfo) {
+    napi_value obj, v; napi_create_object(env, &obj);
+    napi_create_string_utf8(env, w->info.filename.c_str(), NAPI_AUTO_LENGTH, &v); napi_set_named_property(env, obj, "filename", v);
+    napi_create_uint32(env, w->info.object_count, &v); napi_set_named_property(env, obj, "objectCount", v);
+    napi_create_uint32(env, w->info.triangle_count, &v); napi_set_named_property(env, obj, "triangleCount", v);
+    napi_create_double(env, w->info.volume, &v); napi_set_named_property(env, obj, "volume", v);
+    napi_create_string_utf8(env, w->info.bounding_box.c_str(), NAPI_AUTO_LENGTH, &v); napi_set_named_property(env, obj, "boundingBox", v);
+    napi_get_boolean(env, w->info.is_valid, &v); napi_set_named_property(env, obj, "isValid", v);
+    napi_resolve_deferred(env, w->deferred, obj);
+  }
+  else if (w->kind == kJobSessionOpen) { napi_value v; napi_create_string_utf8(env, w->session_handle.c_str(), NAPI_AUTO_LENGTH, &v); napi_resolve_deferred(env, w->deferred, v); }
+  else {
+    napi_value obj, v; napi_create_object(env, &obj);
+    if (w->stream) { napi_create_double(env, (double)w->stream->bytes, &v); napi_set_named_property(env, obj, "bytes", v); }
+    else if (w->to_buffer) napi_set_named_property(env, obj, "buffer", take_engine_buffer(env, &w->buffer));
+    else { napi_create_string_utf8(env, w->p.output_file.c_str(), NAPI_AUTO_LENGTH, &v); napi_set_named_property(env, obj, "output", v); }
+    if (w->session) {
+      static const char* const step_names[] = {"slice", "perimeters", "prepare_infill", "infill", "ironing", "support_material", "wipe_tower", "skirt_brim", "gcode"};
+      napi_create_int32(env, w->reslice_info.apply_status, &v); napi_set_named_property(env, obj, "applyStatus", v);
+      napi_value steps; napi_create_array(env, &steps); uint32_t n = 0;
+      for (uint32_t i = 0; i < sizeof(step_names)/sizeof(step_names[0]); ++i) {
+        if (w->reslice_info.steps_run & (1u << i)) { napi_create_string_utf8(env, step_names[i], NAPI_AUTO_LENGTH, &v); napi_set_element(env, steps, n++, v); }
+      }
+      napi_set_named_property(env, obj, "stepsRun", steps);
+    }
+    if (w->has_timings) napi_set_named_property(env, obj, "timings", make_timings(env, w->timings));
+    std::error_code ec;
+    if (!w->p.trace_file.empty() && std::filesystem::exists(w->p.trace_file, ec)) {
+      napi_create_string_utf8(env, w->p.trace_file.c_str(), NAPI_AUTO_LENGTH, &v); napi_set_named_property(env, obj, "tracePath", v);
+    }
+    napi_resolve_deferred(env, w->deferred, obj);
+  }
+  slice_work_delete(env, w);
 }
 
-static napi_value Slice(napi_env env, napi_callback_info info) {
-  size_t argc = 1; napi_value args[1]; napi_value thisArg; void* data; NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, &thisArg, &data));
-  if (argc < 1) { napi_throw_type_error(env, nullptr, "params object is required"); return nullptr; }
-  napi_value obj = args[0]; napi_valuetype t; NAPI_CALL(env, napi_typeof(env, obj, &t)); if (t != napi_object) { napi_throw_type_error(env, nullptr, "params must be object"); return nullptr; }
+// Model bytes passed as params.input (Buffer, Uint8Array or ArrayBuffer) are referenced, not copied
+static bool read_input_bytes(napi_env env, napi_value v, SliceWork* work) {
+  bool is = false; void* data = nullptr; size_t len = 0;
+  if (napi_is_arraybuffer(env, v, &is) == napi_ok && is) {
+    if (napi_get_arraybuffer_info(env, v, &data, &len) != napi_ok) return false;
+  } else if (napi_is_typedarray(env, v, &is) == napi_ok && is) {
+    napi_typedarray_type type; napi_value ab; size_t offset = 0;
+    if (napi_get_typedarray_info(env, v, &type, &len, &data, &ab, &offset) != napi_ok) return false;
+    if (type != napi_uint8_array && type != napi_int8_array && type != napi_uint8_clamped_array) return false;
+  } else {
+    return false;
+  }
+  if (napi_create_reference(env, v, 1, &work->input_ref) != napi_ok) return false;
+  work->input_data = static_cast<const uint8_t*>(data); work->input_size = len;
+  return true;
+}
 
-  auto* work = new SliceWork();
+// Reads slice()/reslice() params (input, output, profiles, plate, flags, options/custom) into work
+static void read_slice_params(napi_env env, napi_value obj, SliceWork* work) {
   // Robust getters: only read strings if value is actually a string; ignore undefined/null.
   auto set_str = [&](const char* key, std::string& dst){
     bool has=false; napi_value v; napi_has_named_property(env, obj, key, &has);
@@ -546,13 +1233,40 @@ static napi_value Slice(napi_env env, napi_callback_info info) {
   auto set_bool = [&](const char* key, bool& dst){ bool has=false; napi_value v; napi_has_named_property(env, obj, key, &has); if(has){ napi_get_named_property(env, obj, key, &v); get_bool(env, v, &dst);} };
 
   set_str("input", work->p.input_file);
+  {
+    bool has=false; napi_value v; napi_valuetype vt;
+    if (napi_has_named_property(env, obj, "input", &has) == napi_ok && has && napi_get_named_property(env, obj, "input", &v) == napi_ok &&
+        napi_typeof(env, v, &vt) == napi_ok && vt == napi_object && read_input_bytes(env, v, work)) {
+      set_str("inputName", work->p.input_file); // names the object; nothing is read from it
+      set_str("inputFormat", work->input_format);
+      if (work->input_format.empty()) {
+        auto dot = work->p.input_file.find_last_of('.');
+        if (dot != std::string::npos) work->input_format = work->p.input_file.substr(dot + 1);
+      }
+    }
+  }
   set_str("output", work->p.output_file);
   set_str("printerProfile", work->p.printer_profile);
   set_str("filamentProfile", work->p.filament_profile);
   set_str("processProfile", work->p.process_profile);
+  set_str("outputFormat", work->p.output_format);
   set_int("plate", work->p.plate_index);
   set_bool("verbose", work->p.verbose);
   set_bool("dryRun", work->p.dry_run);
+  set_int("timeoutMs", work->timeout_ms);
+  set_int("compressionLevel", work->p.compression_level);
+  // params.trace: a path, or true for "<output>.trace.json" (a temp file when the output is a buffer or stream)
+  set_str("trace", work->p.trace_file);
+  bool trace = false; set_bool("trace", trace);
+  if (trace && work->p.trace_file.empty()) {
+    static std::atomic<uint64_t> next_trace{0};
+    std::error_code ec;
+    work->p.trace_file = !work->p.output_file.empty() ? work->p.output_file + ".trace.json"
+      : (std::filesystem::temp_directory_path(ec) / ("orcaslicer-trace-" + std::to_string(std::chrono::system_clock::now().time_since_epoch().count()) +
+                                                     "-" + std::to_string(++next_trace) + ".json")).string();
+  }
+  std::string priority; set_str("priority", priority);
+  work->priority = priority == "batch" ? kPriorityBatch : kPriorityInteractive;
 
   // Collect options from params.options and params.custom
   auto collect_kv = [&](napi_value mapObj){
@@ -581,22 +1295,159 @@ static napi_value Slice(napi_env env, napi_callback_info info) {
   bool has=false; napi_value map;
   napi_has_named_property(env, obj, "options", &has); if (has) { napi_get_named_property(env, obj, "options", &map); collect_kv(map); }
   napi_has_named_property(env, obj, "custom", &has);  if (has) { napi_get_named_property(env, obj, "custom",  &map); collect_kv(map); }
+}
+
+enum SliceOutput { kOutputFile, kOutputBuffer, kOutputStream };
+
+static napi_value submit_slice(napi_env env, napi_callback_info info, SliceOutput output) {
+  size_t argc = 2; napi_value args[2]; napi_value thisArg; void* data; NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, &thisArg, &data));
+  if (argc < 1) { napi_throw_type_error(env, nullptr, "params object is required"); return nullptr; }
+  napi_value obj = args[0]; napi_valuetype t; NAPI_CALL(env, napi_typeof(env, obj, &t)); if (t != napi_object) { napi_throw_type_error(env, nullptr, "params must be object"); return nullptr; }
+  if (output == kOutputStream) {
+    napi_valuetype ft = napi_undefined;
+    if (argc < 2 || napi_typeof(env, args[1], &ft) != napi_ok || ft != napi_function) { napi_throw_type_error(env, nullptr, "onData callback is required"); return nullptr; }
+  }
+  if (output != kOutputFile) {
+    std::string err;
+    if (!ensure_engine_loaded(&err)) { napi_throw_error(env, nullptr, err.c_str()); return nullptr; }
+    if (output == kOutputBuffer && !g_ffi.slice_to_buffer) { napi_throw_error(env, nullptr, "Engine library does not support sliceToBuffer (orcacli_slice_to_buffer missing)"); return nullptr; }
+    if (output == kOutputStream && !g_ffi.slice_to_stream) { napi_throw_error(env, nullptr, "Engine library does not support sliceChunks (orcacli_slice_to_stream missing)"); return nullptr; }
+  }
+
+  auto* work = new SliceWork();
+  work->to_buffer = output != kOutputFile; // an empty params.output is fine: the kind comes from inputName/extension
+  read_slice_params(env, obj, work);
 
   if (work->p.verbose) {
-    fprintf(stderr, "DEBUG: [addon] Slice() scheduling: input='%s' output='%s' plate=%d opts=%zu\n",
-            work->p.input_file.c_str(), work->p.output_file.c_str(), work->p.plate_index, work->opts.size());
-    fflush(stderr);
+    LOG_INFO_STREAM("[addon] Slice() scheduling: input='" << work->p.input_file << "' output='" << work->p.output_file
+                    << "' plate=" << work->p.plate_index << " opts=" << work->opts.size());
+  }
+
+  if (work->p.input_file.empty() && !work->input_data) { slice_work_delete(env, work); napi_throw_type_error(env, nullptr, "params.input is required"); return nullptr; }
+  if (work->input_data) {
+    std::string err;
+    if (work->input_format.empty()) { slice_work_delete(env, work); napi_throw_type_error(env, nullptr, "params.inputFormat is required when params.input is a buffer"); return nullptr; }
+    if (!ensure_engine_loaded(&err)) { slice_work_delete(env, work); napi_throw_error(env, nullptr, err.c_str()); return nullptr; }
+    if (!g_ffi.load_model_from_memory) { slice_work_delete(env, work); napi_throw_error(env, nullptr, "Engine library does not support in-memory models (orcacli_load_model_from_memory missing)"); return nullptr; }
   }
 
-  if (work->p.input_file.empty()) { delete work; napi_throw_type_error(env, nullptr, "params.input is required"); return nullptr; }
+  if (output == kOutputStream && !attach_stream(env, args[1], work)) { slice_work_delete(env, work); napi_throw_error(env, nullptr, "Could not create the output stream"); return nullptr; }
+
+  napi_value promise; NAPI_CALL(env, napi_create_promise(env, &work->deferred, &promise));
+  if (!attach_abort_signal(env, obj, work)) { napi_reject_deferred(env, work->deferred, make_abort_error(env)); slice_work_delete(env, work); return promise; }
+  static const char* const resource_names[] = {"slice", "sliceToBuffer", "sliceChunks"};
+  napi_value resource_name; napi_create_string_utf8(env, resource_names[output], NAPI_AUTO_LENGTH, &resource_name);
+  NAPI_CALL(env, napi_create_async_work(env, nullptr, resource_name, SliceExecute, SliceComplete, work, &work->work));
+  double retry_after_ms = 0;
+  if (!sched_submit(env, work, &retry_after_ms)) sched_reject(env, work, retry_after_ms);
+  return promise;
+}
+
+static napi_value Slice(napi_env env, napi_callback_info info) { return submit_slice(env, info, kOutputFile); }
+
+// sliceToBuffer(params): Promise<{ buffer: ArrayBuffer }> — params as slice(); output is optional and only picks the
+// kind (".gcode.3mf" vs G-code). The ArrayBuffer wraps engine memory: no file to read back or clean up.
+static napi_value SliceToBuffer(napi_env env, napi_callback_info info) { return submit_slice(env, info, kOutputBuffer); }
+
+// sliceChunks(params, onData): Promise<{ bytes: number }> — params as sliceToBuffer(). onData(chunk: Buffer, resume)
+// receives the output in order, at most a few chunks of 256 KiB in flight; returning false pauses the engine until
+// resume() is called. The promise settles after the last chunk. index.js wraps this as sliceStream() (a Readable).
+static napi_value SliceChunks(napi_env env, napi_callback_info info) { return submit_slice(env, info, kOutputStream); }
+
+// Session handles are "<engine index>:<session id>" strings (the id alone would not say which engine holds the model)
+static bool parse_session_handle(const std::string& handle, size_t* engine, uint64_t* session) {
+  auto colon = handle.find(':');
+  if (colon == std::string::npos || colon == 0 || colon + 1 >= handle.size()) return false;
+  char* end = nullptr;
+  unsigned long long e = std::strtoull(handle.c_str(), &end, 10); if (end != handle.c_str() + colon) return false;
+  unsigned long long id = std::strtoull(handle.c_str() + colon + 1, &end, 10); if (*end != '\0' || id == 0) return false;
+  *engine = (size_t)e; *session = (uint64_t)id; return true;
+}
+
+// openSession({ input, plate?, priority? }): Promise<string> — loads the model once and pins it to one engine for reslice()
+static napi_value OpenSession(napi_env env, napi_callback_info info) {
+  size_t argc = 1; napi_value args[1]; napi_value thisArg; void* data; NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, &thisArg, &data));
+  if (argc < 1) { napi_throw_type_error(env, nullptr, "params object is required"); return nullptr; }
+  napi_valuetype t; NAPI_CALL(env, napi_typeof(env, args[0], &t)); if (t != napi_object) { napi_throw_type_error(env, nullptr, "params must be object"); return nullptr; }
+  auto* work = new SliceWork();
+  work->kind = kJobSessionOpen;
+  bool has=false; napi_value v; napi_valuetype vt;
+  napi_has_named_property(env, args[0], "input", &has);
+  if (has && napi_get_named_property(env, args[0], "input", &v) == napi_ok && napi_typeof(env, v, &vt) == napi_ok && vt == napi_string) work->p.input_file = get_string(env, v);
+  napi_has_named_property(env, args[0], "plate", &has);
+  if (has && napi_get_named_property(env, args[0], "plate", &v) == napi_ok && napi_typeof(env, v, &vt) == napi_ok && vt == napi_number) { double d=0; napi_get_value_double(env, v, &d); work->p.plate_index = (int)d; }
+  napi_has_named_property(env, args[0], "priority", &has);
+  if (has && napi_get_named_property(env, args[0], "priority", &v) == napi_ok && napi_typeof(env, v, &vt) == napi_ok && vt == napi_string) work->priority = get_string(env, v) == "batch" ? kPriorityBatch : kPriorityInteractive;
+  if (work->p.input_file.empty()) { slice_work_delete(env, work); napi_throw_type_error(env, nullptr, "params.input is required"); return nullptr; }
+
+  napi_value promise; NAPI_CALL(env, napi_create_promise(env, &work->deferred, &promise));
+  napi_value resource_name; napi_create_string_utf8(env, "openSession", NAPI_AUTO_LENGTH, &resource_name);
+  NAPI_CALL(env, napi_create_async_work(env, nullptr, resource_name, SliceExecute, SliceComplete, work, &work->work));
+  double retry_after_ms = 0;
+  if (!sched_submit(env, work, &retry_after_ms)) sched_reject(env, work, retry_after_ms);
+  return promise;
+}
+
+// getModelInfo(file): Promise<ModelInfo> — scheduled like slice() (interactive priority)
+static napi_value GetModelInfo(napi_env env, napi_callback_info info) {
+  size_t argc = 1; napi_value args[1]; napi_value thisArg; void* data; NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, &thisArg, &data));
+  if (argc < 1) { napi_throw_type_error(env, nullptr, "file path is required"); return nullptr; }
+  auto* work = new SliceWork();
+  work->kind = kJobModelInfo;
+  work->p.input_file = get_string(env, args[0]);
+
+  napi_value promise; NAPI_CALL(env, napi_create_promise(env, &work->deferred, &promise));
+  napi_value resource_name; napi_create_string_utf8(env, "getModelInfo", NAPI_AUTO_LENGTH, &resource_name);
+  NAPI_CALL(env, napi_create_async_work(env, nullptr, resource_name, SliceExecute, SliceComplete, work, &work->work));
+  double retry_after_ms = 0;
+  if (!sched_submit(env, work, &retry_after_ms)) sched_reject(env, work, retry_after_ms);
+  return promise;
+}
+
+// reslice(session, params): Promise<{ output, applyStatus, stepsRun }> — params as slice() minus input
+static napi_value Reslice(napi_env env, napi_callback_info info) {
+  size_t argc = 2; napi_value args[2]; napi_value thisArg; void* data; NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, &thisArg, &data));
+  if (argc < 2) { napi_throw_type_error(env, nullptr, "session and params are required"); return nullptr; }
+  napi_valuetype t; NAPI_CALL(env, napi_typeof(env, args[0], &t)); if (t != napi_string) { napi_throw_type_error(env, nullptr, "session must be a string"); return nullptr; }
+  NAPI_CALL(env, napi_typeof(env, args[1], &t)); if (t != napi_object) { napi_throw_type_error(env, nullptr, "params must be object"); return nullptr; }
+  size_t engine_index = 0; uint64_t session = 0;
+  if (!parse_session_handle(get_string(env, args[0]), &engine_index, &session)) { napi_throw_type_error(env, nullptr, "invalid session handle"); return nullptr; }
+  if (!g_ffi.session_reslice) { napi_throw_error(env, nullptr, "Engine library does not support sessions (orcacli_session_reslice missing)"); return nullptr; }
+
+  auto* work = new SliceWork();
+  read_slice_params(env, args[1], work);
+  work->session_engine = engine_index; work->session = session;
 
   napi_value promise; NAPI_CALL(env, napi_create_promise(env, &work->deferred, &promise));
-  napi_value resource_name; napi_create_string_utf8(env, "slice", NAPI_AUTO_LENGTH, &resource_name);
+  if (!attach_abort_signal(env, args[1], work)) { napi_reject_deferred(env, work->deferred, make_abort_error(env)); slice_work_delete(env, work); return promise; }
+  napi_value resource_name; napi_create_string_utf8(env, "reslice", NAPI_AUTO_LENGTH, &resource_name);
   NAPI_CALL(env, napi_create_async_work(env, nullptr, resource_name, SliceExecute, SliceComplete, work, &work->work));
-  NAPI_CALL(env, napi_queue_async_work(env, work->work));
+  double retry_after_ms = 0;
+  if (!sched_submit(env, work, &retry_after_ms)) sched_reject(env, work, retry_after_ms);
   return promise;
 }
 
+// closeSession(session): unpins the engine so other jobs can use it (no-op for unknown/expired sessions)
+static napi_value CloseSession(napi_env env, napi_callback_info info) {
+  size_t argc = 1; napi_value args[1]; napi_value thisArg; void* data; NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, &thisArg, &data));
+  if (argc < 1) { napi_throw_type_error(env, nullptr, "session is required"); return nullptr; }
+  napi_valuetype t; NAPI_CALL(env, napi_typeof(env, args[0], &t)); if (t != napi_string) { napi_throw_type_error(env, nullptr, "session must be a string"); return nullptr; }
+  size_t engine_index = 0; uint64_t session = 0;
+  if (parse_session_handle(get_string(env, args[0]), &engine_index, &session)) {
+    {
+      std::lock_guard<std::mutex> lk(g_pool_mutex);
+      if (engine_index < g_engines.size() && g_engines[engine_index].session == session) {
+        auto& slot = g_engines[engine_index];
+        slot.session = 0;
+        // A busy engine is running a reslice for this session; the engine-side session then lingers until the next model load
+        if (!slot.busy && !g_pool_exclusive && g_ffi.session_close) g_ffi.session_close(slot.inst, session);
+      }
+    }
+    g_pool_cv.notify_all();
+  }
+  napi_value undef; NAPI_CALL(env, napi_get_undefined(env, &undef)); return undef;
+}
+
 // loadVendor(vendorId: string)
 static napi_value LoadVendor(napi_env env, napi_callback_info info) {
   size_t argc = 1; napi_value args[1]; napi_value thisArg; void* data;
@@ -606,18 +1457,14 @@ static napi_value LoadVendor(napi_env env, napi_callback_info info) {
   if (t != napi_string) { napi_throw_type_error(env, nullptr, "vendorId must be a string"); return nullptr; }
   std::string vendor = get_string(env, args[0]);
   // Marker to confirm when LoadVendor is invoked and which vendor is requested
-  fprintf(stderr, "DEBUG: [addon] LoadVendor('%s')\n", vendor.c_str()); fflush(stderr);
-  std::lock_guard<std::mutex> lk(g_mutex);
+  LOG_DEBUG_STREAM("[addon] LoadVendor('" << vendor.c_str() << "')");
   std::string err;
-  if (!ensure_engine_loaded(&err)) { napi_throw_error(env, nullptr, err.c_str()); return nullptr; }
-  auto r = g_ffi.load_vendor(g_ffi.inst, vendor.c_str());
-  if (!r.success) {
-    std::string msg = r.message ? r.message : "loadVendor failed";
-    if (g_ffi.free_result) g_ffi.free_result(&r);
-    napi_throw_error(env, nullptr, msg.c_str());
+  PoolExclusive pool;
+  if (!pool.acquire(&err)) { napi_throw_error(env, nullptr, err.c_str()); return nullptr; }
+  if (!broadcast_engines([&](orcacli_handle h){ return g_ffi.load_vendor(h, vendor.c_str()); }, "loadVendor", &err)) {
+    napi_throw_error(env, nullptr, err.c_str());
     return nullptr;
   }
-  if (g_ffi.free_result) g_ffi.free_result(&r);
   napi_value undef; NAPI_CALL(env, napi_get_undefined(env, &undef)); return undef;
 }
 
@@ -629,16 +1476,13 @@ static napi_value LoadPrinterProfile(napi_env env, napi_callback_info info) {
   napi_valuetype t; NAPI_CALL(env, napi_typeof(env, args[0], &t));
   if (t != napi_string) { napi_throw_type_error(env, nullptr, "printer name must be a string"); return nullptr; }
   std::string name = get_string(env, args[0]);
-  std::lock_guard<std::mutex> lk(g_mutex);
-  std::string err; if (!ensure_engine_loaded(&err)) { napi_throw_error(env, nullptr, err.c_str()); return nullptr; }
-  auto r = g_ffi.load_printer_profile(g_ffi.inst, name.c_str());
-  if (!r.success) {
-    std::string msg = r.message ? r.message : "loadPrinterProfile failed";
-    if (g_ffi.free_result) g_ffi.free_result(&r);
-    napi_throw_error(env, nullptr, msg.c_str());
+  std::string err;
+  PoolExclusive pool;
+  if (!pool.acquire(&err)) { napi_throw_error(env, nullptr, err.c_str()); return nullptr; }
+  if (!broadcast_engines([&](orcacli_handle h){ return g_ffi.load_printer_profile(h, name.c_str()); }, "loadPrinterProfile", &err)) {
+    napi_throw_error(env, nullptr, err.c_str());
     return nullptr;
   }
-  if (g_ffi.free_result) g_ffi.free_result(&r);
   napi_value undef; NAPI_CALL(env, napi_get_undefined(env, &undef)); return undef;
 }
 
@@ -650,16 +1494,13 @@ static napi_value LoadFilamentProfile(napi_env env, napi_callback_info info) {
   napi_valuetype t; NAPI_CALL(env, napi_typeof(env, args[0], &t));
   if (t != napi_string) { napi_throw_type_error(env, nullptr, "filament name must be a string"); return nullptr; }
   std::string name = get_string(env, args[0]);
-  std::lock_guard<std::mutex> lk(g_mutex);
-  std::string err; if (!ensure_engine_loaded(&err)) { napi_throw_error(env, nullptr, err.c_str()); return nullptr; }
-  auto r = g_ffi.load_filament_profile(g_ffi.inst, name.c_str());
-  if (!r.success) {
-    std::string msg = r.message ? r.message : "loadFilamentProfile failed";
-    if (g_ffi.free_result) g_ffi.free_result(&r);
-    napi_throw_error(env, nullptr, msg.c_str());
+  std::string err;
+  PoolExclusive pool;
+  if (!pool.acquire(&err)) { napi_throw_error(env, nullptr, err.c_str()); return nullptr; }
+  if (!broadcast_engines([&](orcacli_handle h){ return g_ffi.load_filament_profile(h, name.c_str()); }, "loadFilamentProfile", &err)) {
+    napi_throw_error(env, nullptr, err.c_str());
     return nullptr;
   }
-  if (g_ffi.free_result) g_ffi.free_result(&r);
   napi_value undef; NAPI_CALL(env, napi_get_undefined(env, &undef)); return undef;
 }
 
@@ -671,28 +1512,193 @@ static napi_value LoadProcessProfile(napi_env env, napi_callback_info info) {
   napi_valuetype t; NAPI_CALL(env, napi_typeof(env, args[0], &t));
   if (t != napi_string) { napi_throw_type_error(env, nullptr, "process name must be a string"); return nullptr; }
   std::string name = get_string(env, args[0]);
-  std::lock_guard<std::mutex> lk(g_mutex);
-  std::string err; if (!ensure_engine_loaded(&err)) { napi_throw_error(env, nullptr, err.c_str()); return nullptr; }
-  auto r = g_ffi.load_process_profile(g_ffi.inst, name.c_str());
+  std::string err;
+  PoolExclusive pool;
+  if (!pool.acquire(&err)) { napi_throw_error(env, nullptr, err.c_str()); return nullptr; }
+  if (!broadcast_engines([&](orcacli_handle h){ return g_ffi.load_process_profile(h, name.c_str()); }, "loadProcessProfile", &err)) {
+    napi_throw_error(env, nullptr, err.c_str());
+    return nullptr;
+  }
+  napi_value undef; NAPI_CALL(env, napi_get_undefined(env, &undef)); return undef;
+}
+
+// saveSnapshot(path: string): writes the loaded vendor presets to a binary snapshot (engines are identical; the first one writes)
+static napi_value SaveSnapshot(napi_env env, napi_callback_info info) {
+  size_t argc = 1; napi_value args[1]; napi_value thisArg; void* data;
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, &thisArg, &data));
+  if (argc < 1) { napi_throw_type_error(env, nullptr, "snapshot path is required"); return nullptr; }
+  napi_valuetype t; NAPI_CALL(env, napi_typeof(env, args[0], &t));
+  if (t != napi_string) { napi_throw_type_error(env, nullptr, "snapshot path must be a string"); return nullptr; }
+  std::string path = get_string(env, args[0]);
+  std::string err;
+  PoolExclusive pool;
+  if (!pool.acquire(&err)) { napi_throw_error(env, nullptr, err.c_str()); return nullptr; }
+  if (!g_ffi.save_snapshot) { napi_throw_error(env, nullptr, "engine does not support snapshots (orcacli_save_snapshot missing)"); return nullptr; }
+  auto r = g_ffi.save_snapshot(g_engines.front().inst, path.c_str());
   if (!r.success) {
-    std::string msg = r.message ? r.message : "loadProcessProfile failed";
+    err = r.message ? r.message : "saveSnapshot failed";
+    if (r.error_details) { err += ": "; err += r.error_details; }
     if (g_ffi.free_result) g_ffi.free_result(&r);
-    napi_throw_error(env, nullptr, msg.c_str());
+    napi_throw_error(env, nullptr, err.c_str());
     return nullptr;
   }
   if (g_ffi.free_result) g_ffi.free_result(&r);
   napi_value undef; NAPI_CALL(env, napi_get_undefined(env, &undef)); return undef;
 }
 
+// loadSnapshot(path: string): boolean — false when the snapshot is missing, corrupt or stale (caller falls back to loadVendor).
+// An engine that rejects the snapshot keeps its presets untouched, so the first engine decides for the pool;
+// an engine that fails after it succeeded would differ from the others and is dropped from the pool.
+static napi_value LoadSnapshot(napi_env env, napi_callback_info info) {
+  size_t argc = 1; napi_value args[1]; napi_value thisArg; void* data;
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, &thisArg, &data));
+  if (argc < 1) { napi_throw_type_error(env, nullptr, "snapshot path is required"); return nullptr; }
+  napi_valuetype t; NAPI_CALL(env, napi_typeof(env, args[0], &t));
+  if (t != napi_string) { napi_throw_type_error(env, nullptr, "snapshot path must be a string"); return nullptr; }
+  std::string path = get_string(env, args[0]);
+  std::string err;
+  PoolExclusive pool;
+  if (!pool.acquire(&err)) { napi_throw_error(env, nullptr, err.c_str()); return nullptr; }
+  bool ok = g_ffi.load_snapshot != nullptr;
+  std::vector<orcacli_handle> dropped;
+  for (size_t i = 0; ok && i < g_engines.size(); ++i) {
+    auto r = g_ffi.load_snapshot(g_engines[i].inst, path.c_str());
+    if (!r.success) {
+      if (err.empty()) err = r.message ? r.message : "loadSnapshot failed";
+      if (i == 0) ok = false;
+      else dropped.push_back(g_engines[i].inst);
+    }
+    if (g_ffi.free_result) g_ffi.free_result(&r);
+  }
+  if (!dropped.empty()) {
+    {
+      std::lock_guard<std::mutex> lk(g_pool_mutex);
+      g_engines.erase(std::remove_if(g_engines.begin(), g_engines.end(), [&](const EngineSlot& s) {
+        return std::find(dropped.begin(), dropped.end(), s.inst) != dropped.end();
+      }), g_engines.end());
+    }
+    LOG_WARNING_STREAM("[addon] loadSnapshot('" << path << "') failed on " << dropped.size() << " engine(s) after succeeding on the first: "
+                       << err << "; continuing with " << g_engines.size() << " engine(s)");
+    if (g_ffi.destroy) for (auto h : dropped) { try { g_ffi.destroy(h); } catch (...) {} }
+  }
+  if (!ok) { LOG_DEBUG_STREAM("[addon] loadSnapshot('" << path.c_str() << "') not used: " << (err.empty() ? "orcacli_load_snapshot missing" : err.c_str())); }
+  napi_value result; NAPI_CALL(env, napi_get_boolean(env, ok, &result)); return result;
+}
 
+// configCacheStats(): { hits, misses, evictions, entries, capacity } summed over all engines (does not wait for slices)
+static napi_value ConfigCacheStats(napi_env env, napi_callback_info info) {
+  (void)info;
+  orcacli_cache_stats total{};
+  {
+    std::lock_guard<std::mutex> lk(g_pool_mutex);
+    if (g_ffi.get_config_cache_stats) {
+      for (const auto& slot : g_engines) {
+        orcacli_cache_stats s = g_ffi.get_config_cache_stats(slot.inst);
+        total.hits += s.hits; total.misses += s.misses; total.evictions += s.evictions;
+        total.entries += s.entries; total.capacity += s.capacity;
+      }
+    }
+  }
+  napi_value obj; NAPI_CALL(env, napi_create_object(env, &obj));
+  auto set_num = [&](const char* k, double v){ napi_value n; napi_create_double(env, v, &n); napi_set_named_property(env, obj, k, n); };
+  set_num("hits", (double)total.hits);
+  set_num("misses", (double)total.misses);
+  set_num("evictions", (double)total.evictions);
+  set_num("entries", (double)total.entries);
+  set_num("capacity", (double)total.capacity);
+  return obj;
+}
 
-// shutdown(): cleans up engine state deterministically
+// engineStats(): pool occupancy plus orcacli_get_stats counters summed over all engines (does not wait for slices).
+// rssBytes is the whole process (the engines share it), not a sum.
+static napi_value EngineStats(napi_env env, napi_callback_info info) {
+  (void)info;
+  orcacli_stats total{};
+  size_t engines = 0, busy = 0;
+  {
+    std::lock_guard<std::mutex> lk(g_pool_mutex);
+    engines = g_engines.size();
+    for (const auto& slot : g_engines) {
+      if (slot.busy) ++busy;
+      if (!g_ffi.get_stats) continue;
+      const orcacli_stats s = g_ffi.get_stats(slot.inst);
+      total.slices += s.slices; total.slice_failures += s.slice_failures;
+      total.bytes_in += s.bytes_in; total.bytes_out += s.bytes_out;
+      for (auto pair : {std::make_pair(&total.config_cache, &s.config_cache), std::make_pair(&total.project_cache, &s.project_cache),
+                        std::make_pair(&total.result_cache, &s.result_cache)}) {
+        pair.first->hits += pair.second->hits; pair.first->misses += pair.second->misses;
+        pair.first->evictions += pair.second->evictions; pair.first->entries += pair.second->entries;
+        pair.first->capacity += pair.second->capacity;
+      }
+      total.rss_bytes = std::max(total.rss_bytes, s.rss_bytes);
+    }
+  }
+  napi_value obj; NAPI_CALL(env, napi_create_object(env, &obj));
+  auto set_num = [&](napi_value target, const char* k, double v){ napi_value n; napi_create_double(env, v, &n); napi_set_named_property(env, target, k, n); };
+  set_num(obj, "engines", (double)engines);
+  set_num(obj, "busy", (double)busy);
+  set_num(obj, "idle", (double)(engines - busy));
+  set_num(obj, "slices", (double)total.slices);
+  set_num(obj, "sliceFailures", (double)total.slice_failures);
+  set_num(obj, "bytesIn", (double)total.bytes_in);
+  set_num(obj, "bytesOut", (double)total.bytes_out);
+  set_num(obj, "rssBytes", (double)total.rss_bytes);
+  auto cache = [&](const char* k, const orcacli_cache_stats& c){
+    napi_value co; napi_create_object(env, &co);
+    set_num(co, "hits", (double)c.hits); set_num(co, "misses", (double)c.misses); set_num(co, "evictions", (double)c.evictions);
+    set_num(co, "entries", (double)c.entries); set_num(co, "capacity", (double)c.capacity);
+    napi_set_named_property(env, obj, k, co);
+  };
+  cache("configCache", total.config_cache);
+  cache("projectCache", total.project_cache);
+  cache("resultCache", total.result_cache);
+  return obj;
+}
+
+// schedulerStats(): queue depth/occupancy plus per-priority counters and latency percentiles (ms)
+static napi_value SchedulerStats(napi_env env, napi_callback_info info) {
+  (void)info;
+  napi_value obj; NAPI_CALL(env, napi_create_object(env, &obj));
+  auto set_num = [&](napi_value target, const char* k, double v){ napi_value n; napi_create_double(env, v, &n); napi_set_named_property(env, target, k, n); };
+  set_num(obj, "maxQueueDepth", (double)sched_max_depth());
+  set_num(obj, "capacity", (double)sched_capacity());
+  set_num(obj, "running", (double)g_sched.running);
+  set_num(obj, "queued", (double)sched_queued());
+  for (int p = 0; p < kPriorityCount; ++p) {
+    const auto& st = g_sched.stats[p];
+    napi_value po; napi_create_object(env, &po);
+    set_num(po, "queued", (double)g_sched.queues[p].size());
+    set_num(po, "submitted", (double)st.submitted);
+    set_num(po, "rejected", (double)st.rejected);
+    set_num(po, "completed", (double)st.completed);
+    set_num(po, "failed", (double)st.failed);
+    set_num(po, "aborted", (double)st.aborted);
+    auto percentiles = [&](const char* k, const LatencyRing& ring){
+      napi_value lo; napi_create_object(env, &lo);
+      set_num(lo, "p50", ring.percentile(0.50)); set_num(lo, "p90", ring.percentile(0.90)); set_num(lo, "p99", ring.percentile(0.99));
+      set_num(lo, "samples", (double)ring.samples.size());
+      napi_set_named_property(env, po, k, lo);
+    };
+    percentiles("waitMs", st.wait);
+    percentiles("latencyMs", st.total);
+    napi_set_named_property(env, obj, kPriorityNames[p], po);
+  }
+  return obj;
+}
+
+// shutdown(): cleans up engine state deterministically (waits for in-flight work on every engine)
 static napi_value Shutdown(napi_env env, napi_callback_info info) {
   (void)info;
-  std::lock_guard<std::mutex> lk(g_mutex);
-  if (g_ffi.inst && g_ffi.destroy) {
-    try { g_ffi.destroy(g_ffi.inst); } catch (...) {}
-    g_ffi.inst = nullptr;
+  PoolExclusive pool;
+  std::string err;
+  (void)pool.acquire(&err, /*create_engines=*/false);
+  if (g_ffi.destroy) {
+    for (auto& slot : g_engines) { try { g_ffi.destroy(slot.inst); } catch (...) {} }
+  }
+  {
+    std::lock_guard<std::mutex> lk(g_pool_mutex);
+    g_engines.clear();
+    g_pool_size = 0; // next initialize() may choose a different pool size
   }
   // Keep the library handle loaded; subsequent initialize can reuse it.
   napi_value undef; napi_get_undefined(env, &undef); return undef;
@@ -700,8 +1706,11 @@ static napi_value Shutdown(napi_env env, napi_callback_info info) {
 
 static napi_value Init(napi_env env, napi_value exports) {
   // Marker log to verify we're running the freshly built addon and where it lives
+  // Addon log lines go to stderr (stdout may carry a worker protocol); ORCACLI_LOG_LEVEL=4 shows debug
+  Logger::getInstance().setOutputStream(std::cerr);
+  Logger::getInstance().setLogLevel(Logger::levelFromEnvironment(LogLevel::Info));
   std::string mdir = module_dir_path();
-  fprintf(stderr, "DEBUG: [addon] Init loaded (module_dir=%s, built=%s %s)\n", mdir.c_str(), __DATE__, __TIME__); fflush(stderr);
+  LOG_DEBUG_STREAM("[addon] Init loaded (module_dir=" << mdir.c_str() << ", built=" << __DATE__ << " " << __TIME__ << ")");
 
   napi_property_descriptor props[] = {
     {"initialize", 0, Initialize, 0, 0, 0, napi_default, 0},
@@ -709,10 +1718,20 @@ static napi_value Init(napi_env env, napi_value exports) {
     {"version",    0, Version,    0, 0, 0, napi_default, 0},
     {"getModelInfo", 0, GetModelInfo, 0, 0, 0, napi_default, 0},
     {"slice",      0, Slice,      0, 0, 0, napi_default, 0},
+    {"sliceToBuffer", 0, SliceToBuffer, 0, 0, 0, napi_default, 0},
+    {"sliceChunks", 0, SliceChunks, 0, 0, 0, napi_default, 0},
     {"loadVendor", 0, LoadVendor, 0, 0, 0, napi_default, 0},
     {"loadPrinterProfile", 0, LoadPrinterProfile, 0, 0, 0, napi_default, 0},
     {"loadFilamentProfile", 0, LoadFilamentProfile, 0, 0, 0, napi_default, 0},
     {"loadProcessProfile", 0, LoadProcessProfile, 0, 0, 0, napi_default, 0},
+    {"saveSnapshot", 0, SaveSnapshot, 0, 0, 0, napi_default, 0},
+    {"loadSnapshot", 0, LoadSnapshot, 0, 0, 0, napi_default, 0},
+    {"configCacheStats", 0, ConfigCacheStats, 0, 0, 0, napi_default, 0},
+    {"schedulerStats", 0, SchedulerStats, 0, 0, 0, napi_default, 0},
+    {"engineStats", 0, EngineStats, 0, 0, 0, napi_default, 0},
+    {"openSession", 0, OpenSession, 0, 0, 0, napi_default, 0},
+    {"reslice",    0, Reslice,    0, 0, 0, napi_default, 0},
+    {"closeSession", 0, CloseSession, 0, 0, 0, napi_default, 0},
   };
   NAPI_CALL(env, napi_define_properties(env, exports, sizeof(props)/sizeof(props[0]), props));
   return exports;
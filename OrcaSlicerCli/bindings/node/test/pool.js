@@ -0,0 +1,51 @@
+const assert = require('assert');
+const path = require('path');
+const fs = require('fs');
+const os = require('os');
+const binary = path.join(__dirname, '../../..', 'build', 'bindings', 'node', 'orcaslicer_node.node');
+const orca = require(binary);
+
+function ensureTestSTL() {
+  const envPath = process.env.ORCACLI_TEST_STL;
+  if (envPath && fs.existsSync(envPath)) return envPath;
+  const benchy = path.join(__dirname, '../../..', 'example_files', '3DBenchy.stl');
+  if (fs.existsSync(benchy)) return benchy;
+  const tmp = path.join(os.tmpdir(), 'orcaslicercli_pool_triangle.stl');
+  const asciiStl = [
+    'solid pool_tetra',
+    ' facet normal 0 0 1', '  outer loop', '   vertex 0 0 0', '   vertex 1 0 0', '   vertex 0 1 0', '  endloop', ' endfacet',
+    ' facet normal 1 0 1', '  outer loop', '   vertex 0 0 0', '   vertex 1 0 0', '   vertex 0 0 1', '  endloop', ' endfacet',
+    ' facet normal 0 1 1', '  outer loop', '   vertex 0 0 0', '   vertex 0 1 0', '   vertex 0 0 1', '  endloop', ' endfacet',
+    ' facet normal 1 1 1', '  outer loop', '   vertex 1 0 0', '   vertex 0 1 0', '   vertex 0 0 1', '  endloop', ' endfacet',
+    'endsolid pool_tetra',
+    ''
+  ].join('\n');
+  fs.writeFileSync(tmp, asciiStl, 'utf8');
+  return tmp;
+}
+
+(async () => {
+  // Two engines: concurrent calls are dispatched to whichever engine is idle.
+  orca.initialize({ resourcesPath: '', engines: 2 });
+
+  const stl = ensureTestSTL();
+  const infos = await Promise.all([0, 1, 2, 3].map(() => orca.getModelInfo(stl)));
+  for (const info of infos) {
+    assert.ok(info.objectCount >= 1);
+    assert.strictEqual(info.triangleCount, infos[0].triangleCount);
+  }
+
+  // Broadcast loads must fail the same way they did with a single engine.
+  let threw = false;
+  try { orca.loadVendor('__no_such_vendor__'); } catch (_) { threw = true; }
+  assert.ok(threw, 'loadVendor with unknown vendor should throw');
+
+  // shutdown() drains the pool; a later initialize() may pick another size.
+  orca.shutdown();
+  orca.initialize({ resourcesPath: '', engines: 1 });
+  const again = await orca.getModelInfo(stl);
+  assert.ok(again.objectCount >= 1);
+
+  console.log('pool tests passed');
+  try { orca.shutdown && orca.shutdown(); } catch (_) {}
+})().catch((e) => { console.error(e); try { orca.shutdown && orca.shutdown(); } catch (_) {} process.exit(1); });
@@ -0,0 +1,78 @@
+const assert = require('assert');
+const path = require('path');
+const fs = require('fs');
+const os = require('os');
+const binary = path.join(__dirname, '../../..', 'build', 'bindings', 'node', 'orcaslicer_node.node');
+const orca = require(binary);
+
+function ensureTestSTL() {
+  const envPath = process.env.ORCACLI_TEST_STL;
+  if (envPath && fs.existsSync(envPath)) return envPath;
+  const benchy = path.join(__dirname, '../../..', 'example_files', '3DBenchy.stl');
+  if (fs.existsSync(benchy)) return benchy;
+  const tmp = path.join(os.tmpdir(), 'orcaslicercli_sched_triangle.stl');
+  const asciiStl = [
+    'solid sched_tetra',
+    ' facet normal 0 0 1', '  outer loop', '   vertex 0 0 0', '   vertex 1 0 0', '   vertex 0 1 0', '  endloop', ' endfacet',
+    ' facet normal 1 0 1', '  outer loop', '   vertex 0 0 0', '   vertex 1 0 0', '   vertex 0 0 1', '  endloop', ' endfacet',
+    ' facet normal 0 1 1', '  outer loop', '   vertex 0 0 0', '   vertex 0 1 0', '   vertex 0 0 1', '  endloop', ' endfacet',
+    ' facet normal 1 1 1', '  outer loop', '   vertex 1 0 0', '   vertex 0 1 0', '   vertex 0 0 1', '  endloop', ' endfacet',
+    'endsolid sched_tetra',
+    ''
+  ].join('\n');
+  fs.writeFileSync(tmp, asciiStl, 'utf8');
+  return tmp;
+}
+
+// Records the order in which jobs settle; with one engine that is the dispatch order
+function track(order, name, promise) {
+  return promise.then((v) => { order.push(name); return v; }, (e) => { order.push(name); return e; });
+}
+
+(async () => {
+  // One engine and room for two waiting jobs: the scheduler state is driven from this thread only,
+  // so jobs submitted in the same tick start/queue/reject deterministically.
+  orca.initialize({ resourcesPath: '', engines: 1, queueDepth: 2 });
+  const stl = ensureTestSTL();
+  const out = path.join(os.tmpdir(), 'orcaslicercli_sched_out.gcode');
+
+  // 1) Priority dispatch: a batch job queued before an interactive one runs after it
+  const order = [];
+  const running = track(order, 'running', orca.getModelInfo(stl));
+  const batch = track(order, 'batch', orca.slice({ input: stl, output: out, dryRun: true, priority: 'batch' }));
+  const interactive = track(order, 'interactive', orca.getModelInfo(stl));
+
+  // 2) Admission control: the queue is full, so the next job is rejected right away with a retry hint
+  let full = null;
+  await orca.getModelInfo(stl).catch((e) => { full = e; });
+  assert.ok(full, 'fourth job should be rejected');
+  assert.strictEqual(full.code, 'ORCACLI_QUEUE_FULL');
+  assert.ok(typeof full.retryAfterMs === 'number' && full.retryAfterMs > 0, 'retryAfterMs should be a positive number');
+  let fullSession = null;
+  await orca.openSession({ input: stl, priority: 'batch' }).catch((e) => { fullSession = e; });
+  assert.ok(fullSession && fullSession.code === 'ORCACLI_QUEUE_FULL', 'openSession goes through the same queue');
+
+  await Promise.all([running, batch, interactive]);
+  assert.deepStrictEqual(order, ['running', 'interactive', 'batch']);
+
+  const stats = orca.schedulerStats();
+  assert.strictEqual(stats.queued, 0);
+  assert.strictEqual(stats.running, 0);
+  assert.strictEqual(stats.interactive.rejected, 1);
+  assert.strictEqual(stats.batch.rejected, 1);
+  assert.strictEqual(stats.interactive.submitted, 3);
+  assert.strictEqual(stats.batch.submitted, 2);
+
+  // 3) Sessions are scheduled too: open, then a queued getModelInfo still completes afterwards
+  const sessionOrder = [];
+  const session = track(sessionOrder, 'open', orca.openSession({ input: stl }));
+  const info = track(sessionOrder, 'info', orca.getModelInfo(stl));
+  const handle = await session;
+  assert.strictEqual(typeof handle, 'string', 'openSession should resolve to a handle');
+  assert.ok((await info).objectCount >= 1);
+  assert.deepStrictEqual(sessionOrder, ['open', 'info']);
+  orca.closeSession(handle);
+
+  console.log('scheduler tests passed');
+  try { orca.shutdown && orca.shutdown(); } catch (_) {}
+})().catch((e) => { console.error(e); try { orca.shutdown && orca.shutdown(); } catch (_) {} process.exit(1); });
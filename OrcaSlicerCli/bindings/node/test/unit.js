@@ -78,6 +78,32 @@ function ensureTestSTL() {
   }
   assert.ok(threw, 'slice without params.input should throw');
 
+  // sessions: a closed session cannot be resliced; a malformed handle throws synchronously
+  const session = await orca.openSession({ input: stl });
+  assert.strictEqual(typeof session, 'string');
+  orca.closeSession(session);
+  await assert.rejects(orca.reslice(session, { output: path.join(os.tmpdir(), 'orcaslicercli_unit_reslice.gcode') }));
+  assert.throws(() => orca.reslice('not-a-session', {}));
+
+  // sliceToBuffer validates params like slice()
+  assert.throws(() => orca.sliceToBuffer({}), /params.input is required/);
+  assert.throws(() => orca.sliceChunks({ input: stl }), /onData callback is required/);
+
+  // in-memory input needs a format (explicit or from inputName)
+  assert.throws(() => orca.slice({ input: fs.readFileSync(stl) }), /inputFormat is required/);
+
+  // an already-aborted signal rejects without slicing
+  await assert.rejects(
+    orca.slice({ input: stl, output: path.join(os.tmpdir(), 'orcaslicercli_unit_abort.gcode'), signal: AbortSignal.abort() }),
+    (e) => e.name === 'AbortError'
+  );
+
+  // engineStats: pool occupancy adds up and the counters are numbers
+  const stats = orca.engineStats();
+  assert.strictEqual(stats.busy + stats.idle, stats.engines);
+  assert.ok(stats.slices >= stats.sliceFailures);
+  assert.strictEqual(typeof stats.configCache.hits, 'number');
+
   console.log('unit tests passed');
   try { orca.shutdown && orca.shutdown(); } catch (_) {}
 })().catch((e) => { console.error(e); try { orca.shutdown && orca.shutdown(); } catch (_) {} process.exit(1); });
@@ -1,6 +1,13 @@
 export interface InitializeOptions {
   resourcesPath?: string;
   verbose?: boolean;
+  // Optional: max slice()/reslice() jobs waiting for an engine (default: ORCACLI_QUEUE_DEPTH or 64).
+  // When full, new jobs are rejected at once with a QueueFullError instead of piling up.
+  queueDepth?: number;
+  // Optional: number of engine instances in the pool (default: ORCACLI_ENGINES or 1).
+  // Each engine slices independently; vendor/profile loads are applied to all of them.
+  // Only honored when the pool is created (first initialize, or after shutdown()).
+  engines?: number;
   // Optional: list of vendors to preload lazily during initialize (default: none)
   vendors?: string[];
   // Optional: explicit profiles to load during initialize (only these will be loaded by the addon)
@@ -19,7 +26,12 @@ export interface ModelInfo {
 }
 
 export interface SliceParams {
-  input: string;
+  // Model path, or its bytes (sliced from memory; keep them unchanged until the promise settles)
+  input: string | Uint8Array | ArrayBuffer;
+  // With in-memory input: 'stl', 'obj' or '3mf' (defaults to the extension of inputName)
+  inputFormat?: string;
+  // With in-memory input: object name, e.g. the uploaded file name
+  inputName?: string;
   output?: string;
   plate?: number; // 1-based
   printerProfile?: string;
@@ -27,19 +39,146 @@ export interface SliceParams {
   processProfile?: string;
   verbose?: boolean;
   dryRun?: boolean;
+  // Scheduling class: 'interactive' (default) jobs are dequeued before 'batch' jobs
+  priority?: SlicePriority;
+  // Aborting rejects with an AbortError; a running job is canceled inside the engine
+  signal?: AbortSignal;
+  // Deadline from the call (queue wait included); rejects with DeadlineExceededError
+  timeoutMs?: number;
+  // Compression level 0-9 for .gcode.3mf / .gcode.gz / .gcode.zst / .bgcode outputs (0 = stored)
+  compressionLevel?: number;
+  // G-code output format; default follows the output extension (.3mf outputs ignore it)
+  outputFormat?: 'gcode' | 'gcode.gz' | 'gcode.zst' | 'bgcode';
+  // Chrome trace JSON of the job (chrome://tracing, ui.perfetto.dev), returned as tracePath: a file path,
+  // or true for '<output>.trace.json' (a temp file without output; the caller removes it)
+  trace?: string | boolean;
   // Preferred: options (values coerced to string internally)
   options?: Record<string, string | number | boolean>;
   // Back-compat: custom (string-only)
   custom?: Record<string, string>;
 }
 
+export type SlicePriority = 'interactive' | 'batch';
+
+// Rejection from admission control when the slicing queue is full
+export interface QueueFullError extends Error {
+  code: 'ORCACLI_QUEUE_FULL';
+  retryAfterMs: number;
+}
+
+export interface DeadlineExceededError extends Error {
+  code: 'ORCACLI_DEADLINE_EXCEEDED';
+}
+
+export interface LatencyPercentiles { p50: number; p90: number; p99: number; samples: number }
+export interface PrioritySchedulerStats {
+  queued: number;
+  submitted: number;
+  rejected: number;
+  completed: number;
+  failed: number;
+  aborted: number;
+  waitMs: LatencyPercentiles;    // submit -> engine start (last 1024 jobs)
+  latencyMs: LatencyPercentiles; // submit -> completion (last 1024 jobs)
+}
+export interface SchedulerStats {
+  maxQueueDepth: number;
+  capacity: number; // concurrent slices (= engines)
+  running: number;
+  queued: number;
+  interactive: PrioritySchedulerStats;
+  batch: PrioritySchedulerStats;
+}
+
 export function initialize(opts?: InitializeOptions): void;
+export function shutdown(): void;
 export function version(): string;
 export function getModelInfo(file: string): Promise<ModelInfo>;
-export function slice(params: SliceParams): Promise<{ output: string }>;
+// Where the time of a slice went, in steady-clock nanoseconds (0 = stage did not run). Absent with
+// engine libraries that lack orcacli_get_last_timings.
+export type ProcessStep =
+  | 'slice' | 'perimeters' | 'prepare_infill' | 'infill' | 'ironing'
+  | 'support_material' | 'wipe_tower' | 'skirt_brim';
+export interface SliceTimings {
+  loadModelNs: number;
+  presetsNs: number;
+  applyNs: number;
+  processNs: number;
+  // processNs split by step (sampled at Print status updates); count = objects the step ran for
+  steps: Record<ProcessStep, { ns: number; count: number }>;
+  exportGcodeNs: number;
+  packageNs: number; // .gcode.3mf packaging or .gz/.zst/.bgcode encoding
+  totalNs: number;
+  objects: number;
+  layers: number;
+  cached: boolean; // served by the result cache
+}
+export function slice(params: SliceParams): Promise<{ output: string; timings?: SliceTimings; tracePath?: string }>;
+// Same as slice() but the result stays in memory: `output` is optional and only selects the kind
+// ('.gcode.3mf' vs G-code). The ArrayBuffer wraps engine memory, released when it is garbage collected.
+export function sliceToBuffer(params: SliceParams): Promise<{ buffer: ArrayBuffer; timings?: SliceTimings; tracePath?: string }>;
+// Same as sliceToBuffer() but the output is pushed in chunks of up to 256 KiB as the engine hands it over;
+// onData returning false pauses the engine until resume() is called. Settles after the last chunk.
+export function sliceChunks(params: SliceParams, onData: (chunk: Buffer, resume: () => void) => boolean | void): Promise<{ bytes: number; timings?: SliceTimings; tracePath?: string }>;
+// Readable over sliceChunks() (index.js): backpressure pauses the engine, destroy() cancels the slice.
+// With params.trace it emits 'trace' (the trace file path) before 'end'.
+export function sliceStream(params: SliceParams): import('stream').Readable;
 
 // Lazy loading controls (synchronous)
 export function loadVendor(vendorId: string): void;
 export function loadPrinterProfile(name: string): void;
 export function loadFilamentProfile(name: string): void;
 export function loadProcessProfile(name: string): void;
+
+// Warm start: binary snapshot of the loaded vendor presets.
+// loadSnapshot() returns false when the file is missing, corrupt or was written for other resources/engine version.
+export function saveSnapshot(path: string): void;
+export function loadSnapshot(path: string): boolean;
+
+// Resolved-config cache counters, summed over the engine pool.
+// Size per engine: ORCACLI_CONFIG_CACHE_SIZE (default 32, 0 disables).
+export interface ConfigCacheStats {
+  hits: number;
+  misses: number;
+  evictions: number;
+  entries: number;
+  capacity: number;
+}
+export function configCacheStats(): ConfigCacheStats;
+
+export function schedulerStats(): SchedulerStats;
+
+// Pool occupancy plus the engine counters of orcacli_get_stats(), summed over the pool since initialize().
+// rssBytes is the whole process (0 outside Linux); resultCache has no entries/capacity (0).
+export interface EngineStats {
+  engines: number;
+  busy: number;
+  idle: number;
+  slices: number;
+  sliceFailures: number;
+  bytesIn: number;
+  bytesOut: number;
+  rssBytes: number;
+  configCache: ConfigCacheStats;
+  projectCache: ConfigCacheStats;
+  resultCache: ConfigCacheStats;
+}
+export function engineStats(): EngineStats;
+
+// Re-slice sessions: openSession() loads the model once and pins it to one engine; reslice() reuses its
+// Model/Print so only the steps invalidated by changed settings run again. A session ends when its engine
+// is taken by another job (only when no session-free engine is idle), on shutdown(), or via closeSession().
+export type ReslicePipelineStep =
+  | 'slice' | 'perimeters' | 'prepare_infill' | 'infill' | 'ironing'
+  | 'support_material' | 'wipe_tower' | 'skirt_brim' | 'gcode';
+export interface ResliceResult {
+  output: string;
+  // Print::ApplyStatus: 0 unchanged, 1 changed (steps invalidated), 2 invalidated (everything recomputed)
+  applyStatus: number;
+  stepsRun: ReslicePipelineStep[];
+  timings?: SliceTimings;
+  tracePath?: string;
+}
+export function openSession(params: { input: string; plate?: number; priority?: SlicePriority }): Promise<string>;
+export function reslice(session: string, params: Omit<SliceParams, 'input'>): Promise<ResliceResult>;
+export function closeSession(session: string): void;
@@ -1,11 +1,53 @@
 #include "Application.hpp"
 #include "utils/Logger.hpp"
+#include "server/WorkerPool.hpp"
+#include "bench/Benchmark.hpp"
 
 #include <iostream>
 #include <filesystem>
+#include <thread>
+#include <algorithm>
+#include <cctype>
 
 namespace OrcaSlicerCli {
 
+namespace {
+
+// Parses --set "k=v,k=v,..." into config overrides
+std::map<std::string, std::string> parseOverrides(const std::string& set_arg) {
+    std::map<std::string, std::string> overrides;
+    auto ltrim = [](std::string &s){ s.erase(s.begin(), std::find_if(s.begin(), s.end(), [](unsigned char ch){ return !std::isspace(ch); })); };
+    auto rtrim = [](std::string &s){ s.erase(std::find_if(s.rbegin(), s.rend(), [](unsigned char ch){ return !std::isspace(ch); }).base(), s.end()); };
+    // Split by commas
+    size_t start = 0;
+    while (start < set_arg.size()) {
+        size_t comma = set_arg.find(',', start);
+        std::string kv = (comma == std::string::npos) ? set_arg.substr(start) : set_arg.substr(start, comma - start);
+        ltrim(kv); rtrim(kv);
+        if (!kv.empty()) {
+            size_t eq = kv.find('=');
+            if (eq != std::string::npos) {
+                std::string key = kv.substr(0, eq);
+                std::string val = kv.substr(eq + 1);
+                ltrim(key); rtrim(key);
+                ltrim(val); rtrim(val);
+                // Strip surrounding quotes if present
+                if (val.size() >= 2 && ((val.front() == '"' && val.back() == '"') || (val.front() == '\'' && val.back() == '\''))) {
+                    val = val.substr(1, val.size() - 2);
+                }
+                if (!key.empty()) {
+                    overrides[key] = val;
+                }
+            }
+        }
+        if (comma == std::string::npos) break;
+        start = comma + 1;
+    }
+    return overrides;
+}
+
+} // namespace
+
 Application::Application()
     : m_core(std::make_unique<CliCore>())
     , m_parser(std::make_unique<ArgumentParser>(getAppName(), "Extended CLI for OrcaSlicer")) {
@@ -16,7 +58,7 @@ Application::~Application() = default; // Rely on OS cleanup to avoid destructor
 
 int Application::run(int argc, char* argv[]) {
     try {
-        // Flush std::cout automatically so DEBUG lines show without buffering
+        // Flush std::cout automatically so results show without buffering
         std::cout.setf(std::ios::unitbuf);
 
         // Setup argument parser
@@ -39,6 +81,11 @@ int Application::run(int argc, char* argv[]) {
             return handleHelpCommand(parse_result);
         }
 
+        // bench times slicing; a result-cache hit would only time a file copy
+        if (parse_result.command == "bench") {
+            Benchmark::disableResultCache();
+        }
+
         // Initialize application
         if (!initialize()) {
             return ErrorHandler::errorCodeToExitCode(ErrorCode::InitializationError);
@@ -131,6 +178,9 @@ void Application::setupArgumentParser() {
         ArgumentParser::ArgumentDef("process", ArgumentParser::ArgumentType::Option, "Process profile (e.g., '0.20mm Standard @BBL X1C')"),
         // Comma-separated overrides: key=value[,key=value...]
         ArgumentParser::ArgumentDef("set", ArgumentParser::ArgumentType::Option, "Override config options as key=value pairs separated by commas (e.g., --set \"curr_bed_type=High Temp Plate,first_layer_bed_temperature=65\")"),
+        ArgumentParser::ArgumentDef("compression-level", ArgumentParser::ArgumentType::Option, "Compression level 0-9 for .gcode.3mf, .gcode.gz, .gcode.zst and .bgcode outputs (default: library default)"),
+        ArgumentParser::ArgumentDef("output-format", ArgumentParser::ArgumentType::Option, "G-code output format: gcode, gcode.gz, gcode.zst or bgcode (default: from the output extension)"),
+        ArgumentParser::ArgumentDef("trace", ArgumentParser::ArgumentType::Option, "Write a Chrome trace JSON of the slice (chrome://tracing, ui.perfetto.dev) to this file"),
         ArgumentParser::ArgumentDef("dry-run", ArgumentParser::ArgumentType::Flag, "Validate without slicing")
     };
     m_parser->addCommand(slice_cmd);
@@ -157,6 +207,40 @@ void Application::setupArgumentParser() {
     };
     m_parser->addCommand(list_profiles_cmd);
 
+    // Serve command
+    ArgumentParser::CommandDef serve_cmd("serve", "Run a pre-forked pool of warm slicing workers on a Unix socket");
+
+    ArgumentParser::ArgumentDef socket_arg("socket", ArgumentParser::ArgumentType::Option, "Unix socket path to listen on");
+    socket_arg.required = true;
+
+    serve_cmd.arguments = {
+        socket_arg,
+        ArgumentParser::ArgumentDef("workers", ArgumentParser::ArgumentType::Option, "Number of worker processes (default: number of CPU cores)"),
+        ArgumentParser::ArgumentDef("max-jobs", ArgumentParser::ArgumentType::Option, "Recycle each worker after this many jobs (default: 0 = never)"),
+        ArgumentParser::ArgumentDef("vendors", ArgumentParser::ArgumentType::Option, "Comma-separated vendors to load before forking (e.g., 'BBL,Prusa')"),
+        ArgumentParser::ArgumentDef("printer", ArgumentParser::ArgumentType::Option, "Printer profile to load before forking"),
+        ArgumentParser::ArgumentDef("filament", ArgumentParser::ArgumentType::Option, "Filament profile to load before forking"),
+        ArgumentParser::ArgumentDef("process", ArgumentParser::ArgumentType::Option, "Process profile to load before forking")
+    };
+    m_parser->addCommand(serve_cmd);
+
+    // Bench command
+    ArgumentParser::CommandDef bench_cmd("bench", "Slice a suite of models repeatedly and report wall time, stage timings and peak RSS");
+    bench_cmd.arguments = {
+        ArgumentParser::ArgumentDef("cases", ArgumentParser::ArgumentType::Option, "Comma-separated inputs as path[@plate] (default: example_files 3DBenchy.3mf@1, 3DBenchy.stl, 3DBenchy.3mf@2)"),
+        ArgumentParser::ArgumentDef("runs", ArgumentParser::ArgumentType::Option, "Measured runs per case (default: 5)"),
+        ArgumentParser::ArgumentDef("warmup", ArgumentParser::ArgumentType::Option, "Unmeasured warmup runs per case (default: 1)"),
+        ArgumentParser::ArgumentDef("printer", ArgumentParser::ArgumentType::Option, "Printer profile (default: 'Bambu Lab X1 Carbon 0.4 nozzle')"),
+        ArgumentParser::ArgumentDef("filament", ArgumentParser::ArgumentType::Option, "Filament profile (default: 'Bambu PLA Matte @BBL X1C')"),
+        ArgumentParser::ArgumentDef("process", ArgumentParser::ArgumentType::Option, "Process profile (default: '0.20mm Standard @BBL X1C')"),
+        ArgumentParser::ArgumentDef("set", ArgumentParser::ArgumentType::Option, "Override config options as key=value pairs separated by commas"),
+        ArgumentParser::ArgumentDef("output-format", ArgumentParser::ArgumentType::Option, "Output kind: gcode, gcode.3mf, gcode.gz, gcode.zst or bgcode (default: gcode)"),
+        ArgumentParser::ArgumentDef("json", ArgumentParser::ArgumentType::Option, "Write the results as JSON to this file"),
+        ArgumentParser::ArgumentDef("baseline", ArgumentParser::ArgumentType::Option, "JSON from a previous bench run to compare median wall times against"),
+        ArgumentParser::ArgumentDef("max-regression", ArgumentParser::ArgumentType::Option, "Fail when a case's median is this many percent slower than the baseline (default: 10)")
+    };
+    m_parser->addCommand(bench_cmd);
+
     // Help command
     ArgumentParser::CommandDef help_cmd("help", "Show help information");
     help_cmd.arguments = {
@@ -176,6 +260,10 @@ int Application::executeCommand(const std::string& command, const ArgumentParser
         return handleVersionCommand(args);
     } else if (command == "list-profiles") {
         return handleListProfilesCommand(args);
+    } else if (command == "serve") {
+        return handleServeCommand(args);
+    } else if (command == "bench") {
+        return handleBenchCommand(args);
     } else if (command == "help") {
         return handleHelpCommand(args);
     } else if (command.empty()) {
@@ -214,40 +302,19 @@ int Application::handleSliceCommand(const ArgumentParser::ParseResult& args) {
     params.plate_index = plate;
     LOG_INFO("Plate index: " + std::to_string(params.plate_index));
 
-    // Parse overrides from --set "k=v,k=v,..."
     {
-        std::string set_arg = args.getArgument("set");
-        if (!set_arg.empty()) {
-            // Split by commas
-            size_t start = 0;
-            while (start < set_arg.size()) {
-                size_t comma = set_arg.find(',', start);
-                std::string kv = (comma == std::string::npos) ? set_arg.substr(start) : set_arg.substr(start, comma - start);
-                // Trim spaces
-                auto ltrim = [](std::string &s){ s.erase(s.begin(), std::find_if(s.begin(), s.end(), [](unsigned char ch){ return !std::isspace(ch); })); };
-                auto rtrim = [](std::string &s){ s.erase(std::find_if(s.rbegin(), s.rend(), [](unsigned char ch){ return !std::isspace(ch); }).base(), s.end()); };
-                ltrim(kv); rtrim(kv);
-                if (!kv.empty()) {
-                    size_t eq = kv.find('=');
-                    if (eq != std::string::npos) {
-                        std::string key = kv.substr(0, eq);
-                        std::string val = kv.substr(eq + 1);
-                        ltrim(key); rtrim(key);
-                        ltrim(val); rtrim(val);
-                        // Strip surrounding quotes if present
-                        if (val.size() >= 2 && ((val.front() == '"' && val.back() == '"') || (val.front() == '\'' && val.back() == '\''))) {
-                            val = val.substr(1, val.size() - 2);
-                        }
-                        if (!key.empty()) {
-                            params.custom_settings[key] = val;
-                            LOG_INFO(std::string("Override set: ") + key + "=" + val);
-                        }
-                    }
-                }
-                if (comma == std::string::npos) break;
-                start = comma + 1;
-            }
+        std::string level_str = args.getArgument("compression-level");
+        if (!level_str.empty()) {
+            try { params.compression_level = std::clamp(std::stoi(level_str), 0, 9); } catch (...) {}
         }
+        params.output_format = args.getArgument("output-format");
+    }
+    params.trace_file = args.getArgument("trace");
+
+    // Parse overrides from --set "k=v,k=v,..."
+    params.custom_settings = parseOverrides(args.getArgument("set"));
+    for (const auto& kv : params.custom_settings) {
+        LOG_INFO(std::string("Override set: ") + kv.first + "=" + kv.second);
     }
 
     LOG_INFO("Input file: " + params.input_file);
@@ -274,7 +341,11 @@ int Application::handleSliceCommand(const ArgumentParser::ParseResult& args) {
 
     LOG_INFO("Slicing completed successfully");
     if (!args.getFlag("quiet")) {
+        Logger::getInstance().flush(); // log lines are written asynchronously; keep them above the result
         std::cout << "Slicing completed: " << params.output_file << std::endl;
+        if (!params.trace_file.empty() && std::filesystem::exists(params.trace_file)) {
+            std::cout << "Trace written: " << params.trace_file << std::endl;
+        }
     }
 
     return 0;
@@ -288,6 +359,7 @@ int Application::handleInfoCommand(const ArgumentParser::ParseResult& args) {
     auto validation_info = m_core->validateModel(input_file);
     if (!validation_info.is_valid) {
         if (!args.getFlag("quiet")) {
+            Logger::getInstance().flush();
             std::cout << "Model Information:" << std::endl;
             std::cout << "  File: " << input_file << std::endl;
             std::cout << "  Valid: No" << std::endl;
@@ -306,6 +378,7 @@ int Application::handleInfoCommand(const ArgumentParser::ParseResult& args) {
     auto load_result = m_core->loadModel(input_file);
     if (!load_result.success) {
         if (!args.getFlag("quiet")) {
+            Logger::getInstance().flush();
             std::cout << "Model Information:" << std::endl;
             std::cout << "  File: " << input_file << std::endl;
             std::cout << "  Valid: No" << std::endl;
@@ -322,6 +395,7 @@ int Application::handleInfoCommand(const ArgumentParser::ParseResult& args) {
     auto model_info = m_core->getModelInfo();
 
     if (!args.getFlag("quiet")) {
+        Logger::getInstance().flush();
         std::cout << "Model Information:" << std::endl;
         std::cout << "  File: " << input_file << std::endl;
         std::cout << "  Valid: " << (model_info.is_valid ? "Yes" : "No") << std::endl;
@@ -423,6 +497,143 @@ int Application::handleListProfilesCommand(const ArgumentParser::ParseResult& ar
     return 0;
 }
 
+int Application::handleServeCommand(const ArgumentParser::ParseResult& args) {
+    WorkerPool::Options options;
+    options.socket_path = args.getArgument("socket");
+    options.workers = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    {
+        std::string workers_str = args.getArgument("workers");
+        if (!workers_str.empty()) {
+            try { options.workers = std::max(1, std::stoi(workers_str)); } catch (...) {}
+        }
+        std::string max_jobs_str = args.getArgument("max-jobs");
+        if (!max_jobs_str.empty()) {
+            try { options.max_jobs_per_worker = std::max(0, std::stoi(max_jobs_str)); } catch (...) {}
+        }
+    }
+
+    // Warm the core before forking so every worker inherits the loaded presets
+    std::string vendors = args.getArgument("vendors");
+    size_t start = 0;
+    while (start < vendors.size()) {
+        size_t comma = vendors.find(',', start);
+        std::string vendor = (comma == std::string::npos) ? vendors.substr(start) : vendors.substr(start, comma - start);
+        vendor.erase(std::remove_if(vendor.begin(), vendor.end(), [](unsigned char ch){ return std::isspace(ch); }), vendor.end());
+        if (!vendor.empty()) {
+            auto result = m_core->loadVendor(vendor);
+            if (!result.success) {
+                LOG_ERROR("Failed to load vendor '" + vendor + "': " + result.message);
+                return ErrorHandler::errorCodeToExitCode(ErrorCode::ConfigurationError);
+            }
+            LOG_INFO("Loaded vendor: " + vendor);
+        }
+        if (comma == std::string::npos) break;
+        start = comma + 1;
+    }
+
+    struct ProfileLoad { const char* arg; CliCore::OperationResult (CliCore::*load)(const std::string&); };
+    const ProfileLoad profile_loads[] = {
+        {"printer", &CliCore::loadPrinterProfile},
+        {"filament", &CliCore::loadFilamentProfile},
+        {"process", &CliCore::loadProcessProfile}
+    };
+    for (const auto& pl : profile_loads) {
+        std::string name = args.getArgument(pl.arg);
+        if (name.empty()) continue;
+        auto result = ((*m_core).*(pl.load))(name);
+        if (!result.success) {
+            LOG_ERROR(std::string("Failed to load ") + pl.arg + " profile '" + name + "': " + result.message);
+            return ErrorHandler::errorCodeToExitCode(ErrorCode::ConfigurationError);
+        }
+        LOG_INFO(std::string("Loaded ") + pl.arg + " profile: " + name);
+    }
+
+    WorkerPool pool(*m_core, options);
+    auto result = pool.run();
+    if (!result.success) {
+        LOG_ERROR("Worker pool failed: " + result.message);
+        if (!result.error_details.empty()) {
+            LOG_DEBUG("Details: " + result.error_details);
+        }
+        return ErrorHandler::errorCodeToExitCode(ErrorCode::InternalError);
+    }
+    return 0;
+}
+
+int Application::handleBenchCommand(const ArgumentParser::ParseResult& args) {
+    Benchmark::Options options;
+    const std::string cases = args.getArgument("cases");
+    options.cases = cases.empty() ? Benchmark::defaultSuite() : Benchmark::parseCases(cases);
+    options.printer_profile = args.getArgument("printer", "Bambu Lab X1 Carbon 0.4 nozzle");
+    options.filament_profile = args.getArgument("filament", "Bambu PLA Matte @BBL X1C");
+    options.process_profile = args.getArgument("process", "0.20mm Standard @BBL X1C");
+    options.custom_settings = parseOverrides(args.getArgument("set"));
+    {
+        std::string runs_str = args.getArgument("runs");
+        if (!runs_str.empty()) {
+            try { options.runs = std::max(1, std::stoi(runs_str)); } catch (...) {}
+        }
+        std::string warmup_str = args.getArgument("warmup");
+        if (!warmup_str.empty()) {
+            try { options.warmup = std::max(0, std::stoi(warmup_str)); } catch (...) {}
+        }
+    }
+    const std::string format = args.getArgument("output-format", "gcode");
+    if (format != "gcode" && format != "gcode.3mf" && format != "gcode.gz" && format != "gcode.zst" && format != "bgcode") {
+        std::cerr << "Error: Invalid output format '" << format << "'. Valid formats: gcode, gcode.3mf, gcode.gz, gcode.zst, bgcode" << std::endl;
+        return ErrorHandler::errorCodeToExitCode(ErrorCode::InvalidArguments);
+    }
+    options.output_suffix = "." + format;
+    double max_regression = 10.0;
+    {
+        std::string max_str = args.getArgument("max-regression");
+        if (!max_str.empty()) {
+            try { max_regression = std::max(0.0, std::stod(max_str)); } catch (...) {}
+        }
+    }
+
+    Benchmark bench(*m_core, options);
+    auto result = bench.run();
+    if (!result.success) {
+        LOG_ERROR("Benchmark failed: " + result.message);
+        if (!result.error_details.empty()) {
+            LOG_DEBUG("Details: " + result.error_details);
+        }
+        return ErrorHandler::errorCodeToExitCode(ErrorCode::SlicingError);
+    }
+
+    const std::string baseline = args.getArgument("baseline");
+    if (!baseline.empty()) {
+        auto compared = bench.compareWithBaseline(baseline, max_regression);
+        if (!compared.success) {
+            LOG_ERROR(compared.message);
+            if (!compared.error_details.empty()) {
+                LOG_DEBUG("Details: " + compared.error_details);
+            }
+            return ErrorHandler::errorCodeToExitCode(ErrorCode::InvalidFile);
+        }
+    }
+    const std::string json = args.getArgument("json");
+    if (!json.empty()) {
+        auto written = bench.writeJson(json);
+        if (!written.success) {
+            LOG_ERROR(written.message);
+            return ErrorHandler::errorCodeToExitCode(ErrorCode::InternalError);
+        }
+        LOG_INFO(written.message);
+    }
+
+    Logger::getInstance().flush();
+    std::cout << bench.report() << std::flush;
+    if (bench.anyFailed()) {
+        return ErrorHandler::errorCodeToExitCode(ErrorCode::SlicingError);
+    }
+    if (bench.anyRegressed()) {
+        return ErrorHandler::errorCodeToExitCode(ErrorCode::PerformanceRegression);
+    }
+    return 0;
+}
+
 int Application::handleHelpCommand(const ArgumentParser::ParseResult& args) {
     std::string command = args.getArgument("command");
     m_parser->printHelp(command);
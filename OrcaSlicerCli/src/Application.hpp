@@ -95,6 +95,20 @@ private:
      */
     int handleListProfilesCommand(const ArgumentParser::ParseResult& args);
 
+    /**
+     * @brief Handle serve command (pre-forked worker pool on a Unix socket)
+     * @param args Parsed arguments
+     * @return Exit code
+     */
+    int handleServeCommand(const ArgumentParser::ParseResult& args);
+
+    /**
+     * @brief Handle bench command (repeated slicing of a suite, JSON report, regression check)
+     * @param args Parsed arguments
+     * @return Exit code
+     */
+    int handleBenchCommand(const ArgumentParser::ParseResult& args);
+
     /**
      * @brief Handle help command
      * @param args Parsed arguments
@@ -0,0 +1,383 @@
+#include "Benchmark.hpp"
+#include "core/OutputBuffer.hpp"
+#include "utils/Logger.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "nlohmann/json.hpp"
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+namespace OrcaSlicerCli {
+
+namespace {
+
+using Timings = CliCore::SliceTimings;
+
+const std::pair<const char*, uint64_t Timings::*> kStages[] = {
+    {"load_model", &Timings::load_model_ns},
+    {"presets", &Timings::presets_ns},
+    {"apply", &Timings::apply_ns},
+    {"process", &Timings::process_ns},
+    {"export_gcode", &Timings::export_gcode_ns},
+    {"package", &Timings::package_ns},
+    {"total", &Timings::total_ns}
+};
+
+double to_ms(uint64_t ns) { return static_cast<double>(ns) / 1e6; }
+
+template <typename T>
+T median(std::vector<T> values) {
+    if (values.empty()) return T();
+    std::sort(values.begin(), values.end());
+    const size_t mid = values.size() / 2;
+    return values.size() % 2 ? values[mid] : (values[mid - 1] + values[mid]) / 2;
+}
+
+// Nearest-rank percentile of sorted values
+double percentile(const std::vector<double>& sorted, double pct) {
+    if (sorted.empty()) return 0;
+    const size_t rank = static_cast<size_t>(std::ceil(pct / 100.0 * static_cast<double>(sorted.size())));
+    return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+}
+
+// Linux can reset the peak RSS (VmHWM) of the process, so each case gets its own high-water mark
+bool reset_peak_rss() {
+#if defined(__linux__)
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    return clear_refs && (clear_refs << "5" << std::flush);
+#else
+    return false;
+#endif
+}
+
+uint64_t peak_rss_bytes() {
+#if defined(__linux__)
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) return std::strtoull(line.c_str() + 6, nullptr, 10) * 1024;
+    }
+#endif
+#if defined(_WIN32)
+    return 0;
+#else
+    struct rusage usage {};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+    return static_cast<uint64_t>(usage.ru_maxrss); // bytes
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024; // KiB
+#endif
+#endif
+}
+
+// Projects are named with their plate, so "x.3mf" and "x.3mf@1" match across runs
+Benchmark::Case make_case(const std::string& input, int plate) {
+    Benchmark::Case c;
+    c.input = input;
+    c.plate = std::max(1, plate);
+    const std::filesystem::path path(input);
+    c.name = path.filename().string();
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
+    if (ext == ".3mf") c.name += "@" + std::to_string(c.plate);
+    return c;
+}
+
+} // namespace
+
+Benchmark::Benchmark(CliCore& core, const Options& options)
+    : m_core(core), m_options(options) {
+    m_options.runs = std::max(1, m_options.runs);
+    m_options.warmup = std::max(0, m_options.warmup);
+}
+
+std::vector<Benchmark::Case> Benchmark::defaultSuite() {
+    std::filesystem::path dir;
+    for (const char* candidate : {"example_files", "../example_files", "../../example_files", "../../../example_files"}) {
+        std::error_code ec;
+        if (std::filesystem::is_directory(candidate, ec)) {
+            dir = candidate;
+            break;
+        }
+    }
+    std::vector<Case> suite;
+    if (dir.empty()) return suite;
+    auto add = [&](const char* file, int plate) {
+        std::error_code ec;
+        const std::filesystem::path path = dir / file;
+        if (std::filesystem::is_regular_file(path, ec)) suite.push_back(make_case(path.string(), plate));
+        else LOG_WARNING(std::string("Benchmark input not found, skipped: ") + path.string());
+    };
+    add("3DBenchy.3mf", 1);
+    add("3DBenchy.stl", 1);
+    add("3DBenchy.3mf", 2);
+    return suite;
+}
+
+std::vector<Benchmark::Case> Benchmark::parseCases(const std::string& list) {
+    std::vector<Case> cases;
+    size_t start = 0;
+    while (start <= list.size()) {
+        size_t comma = list.find(',', start);
+        std::string item = list.substr(start, comma == std::string::npos ? std::string::npos : comma - start);
+        item.erase(0, item.find_first_not_of(" \t"));
+        item.erase(item.find_last_not_of(" \t") + 1);
+        if (!item.empty()) {
+            int plate = 1;
+            const size_t at = item.rfind('@');
+            if (at != std::string::npos && at + 1 < item.size() &&
+                std::all_of(item.begin() + at + 1, item.end(), [](unsigned char ch) { return std::isdigit(ch); })) {
+                plate = std::atoi(item.c_str() + at + 1);
+                item.resize(at);
+            }
+            cases.push_back(make_case(item, plate));
+        }
+        if (comma == std::string::npos) break;
+        start = comma + 1;
+    }
+    return cases;
+}
+
+void Benchmark::disableResultCache() {
+#ifdef _WIN32
+    _putenv_s("ORCACLI_RESULT_CACHE_DIR", "");
+#else
+    unsetenv("ORCACLI_RESULT_CACHE_DIR");
+#endif
+}
+
+Benchmark::CaseResult Benchmark::runCase(const Case& bench_case) {
+    CaseResult result;
+    result.bench_case = bench_case;
+
+    CliCore::SlicingParams params;
+    params.input_file = bench_case.input;
+    params.plate_index = bench_case.plate;
+    params.printer_profile = m_options.printer_profile;
+    params.filament_profile = m_options.filament_profile;
+    params.process_profile = m_options.process_profile;
+    params.custom_settings = m_options.custom_settings;
+
+    // Run 0 is cold: the previous case's parsed project and resolved configs must not serve it
+    m_core.clearCaches();
+    std::vector<Timings> timings;
+    const int total_runs = 1 + m_options.warmup + m_options.runs;
+    for (int i = 0; i < total_runs; ++i) {
+        const bool cold = i == 0;
+        const bool measured = i > m_options.warmup;
+        if (i == m_options.warmup + 1) result.peak_rss_per_case = reset_peak_rss();
+        params.output_file = OutputBuffer::scratchPath(m_options.output_suffix);
+
+        const auto t0 = std::chrono::steady_clock::now();
+        const auto sliced = m_core.slice(params);
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+        std::error_code ec;
+        if (sliced.success) {
+            if (cold) {
+                result.cold_ms = ms;
+                result.cold_stages = m_core.getLastTimings();
+            } else if (measured) {
+                result.wall_ms.push_back(ms);
+                timings.push_back(m_core.getLastTimings());
+                result.output_bytes = std::filesystem::file_size(params.output_file, ec);
+            }
+        } else {
+            ++result.failures;
+            if (result.error.empty()) {
+                result.error = sliced.message + (sliced.error_details.empty() ? "" : ": " + sliced.error_details);
+            }
+        }
+        std::filesystem::remove(params.output_file, ec);
+        const std::string label = cold ? " cold" : measured ? " run " + std::to_string(i - m_options.warmup) : " warmup " + std::to_string(i);
+        LOG_INFO("bench " + bench_case.name + label +
+                 ": " + (sliced.success ? std::to_string(static_cast<long long>(ms)) + " ms" : "failed (" + sliced.message + ")"));
+    }
+    result.peak_rss_bytes = peak_rss_bytes();
+
+    if (!result.wall_ms.empty()) {
+        std::vector<double> sorted = result.wall_ms;
+        std::sort(sorted.begin(), sorted.end());
+        result.min_ms = sorted.front();
+        result.max_ms = sorted.back();
+        result.median_ms = median(sorted);
+        result.p95_ms = percentile(sorted, 95.0);
+
+        for (const auto& stage : kStages) {
+            std::vector<uint64_t> values;
+            for (const Timings& t : timings) values.push_back(t.*stage.second);
+            result.stages.*stage.second = median(values);
+        }
+        for (int s = 0; s < Timings::StepCount; ++s) {
+            std::vector<uint64_t> ns;
+            std::vector<uint32_t> count;
+            for (const Timings& t : timings) { ns.push_back(t.step_ns[s]); count.push_back(t.step_count[s]); }
+            result.stages.step_ns[s] = median(ns);
+            result.stages.step_count[s] = median(count);
+        }
+        result.stages.objects = timings.back().objects;
+        result.stages.layers = timings.back().layers;
+    }
+    return result;
+}
+
+CliCore::OperationResult Benchmark::run() {
+    m_results.clear();
+    if (m_options.cases.empty()) {
+        return CliCore::OperationResult(false, "No benchmark inputs", "pass --cases or run from a checkout with example_files/");
+    }
+    bool any_sliced = false;
+    for (const Case& bench_case : m_options.cases) {
+        m_results.push_back(runCase(bench_case));
+        any_sliced = any_sliced || !m_results.back().wall_ms.empty();
+    }
+    if (!any_sliced) {
+        return CliCore::OperationResult(false, "No benchmark case could be sliced", m_results.front().error);
+    }
+    return CliCore::OperationResult(true, "Benchmark completed");
+}
+
+CliCore::OperationResult Benchmark::compareWithBaseline(const std::string& baseline_file, double max_regression_pct) {
+    m_max_regression_pct = max_regression_pct;
+    nlohmann::json baseline;
+    try {
+        std::ifstream in(baseline_file);
+        if (!in) return CliCore::OperationResult(false, "Cannot open baseline: " + baseline_file);
+        in >> baseline;
+        for (CaseResult& result : m_results) {
+            for (const auto& entry : baseline.at("cases")) {
+                if (entry.at("name").get<std::string>() != result.bench_case.name) continue;
+                result.baseline_median_ms = entry.at("wall_ms").at("median").get<double>();
+                result.regressed = !result.wall_ms.empty() && result.baseline_median_ms > 0 &&
+                                   result.median_ms > result.baseline_median_ms * (1.0 + max_regression_pct / 100.0);
+                break;
+            }
+        }
+    } catch (const std::exception& e) {
+        return CliCore::OperationResult(false, "Invalid baseline: " + baseline_file, e.what());
+    }
+    return CliCore::OperationResult(true, "Baseline compared");
+}
+
+CliCore::OperationResult Benchmark::writeJson(const std::string& json_file) const {
+    nlohmann::ordered_json doc;
+    doc["engine"] = CliCore::getVersion();
+    doc["profiles"] = {{"printer", m_options.printer_profile}, {"filament", m_options.filament_profile}, {"process", m_options.process_profile}};
+    doc["overrides"] = m_options.custom_settings;
+    doc["output_suffix"] = m_options.output_suffix;
+    doc["runs"] = m_options.runs;
+    doc["warmup"] = m_options.warmup;
+    doc["cases"] = nlohmann::ordered_json::array();
+    for (const CaseResult& r : m_results) {
+        nlohmann::ordered_json c;
+        c["name"] = r.bench_case.name;
+        c["input"] = r.bench_case.input;
+        c["plate"] = r.bench_case.plate;
+        c["runs"] = r.wall_ms.size();
+        c["failures"] = r.failures;
+        if (!r.error.empty()) c["error"] = r.error;
+        c["wall_ms"] = {{"min", r.min_ms}, {"median", r.median_ms}, {"p95", r.p95_ms}, {"max", r.max_ms}};
+        c["samples_ms"] = r.wall_ms;
+        nlohmann::ordered_json cold_stages;
+        for (const auto& stage : kStages) cold_stages[stage.first] = to_ms(r.cold_stages.*stage.second);
+        c["cold"] = {{"wall_ms", r.cold_ms}, {"stages_ms", cold_stages}};
+        nlohmann::ordered_json stages;
+        for (const auto& stage : kStages) stages[stage.first] = to_ms(r.stages.*stage.second);
+        nlohmann::ordered_json steps;
+        for (int s = 0; s < Timings::StepCount; ++s) {
+            steps[Timings::stepName(s)] = {{"ms", to_ms(r.stages.step_ns[s])}, {"count", r.stages.step_count[s]}};
+        }
+        stages["steps"] = steps;
+        c["stages_ms"] = stages;
+        c["objects"] = r.stages.objects;
+        c["layers"] = r.stages.layers;
+        c["peak_rss_bytes"] = r.peak_rss_bytes;
+        c["peak_rss_scope"] = r.peak_rss_per_case ? "case" : "process";
+        c["output_bytes"] = r.output_bytes;
+        if (r.baseline_median_ms > 0) {
+            c["baseline_median_ms"] = r.baseline_median_ms;
+            c["change_pct"] = r.wall_ms.empty() ? 0.0 : (r.median_ms / r.baseline_median_ms - 1.0) * 100.0;
+            c["regressed"] = r.regressed;
+        }
+        doc["cases"].push_back(std::move(c));
+    }
+
+    const std::string tmp = json_file + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out || !(out << doc.dump(2) << '\n')) return CliCore::OperationResult(false, "Cannot write " + json_file);
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, json_file, ec);
+    if (ec) return CliCore::OperationResult(false, "Cannot write " + json_file, ec.message());
+    return CliCore::OperationResult(true, "Benchmark results written to " + json_file);
+}
+
+std::string Benchmark::report() const {
+    std::ostringstream out;
+    char line[256];
+    std::snprintf(line, sizeof(line), "%-24s %10s %5s %10s %10s %10s %10s %12s\n", "case", "cold ms", "runs", "min ms", "median ms", "p95 ms", "peak MiB", "output KiB");
+    out << line;
+    for (const CaseResult& r : m_results) {
+        std::snprintf(line, sizeof(line), "%-24s %10.1f %5zu %10.1f %10.1f %10.1f %10.1f %12.1f",
+                      r.bench_case.name.c_str(), r.cold_ms, r.wall_ms.size(), r.min_ms, r.median_ms, r.p95_ms,
+                      static_cast<double>(r.peak_rss_bytes) / (1024.0 * 1024.0), static_cast<double>(r.output_bytes) / 1024.0);
+        out << line;
+        if (r.baseline_median_ms > 0 && !r.wall_ms.empty()) {
+            std::snprintf(line, sizeof(line), "  %+.1f%% vs baseline%s", (r.median_ms / r.baseline_median_ms - 1.0) * 100.0,
+                          r.regressed ? " REGRESSION" : "");
+            out << line;
+        }
+        if (r.failures > 0) out << "  " << r.failures << " failed: " << r.error;
+        out << '\n';
+        if (r.wall_ms.empty()) continue;
+        if (r.cold_ms > 0) {
+            out << "    cold stages ms:  ";
+            for (const auto& stage : kStages) {
+                if (stage.second == &Timings::total_ns) continue;
+                std::snprintf(line, sizeof(line), " %s=%.1f", stage.first, to_ms(r.cold_stages.*stage.second));
+                out << line;
+            }
+            out << '\n';
+        }
+        out << "    median stages ms:";
+        for (const auto& stage : kStages) {
+            if (stage.second == &Timings::total_ns) continue;
+            std::snprintf(line, sizeof(line), " %s=%.1f", stage.first, to_ms(r.stages.*stage.second));
+            out << line;
+        }
+        out << "\n    process steps ms:";
+        for (int s = 0; s < Timings::StepCount; ++s) {
+            std::snprintf(line, sizeof(line), " %s=%.1f", Timings::stepName(s), to_ms(r.stages.step_ns[s]));
+            out << line;
+        }
+        out << '\n';
+    }
+    if (anyRegressed()) {
+        std::snprintf(line, sizeof(line), "Median wall time regressed by more than %.1f%% on at least one case\n", m_max_regression_pct);
+        out << line;
+    }
+    return out.str();
+}
+
+bool Benchmark::anyRegressed() const {
+    return std::any_of(m_results.begin(), m_results.end(), [](const CaseResult& r) { return r.regressed; });
+}
+
+bool Benchmark::anyFailed() const {
+    return std::any_of(m_results.begin(), m_results.end(), [](const CaseResult& r) { return r.failures > 0; });
+}
+
+} // namespace OrcaSlicerCli
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "core/CliCore.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace OrcaSlicerCli {
+
+/**
+ * @brief Slicing benchmark behind `orcaslicer-cli bench`
+ *
+ * Slices each case of a suite on one CliCore with fixed profiles, to scratch
+ * outputs: one cold run after CliCore::clearCaches() (project parse and preset
+ * resolution included), then `warmup + runs` warm runs that reuse the engine's
+ * project and config caches. The measured warm runs give the min/median/p95
+ * wall time, the median of each CliCore::SliceTimings stage, the peak RSS and
+ * the output size; the cold run is reported next to them. Results are written as JSON and can be compared against a
+ * previous JSON (e.g. from another commit) to fail on a slowdown.
+ */
+class Benchmark {
+public:
+    struct Case {
+        std::string name;  // file name, plus "@<plate>" for .3mf projects
+        std::string input;
+        int plate = 1;
+    };
+
+    struct Options {
+        std::vector<Case> cases;
+        std::string printer_profile;
+        std::string filament_profile;
+        std::string process_profile;
+        std::map<std::string, std::string> custom_settings;
+        int runs = 5;
+        int warmup = 1;
+        std::string output_suffix = ".gcode"; // ".gcode", ".gcode.3mf", ".gcode.gz", ".gcode.zst" or ".bgcode"
+    };
+
+    struct CaseResult {
+        Case bench_case;
+        double cold_ms = 0;                // first run after clearing the engine caches; 0 = it failed
+        CliCore::SliceTimings cold_stages;
+        std::vector<double> wall_ms;       // measured warm runs, in run order
+        double min_ms = 0, median_ms = 0, p95_ms = 0, max_ms = 0;
+        CliCore::SliceTimings stages;      // median of each stage over the measured runs
+        uint64_t peak_rss_bytes = 0;
+        bool peak_rss_per_case = false;    // false: process high-water mark (no per-case reset on this platform)
+        uint64_t output_bytes = 0;
+        int failures = 0;
+        std::string error;                 // message of the first failed run
+        double baseline_median_ms = 0;     // 0 = no baseline for this case
+        bool regressed = false;
+    };
+
+    Benchmark(CliCore& core, const Options& options);
+
+    /**
+     * @brief The default suite: 3DBenchy.3mf plate 1 and plate 2, and 3DBenchy.stl, from example_files
+     *
+     * example_files is searched from the working directory upwards; missing files are left out.
+     */
+    static std::vector<Case> defaultSuite();
+
+    /**
+     * @brief Parse "path[@plate],path[@plate],..."
+     */
+    static std::vector<Case> parseCases(const std::string& list);
+
+    /**
+     * @brief Keep bench jobs out of the on-disk result cache (ORCACLI_RESULT_CACHE_DIR)
+     *
+     * A cache hit would time a file copy instead of slicing. Call before CliCore::initialize().
+     */
+    static void disableResultCache();
+
+    /**
+     * @brief Run every case; fails only if no case could be sliced at all
+     */
+    CliCore::OperationResult run();
+
+    /**
+     * @brief Compare medians with a JSON written by writeJson(); marks cases slower by more than max_regression_pct
+     * @return Operation result (fails if the baseline cannot be read)
+     */
+    CliCore::OperationResult compareWithBaseline(const std::string& baseline_file, double max_regression_pct);
+
+    CliCore::OperationResult writeJson(const std::string& json_file) const;
+
+    /**
+     * @brief Human-readable summary table
+     */
+    std::string report() const;
+
+    const std::vector<CaseResult>& results() const { return m_results; }
+    bool anyRegressed() const;
+    bool anyFailed() const;
+
+private:
+    CaseResult runCase(const Case& bench_case);
+
+    CliCore& m_core;
+    Options m_options;
+    std::vector<CaseResult> m_results;
+    double m_max_regression_pct = 0;
+};
+
+} // namespace OrcaSlicerCli
@@ -1,4 +1,14 @@
 #include "CliCore.hpp"
+#include "GcodeEncoder.hpp"
+#include "MeshReader.hpp"
+#include "OutputBuffer.hpp"
+#include "ParallelDeflate.hpp"
+#include "PlateExtractor.hpp"
+#include "ProjectCache.hpp"
+#include "SliceTrace.hpp"
+#include "ZipArchive.hpp"
+#include "utils/Logger.hpp"
+#include "utils/Md5.hpp"
 
 #include <iostream>
 #include <fstream>
@@ -15,8 +25,17 @@
 
 #include <string>
 #include <vector>
+#include <array>
 #include <limits>
 #include <cstdlib>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#if defined(__linux__)
+#include <unistd.h>
+#endif
 
 
 #if !HAVE_LIBSLIC3R
@@ -44,6 +63,12 @@
     #include "libslic3r/Geometry.hpp"
 
 #include "libslic3r/Preset.hpp"
+#include <tbb/task_group.h>
+#include <tbb/task_scheduler_observer.h>
+#include "PresetIndex.hpp"
+#include "PresetSnapshot.hpp"
+#include "ResolvedConfigCache.hpp"
+#include "SliceResultCache.hpp"
 
 #endif
 
@@ -88,8 +113,16 @@ public:
     bool initialized = false;
     std::string resources_path;
     int plate_id = 0; // 0-based plate index for .3mf projects
+    int compression_level = -1; // SlicingParams::compression_level of the current job
+    GcodeEncoder::Format gcode_format = GcodeEncoder::Format::Plain; // encoding of non-3MF outputs of the current job
 
     std::string last_error;
+    CliCore::SliceTimings last_timings; // stage timings of the running or last slice()
+    // getStats() counters; read from other threads while a job runs
+    std::atomic<uint64_t> stat_slices{0};
+    std::atomic<uint64_t> stat_slice_failures{0};
+    std::atomic<uint64_t> stat_bytes_in{0};
+    std::atomic<uint64_t> stat_bytes_out{0};
 
 #if HAVE_LIBSLIC3R
     std::unique_ptr<Slic3r::Model> model;
@@ -102,6 +135,34 @@ public:
     Slic3r::AppConfig app_config;
     Slic3r::PresetBundle preset_bundle;
     std::set<std::string> loaded_vendors;
+    // Name/alias/(model, variant) -> preset lookup; rebuilt lazily when preset_generation moves on
+    PresetIndex preset_index;
+    // Bumped by presets_changed() whenever presets are added to or removed from preset_bundle (vendor, snapshot, project loads)
+    uint64_t preset_generation = 1;
+    // Fully resolved working configs per (printer, filament, process, overrides); cleared by presets_changed()
+    ResolvedConfigCache config_cache;
+    // On-disk results of identical jobs (ORCACLI_RESULT_CACHE_DIR); shared between engines and processes
+    SliceResultCache result_cache;
+    // Parsed 3MF projects per (content hash, plate) (ORCACLI_PROJECT_CACHE_SIZE entries, 0 disables)
+    ProjectCache project_cache;
+    // Parsed project the current model was loaded from (null for STL/OBJ); its plate thumbnails are reused by .gcode.3mf packaging
+    std::shared_ptr<const ProjectCache::Entry> loaded_project;
+    // Re-slice session: Model and Print are kept between reslices so Print::apply() only invalidates
+    // the steps affected by the changed settings. Any model reload ends the session.
+    uint64_t session_id = 0; // 0 = no open session
+    std::string session_input_ext; // model kind of the open session; reslice() jobs carry no input of their own
+    // Cancellation/deadline of the job inside slice(); cancel() runs on another thread
+    enum class JobStop { None, Canceled, Deadline };
+    std::mutex job_mutex;              // guards the job fields below and print->cancel() while processing
+    std::condition_variable job_cv;    // wakes the deadline watchdog when the job ends
+    uint64_t job_id = 0;               // 0 = anonymous job
+    bool job_running = false;
+    bool print_processing = false;     // print->process()/export running: a stop interrupts the Print
+    JobStop job_stop = JobStop::None;
+    uint64_t pending_cancel_id = 0;    // cancel(id) that arrived before slice() started that job
+    // Outcome of the last performSlicing(): Print::ApplyStatus and the pipeline steps that were computed
+    int last_apply_status = -1;
+    std::vector<std::string> last_steps_run;
     // Preset names embedded in a 3MF project (if any). Used for auto-apply when no CLI presets are provided.
     std::string project_printer_preset;
     std::string project_print_preset;
@@ -127,6 +188,269 @@ public:
 
 
     #if HAVE_LIBSLIC3R
+        // preset_bundle gained, replaced or lost presets: the index and every resolved config built from the old set are stale
+        void presets_changed()
+        {
+            ++preset_generation;
+            config_cache.clear();
+        }
+
+        const PresetIndex& presetIndex()
+        {
+            if (!preset_index.isCurrent(preset_generation)) {
+                preset_index.build(preset_bundle, preset_generation, resources_path, loaded_vendors);
+            }
+            return preset_index;
+        }
+
+        // Enable (vendor, model, variant) in AppConfig so the printer preset becomes visible.
+        // load_installed_printers() re-materializes the whole bundle, so only run it for a new variant.
+        void enable_printer_variant(const Slic3r::Preset& preset)
+        {
+            std::string vendor_id = preset.vendor ? preset.vendor->id : std::string();
+            std::string model     = preset.config.has("printer_model")   ? preset.config.opt_string("printer_model")   : std::string();
+            std::string variant   = preset.config.has("printer_variant") ? preset.config.opt_string("printer_variant") : std::string();
+            if (vendor_id.empty()) vendor_id = "BBL"; // default to BBL vendor when unspecified
+            if (model.empty() || variant.empty() || app_config.get_variant(vendor_id, model, variant)) return;
+            LOG_DEBUG_STREAM("Enabling vendor/model/variant: vendor_id=" << vendor_id
+                      << ", model=" << model << ", variant=" << variant);
+            app_config.set_variant(vendor_id, model, variant, true);
+            preset_bundle.load_installed_printers(app_config);
+        }
+
+        // A job's resolved config depends only on (printer, filament, process, overrides) when no
+        // 3MF project state, config file or legacy preset takes part in the resolution.
+        bool is_config_cacheable(const CliCore::SlicingParams& params) const
+        {
+            if (params.printer_profile.empty() || params.filament_profile.empty() || params.process_profile.empty()) return false;
+            if (!params.config_file.empty() || !params.preset_name.empty()) return false;
+            if (!print_overrides_keys.empty() || !project_overrides_keys.empty()) return false;
+            return job_input_extension(params) != ".3mf";
+        }
+
+        // Restore a cached working config. Preset selection is only re-pointed when it differs, because
+        // performSlicing still reads the selected printer (vendor/type) from the bundle.
+        void apply_cached_config(const ResolvedConfigCache::Entry& entry)
+        {
+            if (preset_bundle.printers.get_selected_preset_name() != entry.printer)
+                preset_bundle.printers.select_preset_by_name(entry.printer, /*force=*/true);
+            if (preset_bundle.filaments.get_selected_preset_name() != entry.filament)
+                preset_bundle.filaments.select_preset_by_name(entry.filament, /*force=*/true);
+            if (preset_bundle.prints.get_selected_preset_name() != entry.process)
+                preset_bundle.prints.select_preset_by_name(entry.process, /*force=*/true);
+            *config = *entry.config;
+        }
+
+        // Requests the running job to stop; PrintBase::throw_if_canceled() unwinds process()/export. Caller holds job_mutex.
+        void stop_job_locked(JobStop why)
+        {
+            if (job_stop == JobStop::None) job_stop = why;
+            if (print_processing && print) print->cancel();
+        }
+
+        JobStop job_stop_reason()
+        {
+            std::lock_guard<std::mutex> lk(job_mutex);
+            return job_stop;
+        }
+
+        static OperationResult stopped_result(JobStop stop)
+        {
+            if (stop == JobStop::Deadline) return OperationResult(false, "Slicing deadline exceeded");
+            return OperationResult(false, "Slicing canceled");
+        }
+
+        // Marks a slice() in flight so cancel() and its deadline can reach it; ends the job on scope exit
+        class JobScope {
+        public:
+            JobScope(Impl& impl, uint64_t id, int timeout_ms) : m_impl(impl)
+            {
+                std::lock_guard<std::mutex> lk(m_impl.job_mutex);
+                m_impl.job_id = id;
+                m_impl.job_running = true;
+                m_impl.print_processing = false;
+                m_impl.job_stop = JobStop::None;
+                if (id != 0 && m_impl.pending_cancel_id == id) {
+                    m_impl.job_stop = JobStop::Canceled;
+                    m_impl.pending_cancel_id = 0;
+                }
+                if (timeout_ms > 0) {
+                    m_watchdog = std::thread([this, timeout_ms] {
+                        std::unique_lock<std::mutex> wl(m_impl.job_mutex);
+                        if (!m_impl.job_cv.wait_for(wl, std::chrono::milliseconds(timeout_ms), [this] { return !m_impl.job_running; })) {
+                            LOG_DEBUG_STREAM("slice deadline of " << timeout_ms << " ms exceeded (job " << m_impl.job_id << ")");
+                            m_impl.stop_job_locked(JobStop::Deadline);
+                        }
+                    });
+                }
+            }
+            ~JobScope()
+            {
+                {
+                    std::lock_guard<std::mutex> lk(m_impl.job_mutex);
+                    m_impl.job_running = false;
+                    m_impl.print_processing = false;
+                }
+                m_impl.job_cv.notify_all();
+                if (m_watchdog.joinable()) m_watchdog.join();
+            }
+            JobScope(const JobScope&) = delete;
+            JobScope& operator=(const JobScope&) = delete;
+
+        private:
+            Impl& m_impl;
+            std::thread m_watchdog;
+        };
+
+        static uint64_t ns_since(std::chrono::steady_clock::time_point start)
+        {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        }
+
+        // Adds the lifetime of the scope to a SliceTimings stage, and a span named `span` to a traced job
+        class StageTimer {
+        public:
+            explicit StageTimer(uint64_t& ns, const char* span = nullptr)
+                : m_ns(ns), m_start(std::chrono::steady_clock::now()), m_span(span, "stage") {}
+            ~StageTimer() { m_ns += ns_since(m_start); }
+            StageTimer(const StageTimer&) = delete;
+            StageTimer& operator=(const StageTimer&) = delete;
+
+        private:
+            uint64_t& m_ns;
+            std::chrono::steady_clock::time_point m_start;
+            SliceTrace::Scope m_span;
+        };
+
+#if HAVE_LIBSLIC3R
+        // TBB worker threads of a traced job: one span per stay of a worker in the arena (including its
+        // short idle spin before leaving). Workers of concurrent jobs share the arena, so they show up too.
+        class TbbTraceObserver : public tbb::task_scheduler_observer {
+        public:
+            explicit TbbTraceObserver(uint64_t session) : m_session(session), m_start(SliceTrace::Clock::now()) { observe(true); }
+            ~TbbTraceObserver() override { observe(false); }
+
+            void on_scheduler_entry(bool is_worker) override
+            {
+                if (!is_worker) return;
+                SliceTrace::nameThread("tbb worker");
+                entered() = SliceTrace::Clock::now();
+            }
+
+            void on_scheduler_exit(bool is_worker) override
+            {
+                if (!is_worker) return;
+                // Workers already in the arena when tracing started were never seen entering. The arena is shared, so the
+                // span is not attributed to this job: it may hold other jobs' tasks
+                SliceTrace::recordFor(m_session, nullptr, "tbb worker (unattributed)", "unattributed", std::max(entered(), m_start),
+                                      SliceTrace::Clock::now(), "shared TBB arena; may include other jobs' work");
+            }
+
+        private:
+            static SliceTrace::Clock::time_point& entered()
+            {
+                thread_local SliceTrace::Clock::time_point t;
+                return t;
+            }
+
+            uint64_t m_session;
+            SliceTrace::Clock::time_point m_start;
+        };
+#endif
+
+        // Canonical text of the working config (sorted key=value lines) for the result cache key
+        std::string config_fingerprint() const
+        {
+            std::string out;
+            for (const std::string& key : config->keys()) {
+                out += key;
+                out += '=';
+                out += config->opt_serialize(key);
+                out += '\n';
+            }
+            return out;
+        }
+
+        // Records which steps process() is about to run (steps not yet valid after apply()).
+        // G-code export always runs.
+        void collect_pending_steps()
+        {
+            last_steps_run.clear();
+            static const std::pair<Slic3r::PrintObjectStep, const char*> object_steps[] = {
+                {Slic3r::posSlice, "slice"}, {Slic3r::posPerimeters, "perimeters"}, {Slic3r::posPrepareInfill, "prepare_infill"},
+                {Slic3r::posInfill, "infill"}, {Slic3r::posIroning, "ironing"}, {Slic3r::posSupportMaterial, "support_material"}
+            };
+            for (const auto& step : object_steps) {
+                for (const Slic3r::PrintObject* obj : print->objects()) {
+                    if (!obj->is_step_done(step.first)) { last_steps_run.emplace_back(step.second); break; }
+                }
+            }
+            if (!print->is_step_done(Slic3r::psWipeTower)) last_steps_run.emplace_back("wipe_tower");
+            if (!print->is_step_done(Slic3r::psSkirtBrim)) last_steps_run.emplace_back("skirt_brim");
+            last_steps_run.emplace_back("gcode");
+        }
+
+        // Print::process() does not report step boundaries, so the time is split at its status updates:
+        // the steps completed since the previous sample share the time elapsed since then.
+        using StepsDone = std::vector<std::array<bool, CliCore::SliceTimings::StepCount>>;
+        std::mutex step_sample_mutex; // status updates may come from worker threads
+        std::chrono::steady_clock::time_point step_sample_mark;
+        StepsDone step_sample_done;
+        uint64_t step_trace_session = 0; // traced job: sampled steps also become spans on a "Print steps" track
+
+        // One row per PrintObject (object steps), then one row for the Print-level steps
+        StepsDone steps_done() const
+        {
+            using T = CliCore::SliceTimings;
+            static const Slic3r::PrintObjectStep object_steps[] = {
+                Slic3r::posSlice, Slic3r::posPerimeters, Slic3r::posPrepareInfill, Slic3r::posInfill, Slic3r::posIroning, Slic3r::posSupportMaterial
+            };
+            StepsDone done;
+            for (const Slic3r::PrintObject* obj : print->objects()) {
+                done.emplace_back();
+                for (int s = T::Slice; s <= T::SupportMaterial; ++s) done.back()[s] = obj->is_step_done(object_steps[s]);
+            }
+            done.emplace_back();
+            done.back()[T::WipeTower] = print->is_step_done(Slic3r::psWipeTower);
+            done.back()[T::SkirtBrim] = print->is_step_done(Slic3r::psSkirtBrim);
+            return done;
+        }
+
+        void start_step_sampling()
+        {
+            std::lock_guard<std::mutex> lk(step_sample_mutex);
+            step_sample_done = steps_done();
+            step_sample_mark = std::chrono::steady_clock::now();
+            step_trace_session = SliceTrace::currentSession();
+        }
+
+        void sample_steps()
+        {
+            std::lock_guard<std::mutex> lk(step_sample_mutex);
+            StepsDone done = steps_done();
+            if (done.size() != step_sample_done.size()) return;
+            uint32_t completed[CliCore::SliceTimings::StepCount] = {};
+            int steps = 0;
+            for (size_t row = 0; row < done.size(); ++row) {
+                for (int s = 0; s < CliCore::SliceTimings::StepCount; ++s) {
+                    if (done[row][s] && !step_sample_done[row][s] && completed[s]++ == 0) ++steps;
+                }
+            }
+            if (steps == 0) return; // still inside the same step(s)
+            const uint64_t ns = ns_since(step_sample_mark);
+            for (int s = 0; s < CliCore::SliceTimings::StepCount; ++s) {
+                if (completed[s] == 0) continue;
+                last_timings.step_ns[s] += ns / steps;
+                last_timings.step_count[s] += completed[s];
+                if (step_trace_session) {
+                    SliceTrace::recordFor(step_trace_session, "Print steps", CliCore::SliceTimings::stepName(s), "print",
+                                          step_sample_mark, std::chrono::steady_clock::now(), std::to_string(completed[s]) + " object(s)");
+                }
+            }
+            step_sample_done = std::move(done);
+            step_sample_mark = std::chrono::steady_clock::now();
+        }
+
         // Compute and set plate_origin from model instances (assembly offsets) so that G-code is plate-local.
         bool compute_and_set_plate_origin_from_model_instances()
         {
@@ -163,11 +487,11 @@ public:
                 if (!origin_found) return false;
 
                 print->set_plate_origin(Slic3r::Vec3d(origin_x, origin_y, 0.0));
-                std::cout << "DEBUG: plate_origin (from instance assembly offsets) => origin=(" << origin_x << "," << origin_y
-                          << ") stride=(" << stride_x << "," << stride_y << ")" << std::endl;
+                LOG_DEBUG_STREAM("plate_origin (from instance assembly offsets) => origin=(" << origin_x << "," << origin_y
+                          << ") stride=(" << stride_x << "," << stride_y << ")");
                 return true;
             } catch (const std::exception &e) {
-                std::cout << "WARN: compute_and_set_plate_origin_from_model_instances failed: " << e.what() << std::endl;
+                LOG_WARNING_STREAM("compute_and_set_plate_origin_from_model_instances failed: " << e.what());
                 return false;
             }
         }
@@ -219,8 +543,8 @@ public:
                         ++adjusted;
                     }
                 }
-                std::cout << "DEBUG: normalized instances to plate-local FROM assembly: asm_origin=(" << asm_origin_x << "," << asm_origin_y
-                          << ") stride=(" << stride_x << "," << stride_y << ") adjusted_instances=" << adjusted << std::endl;
+                LOG_DEBUG_STREAM("normalized instances to plate-local FROM assembly: asm_origin=(" << asm_origin_x << "," << asm_origin_y
+                          << ") stride=(" << stride_x << "," << stride_y << ") adjusted_instances=" << adjusted);
                 return adjusted > 0;
             } catch (...) { return false; }
         }
@@ -245,7 +569,7 @@ public:
             }
         } catch (const std::exception& e) {
             // Log error but don't throw in destructor
-            std::cerr << "Warning: Error during cleanup: " << e.what() << std::endl;
+            LOG_WARNING_STREAM("Error during cleanup: " << e.what());
         }
 #endif
     }
@@ -262,7 +586,7 @@ public:
             // Load configuration from JSON file
             Slic3r::ConfigSubstitutions substitutions = config.load(file_path, Slic3r::ForwardCompatibilitySubstitutionRule::Enable);
 
-            std::cout << "DEBUG: Loaded profile from " << file_path << " with " << substitutions.size() << " substitutions" << std::endl;
+            LOG_DEBUG_STREAM("Loaded profile from " << file_path << " with " << substitutions.size() << " substitutions");
             return true;
         } catch (const std::exception& e) {
             last_error = "Failed to load profile from " + file_path + ": " + e.what();
@@ -297,7 +621,7 @@ public:
                 }
             }
         } catch (const std::exception& e) {
-            std::cerr << "Error searching for profile: " << e.what() << std::endl;
+            LOG_ERROR_STREAM("Error searching for profile: " << e.what());
         }
 
         return "";
@@ -312,17 +636,17 @@ public:
                 namespace fs = std::filesystem;
                 bool root_ok = fs::exists(fs::path(resources_path));
                 bool bbl_ok  = fs::exists(fs::path(resources_path) / "profiles" / "BBL.json");
-                std::cout << "DEBUG: initializeSlic3r: resources_path='" << resources_path
+                LOG_DEBUG_STREAM("initializeSlic3r: resources_path='" << resources_path
                           << "' root_exists=" << (root_ok?1:0)
-                          << " BBL.json_exists=" << (bbl_ok?1:0) << std::endl;
+                          << " BBL.json_exists=" << (bbl_ok?1:0));
             } catch (...) {}
             // Extra DEBUG: dump env relevant to strict/eager loading
             try {
                 auto getenv_or = [](const char* n){ const char* v = std::getenv(n); return v? v : "(unset)"; };
-                std::cout << "DEBUG: initializeSlic3r env: ORCACLI_STRICT_VENDORS_ONLY=" << getenv_or("ORCACLI_STRICT_VENDORS_ONLY") << std::endl;
-                std::cout << "DEBUG: initializeSlic3r env: ORCACLI_DISABLE_AUTOLOAD=" << getenv_or("ORCACLI_DISABLE_AUTOLOAD") << std::endl;
-                std::cout << "DEBUG: initializeSlic3r env: ORCACLI_EAGER_LOAD_PRESETS=" << getenv_or("ORCACLI_EAGER_LOAD_PRESETS") << std::endl;
-                std::cout << "DEBUG: initializeSlic3r env: ORCACLI_VENDORS=" << getenv_or("ORCACLI_VENDORS") << std::endl;
+                LOG_DEBUG_STREAM("initializeSlic3r env: ORCACLI_STRICT_VENDORS_ONLY=" << getenv_or("ORCACLI_STRICT_VENDORS_ONLY"));
+                LOG_DEBUG_STREAM("initializeSlic3r env: ORCACLI_DISABLE_AUTOLOAD=" << getenv_or("ORCACLI_DISABLE_AUTOLOAD"));
+                LOG_DEBUG_STREAM("initializeSlic3r env: ORCACLI_EAGER_LOAD_PRESETS=" << getenv_or("ORCACLI_EAGER_LOAD_PRESETS"));
+                LOG_DEBUG_STREAM("initializeSlic3r env: ORCACLI_VENDORS=" << getenv_or("ORCACLI_VENDORS"));
             } catch (...) {}
 
 
@@ -338,18 +662,18 @@ public:
             fs::path data_dir = cwd / ".orcaslicercli";
             if (!fs::exists(data_dir)) fs::create_directories(data_dir);
             Slic3r::set_data_dir(data_dir.string());
-            std::cout << "DEBUG: Set data_dir to '" << data_dir.string() << "'" << std::endl; // TEST TRACE
+            LOG_DEBUG_STREAM("Set data_dir to '" << data_dir.string() << "'"); // TEST TRACE
             // Ensure a writable temporary directory for libslic3r (needed by 3MF loader backup/extract paths)
             try {
                 fs::path tmp_dir = data_dir / "tmp";
                 if (!fs::exists(tmp_dir)) fs::create_directories(tmp_dir);
                 Slic3r::set_temporary_dir(tmp_dir.string());
-                std::cout << "DEBUG: Set temporary_dir to '" << tmp_dir.string() << "'" << std::endl;
+                LOG_DEBUG_STREAM("Set temporary_dir to '" << tmp_dir.string() << "'");
             } catch (const std::exception &e) {
 
 
 
-                std::cerr << "WARN: Failed to prepare temporary_dir under data_dir: " << e.what() << std::endl;
+                LOG_WARNING_STREAM("Failed to prepare temporary_dir under data_dir: " << e.what());
             }
             // var/local/sys_shapes/custom_gcodes are runtime/read paths that default off data/resources
             // Keep them unset to let libslic3r resolve internally unless the directories exist.
@@ -377,20 +701,37 @@ public:
             if (const char* s2 = std::getenv("ORCACLI_DISABLE_AUTOLOAD")) {
                 if (s2[0]=='1' || s2[0]=='T' || s2[0]=='t' || s2[0]=='Y' || s2[0]=='y') strict_no_autoload = true;
             }
-            std::cout << "DEBUG: [TEST TRACE] strict_no_autoload=" << (strict_no_autoload?1:0) << std::endl;
+            LOG_DEBUG_STREAM("[TEST TRACE] strict_no_autoload=" << (strict_no_autoload?1:0));
+
+            // Resolved-config cache size (entries); 0 disables it
+            if (const char* cs = std::getenv("ORCACLI_CONFIG_CACHE_SIZE")) {
+                try { config_cache.setCapacity(static_cast<size_t>(std::stoul(cs))); } catch (...) {}
+            }
+            // Parsed 3MF project cache size (entries, each one plate's model); 0 disables it
+            if (const char* ps = std::getenv("ORCACLI_PROJECT_CACHE_SIZE")) {
+                try { project_cache.setCapacity(static_cast<size_t>(std::stoul(ps))); } catch (...) {}
+            }
+            // Slice result cache: disabled unless a directory is given; size budget in MiB (default 2048)
+            if (const char* rd = std::getenv("ORCACLI_RESULT_CACHE_DIR")) {
+                uint64_t max_mb = 2048;
+                if (const char* rm = std::getenv("ORCACLI_RESULT_CACHE_MAX_MB")) {
+                    try { max_mb = std::stoull(rm); } catch (...) {}
+                }
+                result_cache.configure(rd, max_mb << 20);
+            }
 
                 // Enforce API-only control: disable any env-driven autoloads unconditionally
                 strict_no_autoload = true;
-                std::cout << "DEBUG: [TEST TRACE] overriding strict_no_autoload=1 (API-only control)" << std::endl;
+                LOG_DEBUG_STREAM("[TEST TRACE] overriding strict_no_autoload=1 (API-only control)");
 
 
             if (strict_no_autoload) {
-                std::cout << "DEBUG: Strict no-autoload mode enabled: skipping seeding and env-driven vendor/preset loads" << std::endl;
+                LOG_DEBUG_STREAM("Strict no-autoload mode enabled: skipping seeding and env-driven vendor/preset loads");
                 try {
                     namespace fs = std::filesystem;
                     fs::path sys_dir = fs::path(Slic3r::data_dir()) / "system";
                     if (fs::exists(sys_dir)) {
-                        std::cout << "DEBUG: Strict mode: clearing system presets directory '" << sys_dir.string() << "'" << std::endl;
+                        LOG_DEBUG_STREAM("Strict mode: clearing system presets directory '" << sys_dir.string() << "'");
                         std::error_code ec;
                         fs::remove_all(sys_dir, ec);
                         (void)ec;
@@ -439,7 +780,7 @@ public:
                             } catch (...) { /* ignore individual copy errors */ }
                         }
                     }
-                    std::cout << "DEBUG: Seeded vendor profiles into '" << sys_dir.string() << "' (jsons=" << copied_jsons << ", dirs=" << copied_dirs << ")" << std::endl;
+                    LOG_DEBUG_STREAM("Seeded vendor profiles into '" << sys_dir.string() << "' (jsons=" << copied_jsons << ", dirs=" << copied_dirs << ")");
                     // List root vendor JSONs to verify presence (e.g., BBL.json)
                     try {
                         std::vector<std::string> root_jsons;
@@ -450,9 +791,12 @@ public:
                         }
                         std::sort(root_jsons.begin(), root_jsons.end());
                         bool has_bbl = std::find(root_jsons.begin(), root_jsons.end(), std::string("BBL.json")) != root_jsons.end();
-                        std::cout << "DEBUG: system root JSONs (" << root_jsons.size() << ") has BBL.json=" << (has_bbl?"yes":"no") << std::endl;
-                        size_t show = std::min<size_t>(root_jsons.size(), 10);
-                        for (size_t i=0;i<show;i++) std::cout << "  - " << root_jsons[i] << std::endl;
+                        if (Logger::isEnabled(LogLevel::Debug)) {
+                            std::string listing;
+                            size_t show = std::min<size_t>(root_jsons.size(), 10);
+                            for (size_t i=0;i<show;i++) listing += "\n  - " + root_jsons[i];
+                            LOG_DEBUG_STREAM("system root JSONs (" << root_jsons.size() << ") has BBL.json=" << (has_bbl?"yes":"no") << listing);
+                        }
                     } catch (...) {}
 
                     // Optional: validation mode to focus vendor loading diagnostics
@@ -460,7 +804,7 @@ public:
                         try {
                             preset_bundle.set_is_validation_mode(true);
                             preset_bundle.set_vendor_to_validate(std::string(v));
-                            std::cout << "DEBUG: Validation mode enabled for vendor '" << v << "'" << std::endl;
+                            LOG_DEBUG_STREAM("Validation mode enabled for vendor '" << v << "'");
                         } catch (...) {}
                     }
                     // Intentionally do NOT auto-load any vendors here.
@@ -476,7 +820,7 @@ public:
 
 
             // Lazy load only vendors requested via env ORCACLI_VENDORS (comma-separated)
-            std::cout << "DEBUG: [TEST TRACE] entering env-driven vendor autoload section, strict_no_autoload=" << (strict_no_autoload?1:0) << std::endl;
+            LOG_DEBUG_STREAM("[TEST TRACE] entering env-driven vendor autoload section, strict_no_autoload=" << (strict_no_autoload?1:0));
 
             if (!strict_no_autoload) {
                 if (const char* ev = std::getenv("ORCACLI_VENDORS")) {
@@ -495,6 +839,8 @@ public:
                             try {
                                 preset_bundle.load_vendor_configs_from_json(res_profiles.string(), v, Slic3r::PresetBundle::LoadSystem, Slic3r::ForwardCompatibilitySubstitutionRule::EnableSystemSilent);
                                 loaded_vendors.insert(v);
+                                preset_index.forgetVendor(v);
+                                presets_changed();
                             } catch (...) {}
                         }
                         // Materialize installed printers for selected vendors
@@ -504,24 +850,25 @@ public:
             }
 
             // Load system and user presets using PresetBundle's official API (handles vendor order and merges internally).
-            std::cout << "DEBUG: [TEST TRACE] considering eager load: strict_no_autoload=" << (strict_no_autoload?1:0) << std::endl;
+            LOG_DEBUG_STREAM("[TEST TRACE] considering eager load: strict_no_autoload=" << (strict_no_autoload?1:0));
             if (!strict_no_autoload) {
                 if (const char* eager = std::getenv("ORCACLI_EAGER_LOAD_PRESETS")) {
-                    std::cout << "DEBUG: [TEST TRACE] ORCACLI_EAGER_LOAD_PRESETS='" << eager << "'" << std::endl;
+                    LOG_DEBUG_STREAM("[TEST TRACE] ORCACLI_EAGER_LOAD_PRESETS='" << eager << "'");
                     if (eager[0]=='1' || eager[0]=='T' || eager[0]=='t' || eager[0]=='Y' || eager[0]=='y') {
-                        std::cout << "DEBUG: [TEST TRACE] calling preset_bundle.load_presets(...)" << std::endl;
+                        LOG_DEBUG_STREAM("[TEST TRACE] calling preset_bundle.load_presets(...)");
                         preset_bundle.load_presets(app_config, Slic3r::ForwardCompatibilitySubstitutionRule::EnableSystemSilent);
+                        presets_changed();
                     }
                 } else {
-                    std::cout << "DEBUG: [TEST TRACE] ORCACLI_EAGER_LOAD_PRESETS not set" << std::endl;
+                    LOG_DEBUG_STREAM("[TEST TRACE] ORCACLI_EAGER_LOAD_PRESETS not set");
                 }
             } else {
-                std::cout << "DEBUG: [TEST TRACE] Skipping eager load due to strict_no_autoload=1" << std::endl;
+                LOG_DEBUG_STREAM("[TEST TRACE] Skipping eager load due to strict_no_autoload=1");
             }
             try {
                 size_t total = preset_bundle.printers.size();
                 size_t visible = 0; for (const auto &p : preset_bundle.printers) if (p.is_visible) ++visible;
-                std::cout << "DEBUG: After load_presets: printers total=" << total << " visible=" << visible << std::endl;
+                LOG_DEBUG_STREAM("After load_presets: printers total=" << total << " visible=" << visible);
             } catch (...) {}
 
                 // Defer model/printer materialization until vendors are explicitly loaded or EAGER preset load is requested
@@ -530,7 +877,7 @@ public:
                         preset_bundle.load_installed_printers(app_config);
                         size_t totalp = preset_bundle.printers.size();
                         size_t visiblep = 0; for (const auto &p : preset_bundle.printers) if (p.is_visible) ++visiblep;
-                        std::cout << "DEBUG: After guarded load_installed_printers: printers total=" << totalp << " visible=" << visiblep << std::endl;
+                        LOG_DEBUG_STREAM("After guarded load_installed_printers: printers total=" << totalp << " visible=" << visiblep);
                     } catch (...) {}
                 }
 
@@ -548,7 +895,7 @@ public:
                     preset_bundle.load_installed_printers(app_config);
                     size_t total = preset_bundle.printers.size();
                     size_t visible = 0; for (const auto &p : preset_bundle.printers) if (p.is_visible) ++visible;
-                    std::cout << "DEBUG: After guarded load_installed_printers (2): printers total=" << total << " visible=" << visible << std::endl;
+                    LOG_DEBUG_STREAM("After guarded load_installed_printers (2): printers total=" << total << " visible=" << visible);
                 } catch (...) {}
             }
 
@@ -558,9 +905,9 @@ public:
             print = std::make_unique<Slic3r::Print>();
             if (!loaded_vendors.empty()) {
                 *config = preset_bundle.full_config_secure();
-                std::cout << "DEBUG: Materialized config/model/print with loaded vendors" << std::endl;
+                LOG_DEBUG_STREAM("Materialized config/model/print with loaded vendors");
             } else {
-                std::cout << "DEBUG: Created empty config and base model/print (no vendors loaded yet)" << std::endl;
+                LOG_DEBUG_STREAM("Created empty config and base model/print (no vendors loaded yet)");
             }
 #endif
 
@@ -571,14 +918,158 @@ public:
         }
     }
 
-    bool loadModelFromFile(const std::string& filename) {
+    // Lower-case model kind of a job (".stl", ".obj", ".3mf"), from input_format for in-memory models
+    static std::string input_extension(const CliCore::SlicingParams& params)
+    {
+        return params.input_data ? normalize_format(params.input_format) : normalize_format(std::filesystem::path(params.input_file).extension().string());
+    }
+
+    // Model name as loadModel*() gives it to the object (and so to the G-code header and slice_info)
+    static std::string input_name(const CliCore::SlicingParams& params)
+    {
+        if (params.input_data && params.input_file.empty()) return "model" + input_extension(params);
+        return std::filesystem::path(params.input_file).filename().string();
+    }
+
+    // Model kind the job slices: its own input, else the open session's model (reslice)
+    std::string job_input_extension(const CliCore::SlicingParams& params) const
+    {
+        if (!params.input_data && params.input_file.empty() && session_id != 0) return session_input_ext;
+        return input_extension(params);
+    }
+
+    // STL/OBJ files go through MeshReader instead of libslic3r's loaders (opt-in until G-code parity is established)
+    static bool mesh_reader_files()
+    {
+        const char* env = std::getenv("ORCACLI_MESH_READER");
+        return env && std::string(env) == "1";
+    }
+
+    // 3MF projects are reduced to the selected plate (PlateExtractor) unless ORCACLI_3MF_LAZY=0
+    bool plate_only_3mf() const
+    {
+        const char* env = std::getenv("ORCACLI_3MF_LAZY");
+        return plate_id >= 1 && !(env && std::string(env) == "0");
+    }
+
+    static std::string normalize_format(std::string format)
+    {
+        std::transform(format.begin(), format.end(), format.begin(), [](unsigned char c){ return static_cast<char>(std::tolower(c)); });
+        if (!format.empty() && format.front() != '.') format.insert(format.begin(), '.');
+        return format;
+    }
+
+    bool loadModelFromMemory(const uint8_t* data, size_t size, const std::string& format, const std::string& name) {
+        const std::string extension = normalize_format(format);
+        LOG_DEBUG_STREAM("loadModelFromMemory: " << size << " bytes, format='" << extension << "' plate_id=" << plate_id);
+        if (data == nullptr || size == 0) {
+            last_error = "Empty model buffer";
+            return false;
+        }
+
+        if (extension == ".3mf") {
+            // The 3MF reader (zip) and PresetBundle::load_config_model only take a path
+            const std::string staged = OutputBuffer::scratchPath(".3mf");
+            {
+                std::ofstream ofs(staged, std::ios::binary | std::ios::trunc);
+                ofs.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+                if (!ofs) {
+                    last_error = "Failed to stage 3MF buffer: " + staged;
+                    std::error_code ec;
+                    std::filesystem::remove(staged, ec);
+                    return false;
+                }
+            }
+            std::string project_key;
+#if HAVE_LIBSLIC3R
+            if (project_cache.enabled()) project_key = ProjectCache::key(data, size, plate_id, plate_only_3mf() ? "" : "full");
+#endif
+            const bool ok = loadModelFromFile(staged, project_key);
+            std::error_code ec;
+            std::filesystem::remove(staged, ec);
+            return ok;
+        }
+
+        if (extension != ".stl" && extension != ".obj") {
+            last_error = "Unsupported model format: " + format;
+            return false;
+        }
+
+        session_id = 0; // a new model ends any open re-slice session
+#if HAVE_LIBSLIC3R
+        loaded_project.reset();
+#endif
+
+        // Parsed straight from the buffer; addMeshObject repairs it like the file loaders do
+        MeshReader::Mesh raw;
+        std::string error;
+        const bool parsed = extension == ".stl" ? MeshReader::readStl(data, size, raw, error) : MeshReader::readObj(data, size, raw, error);
+        if (!parsed) {
+            last_error = error;
+            return false;
+        }
+        const std::string object_name = name.empty() ? "model" + extension : std::filesystem::path(name).filename().string();
+        return addMeshObject(raw, object_name, "");
+    }
+
+    // Replaces the model with one object built from a parsed mesh (MeshReader output). The facets go through
+    // the same admesh import as libslic3r's STL/OBJ loaders (stl_file + TriangleMesh::from_stl with repair),
+    // so normals, orientation and the shared vertex numbering come out as ReadSTLFile would produce them.
+    bool addMeshObject(const MeshReader::Mesh& raw, const std::string& object_name, const std::string& input_file) {
+#if HAVE_LIBSLIC3R
+        try {
+            model->clear_objects();
+
+            stl_file stl;
+            stl.stats.type = inmemory;
+            stl.stats.number_of_facets = uint32_t(raw.faces.size());
+            stl.stats.original_num_facets = int(stl.stats.number_of_facets);
+            stl_allocate(&stl);
+            for (size_t i = 0; i < raw.faces.size(); ++i) {
+                stl_facet& facet = stl.facet_start[i];
+                for (int c = 0; c < 3; ++c) {
+                    const auto& v = raw.vertices[raw.faces[i][c]];
+                    facet.vertex[c] = stl_vertex(v[0], v[1], v[2]);
+                }
+            }
+            Slic3r::TriangleMesh mesh;
+            if (!mesh.from_stl(stl, /*repair=*/true) || mesh.empty()) {
+                last_error = "Model is empty or invalid: " + object_name;
+                return false;
+            }
+
+            model->add_object(object_name.c_str(), input_file.c_str(), std::move(mesh));
+            for (auto* obj : model->objects) {
+                if (obj->instances.empty()) obj->add_instance();
+            }
+            LOG_DEBUG_STREAM("addMeshObject: '" << object_name << "' " << raw.vertices.size() << " vertices, "
+                      << raw.faces.size() << " facets");
+            return true;
+        } catch (const std::exception& e) {
+            last_error = std::string("Error loading model: ") + e.what();
+            return false;
+        }
+#else
+        last_error = "libslic3r not available";
+        return false;
+#endif
+    }
+
+    // project_key: ProjectCache key already computed by the caller (in-memory 3MF), else the file is hashed
+    bool loadModelFromFile(const std::string& filename, const std::string& project_key = std::string()) {
+        SliceTrace::Scope span("loadModelFromFile", "model", filename);
         if (!std::filesystem::exists(filename)) {
             last_error = "File not found: " + filename;
             return false;
         }
 
+        session_id = 0; // a new model ends any open re-slice session
+#if HAVE_LIBSLIC3R
+        loaded_project.reset();
+#endif
+
         std::filesystem::path file_path(filename);
-        std::cout << "DEBUG: loadModelFromFile: '" << filename << "' ext='" << file_path.extension().string() << "' plate_id=" << plate_id << std::endl;
+        LOG_DEBUG_STREAM("loadModelFromFile: '" << filename << "' ext='" << file_path.extension().string() << "' plate_id=" << plate_id);
         std::string extension = file_path.extension().string();
         std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
 
@@ -587,6 +1078,30 @@ public:
             return false;
         }
 
+        // With ORCACLI_MESH_READER=1, STL/OBJ are memory-mapped and parsed by MeshReader, parallel for large
+        // files, then repaired like ReadSTLFile. By default they stay on libslic3r's loaders.
+        if ((extension == ".stl" || extension == ".obj") && mesh_reader_files()) {
+            const auto t0 = std::chrono::steady_clock::now();
+            std::string error;
+            std::unique_ptr<OutputBuffer> file = OutputBuffer::map(filename, error);
+            if (!file || file->size() == 0) {
+                last_error = file ? "Model file is empty: " + filename : error;
+                return false;
+            }
+            MeshReader::Mesh raw;
+            const bool parsed = extension == ".stl" ? MeshReader::readStl(file->data(), file->size(), raw, error)
+                                                    : MeshReader::readObj(file->data(), file->size(), raw, error);
+            if (!parsed) {
+                last_error = error + ": " + filename;
+                return false;
+            }
+            LOG_DEBUG_STREAM("loadModelFromFile: parsed " << file->size() << " bytes in "
+                      << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count() << " ms");
+            file.reset();
+            // Object name keeps the extension to match reference G-code
+            return addMeshObject(raw, file_path.filename().string(), filename);
+        }
+
 #if HAVE_LIBSLIC3R
         try {
             // Clear existing model
@@ -612,6 +1127,15 @@ public:
 
                 // Add object to model
                 model->add_object(object_name.c_str(), filename.c_str(), std::move(mesh));
+            } else if (extension == ".obj") {
+                // libslic3r's OBJ import (load_obj), as the GUI uses it
+                Slic3r::Model loaded = Slic3r::Model::read_from_file(filename, nullptr, nullptr, Slic3r::LoadStrategy::LoadModel);
+                const std::string object_name = file_path.filename().string();
+                for (Slic3r::ModelObject* object : loaded.objects) {
+                    object->name = object_name;
+                    object->input_file = filename;
+                }
+                *model = std::move(loaded);
             } else if (extension == ".3mf") {
                 // Load .3mf project and select the requested plate (0-based id in Impl)
                 Slic3r::ConfigSubstitutionContext config_substitutions{Slic3r::ForwardCompatibilitySubstitutionRule::Enable};
@@ -619,25 +1143,100 @@ public:
                 std::vector<Slic3r::Preset*> project_presets;
                 bool is_bbl_3mf = false;
                 Slic3r::Semver file_version;
+                Slic3r::Model loaded;
 
-                // Read model and project config from 3mf (includes per-plate content)
-                Slic3r::Model loaded = Slic3r::Model::read_from_file(
-                    filename,
-                    config.get(),
-                    &config_substitutions,
-                    Slic3r::LoadStrategy::LoadModel | Slic3r::LoadStrategy::LoadConfig,
-                    &plate_data_src,
-                    &project_presets,
-                    &is_bbl_3mf,
-                    &file_version,
-                    nullptr,
-                    nullptr,
-                    nullptr,
-                    plate_id // 0-based
-                );
-                std::cout << "DEBUG: read_from_file: project_presets=" << project_presets.size()
-                          << ", is_bbl_3mf=" << (is_bbl_3mf ? 1 : 0)
-                          << ", file_version=" << file_version.to_string() << std::endl;
+                // Parsed projects are cached per (content hash, plate); a hit skips unzipping and parsing
+                const bool lazy = plate_only_3mf();
+                std::string cache_key;
+                if (project_cache.enabled()) {
+                    cache_key = !project_key.empty() ? project_key : ProjectCache::key(filename, plate_id, lazy ? "" : "full");
+                }
+                std::shared_ptr<const ProjectCache::Entry> project = project_cache.find(cache_key);
+                std::shared_ptr<ProjectCache::Entry> parsed;
+
+                if (project) {
+                    loaded = *project->model;
+                    *config = *project->config;
+                    is_bbl_3mf = project->is_bbl_3mf;
+                    file_version = *project->file_version;
+                    // The copy shares object ids with earlier loads of this project; start from an empty
+                    // Print so apply() never reuses steps computed for another job
+                    print = std::make_unique<Slic3r::Print>();
+                    LOG_DEBUG_STREAM("3MF project cache hit (" << cache_key.substr(0, 12) << ", plate " << plate_id << ")");
+                } else {
+                    // With a plate selected, load a copy of the project holding only that plate's objects so
+                    // meshes of other plates are never inflated
+                    struct ScratchProject {
+                        std::string path;
+                        ~ScratchProject() { std::error_code ec; if (!path.empty()) std::filesystem::remove(path, ec); }
+                    } plate_project;
+                    if (lazy) {
+                        const auto t0 = std::chrono::steady_clock::now();
+                        const std::string reduced = OutputBuffer::scratchPath(".3mf");
+                        PlateExtractor::Stats stats;
+                        std::string reason;
+                        if (PlateExtractor::extract(filename, plate_id, reduced, stats, reason)) {
+                            plate_project.path = reduced;
+                            LOG_DEBUG_STREAM("plate " << plate_id << " project: kept " << stats.objects_kept << " objects, dropped "
+                                      << stats.objects_dropped << " objects / " << stats.entries_dropped << " entries ("
+                                      << stats.bytes_dropped << " bytes) in "
+                                      << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count()
+                                      << " ms");
+                        } else {
+                            std::error_code ec;
+                            std::filesystem::remove(reduced, ec);
+                            LOG_DEBUG_STREAM("loading full project: " << reason);
+                        }
+                    }
+
+                    // Read model and project config from 3mf (includes per-plate content)
+                    loaded = Slic3r::Model::read_from_file(
+                        plate_project.path.empty() ? filename : plate_project.path,
+                        config.get(),
+                        &config_substitutions,
+                        Slic3r::LoadStrategy::LoadModel | Slic3r::LoadStrategy::LoadConfig,
+                        &plate_data_src,
+                        &project_presets,
+                        &is_bbl_3mf,
+                        &file_version,
+                        nullptr,
+                        nullptr,
+                        nullptr,
+                        plate_id // 0-based
+                    );
+                    if (!plate_project.path.empty()) {
+                        for (Slic3r::ModelObject* object : loaded.objects) object->input_file = filename;
+                    }
+                    LOG_DEBUG_STREAM("read_from_file: project_presets=" << project_presets.size()
+                              << ", is_bbl_3mf=" << (is_bbl_3mf ? 1 : 0)
+                              << ", file_version=" << file_version.to_string());
+
+                    // The parsed project owns the loaded presets; the PresetBundle below works on copies
+                    parsed = std::make_shared<ProjectCache::Entry>();
+                    for (Slic3r::Preset* pp : project_presets) {
+                        if (pp != nullptr) parsed->presets.emplace_back(pp);
+                    }
+                    project_presets.clear();
+                    parsed->is_bbl_3mf = is_bbl_3mf;
+                    parsed->file_version = std::make_shared<const Slic3r::Semver>(file_version);
+                    // Plate thumbnails, kept compressed for the .gcode.3mf export
+                    std::string assets_reason;
+                    if (PlateExtractor::readAssets(filename, plate_id >= 1 ? plate_id : 1, parsed->plate_assets, assets_reason))
+                        LOG_DEBUG_STREAM("kept " << parsed->plate_assets.entries.size() << " plate thumbnail(s) for packaging");
+                    if (project_cache.enabled()) {
+                        parsed->model = std::make_shared<const Slic3r::Model>(loaded);
+                        parsed->config = std::make_shared<const Slic3r::DynamicPrintConfig>(*config);
+                    }
+                    project = parsed;
+                }
+                loaded_project = project;
+
+                // Working copies for the PresetBundle import below; cached presets stay as loaded
+                std::vector<std::unique_ptr<Slic3r::Preset>> preset_copies;
+                for (const auto& pp : project->presets) {
+                    preset_copies.push_back(std::make_unique<Slic3r::Preset>(*pp));
+                    project_presets.push_back(preset_copies.back().get());
+                }
 
                 // Capture project-embedded preset names (prefer these over config IDs) BEFORE moving the model
                 project_printer_preset.clear();
@@ -680,12 +1279,23 @@ public:
                         auto rtrim = [](std::string &s){ s.erase(std::find_if(s.rbegin(), s.rend(), [](unsigned char ch){ return !std::isspace(ch); }).base(), s.end()); };
                         ltrim(first); rtrim(first);
                         if (!first.empty()) plate_nozzle_variant = first;
-                        std::cout << "DEBUG: Plate hints -> printer_model_id='" << plate_printer_model_id
-                                  << "', nozzle_variant='" << plate_nozzle_variant << "'" << std::endl;
+                        LOG_DEBUG_STREAM("Plate hints -> printer_model_id='" << plate_printer_model_id
+                                  << "', nozzle_variant='" << plate_nozzle_variant << "'");
                     }
                     // Record total plate count for origin computation (GUI parity)
                     total_plates_count = static_cast<int>(plate_data_src.size());
                 }
+                if (parsed) {
+                    parsed->has_plate_data = !plate_data_src.empty();
+                    parsed->plate_printer_model_id = plate_printer_model_id;
+                    parsed->plate_nozzle_variant = plate_nozzle_variant;
+                    parsed->total_plates_count = total_plates_count;
+                    if (parsed->model) project_cache.put(cache_key, parsed);
+                } else if (project->has_plate_data) {
+                    plate_printer_model_id = project->plate_printer_model_id;
+                    plate_nozzle_variant = project->plate_nozzle_variant;
+                    total_plates_count = project->total_plates_count;
+                }
 
 
                 // Import the 3MF project configuration into the PresetBundle (mirror GUI behavior)
@@ -700,6 +1310,7 @@ public:
                     Slic3r::DynamicPrintConfig _cfg_before(*config);
 
                     preset_bundle.load_config_model(filename, *config, file_version);
+                    presets_changed();
 
                     // After loading 3MF, the GUI stores project-level overrides into preset_bundle.project_config.
                     // For CLI parity, snapshot those overrides and re-apply onto the working config later.
@@ -710,7 +1321,7 @@ public:
                         print_overrides_keys.assign(dirty.begin(), dirty.end());
                         print_cfg_overrides = Slic3r::DynamicPrintConfig();
                         print_cfg_overrides.apply_only(preset_bundle.prints.get_edited_preset().config, print_overrides_keys);
-                        std::cout << "DEBUG: Detected " << print_overrides_keys.size() << " print override key(s) from 3MF" << std::endl;
+                        LOG_DEBUG_STREAM("Detected " << print_overrides_keys.size() << " print override key(s) from 3MF");
                     } catch (...) {}
 
                     project_cfg_after_3mf.apply(preset_bundle.project_config, /*ignore_nonexistent=*/true);
@@ -753,24 +1364,25 @@ public:
                     if (std::find(project_overrides_keys.begin(), project_overrides_keys.end(), std::string("wipe_tower_x")) != project_overrides_keys.end()) {
                         try {
                             auto *opt = project_cfg_after_3mf.optptr("wipe_tower_x");
-                            if (opt) std::cout << "DEBUG: 3MF overrides wipe_tower_x = " << opt->serialize() << std::endl;
+                            if (opt) LOG_DEBUG_STREAM("3MF overrides wipe_tower_x = " << opt->serialize());
                         } catch (...) {}
                     }
 
                     // Refresh working config from bundle selections
                     *config = preset_bundle.full_config_secure();
-                    std::cout << "DEBUG: Loaded 3MF project config into PresetBundle -> printer='"
+                    LOG_DEBUG_STREAM("Loaded 3MF project config into PresetBundle -> printer='"
                               << preset_bundle.printers.get_selected_preset_name()
                               << "', print='" << preset_bundle.prints.get_selected_preset_name()
                               << "', filament='" << (preset_bundle.filament_presets.empty()?std::string():preset_bundle.filament_presets.front())
-                              << "' (project overrides keys: " << project_overrides_keys.size() << ")" << std::endl;
+                              << "' (project overrides keys: " << project_overrides_keys.size() << ")");
                 } catch (const std::exception &e) {
-                    std::cout << "WARN: Failed to load 3MF project config into PresetBundle: " << e.what() << std::endl;
+                    LOG_WARNING_STREAM("Failed to load 3MF project config into PresetBundle: " << e.what());
                 }
 
                 // Load and activate project-embedded presets via PresetBundle official API
                 try {
                     auto subs = preset_bundle.load_project_embedded_presets(project_presets, Slic3r::ForwardCompatibilitySubstitutionRule::Enable);
+                    presets_changed();
                     (void)subs; // substitutions may be logged/used later if needed
                     // Refresh working config from full resolved config after selections
                     *config = preset_bundle.full_config_secure();
@@ -787,7 +1399,7 @@ public:
                         auto dump_opt = [&](const char* label, const Slic3r::DynamicConfig& cfg){
                             auto dump_one = [&](const char* k){
                                 if (const Slic3r::ConfigOption* o = cfg.optptr(k))
-                                    std::cout << "DEBUG: " << label << "[" << k << "] = " << o->serialize() << std::endl;
+                                    LOG_DEBUG_STREAM(label << "[" << k << "] = " << o->serialize());
                             };
                             dump_one("sparse_infill_density");
                             dump_one("top_shell_layers");
@@ -806,7 +1418,7 @@ public:
                                 for (const auto &k : project_overrides_keys) {
                                     if (k == std::string("sparse_infill_density") || k == std::string("top_shell_layers")) {
                                         if (const Slic3r::ConfigOption* o = config->optptr(k.c_str()))
-                                            std::cout << "DEBUG: working_config_after_override[" << k << "] = " << o->serialize() << std::endl;
+                                            LOG_DEBUG_STREAM("working_config_after_override[" << k << "] = " << o->serialize());
                                     }
                                 }
                             } catch (...) {}
@@ -827,13 +1439,13 @@ public:
 
 
 
-                    std::cout << "DEBUG: Applied project-embedded presets -> printer='"
+                    LOG_DEBUG_STREAM("Applied project-embedded presets -> printer='"
                               << preset_bundle.printers.get_selected_preset_name()
                               << "', print='" << preset_bundle.prints.get_selected_preset_name()
                               << "', filament='" << preset_bundle.filaments.get_selected_preset_name()
-                              << "'" << std::endl;
+                              << "'");
                 } catch (const std::exception &e) {
-                    std::cout << "WARN: Failed to apply project-embedded presets via PresetBundle: " << e.what() << std::endl;
+                    LOG_WARNING_STREAM("Failed to apply project-embedded presets via PresetBundle: " << e.what());
                 }
 
                 // No strict failure here; we will enforce policy later in slice() based on CLI vs 3MF data presence.
@@ -852,9 +1464,9 @@ public:
 
             // GUI parity: do not normalize instances here. Use only plate_origin for plate-local coordinates.
             // Keep instances in assembly space and apply the offset only during G-code export.
-            std::cout << "DEBUG: 3MF project preset names captured: printer='" << project_printer_preset
+            LOG_DEBUG_STREAM("3MF project preset names captured: printer='" << project_printer_preset
                       << "', print='" << project_print_preset
-                      << "', filament='" << project_filament_preset << "'" << std::endl;
+                      << "', filament='" << project_filament_preset << "'");
 
             // Ensure model has objects
             if (model->objects.empty()) {
@@ -886,7 +1498,158 @@ public:
 #endif
     }
 
+    // Output kind of a job: .3mf outputs by name, otherwise SlicingParams::output_format when given
+    static std::string output_suffix(const CliCore::SlicingParams& params) {
+        const std::string by_name = SliceResultCache::outputSuffix(params.output_file);
+        GcodeEncoder::Format format;
+        if (by_name == ".gcode.3mf" || by_name == ".3mf" || !GcodeEncoder::parseFormat(params.output_format, format)) return by_name;
+        return GcodeEncoder::suffix(format);
+    }
+
+    // .gcode.gz / .gcode.zst / .bgcode: encode the scratch export (mapped, then removed) into output_file
+    bool encodeGcode(const std::string& gcode_file, const std::string& output_file) {
+        std::string error;
+        std::unique_ptr<OutputBuffer> gcode = OutputBuffer::adopt(gcode_file, error);
+        if (!gcode) {
+            std::error_code ec;
+            std::filesystem::remove(gcode_file, ec);
+            last_error = "G-code encoding failed: " + error;
+            return false;
+        }
+        const auto t0 = std::chrono::steady_clock::now();
+        if (!GcodeEncoder::encode(gcode->data(), gcode->size(), gcode_format, compression_level, output_file, error)) {
+            last_error = "G-code encoding failed: " + error;
+            return false;
+        }
+        std::error_code ec;
+        LOG_DEBUG_STREAM("Encoded " << GcodeEncoder::suffix(gcode_format) << " (level " << compression_level << "): "
+                  << gcode->size() << " -> " << std::filesystem::file_size(output_file, ec) << " bytes in "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count() << " ms");
+        return true;
+    }
+
+    // .gcode.3mf packaging without a serial deflate of the G-code on the critical path: store_bbs_3mf packages
+    // the project around a tiny placeholder G-code while the real one is deflated in parallel blocks (and
+    // hashed), then the archive is stitched with every other entry copied raw. Returns false with the output
+    // untouched when this is not possible (ORCACLI_3MF_PARALLEL=0, no hard links, unexpected layout); the
+    // caller then packages serially.
+    bool store3mfParallel(Slic3r::StoreParams sp, Slic3r::PlateData& plate, std::string gcode_file, const std::string& output_file) {
+        if (const char* env = std::getenv("ORCACLI_3MF_PARALLEL"); env && std::string(env) == "0") return false;
+        const std::string gcode_entry = "Metadata/plate_" + std::to_string(plate.plate_index + 1) + ".gcode";
+        const std::string parts_file = output_file + ".parts";
+        const std::string placeholder_file = gcode_file + ".placeholder";
+        const std::string mapped_file = gcode_file + ".deflate";
+
+        // A second link is mapped (and unlinked) by OutputBuffer; gcode_file stays for the serial fallback
+        std::error_code ec;
+        std::filesystem::create_hard_link(gcode_file, mapped_file, ec);
+        if (ec) {
+            LOG_DEBUG_STREAM("parallel 3MF packaging skipped (hard link: " << ec.message() << ")");
+            return false;
+        }
+        std::string error;
+        std::unique_ptr<OutputBuffer> gcode = OutputBuffer::adopt(mapped_file, error);
+        if (!gcode) {
+            LOG_DEBUG_STREAM("parallel 3MF packaging skipped (" << error << ")");
+            return false;
+        }
+        struct Cleanup {
+            std::vector<std::string> files;
+            ~Cleanup() { for (const auto& f : files) { std::error_code ec; std::filesystem::remove(f, ec); } }
+        } cleanup{{parts_file, placeholder_file}};
+        {
+            std::ofstream placeholder(placeholder_file, std::ios::binary);
+            placeholder << "; placeholder\n";
+        }
+
+        plate.gcode_file = placeholder_file;
+        sp.path = parts_file.c_str();
+        bool stored = false;
+        std::string store_error;
+        // Packing and hashing run as TBB tasks next to the compression blocks, in the same arena as the slicing
+        tbb::task_group side_tasks;
+        side_tasks.run([&] {
+            try {
+                stored = Slic3r::store_bbs_3mf(sp);
+            } catch (const std::exception& e) {
+                store_error = e.what();
+            }
+        });
+        std::array<uint8_t, 16> digest{};
+        side_tasks.run([&] {
+            Md5 md5;
+            md5.update(gcode->data(), gcode->size());
+            digest = md5.digest();
+        });
+        std::vector<uint8_t> deflated;
+        uint32_t crc = 0;
+        const bool compressed = ParallelDeflate::compress(gcode->data(), gcode->size(), compression_level, 0, deflated, crc, error);
+        side_tasks.wait();
+        plate.gcode_file = gcode_file;
+        if (!stored || !compressed) {
+            LOG_DEBUG_STREAM("parallel 3MF packaging failed (" << (compressed ? (store_error.empty() ? "store_bbs_3mf" : store_error) : error)
+                      << "), packaging serially");
+            return false;
+        }
+
+        ZipReader parts;
+        if (!parts.open(parts_file, error) || !parts.find(gcode_entry)) {
+            LOG_DEBUG_STREAM("parallel 3MF packaging failed (" << (error.empty() ? gcode_entry + " not in package" : error)
+                      << "), packaging serially");
+            return false;
+        }
+        // Same hex case as store_bbs_3mf used for the placeholder
+        const ZipEntry* md5_entry = parts.find(gcode_entry + ".md5");
+        bool uppercase = true;
+        if (std::string previous; md5_entry && parts.read(*md5_entry, previous, error))
+            uppercase = previous.find_first_of("abcdef") == std::string::npos;
+        std::string md5_hex;
+        for (uint8_t b : digest) {
+            md5_hex += (uppercase ? "0123456789ABCDEF" : "0123456789abcdef")[b >> 4];
+            md5_hex += (uppercase ? "0123456789ABCDEF" : "0123456789abcdef")[b & 0xf];
+        }
+
+        // The source project's thumbnails of this plate are copied as stored and referenced from
+        // _rels/.rels and the plate's metadata (store_bbs_3mf is given no thumbnail data)
+        const PlateExtractor::PlateAssets* assets =
+            loaded_project && !loaded_project->plate_assets.empty() ? &loaded_project->plate_assets : nullptr;
+        size_t reused = 0;
+
+        ZipWriter out;
+        bool ok = out.open(output_file, error);
+        for (const ZipEntry& e : parts.entries()) {
+            if (!ok) break;
+            if (e.name == gcode_entry) {
+                ok = out.addDeflated(e, deflated.data(), deflated.size(), gcode->size(), crc, error);
+            } else if (md5_entry && e.name == md5_entry->name) {
+                ok = out.add(e, md5_hex.data(), md5_hex.size(), compression_level, error);
+            } else if (std::string part; assets && (e.name == "_rels/.rels" || e.name == "Metadata/model_settings.config" ||
+                                                          e.name == "[Content_Types].xml")) {
+                ok = parts.read(e, part, error);
+                if (ok && PlateExtractor::addAssetReferences(e.name, part, *assets))
+                    ok = out.add(e, part.data(), part.size(), compression_level, error);
+                else if (ok)
+                    ok = out.copyRaw(parts, e, error);
+            } else {
+                ok = out.copyRaw(parts, e, error);
+            }
+        }
+        for (size_t i = 0; ok && assets && i < assets->entries.size(); ++i) {
+            if (parts.find(assets->entries[i].entry.name)) continue;
+            ok = out.addRaw(assets->entries[i], error);
+            ++reused;
+        }
+        if (!ok || !out.finish(error)) {
+            LOG_DEBUG_STREAM("parallel 3MF packaging failed (" << error << "), packaging serially");
+            return false;
+        }
+        LOG_DEBUG_STREAM("3MF packaged with parallel deflate (level " << compression_level << "): G-code "
+                  << gcode->size() << " -> " << deflated.size() << " bytes, " << reused << " thumbnail(s) copied from the project");
+        return true;
+    }
+
     bool performSlicing(const std::string& output_file) {
+        SliceTrace::Scope span("performSlicing", "core", output_file);
 #if HAVE_LIBSLIC3R
         try {
             if (!model || model->objects.empty()) {
@@ -894,23 +1657,23 @@ public:
                 return false;
             }
 
-            std::cout << "DEBUG: Starting slicing process..." << std::endl;
-            std::cout << "DEBUG: Model has " << model->objects.size() << " objects" << std::endl;
-            std::cout << "DEBUG: Config is " << (config ? "valid" : "null") << std::endl;
-            std::cout << "DEBUG: Print is " << (print ? "valid" : "null") << std::endl;
+            LOG_DEBUG_STREAM("Starting slicing process...");
+            LOG_DEBUG_STREAM("Model has " << model->objects.size() << " objects");
+            LOG_DEBUG_STREAM("Config is " << (config ? "valid" : "null"));
+            LOG_DEBUG_STREAM("Print is " << (print ? "valid" : "null"));
             // Log currently selected presets inside PresetBundle
-            std::cout << "DEBUG: Selected printer preset: " << preset_bundle.printers.get_selected_preset_name() << std::endl;
-            std::cout << "DEBUG: Selected print preset:   " << preset_bundle.prints.get_selected_preset_name() << std::endl;
+            LOG_DEBUG_STREAM("Selected printer preset: " << preset_bundle.printers.get_selected_preset_name());
+            LOG_DEBUG_STREAM("Selected print preset:   " << preset_bundle.prints.get_selected_preset_name());
             if (!preset_bundle.filament_presets.empty())
-                std::cout << "DEBUG: Selected filament[0]:   " << preset_bundle.filament_presets[0] << std::endl;
+                LOG_DEBUG_STREAM("Selected filament[0]:   " << preset_bundle.filament_presets[0]);
 
             // Ensure Print knows whether this is a BBL printer (affects header + CONFIG placement)
             try {
                 bool is_bbl = preset_bundle.is_bbl_vendor();
                 print->is_BBL_printer() = is_bbl;
-                std::cout << "DEBUG: is_BBL_printer set to " << (is_bbl ? "true" : "false") << std::endl;
+                LOG_DEBUG_STREAM("is_BBL_printer set to " << (is_bbl ? "true" : "false"));
             } catch (...) {
-                std::cout << "WARN: Failed to set is_BBL_printer flag (continuing)" << std::endl;
+                LOG_WARNING_STREAM("Failed to set is_BBL_printer flag (continuing)");
             }
 
             // GUI parity: do not normalize instances; rely solely on plate_origin to localize coordinates.
@@ -918,7 +1681,7 @@ public:
             // and uses plate_origin to generate plate-local G-code.
 
             // GUI parity: do not normalize instances; set plate_origin from assembly offsets.
-            std::cout << "DEBUG: GUI parity: will set plate_origin from instance assembly offsets" << std::endl;
+            LOG_DEBUG_STREAM("GUI parity: will set plate_origin from instance assembly offsets");
 
             // GUI parity: compute and set plate_origin BEFORE process, based on instance assembly offsets or plate index stride
             {
@@ -944,12 +1707,12 @@ public:
                             const int col = idx0 % cols;
             // DEBUG: dump a couple of key values just before apply()
             try {
-                auto dump_one = [&](const char* k){ if (const Slic3r::ConfigOption* o = config->optptr(k)) std::cout << "DEBUG: before_apply[" << k << "] = " << o->serialize() << std::endl; };
+                auto dump_one = [&](const char* k){ if (const Slic3r::ConfigOption* o = config->optptr(k)) LOG_DEBUG_STREAM("before_apply[" << k << "] = " << o->serialize()); };
                 dump_one("sparse_infill_density");
                 dump_one("top_shell_layers");
             } catch (...) {}
             // Enforce project-level overrides from 3MF with highest priority just before apply
-            try { config->apply(project_cfg_after_3mf, /*ignore_nonexistent=*/true); std::cout << "DEBUG: enforced project_cfg_after_3mf onto working config before apply()" << std::endl; } catch (...) {}
+            try { config->apply(project_cfg_after_3mf, /*ignore_nonexistent=*/true); LOG_DEBUG_STREAM("enforced project_cfg_after_3mf onto working config before apply()"); } catch (...) {}
 
 
                             // Ensure selected plate index is propagated to Print & Model for GUI parity
@@ -963,27 +1726,30 @@ public:
                                 const double origin_x =  (col * stride_x);
                                 const double origin_y = -(row * stride_y);
                                 print->set_plate_origin(Slic3r::Vec3d(origin_x, origin_y, 0.0));
-                                std::cout << "DEBUG: plate_origin (from plate index, fallback, BEFORE process) => origin=(" << origin_x << "," << origin_y
+                                LOG_DEBUG_STREAM("plate_origin (from plate index, fallback, BEFORE process) => origin=(" << origin_x << "," << origin_y
                                           << ") stride=(" << stride_x << "," << stride_y << ") idx=" << idx0 << " cols=" << cols
-                                          << " total=" << total << std::endl;
+                                          << " total=" << total);
                             } else {
                                 auto po = print->get_plate_origin();
-                                std::cout << "DEBUG: plate_origin (from instances, BEFORE process) => (" << po(0) << "," << po(1) << ")" << std::endl;
+                                LOG_DEBUG_STREAM("plate_origin (from instances, BEFORE process) => (" << po(0) << "," << po(1) << ")");
                             }
                         }
                     }
                 } catch (const std::exception &e) {
-                    std::cout << "WARN: set_plate_origin (BEFORE process) failed: " << e.what() << std::endl;
+                    LOG_WARNING_STREAM("set_plate_origin (BEFORE process) failed: " << e.what());
                 }
             }
 
             // Apply model and config to print
-            try { if (const auto* o = config->optptr("sparse_infill_density")) std::cout << "DEBUG: before_apply[sparse_infill_density]=" << o->serialize() << std::endl; } catch (...) {}
-            try { if (const auto* o = config->optptr("top_shell_layers")) std::cout << "DEBUG: before_apply[top_shell_layers]=" << o->serialize() << std::endl; } catch (...) {}
+            try { if (const auto* o = config->optptr("sparse_infill_density")) LOG_DEBUG_STREAM("before_apply[sparse_infill_density]=" << o->serialize()); } catch (...) {}
+            try { if (const auto* o = config->optptr("top_shell_layers")) LOG_DEBUG_STREAM("before_apply[top_shell_layers]=" << o->serialize()); } catch (...) {}
 
-            std::cout << "DEBUG: Applying model and config to print..." << std::endl;
-            print->apply(*model, *config);
-            std::cout << "DEBUG: Apply completed successfully" << std::endl;
+            LOG_DEBUG_STREAM("Applying model and config to print...");
+            {
+                StageTimer timer(last_timings.apply_ns, "apply");
+                last_apply_status = static_cast<int>(print->apply(*model, *config));
+            }
+            LOG_DEBUG_STREAM("Apply completed successfully (status=" << last_apply_status << ")");
 
             // Re-assert plate_origin AFTER apply, BEFORE process (apply may reset internal state)
 
@@ -1026,23 +1792,44 @@ public:
                                 const double origin_x =  (col * stride_x);
                                 const double origin_y = -(row * stride_y);
                                 print->set_plate_origin(Slic3r::Vec3d(origin_x, origin_y, 0.0));
-                                std::cout << "DEBUG: plate_origin (fallback, AFTER apply) => (" << origin_x << "," << origin_y << ")" << std::endl;
+                                LOG_DEBUG_STREAM("plate_origin (fallback, AFTER apply) => (" << origin_x << "," << origin_y << ")");
                             } else {
                                 auto po = print->get_plate_origin();
-                                std::cout << "DEBUG: plate_origin (from instances, AFTER apply) => (" << po(0) << "," << po(1) << ")" << std::endl;
+                                LOG_DEBUG_STREAM("plate_origin (from instances, AFTER apply) => (" << po(0) << "," << po(1) << ")");
                             }
                         }
                     }
                 } catch (const std::exception &e) {
-                    std::cout << "WARN: set_plate_origin (AFTER apply) failed: " << e.what() << std::endl;
+                    LOG_WARNING_STREAM("set_plate_origin (AFTER apply) failed: " << e.what());
                 }
             }
 
 
             // Process the print (this does the actual slicing)
-            std::cout << "DEBUG: Starting print processing..." << std::endl;
-            print->process();
-            std::cout << "DEBUG: Print processing completed" << std::endl;
+            collect_pending_steps();
+            if (Logger::isEnabled(LogLevel::Debug)) {
+                std::string steps;
+                for (const auto& step : last_steps_run) steps += " " + step;
+                LOG_DEBUG_STREAM("Starting print processing (steps:" << steps << ")...");
+            }
+            {
+                // From here until the job ends, cancel()/deadline interrupt the Print directly
+                std::lock_guard<std::mutex> lk(job_mutex);
+                print->restart();
+                print_processing = true;
+                if (job_stop != JobStop::None) print->cancel();
+            }
+            {
+                StageTimer timer(last_timings.process_ns, "process");
+                start_step_sampling();
+                print->set_status_callback([this](const Slic3r::PrintBase::SlicingStatus&) { sample_steps(); });
+                struct StatusReset { Slic3r::Print& print; ~StatusReset() { print.set_status_callback(nullptr); } } status_reset{*print};
+                print->process();
+                sample_steps();
+            }
+            last_timings.objects = static_cast<uint32_t>(print->objects().size());
+            for (const Slic3r::PrintObject* obj : print->objects()) last_timings.layers += static_cast<uint32_t>(obj->layer_count());
+            LOG_DEBUG_STREAM("Print processing completed in " << last_timings.process_ns / 1000000 << " ms");
 
             // GUI parity: compute plate_origin from plate index and bed stride AFTER process, before export
             {
@@ -1073,14 +1860,14 @@ public:
                                 const double origin_x =  (col * stride_x);
                                 const double origin_y = -(row * stride_y);
                                 print->set_plate_origin(Slic3r::Vec3d(origin_x, origin_y, 0.0));
-                                std::cout << "DEBUG: plate_origin (from plate index, fallback) => origin=(" << origin_x << "," << origin_y
+                                LOG_DEBUG_STREAM("plate_origin (from plate index, fallback) => origin=(" << origin_x << "," << origin_y
                                           << ") stride=(" << stride_x << "," << stride_y << ") idx=" << idx0 << " cols=" << cols
-                                          << " total=" << total << std::endl;
+                                          << " total=" << total);
                             }
                         }
                     }
                 } catch (const std::exception &e) {
-                    std::cout << "WARN: set_plate_origin failed: " << e.what() << std::endl;
+                    LOG_WARNING_STREAM("set_plate_origin failed: " << e.what());
                 }
             }
 
@@ -1093,7 +1880,7 @@ public:
 
             if (export_3mf) {
                 // 3MF production export with embedded G-code (parity with GUI export_gcode_3mf)
-                std::cout << "DEBUG: Exporting 3MF (production) to: " << output_file << std::endl;
+                LOG_DEBUG_STREAM("Exporting 3MF (production) to: " << output_file);
 
                 // Prepare temp G-code path next to target: filename.stem() + ".gcode"
                 std::filesystem::path tmp_gcode = out_path;
@@ -1107,11 +1894,12 @@ public:
 
                 // Export raw G-code first
                 Slic3r::GCodeProcessorResult proc_result;
-                std::cout << "DEBUG: Exporting intermediate G-code to: " << tmp_gcode.string() << std::endl;
+                LOG_DEBUG_STREAM("Exporting intermediate G-code to: " << tmp_gcode.string());
                 try {
                     auto po = print->get_plate_origin();
-                    std::cout << "DEBUG: plate_origin at export => (" << po(0) << "," << po(1) << ")" << std::endl;
+                    LOG_DEBUG_STREAM("plate_origin at export => (" << po(0) << "," << po(1) << ")");
                     // Export using current config/model; GUI exporter derives plate-local values itself
+                    StageTimer timer(last_timings.export_gcode_ns, "export_gcode");
                     std::string gcode_path = print->export_gcode(tmp_gcode.string(), &proc_result, nullptr);
                     (void)gcode_path;
                 } catch (const std::exception &e) {
@@ -1160,11 +1948,17 @@ public:
                 sp.strategy = Slic3r::SaveStrategy::Silence | Slic3r::SaveStrategy::SplitModel | Slic3r::SaveStrategy::WithGcode | Slic3r::SaveStrategy::SkipModel | Slic3r::SaveStrategy::Zip64;
 
                 bool ok3mf = false;
-                try {
-                    ok3mf = Slic3r::store_bbs_3mf(sp);
-                } catch (const std::exception &e) {
-                    last_error = std::string("3MF packaging failed: ") + e.what();
-                    ok3mf = false;
+                {
+                    StageTimer timer(last_timings.package_ns, "package");
+                    ok3mf = store3mfParallel(sp, plate, tmp_gcode.string(), output_file);
+                    if (!ok3mf) {
+                        try {
+                            ok3mf = Slic3r::store_bbs_3mf(sp);
+                        } catch (const std::exception &e) {
+                            last_error = std::string("3MF packaging failed: ") + e.what();
+                            ok3mf = false;
+                        }
+                    }
                 }
 
                 // Clean up temp G-code
@@ -1178,8 +1972,10 @@ public:
                 // Success
                 return true;
             } else {
-                // Plain G-code export path
-                std::cout << "DEBUG: Exporting G-code to: " << output_file << std::endl;
+                // Plain G-code export path; compressed formats are encoded from a scratch export
+                const bool encoded = gcode_format != GcodeEncoder::Format::Plain;
+                const std::string gcode_file = encoded ? OutputBuffer::scratchPath(".gcode") : output_file;
+                LOG_DEBUG_STREAM("Exporting G-code to: " << gcode_file);
 
                 // Remove any existing output file
                 if (std::filesystem::exists(output_file)) {
@@ -1191,53 +1987,60 @@ public:
                 try {
 
 
-                    std::cout << "DEBUG: Attempting direct G-code export..." << std::endl;
+                    LOG_DEBUG_STREAM("Attempting direct G-code export...");
                     // Log current plate_origin that will be applied by GCode
                     {
                         auto po = print->get_plate_origin();
-                        std::cout << "DEBUG: plate_origin at export => (" << po(0) << "," << po(1) << ")" << std::endl;
+                        LOG_DEBUG_STREAM("plate_origin at export => (" << po(0) << "," << po(1) << ")");
                     }
                     Slic3r::GCodeProcessorResult proc_result; // provide valid result storage to avoid null deref in export path
-                    std::string gcode_path = print->export_gcode(output_file, &proc_result, nullptr);
-                    std::cout << "DEBUG: Direct G-code export completed successfully" << std::endl;
+                    StageTimer timer(last_timings.export_gcode_ns, "export_gcode");
+                    std::string gcode_path = print->export_gcode(gcode_file, &proc_result, nullptr);
+                    LOG_DEBUG_STREAM("Direct G-code export completed successfully");
                     export_successful = true;
                 } catch (const std::exception& e) {
-                    std::cout << "DEBUG: Direct export failed with exception: " << e.what() << std::endl;
+                    LOG_DEBUG_STREAM("Direct export failed with exception: " << e.what());
                     export_successful = false;
                 } catch (...) {
-                    std::cout << "DEBUG: Direct export failed with unknown exception" << std::endl;
+                    LOG_DEBUG_STREAM("Direct export failed with unknown exception");
                     export_successful = false;
                 }
 
                 // If export failed, do not create any fallback file
                 if (!export_successful) {
-                    std::cout << "DEBUG: G-code export failed, no fallback file will be created" << std::endl;
+                    std::error_code ec;
+                    if (encoded) std::filesystem::remove(gcode_file, ec);
+                    LOG_DEBUG_STREAM("G-code export failed, no fallback file will be created");
                     last_error = "G-code export failed";
                     return false;
                 }
 
                 // Check if export was successful
-                if (export_successful && std::filesystem::exists(output_file)) {
-                    auto file_size = std::filesystem::file_size(output_file);
-                    std::cout << "DEBUG: G-code file size: " << file_size << " bytes" << std::endl;
+                if (export_successful && std::filesystem::exists(gcode_file)) {
+                    auto file_size = std::filesystem::file_size(gcode_file);
+                    LOG_DEBUG_STREAM("G-code file size: " << file_size << " bytes");
 
                     if (file_size > 1000) {  // Expect at least 1KB for a real G-code file
-                        std::cout << "DEBUG: G-code export successful" << std::endl;
-                        return true;
+                        LOG_DEBUG_STREAM("G-code export successful");
+                        if (!encoded) return true;
+                        StageTimer timer(last_timings.package_ns, "package");
+                        return encodeGcode(gcode_file, output_file);
                     } else {
-                        std::cout << "DEBUG: G-code file too small (" << file_size << " bytes)" << std::endl;
+                        std::error_code ec;
+                        if (encoded) std::filesystem::remove(gcode_file, ec);
+                        LOG_DEBUG_STREAM("G-code file too small (" << file_size << " bytes)");
                         last_error = "G-code file too small (" + std::to_string(file_size) + " bytes)";
                         return false;
                     }
                 } else {
-                    std::cout << "DEBUG: G-code export failed" << std::endl;
+                    LOG_DEBUG_STREAM("G-code export failed");
                     last_error = "G-code export failed";
                     return false;
                 }
             }
         } catch (const std::exception& e) {
             last_error = std::string("Slicing failed: ") + e.what();
-            std::cout << "DEBUG: Exception caught: " << e.what() << std::endl;
+            LOG_DEBUG_STREAM("Exception caught: " << e.what());
             return false;
         }
 #else
@@ -1343,6 +2146,7 @@ void CliCore::shutdown() {
         try {
             // Reset preset bundle collections to release resources deterministically
             m_impl->preset_bundle.reset(false /* delete_files */);
+            m_impl->presets_changed();
             // Reset app config to default state
             m_impl->app_config.reset();
         } catch (...) {
@@ -1373,6 +2177,18 @@ CliCore::OperationResult CliCore::loadModel(const std::string& filename) {
     }
 }
 
+CliCore::OperationResult CliCore::loadModelFromMemory(const uint8_t* data, size_t size, const std::string& format, const std::string& name) {
+    if (!m_impl->initialized) {
+        return OperationResult(false, "CLI Core not initialized");
+    }
+
+    if (m_impl->loadModelFromMemory(data, size, format, name)) {
+        return OperationResult(true, "Model loaded successfully from memory (" + std::to_string(size) + " bytes)");
+    } else {
+        return OperationResult(false, "Failed to load model", m_impl->last_error);
+    }
+}
+
 CliCore::ModelInfo CliCore::getModelInfo() const {
     if (!m_impl->initialized) {
         ModelInfo info;
@@ -1385,24 +2201,82 @@ CliCore::ModelInfo CliCore::getModelInfo() const {
 }
 
 CliCore::OperationResult CliCore::slice(const SlicingParams& params) {
+    std::optional<SliceTrace::Session> trace;
+#if HAVE_LIBSLIC3R
+    std::optional<Impl::TbbTraceObserver> tbb_trace;
+#endif
+    if (!params.trace_file.empty()) {
+        trace.emplace();
+#if HAVE_LIBSLIC3R
+        tbb_trace.emplace(trace->id());
+#endif
+    }
+    auto result = runSlice(params);
+    if (trace) {
+#if HAVE_LIBSLIC3R
+        tbb_trace.reset(); // workers stop recording before the spans are read
+#endif
+        // The trace is a diagnostic: failing to write it does not fail the slice
+        std::string trace_error;
+        if (!trace->write(params.trace_file, trace_error)) {
+            LOG_DEBUG_STREAM("slice trace not written: " << trace_error);
+        }
+    }
+    ++m_impl->stat_slices;
+    if (!result.success) {
+        ++m_impl->stat_slice_failures;
+    }
+    std::error_code ec;
+    if (params.input_data) {
+        m_impl->stat_bytes_in += params.input_size;
+    } else if (!params.input_file.empty()) {
+        const auto size = std::filesystem::file_size(params.input_file, ec);
+        if (!ec) m_impl->stat_bytes_in += size;
+    }
+    if (result.success && !params.dry_run && !params.output_file.empty()) {
+        const auto size = std::filesystem::file_size(params.output_file, ec);
+        if (!ec) m_impl->stat_bytes_out += size;
+    }
+    return result;
+}
+
+CliCore::OperationResult CliCore::runSlice(const SlicingParams& params) {
     if (!m_impl->initialized) {
         return OperationResult(false, "CLI Core not initialized");
     }
+    Impl::JobScope job(*m_impl, params.job_id, params.timeout_ms);
+    m_impl->last_timings = SliceTimings{};
+    Impl::StageTimer total_timer(m_impl->last_timings.total_ns, "slice");
+    m_impl->compression_level = params.compression_level;
+    m_impl->gcode_format = GcodeEncoder::formatFor(params.output_file);
+    if (!params.output_format.empty() && !GcodeEncoder::parseFormat(params.output_format, m_impl->gcode_format)) {
+        return OperationResult(false, "Invalid output format",
+                               "Unknown output format '" + params.output_format + "' (expected gcode, gcode.gz, gcode.zst or bgcode)");
+    }
+    if (!GcodeEncoder::available(m_impl->gcode_format)) {
+        return OperationResult(false, "Invalid output format",
+                               std::string(GcodeEncoder::suffix(m_impl->gcode_format)) + " output is not available in this build");
+    }
 
-    std::cout << "DEBUG: Entering slice(): input='" << params.input_file
+    LOG_DEBUG_STREAM("Entering slice(): input='" << (params.input_data ? "<memory>" : params.input_file)
               << "' plate_index=" << params.plate_index
               << ", profiles(prn/fil/proc)=('" << params.printer_profile << "','"
-              << params.filament_profile << "','" << params.process_profile << "')"
-              << std::endl;
+              << params.filament_profile << "','" << params.process_profile << "')");
 
     // Load model if not already loaded
-    if (!params.input_file.empty()) {
+    if (params.input_data || !params.input_file.empty()) {
     #if HAVE_LIBSLIC3R
         // NOTE: Model::read_from_file -> load_bbs_3mf expects 1-based plate_id.
         // Passing 0 means "all plates". Keep 0 only if caller explicitly sets < 1.
         m_impl->plate_id = (params.plate_index >= 1 ? params.plate_index : 0);
     #endif
-        auto load_result = loadModel(params.input_file);
+        OperationResult load_result;
+        {
+            Impl::StageTimer timer(m_impl->last_timings.load_model_ns, "load_model");
+            load_result = params.input_data
+                ? loadModelFromMemory(params.input_data, params.input_size, params.input_format, params.input_file)
+                : loadModel(params.input_file);
+        }
         if (!load_result.success) {
             return load_result;
         }
@@ -1413,8 +2287,29 @@ CliCore::OperationResult CliCore::slice(const SlicingParams& params) {
     #endif
     }
 
+    const auto presets_start = std::chrono::steady_clock::now();
+    // Repeated (printer, filament, process, overrides) combinations reuse the resolved config
+    bool config_from_cache = false;
+#if HAVE_LIBSLIC3R
+    const bool config_cacheable = m_impl->is_config_cacheable(params);
+    ResolvedConfigCache::Key config_key;
+    if (config_cacheable) {
+        config_key = ResolvedConfigCache::Key{params.printer_profile, params.filament_profile, params.process_profile, params.custom_settings};
+        if (const ResolvedConfigCache::Entry* hit = m_impl->config_cache.find(config_key)) {
+            try {
+                m_impl->apply_cached_config(*hit);
+                config_from_cache = true;
+                LOG_DEBUG_STREAM("Resolved config cache hit (key=" << std::hex << ResolvedConfigCache::hash(config_key) << std::dec
+                          << ") -> printer='" << hit->printer << "', filament='" << hit->filament << "', process='" << hit->process << "'");
+            } catch (const std::exception& e) {
+                LOG_WARNING_STREAM("Failed to apply cached config, resolving presets: " << e.what());
+            }
+        }
+    }
+#endif
+
     // Load printer profile if specified
-    if (!params.printer_profile.empty()) {
+    if (!config_from_cache && !params.printer_profile.empty()) {
         auto result = loadPrinterProfile(params.printer_profile);
         if (!result.success) {
             return OperationResult(false, "Failed to load printer profile: " + params.printer_profile, result.error_details);
@@ -1422,7 +2317,7 @@ CliCore::OperationResult CliCore::slice(const SlicingParams& params) {
     }
 
     // Load filament profile if specified
-    if (!params.filament_profile.empty()) {
+    if (!config_from_cache && !params.filament_profile.empty()) {
         auto result = loadFilamentProfile(params.filament_profile);
         if (!result.success) {
             return OperationResult(false, "Failed to load filament profile: " + params.filament_profile, result.error_details);
@@ -1430,7 +2325,7 @@ CliCore::OperationResult CliCore::slice(const SlicingParams& params) {
     }
 
     // Load process profile if specified
-    if (!params.process_profile.empty()) {
+    if (!config_from_cache && !params.process_profile.empty()) {
         auto result = loadProcessProfile(params.process_profile);
         if (!result.success) {
             return OperationResult(false, "Failed to load process profile: " + params.process_profile, result.error_details);
@@ -1441,9 +2336,7 @@ CliCore::OperationResult CliCore::slice(const SlicingParams& params) {
     // Auto-apply project presets from 3MF. We always parse 3MF to capture project hints;
     // if user provided explicit profiles, we will not override them during selection.
     {
-        std::filesystem::path _p(params.input_file);
-        std::string _ext = _p.extension().string();
-        std::transform(_ext.begin(), _ext.end(), _ext.begin(), [](unsigned char c){ return static_cast<char>(std::tolower(c)); });
+        const std::string _ext = m_impl->job_input_extension(params);
         if (_ext == ".3mf") {
             try {
                 // Prefer exact names captured from project presets over config IDs (more reliable)
@@ -1505,11 +2398,11 @@ CliCore::OperationResult CliCore::slice(const SlicingParams& params) {
                         }
                         m_impl->preset_bundle.update_compatible(Slic3r::PresetSelectCompatibleType::Always);
                         *m_impl->config = m_impl->preset_bundle.full_config_secure();
-                        std::cout << "DEBUG: Strict 3MF preset names applied -> printer='"
+                        LOG_DEBUG_STREAM("Strict 3MF preset names applied -> printer='"
                                   << m_impl->preset_bundle.printers.get_selected_preset_name()
                                   << "', process='" << m_impl->preset_bundle.prints.get_selected_preset_name()
                                   << "', filament='" << (m_impl->preset_bundle.filament_presets.empty()?std::string():m_impl->preset_bundle.filament_presets.front())
-                                  << "'" << std::endl;
+                                  << "'");
                         // Neuter any remaining heuristic paths by clearing hint sources and names
                         m_impl->plate_printer_model_id.clear();
                         m_impl->plate_nozzle_variant.clear();
@@ -1538,27 +2431,25 @@ CliCore::OperationResult CliCore::slice(const SlicingParams& params) {
 
 
                 std::string derived_printer;
-                if ((_printer.empty() || _printer == "Default Printer") && !cfg_model.empty() && !cfg_variant.empty()) {
-                    // e.g. "Bambu Lab A1" + "0.4" -> "Bambu Lab A1 0.4 nozzle"
-                    derived_printer = cfg_model + " " + cfg_variant + " nozzle";
-                    std::cout << "DEBUG: Derived printer from project config: '" << derived_printer << "'" << std::endl;
-                }
-
-                // Ensure BBL vendor and the exact (model, variant) are enabled so the preset becomes visible for selection
                 if (!cfg_model.empty() && !cfg_variant.empty()) {
-                    try {
-                        m_impl->app_config.set_variant("BBL", cfg_model, cfg_variant, true);
-                        m_impl->preset_bundle.load_installed_printers(m_impl->app_config);
-                        std::cout << "DEBUG: Enabled variant in AppConfig and reloaded installed printers for model='"
-                                  << cfg_model << "' variant='" << cfg_variant << "'" << std::endl;
-                    } catch (...) {
-                        std::cout << "WARN: Failed to enable model/variant in AppConfig (continuing)" << std::endl;
+                    // (model, variant) from the project config, e.g. ("Bambu Lab A1", "0.4"): one index lookup
+                    if (const Slic3r::Preset *derived = m_impl->presetIndex().findPrinterByModel(m_impl->preset_bundle, cfg_model, cfg_variant)) {
+                        if (_printer.empty() || _printer == "Default Printer") {
+                            derived_printer = derived->name;
+                            LOG_DEBUG_STREAM("Derived printer from project config: '" << derived_printer << "'");
+                        }
+                        // Make the (model, variant) visible for selection; a no-op once it is enabled
+                        try {
+                            m_impl->enable_printer_variant(*derived);
+                        } catch (...) {
+                            LOG_WARNING_STREAM("Failed to enable model/variant in AppConfig (continuing)");
+                        }
                     }
                 }
 
-                std::cout << "DEBUG: 3MF auto-apply candidates -> printer='" << (_printer.empty() ? derived_printer : _printer)
+                LOG_DEBUG_STREAM("3MF auto-apply candidates -> printer='" << (_printer.empty() ? derived_printer : _printer)
                           << "', process='" << _process
-                          << "', filament='" << _filament << "'" << std::endl;
+                          << "', filament='" << _filament << "'");
 
                 // When the 3MF embeds presets, prefer those and do NOT reselect from system by name.
                 const bool project_has_embedded = m_impl->has_project_embedded_presets;
@@ -1568,13 +2459,15 @@ CliCore::OperationResult CliCore::slice(const SlicingParams& params) {
                 if (!project_has_embedded && !user_prn) {
                     // Try plate-derived hints first (from BBL 3MF metadata)
                     if (selected_printer_name.empty() && !m_impl->plate_printer_model_id.empty() && !m_impl->plate_nozzle_variant.empty()) {
-                        const Slic3r::Preset *sys = m_impl->preset_bundle.printers.find_system_preset_by_model_and_variant(m_impl->plate_printer_model_id, m_impl->plate_nozzle_variant);
+                        const Slic3r::Preset *sys = m_impl->presetIndex().findPrinterByModel(m_impl->preset_bundle, m_impl->plate_printer_model_id, m_impl->plate_nozzle_variant);
+                        if (sys == nullptr)
+                            sys = m_impl->preset_bundle.printers.find_system_preset_by_model_and_variant(m_impl->plate_printer_model_id, m_impl->plate_nozzle_variant);
                         if (sys != nullptr) {
                             if (m_impl->preset_bundle.printers.select_preset_by_name(sys->name, /*force=*/true)) {
                                 selected_printer_name = sys->name;
                                 m_impl->preset_bundle.update_compatible(Slic3r::PresetSelectCompatibleType::Always);
                                 *m_impl->config = m_impl->preset_bundle.full_config_secure();
-                                std::cout << "DEBUG: Selected printer from plate hints: '" << selected_printer_name << "'" << std::endl;
+                                LOG_DEBUG_STREAM("Selected printer from plate hints: '" << selected_printer_name << "'");
                             }
                         }
                     }
@@ -1614,26 +2507,21 @@ CliCore::OperationResult CliCore::slice(const SlicingParams& params) {
                             }
                         }
                     }
-                    // Fallback: scan printers for matching model when variant is unknown
+                    // Fallback: any printer of the model when the variant is unknown
                     if (selected_printer_name.empty() && !cfg_model.empty() && cfg_variant.empty()) {
-                        for (const auto &p : m_impl->preset_bundle.printers) {
-                            try {
-                                std::string m = p.config.has("printer_model") ? p.config.opt_string("printer_model") : std::string();
-                                if (m == cfg_model) {
-                                    if (m_impl->preset_bundle.printers.select_preset_by_name(p.name, /*force=*/true)) {
-                                        selected_printer_name = p.name;
-                                        m_impl->preset_bundle.update_compatible(Slic3r::PresetSelectCompatibleType::Always);
-                                        *m_impl->config = m_impl->preset_bundle.full_config_secure();
-                                        // Enable visibility for this specific preset
-                                        std::string v = p.config.has("printer_variant") ? p.config.opt_string("printer_variant") : std::string();
-                                        if (!v.empty()) {
-                                            try { m_impl->app_config.set_variant("BBL", m, v, true); m_impl->preset_bundle.load_installed_printers(m_impl->app_config); } catch (...) {}
-                                        }
-                                        break;
-                                    }
+                        try {
+                            if (const Slic3r::Preset *p = m_impl->presetIndex().findPrinterByModel(m_impl->preset_bundle, cfg_model, std::string())) {
+                                const std::string name = p->name;
+                                if (m_impl->preset_bundle.printers.select_preset_by_name(name, /*force=*/true)) {
+                                    selected_printer_name = name;
+                                    m_impl->preset_bundle.update_compatible(Slic3r::PresetSelectCompatibleType::Always);
+                                    *m_impl->config = m_impl->preset_bundle.full_config_secure();
+                                    // Enable visibility for this specific preset
+                                    if (const Slic3r::Preset *sel = m_impl->preset_bundle.printers.find_preset(name, false, false, false))
+                                        m_impl->enable_printer_variant(*sel);
                                 }
-                            } catch (...) {}
-                        }
+                            }
+                        } catch (...) {}
                     }
                 }
 
@@ -1759,11 +2647,11 @@ CliCore::OperationResult CliCore::slice(const SlicingParams& params) {
                     }
                 }
 
-                std::cout << "DEBUG: After applying 3MF presets -> selected printer='"
+                LOG_DEBUG_STREAM("After applying 3MF presets -> selected printer='"
                           << m_impl->preset_bundle.printers.get_selected_preset_name()
                           << "', print='" << m_impl->preset_bundle.prints.get_selected_preset_name()
                           << "', filament='" << m_impl->preset_bundle.filaments.get_selected_preset_name()
-                          << "'" << std::endl;
+                          << "'");
 
                 // Final guard: if still on Default Printer and project presets exist, select them
                 {
@@ -1773,47 +2661,49 @@ CliCore::OperationResult CliCore::slice(const SlicingParams& params) {
                         if (rr.success) {
                             m_impl->preset_bundle.update_compatible(Slic3r::PresetSelectCompatibleType::Always);
                             *m_impl->config = m_impl->preset_bundle.full_config_secure();
-                            std::cout << "DEBUG: Final-guard selected printer from project preset: '"
-                                      << m_impl->project_printer_preset << "'" << std::endl;
+                            LOG_DEBUG_STREAM("Final-guard selected printer from project preset: '"
+                                      << m_impl->project_printer_preset << "'");
                         }
                     }
                     // Ensure project print and filament presets are selected if provided by 3MF
                     if (!m_impl->project_print_preset.empty()) {
                         if (m_impl->preset_bundle.prints.select_preset_by_name(m_impl->project_print_preset, /*force=*/true)) {
-                            std::cout << "DEBUG: Final-guard selected process from project preset: '"
-                                      << m_impl->project_print_preset << "'" << std::endl;
+                            LOG_DEBUG_STREAM("Final-guard selected process from project preset: '"
+                                      << m_impl->project_print_preset << "'");
                         }
                     }
                     if (!m_impl->project_filament_preset.empty()) {
                         if (m_impl->preset_bundle.filaments.select_preset_by_name(m_impl->project_filament_preset, /*force=*/true)) {
-                            std::cout << "DEBUG: Final-guard selected filament from project preset: '"
-                                      << m_impl->project_filament_preset << "'" << std::endl;
+                            LOG_DEBUG_STREAM("Final-guard selected filament from project preset: '"
+                                      << m_impl->project_filament_preset << "'");
                         }
                     }
                     m_impl->preset_bundle.update_compatible(Slic3r::PresetSelectCompatibleType::Always);
                     *m_impl->config = m_impl->preset_bundle.full_config_secure();
                 }
             } catch (const std::exception &e) {
-                std::cout << "WARN: Failed to apply project presets from 3MF: " << e.what() << std::endl;
+                LOG_WARNING_STREAM("Failed to apply project presets from 3MF: " << e.what());
             }
         }
     }
 #endif
 
 #if HAVE_LIBSLIC3R
-    try {
-        m_impl->preset_bundle.update_compatible(Slic3r::PresetSelectCompatibleType::Always);
-        *m_impl->config = m_impl->preset_bundle.full_config_secure();
-        std::cout << "DEBUG: Synchronized working config with selected presets -> printer='"
-                  << m_impl->preset_bundle.printers.get_selected_preset_name()
-                  << "', print='" << m_impl->preset_bundle.prints.get_selected_preset_name()
-                  << "', filament='" << m_impl->preset_bundle.filaments.get_selected_preset_name()
-                  << "'" << std::endl;
-        // Dump key values after syncing working config with selected presets
-        try { if (const auto* o = m_impl->config->optptr("sparse_infill_density")) std::cout << "DEBUG: synced_config[sparse_infill_density]=" << o->serialize() << std::endl; } catch (...) {}
-        try { if (const auto* o = m_impl->config->optptr("top_shell_layers")) std::cout << "DEBUG: synced_config[top_shell_layers]=" << o->serialize() << std::endl; } catch (...) {}
-    } catch (const std::exception &e) {
-        std::cout << "WARN: Failed to refresh working config from selected presets: " << e.what() << std::endl;
+    if (!config_from_cache) {
+        try {
+            m_impl->preset_bundle.update_compatible(Slic3r::PresetSelectCompatibleType::Always);
+            *m_impl->config = m_impl->preset_bundle.full_config_secure();
+            LOG_DEBUG_STREAM("Synchronized working config with selected presets -> printer='"
+                      << m_impl->preset_bundle.printers.get_selected_preset_name()
+                      << "', print='" << m_impl->preset_bundle.prints.get_selected_preset_name()
+                      << "', filament='" << m_impl->preset_bundle.filaments.get_selected_preset_name()
+                      << "'");
+            // Dump key values after syncing working config with selected presets
+            try { if (const auto* o = m_impl->config->optptr("sparse_infill_density")) LOG_DEBUG_STREAM("synced_config[sparse_infill_density]=" << o->serialize()); } catch (...) {}
+            try { if (const auto* o = m_impl->config->optptr("top_shell_layers")) LOG_DEBUG_STREAM("synced_config[top_shell_layers]=" << o->serialize()); } catch (...) {}
+        } catch (const std::exception &e) {
+            LOG_WARNING_STREAM("Failed to refresh working config from selected presets: " << e.what());
+        }
     }
 #endif
 
@@ -1822,13 +2712,13 @@ CliCore::OperationResult CliCore::slice(const SlicingParams& params) {
     try {
         if (!m_impl->print_overrides_keys.empty()) {
             m_impl->config->apply_only(m_impl->print_cfg_overrides, m_impl->print_overrides_keys, /*ignore_nonexistent=*/true);
-            std::cout << "DEBUG: Re-applied " << m_impl->print_overrides_keys.size() << " 3MF print override(s) on top of selected profiles" << std::endl;
+            LOG_DEBUG_STREAM("Re-applied " << m_impl->print_overrides_keys.size() << " 3MF print override(s) on top of selected profiles");
             // Dump key values after re-apply
-            if (const auto* o = m_impl->config->optptr("sparse_infill_density")) std::cout << "DEBUG: synced_after_overrides[sparse_infill_density]=" << o->serialize() << std::endl;
-            if (const auto* o2 = m_impl->config->optptr("top_shell_layers")) std::cout << "DEBUG: synced_after_overrides[top_shell_layers]=" << o2->serialize() << std::endl;
+            if (const auto* o = m_impl->config->optptr("sparse_infill_density")) LOG_DEBUG_STREAM("synced_after_overrides[sparse_infill_density]=" << o->serialize());
+            if (const auto* o2 = m_impl->config->optptr("top_shell_layers")) LOG_DEBUG_STREAM("synced_after_overrides[top_shell_layers]=" << o2->serialize());
         }
     } catch (const std::exception &e) {
-        std::cout << "WARN: Failed to re-apply 3MF print overrides: " << e.what() << std::endl;
+        LOG_WARNING_STREAM("Failed to re-apply 3MF print overrides: " << e.what());
     }
 #endif
 
@@ -1850,13 +2740,13 @@ CliCore::OperationResult CliCore::slice(const SlicingParams& params) {
 
     // Apply custom settings (these override profile settings)
     // Handle bed temperature aliases correctly for current bed type.
-    if (!params.custom_settings.empty()) {
+    if (!config_from_cache && !params.custom_settings.empty()) {
         // 1) Apply curr_bed_type first if provided, so alias resolution uses the right type.
         auto it_bed = params.custom_settings.find("curr_bed_type");
         if (it_bed != params.custom_settings.end()) {
             auto r = setConfigOption(it_bed->first, it_bed->second);
             if (!r.success) {
-                std::cout << "DEBUG: Ignoring invalid override key/value: " << it_bed->first << " (" << r.error_details << ")" << std::endl;
+                LOG_DEBUG_STREAM("Ignoring invalid override key/value: " << it_bed->first << " (" << r.error_details << ")");
             }
         }
         // 2) Apply the rest, resolving known aliases.
@@ -1875,12 +2765,12 @@ CliCore::OperationResult CliCore::slice(const SlicingParams& params) {
                 Slic3r::BedType bed_type = static_cast<Slic3r::BedType>(bed_type_int);
                 std::string actual_key = bed_temp_key_for(bed_type, key == "first_layer_bed_temperature");
                 if (actual_key.empty()) {
-                    std::cout << "DEBUG: Ignoring alias override '" << key << "' for current bed type (no mapping available)" << std::endl;
+                    LOG_DEBUG_STREAM("Ignoring alias override '" << key << "' for current bed type (no mapping available)");
                     continue;
                 }
                 auto rr = setConfigOption(actual_key, val);
                 if (!rr.success) {
-                    std::cout << "DEBUG: Ignoring invalid alias override: " << actual_key << " (" << rr.error_details << ")" << std::endl;
+                    LOG_DEBUG_STREAM("Ignoring invalid alias override: " << actual_key << " (" << rr.error_details << ")");
                 }
                 continue;
             }
@@ -1917,17 +2807,32 @@ CliCore::OperationResult CliCore::slice(const SlicingParams& params) {
 
         #if HAVE_LIBSLIC3R
             if (m_impl->config && !m_impl->config->has(mapped_key)) {
-                std::cout << "DEBUG: Ignoring unknown override key: " << mapped_key << std::endl;
+                LOG_DEBUG_STREAM("Ignoring unknown override key: " << mapped_key);
                 continue;
             }
         #endif
             auto result = setConfigOption(mapped_key, mapped_val);
             if (!result.success) {
-                std::cout << "DEBUG: Ignoring invalid override key/value: " << mapped_key << " (" << result.error_details << ")" << std::endl;
+                LOG_DEBUG_STREAM("Ignoring invalid override key/value: " << mapped_key << " (" << result.error_details << ")");
             }
         }
     }
 
+#if HAVE_LIBSLIC3R
+    if (config_cacheable && !config_from_cache) {
+        try {
+            ResolvedConfigCache::Entry entry;
+            entry.printer  = m_impl->preset_bundle.printers.get_selected_preset_name();
+            entry.filament = m_impl->preset_bundle.filaments.get_selected_preset_name();
+            entry.process  = m_impl->preset_bundle.prints.get_selected_preset_name();
+            entry.config   = std::make_shared<const Slic3r::DynamicPrintConfig>(*m_impl->config);
+            m_impl->config_cache.put(config_key, std::move(entry));
+        } catch (...) { /* caching is best effort */ }
+    }
+#endif
+
+    m_impl->last_timings.presets_ns = Impl::ns_since(presets_start);
+    SliceTrace::record("presets", "stage", presets_start, std::chrono::steady_clock::now(), config_from_cache ? "resolved config from cache" : "");
     if (params.dry_run) {
         return OperationResult(true, "Dry run completed - no actual slicing performed");
     }
@@ -1937,9 +2842,9 @@ CliCore::OperationResult CliCore::slice(const SlicingParams& params) {
     if (!m_impl->project_overrides_keys.empty()) {
         try {
             m_impl->config->apply_only(m_impl->project_cfg_after_3mf, m_impl->project_overrides_keys, /*ignore_nonexistent=*/true);
-            std::cout << "DEBUG: Re-applied " << m_impl->project_overrides_keys.size() << " 3MF project override(s) on top of selected profiles" << std::endl;
+            LOG_DEBUG_STREAM("Re-applied " << m_impl->project_overrides_keys.size() << " 3MF project override(s) on top of selected profiles");
         } catch (const std::exception &e) {
-            std::cout << "WARN: Failed to re-apply 3MF overrides: " << e.what() << std::endl;
+            LOG_WARNING_STREAM("Failed to re-apply 3MF overrides: " << e.what());
         }
     }
 
@@ -1948,13 +2853,102 @@ CliCore::OperationResult CliCore::slice(const SlicingParams& params) {
 
 #endif
 
-    if (m_impl->performSlicing(params.output_file)) {
+    if (const auto stop = m_impl->job_stop_reason(); stop != Impl::JobStop::None) {
+        return Impl::stopped_result(stop);
+    }
+
+    // Identical jobs (same model bytes, plate, resolved config and engine version) are served from the
+    // on-disk result cache; a concurrent identical job waits for the one already slicing.
+    std::string result_key;
+    const std::string result_suffix = Impl::output_suffix(params);
+#if HAVE_LIBSLIC3R
+    if (m_impl->result_cache.enabled() && (params.input_data || !params.input_file.empty()) && !params.output_file.empty()) {
+        // The compression level changes the output bytes, so it is part of the key (not of the entry's file name)
+        std::string key_suffix = params.compression_level >= 0 ? result_suffix + "@" + std::to_string(params.compression_level) : result_suffix;
+        // MeshReader (buffers, and files with ORCACLI_MESH_READER=1) may build a different mesh than libslic3r's loaders;
+        // keep its results apart
+        if ((params.input_data || Impl::mesh_reader_files()) && Impl::input_extension(params) != ".3mf") key_suffix += "@meshreader";
+        result_key = params.input_data
+            ? SliceResultCache::computeKey(params.input_data, params.input_size, m_impl->plate_id, m_impl->config_fingerprint(), getVersion(), key_suffix, Impl::input_name(params))
+            : SliceResultCache::computeKey(params.input_file, m_impl->plate_id, m_impl->config_fingerprint(), getVersion(), key_suffix, Impl::input_name(params));
+        // cancel() and the deadline watchdog set job_stop; a job waiting on another engine's claim gives up on either
+        const auto stopped = [this] { return m_impl->job_stop_reason() != Impl::JobStop::None; };
+        switch (m_impl->result_cache.acquire(result_key, result_suffix, params.output_file, stopped)) {
+            case SliceResultCache::Lookup::Hit:
+                m_impl->last_timings.cached = true;
+                return OperationResult(true, "Slicing completed successfully (cached): " + params.output_file);
+            case SliceResultCache::Lookup::Stopped:
+                return Impl::stopped_result(m_impl->job_stop_reason());
+            case SliceResultCache::Lookup::Claimed:
+                break;
+            case SliceResultCache::Lookup::Bypass:
+                result_key.clear();
+                break;
+        }
+    }
+#endif
+
+    const bool sliced = m_impl->performSlicing(params.output_file);
+    if (!result_key.empty()) {
+        if (sliced) m_impl->result_cache.publish(result_key, result_suffix, params.output_file);
+        else m_impl->result_cache.release(result_key);
+    }
+    if (sliced) {
         return OperationResult(true, "Slicing completed successfully: " + params.output_file);
+    } else if (const auto stop = m_impl->job_stop_reason(); stop != Impl::JobStop::None) {
+        return Impl::stopped_result(stop);
     } else {
         return OperationResult(false, "Slicing failed", m_impl->last_error);
     }
 }
 
+CliCore::OperationResult CliCore::sliceToBuffer(const SlicingParams& params, std::unique_ptr<OutputBuffer>& out) {
+    out.reset();
+    if (params.dry_run) return slice(params);
+    SlicingParams p = params;
+    std::string suffix = Impl::output_suffix(params);
+    if (suffix == ".3mf") suffix = ".gcode.3mf";
+    p.output_file = OutputBuffer::scratchPath(suffix);
+    auto result = slice(p);
+    std::string error;
+    if (result.success) out = OutputBuffer::adopt(p.output_file, error);
+    if (!out) {
+        std::error_code ec;
+        std::filesystem::remove(p.output_file, ec);
+        if (result.success) return OperationResult(false, "Slicing failed", error);
+        return result;
+    }
+    LOG_DEBUG_STREAM("sliceToBuffer: " << out->size() << " bytes from " << p.output_file);
+    return OperationResult(true, "Slicing completed successfully (" + std::to_string(out->size()) + " bytes in memory)");
+}
+
+CliCore::OperationResult CliCore::sliceToStream(const SlicingParams& params, const std::function<bool(const uint8_t*, size_t)>& sink) {
+    // libslic3r writes G-code to "<path>.tmp" and post-processes it (time estimates, M73) before the rename, so
+    // bytes are only final once export_gcode returns: stream the finished output from the scratch mapping.
+    std::unique_ptr<OutputBuffer> out;
+    auto result = sliceToBuffer(params, out);
+    if (!result.success || !out) return result;
+    const uint8_t* data = out->data();
+    const size_t size = out->size();
+    for (size_t offset = 0; offset < size; offset += kStreamChunkSize) {
+        if (!sink(data + offset, std::min(kStreamChunkSize, size - offset))) {
+            LOG_DEBUG_STREAM("sliceToStream: consumer stopped at " << offset << "/" << size << " bytes");
+            return OperationResult(false, "Slicing canceled", "output stream closed by the consumer");
+        }
+    }
+    return OperationResult(true, "Slicing completed successfully (" + std::to_string(size) + " bytes streamed)");
+}
+
+void CliCore::cancel(uint64_t job_id) {
+    std::lock_guard<std::mutex> lk(m_impl->job_mutex);
+    if (m_impl->job_running && (job_id == 0 || job_id == m_impl->job_id)) {
+        LOG_DEBUG_STREAM("CliCore::cancel job " << m_impl->job_id);
+        m_impl->stop_job_locked(Impl::JobStop::Canceled);
+    } else if (job_id != 0) {
+        m_impl->pending_cancel_id = job_id; // the job has not reached slice() yet
+    }
+}
+
 std::string CliCore::getVersion() {
 #if HAVE_LIBSLIC3R
     return "OrcaSlicerCli 1.0.0 (based on OrcaSlicer " + std::string(SLIC3R_VERSION) + ")";
@@ -1989,192 +2983,52 @@ CliCore::OperationResult CliCore::loadPreset(const std::string& preset_name) {
 }
 
 CliCore::OperationResult CliCore::loadPrinterProfile(const std::string& printer_name) {
+    SliceTrace::Scope span("loadPrinterProfile", "presets", printer_name);
     if (!m_impl->initialized) {
         return OperationResult(false, "CLI Core not initialized");
     }
 
 #if HAVE_LIBSLIC3R
     try {
-        // Proactively enable BBL (model, variant) visibility in AppConfig when the printer name follows
-        // the common pattern "<Model Name> <diameter> nozzle". This materializes the system preset.
-        {
-            const std::string suffix = " nozzle";
-            if (printer_name.size() > suffix.size() && printer_name.rfind(suffix) == printer_name.size() - suffix.size()) {
-                std::string tmp = printer_name.substr(0, printer_name.size() - suffix.size());
-                // Extract last token as variant if it looks numeric (e.g., "0.4")
-                auto sp = tmp.find_last_of(' ');
-                if (sp != std::string::npos) {
-                    std::string maybe_variant = tmp.substr(sp + 1);
-                    auto is_numeric = [](const std::string &s){ return !s.empty() && (std::isdigit((unsigned char)s[0]) || s[0] == '.'); };
-                    if (is_numeric(maybe_variant)) {
-                        std::string model_name = tmp.substr(0, sp);
-                        try {
-                            m_impl->app_config.set_variant("BBL", model_name, maybe_variant, true);
-                            m_impl->preset_bundle.load_installed_printers(m_impl->app_config);
-                        } catch (...) { /* non-fatal */ }
-                    }
-                }
-            }
-        }
-
-        // Find the preset regardless of its current visibility
-        auto *preset = m_impl->preset_bundle.printers.find_preset(printer_name, /*first_visible_if_not_found=*/false, /*real=*/true, /*only_from_library=*/false);
-        if (preset == nullptr) {
-            // Attempt a compatibility fallback: many G-code headers encode printer as "<model> <nozzle> nozzle",
-            // while installed presets may be named just by model (e.g., "Bambu Lab X1 Carbon").
-            std::string base_try;
-            {
-                const std::string &s = printer_name;
-                const std::string suffix = " nozzle";
-                auto pos = s.rfind(suffix);
-                if (pos != std::string::npos) {
-                    // Drop the " nozzle" suffix
-                    std::string tmp = s.substr(0, pos);
-                    // If the remaining ends with a diameter token like " 0.4" or " 0.2", strip that token as well
-                    auto sp = tmp.find_last_of(' ');
-                    if (sp != std::string::npos) {
-                        std::string last = tmp.substr(sp + 1);
-                        bool looks_diameter = !last.empty() && (std::isdigit(last[0]) || last[0] == '.');
-                        if (looks_diameter) {
-                            base_try = tmp.substr(0, sp);
-                        }
-                    }
-                }
-            }
-
-            if (!base_try.empty()) {
-                std::cout << "DEBUG: Printer preset not found by name: '" << printer_name
-                          << "'. Trying base model fallback: '" << base_try << "'" << std::endl;
-                preset = m_impl->preset_bundle.printers.find_preset(base_try, /*first_visible_if_not_found=*/false, /*real=*/true, /*only_from_library=*/false);
-                if (preset) {
-                    // Use the base model name
-                    std::cout << "DEBUG: Fallback matched base printer preset: '" << base_try << "'" << std::endl;
-                }
-            }
-
-            // If still not found, try enabling the BBL model/variant in AppConfig to materialize system presets, then retry
-            if (!preset) {
-                try {
-                    // Extract nozzle variant (e.g., "0.4") from the original name if present
-                    std::string variant;
-                    {
-                        const std::string &s = printer_name;
-                        const std::string suffix = " nozzle";
-                        auto pos = s.rfind(suffix);
-                        if (pos != std::string::npos) {
-                            std::string tmp = s.substr(0, pos);
-                            auto sp = tmp.find_last_of(' ');
-                            if (sp != std::string::npos) {
-                                std::string last = tmp.substr(sp + 1);
-                                bool looks = !last.empty() && (std::isdigit(last[0]) || last[0] == '.');
-                                if (looks) variant = last;
-                            }
-                        }
-                    }
-                    if (!base_try.empty() && !variant.empty()) {
-                        std::cout << "DEBUG: Enabling AppConfig vendor variant: vendor=BBL, model='" << base_try << "', variant='" << variant << "'" << std::endl;
-                        m_impl->app_config.set_variant("BBL", base_try, variant, true);
-                        m_impl->preset_bundle.load_installed_printers(m_impl->app_config);
-                        // Retry lookup by full name first, then base model
-                        preset = m_impl->preset_bundle.printers.find_preset(printer_name, /*first_visible_if_not_found=*/false, /*real=*/true, /*only_from_library=*/false);
-                        if (!preset)
-                            preset = m_impl->preset_bundle.printers.find_preset(base_try, /*first_visible_if_not_found=*/false, /*real=*/true, /*only_from_library=*/false);
-                        // As a final attempt, resolve BBL model_id from resources by matching machine name, then match by (model_id, variant)
-                        if (!preset) {
-                            try {
-                                namespace fs = std::filesystem;
-                                std::string model_id;
-                                fs::path machines_dir = fs::path(m_impl->resources_path) / "profiles" / "BBL" / "machine";
-                                if (fs::exists(machines_dir) && fs::is_directory(machines_dir)) {
-                                    for (const auto &entry : fs::directory_iterator(machines_dir)) {
-                                        if (!entry.is_regular_file()) continue;
-                                        if (entry.path().extension() != ".json") continue;
-                                        try {
-                                            std::ifstream ifs(entry.path());
-                                            nlohmann::json j; ifs >> j;
-                                            if (j.contains("name") && j["name"].is_string() && j["name"].get<std::string>() == base_try) {
-                                                if (j.contains("model_id") && j["model_id"].is_string()) {
-                                                    model_id = j["model_id"].get<std::string>();
-                                                    break;
-                                                }
-                                            }
-                                        } catch (...) { /* ignore malformed json */ }
-                                    }
-                                }
-                                if (!model_id.empty()) {
-                                    // Enable the exact (vendor_id, model_id, variant) in AppConfig to materialize visibility, then refresh installed printers.
-                                    try {
-                                        m_impl->app_config.set_variant("BBL", model_id, variant, true);
-                                        m_impl->preset_bundle.load_installed_printers(m_impl->app_config);
-                                    } catch (...) { /* ignore */ }
-                                    if (const Slic3r::Preset* sys = m_impl->preset_bundle.printers.find_system_preset_by_model_and_variant(model_id, variant)) {
-                                        std::cout << "DEBUG: Matched system preset by model_id+variant: model_id='" << model_id << "', variant='" << variant << "' -> name='" << sys->name << "'" << std::endl;
-                                        preset = const_cast<Slic3r::Preset*>(sys);
-                                    }
-                                }
-                                // As a robust fallback, scan visible printers for matching (printer_model, printer_variant)
-                                if (!preset) {
-                                    for (const auto &p : m_impl->preset_bundle.printers) {
-                                        try {
-                                            std::string m = p.config.has("printer_model")   ? p.config.opt_string("printer_model")   : std::string();
-                                            std::string v = p.config.has("printer_variant") ? p.config.opt_string("printer_variant") : std::string();
-                                            if (m == base_try && (v == variant || v == (variant + ".0"))) {
-                                                std::cout << "DEBUG: Found matching preset by (printer_model,printer_variant): '" << p.name << "'" << std::endl;
-                                                preset = const_cast<Slic3r::Preset*>(&p);
-                                                break;
-                                            }
-                                        } catch (...) {}
-                                    }
-                                }
-                            } catch (...) { /* ignore */ }
-                        }
-                    }
-                } catch (...) {
-                    // ignore
-                }
-            }
-
-            if (!preset) {
-                std::cout << "DEBUG: Printer preset not found by name: '" << printer_name << "'. Available examples:" << std::endl;
+        // Single hash lookup over names, aliases, "<model> <diameter> nozzle" and (model, variant)
+        const Slic3r::Preset* preset = m_impl->presetIndex().findPrinter(m_impl->preset_bundle, printer_name);
+        if (!preset) {
+            if (Logger::isEnabled(LogLevel::Debug)) {
+                std::string examples;
                 size_t count = 0;
                 for (const auto &p : m_impl->preset_bundle.printers) {
                     if (count++ >= 10) break;
-                    std::cout << "  - " << p.name << (p.is_visible ? "" : " (hidden)") << std::endl;
+                    examples += "\n  - " + p.name + (p.is_visible ? "" : " (hidden)");
                 }
-                return OperationResult(false, "Printer profile not found", printer_name);
+                LOG_DEBUG_STREAM("Printer preset not found by name: '" << printer_name << "'. Available examples:" << examples);
             }
+            return OperationResult(false, "Printer profile not found", printer_name);
         }
+        if (preset->name != printer_name) {
+            LOG_DEBUG_STREAM("Printer '" << printer_name << "' resolved via index to preset '" << preset->name << "'");
+        }
+        // Copy the name: enabling a variant re-materializes the bundle and may move presets
+        const std::string resolved_name = preset->name;
 
         // Ensure this model/variant is enabled in AppConfig so the preset becomes visible
         try {
-            std::string vendor_id = preset->vendor ? preset->vendor->id : std::string();
-            std::string model     = preset->config.has("printer_model")   ? preset->config.opt_string("printer_model")   : std::string();
-            std::string variant   = preset->config.has("printer_variant") ? preset->config.opt_string("printer_variant") : std::string();
-            if (vendor_id.empty()) vendor_id = "BBL"; // default to BBL vendor when unspecified
-            if (!vendor_id.empty() && !model.empty() && !variant.empty()) {
-                std::cout << "DEBUG: Enabling vendor/model/variant: vendor_id=" << vendor_id
-                          << ", model=" << model << ", variant=" << variant << std::endl;
-                m_impl->app_config.set_variant(vendor_id, model, variant, true);
-                m_impl->preset_bundle.load_installed_printers(m_impl->app_config);
-            }
+            m_impl->enable_printer_variant(*preset);
         } catch (...) {
             // Don't fail due to visibility refresh errors
         }
 
         // Now select the printer preset. Prefer the resolved preset->name if it differs from the incoming string.
-        std::string to_select = printer_name;
-        if (preset != nullptr && !preset->name.empty() && preset->name != printer_name)
-            to_select = preset->name;
+        const std::string& to_select = resolved_name;
         if (!m_impl->preset_bundle.printers.select_preset_by_name(to_select, /*force=*/true)) {
-            std::cout << "DEBUG: Failed to select printer preset by name: '" << to_select << "'. Current selected: '"
-                      << m_impl->preset_bundle.printers.get_selected_preset_name() << "'" << std::endl;
+            LOG_DEBUG_STREAM("Failed to select printer preset by name: '" << to_select << "'. Current selected: '"
+                      << m_impl->preset_bundle.printers.get_selected_preset_name() << "'");
             return OperationResult(false, "Failed to select printer preset", to_select);
         }
         // Update compatibility of other presets with the selected printer
         m_impl->preset_bundle.update_compatible(Slic3r::PresetSelectCompatibleType::Always);
         // Update working config from full resolved config
         *m_impl->config = m_impl->preset_bundle.full_config_secure();
-        std::cout << "DEBUG: Loaded printer profile (via PresetBundle): " << printer_name << std::endl;
+        LOG_DEBUG_STREAM("Loaded printer profile (via PresetBundle): " << printer_name);
         return OperationResult(true, "Printer profile loaded successfully: " + printer_name);
     } catch (const std::exception& e) {
         return OperationResult(false, "Error loading printer profile", e.what());
@@ -2185,6 +3039,7 @@ CliCore::OperationResult CliCore::loadPrinterProfile(const std::string& printer_
 }
 
 CliCore::OperationResult CliCore::loadFilamentProfile(const std::string& filament_name) {
+    SliceTrace::Scope span("loadFilamentProfile", "presets", filament_name);
     if (!m_impl->initialized) {
         return OperationResult(false, "CLI Core not initialized");
     }
@@ -2197,17 +3052,12 @@ CliCore::OperationResult CliCore::loadFilamentProfile(const std::string& filamen
         if (active_printer.name.empty() || active_printer.name == "Default Printer") {
             return OperationResult(false, "No printer selected before filament profile");
         }
-        // Resolve alias to canonical preset name if needed
-        std::string fil_name = filament_name;
-        {
-            const std::string &canonical = m_impl->preset_bundle.get_preset_name_by_alias(Slic3r::Preset::TYPE_FILAMENT, filament_name);
-            if (!canonical.empty()) fil_name = canonical;
-        }
-        // Validate filament exists
-        auto *fil_preset = m_impl->preset_bundle.filaments.find_preset(fil_name, /*first_visible_if_not_found=*/false, /*real=*/false, /*only_from_library=*/false);
+        // Resolve name or alias to the canonical preset (index prefers presets compatible with the printer)
+        const Slic3r::Preset *fil_preset = m_impl->presetIndex().find(m_impl->preset_bundle.filaments, filament_name);
         if (fil_preset == nullptr) {
-            return OperationResult(false, "Filament profile not found", fil_name);
+            return OperationResult(false, "Filament profile not found", filament_name);
         }
+        const std::string fil_name = fil_preset->name;
         // Select filament preset and bind it to extruder slot 0
         if (!m_impl->preset_bundle.filaments.select_preset_by_name(fil_name, /*force=*/true)) {
             return OperationResult(false, "Failed to select filament preset", fil_name);
@@ -2217,7 +3067,7 @@ CliCore::OperationResult CliCore::loadFilamentProfile(const std::string& filamen
         m_impl->preset_bundle.update_compatible(Slic3r::PresetSelectCompatibleType::Always);
         *m_impl->config = m_impl->preset_bundle.full_config_secure();
 
-        std::cout << "DEBUG: Loaded filament profile (via PresetBundle): " << fil_name << std::endl;
+        LOG_DEBUG_STREAM("Loaded filament profile (via PresetBundle): " << fil_name);
         return OperationResult(true, "Filament profile loaded successfully: " + fil_name);
     } catch (const std::exception& e) {
         return OperationResult(false, "Error loading filament profile", e.what());
@@ -2228,6 +3078,7 @@ CliCore::OperationResult CliCore::loadFilamentProfile(const std::string& filamen
 }
 
 CliCore::OperationResult CliCore::loadProcessProfile(const std::string& process_name) {
+    SliceTrace::Scope span("loadProcessProfile", "presets", process_name);
     if (!m_impl->initialized) {
         return OperationResult(false, "CLI Core not initialized");
     }
@@ -2242,17 +3093,12 @@ CliCore::OperationResult CliCore::loadProcessProfile(const std::string& process_
         if (active_printer.name.empty() || active_printer.name == "Default Printer") {
             return OperationResult(false, "No printer selected before process profile");
         }
-        // Resolve alias to canonical preset name if needed
-        std::string proc_name = process_name;
-        {
-            const std::string &canonical = m_impl->preset_bundle.get_preset_name_by_alias(Slic3r::Preset::TYPE_PRINT, process_name);
-            if (!canonical.empty()) proc_name = canonical;
-        }
-        // Validate process exists
-        auto *proc_preset = m_impl->preset_bundle.prints.find_preset(proc_name, /*first_visible_if_not_found=*/false, /*real=*/false, /*only_from_library=*/false);
+        // Resolve name or alias to the canonical preset (index prefers presets compatible with the printer)
+        const Slic3r::Preset *proc_preset = m_impl->presetIndex().find(m_impl->preset_bundle.prints, process_name);
         if (proc_preset == nullptr) {
-            return OperationResult(false, "Process profile not found", proc_name);
+            return OperationResult(false, "Process profile not found", process_name);
         }
+        const std::string proc_name = proc_preset->name;
         // Select process preset
         if (!m_impl->preset_bundle.prints.select_preset_by_name(proc_name, /*force=*/true)) {
             return OperationResult(false, "Failed to select process preset", proc_name);
@@ -2263,7 +3109,7 @@ CliCore::OperationResult CliCore::loadProcessProfile(const std::string& process_
 
 
         *m_impl->config = m_impl->preset_bundle.full_config_secure();
-        std::cout << "DEBUG: Loaded process profile (via PresetBundle): " << proc_name << std::endl;
+        LOG_DEBUG_STREAM("Loaded process profile (via PresetBundle): " << proc_name);
         return OperationResult(true, "Process profile loaded successfully: " + proc_name);
     } catch (const std::exception& e) {
         return OperationResult(false, "Error loading process profile", e.what());
@@ -2289,7 +3135,7 @@ CliCore::OperationResult CliCore::setConfigOption(const std::string& key, const
         // Use set_deserialize to let libslic3r parse and validate the value
         Slic3r::ConfigSubstitutionContext ctx{Slic3r::ForwardCompatibilitySubstitutionRule::Enable};
         m_impl->config->set_deserialize(key, value, ctx, /*append=*/false);
-        std::cout << "DEBUG: Override applied: " << key << "=" << value << std::endl;
+        LOG_DEBUG_STREAM("Override applied: " << key << "=" << value);
         return OperationResult(true, "Config option set: " + key);
     } catch (const std::exception& e) {
         return OperationResult(false, std::string("Failed to set config option: ") + key, e.what());
@@ -2340,7 +3186,7 @@ std::vector<std::string> CliCore::getAvailablePrinterProfiles() const {
             }
         }
     } catch (const std::exception& e) {
-        std::cerr << "Error scanning printer profiles: " << e.what() << std::endl;
+        LOG_ERROR_STREAM("Error scanning printer profiles: " << e.what());
     }
 
     return profiles;
@@ -2371,7 +3217,7 @@ std::vector<std::string> CliCore::getAvailableFilamentProfiles() const {
             }
         }
     } catch (const std::exception& e) {
-        std::cerr << "Error scanning filament profiles: " << e.what() << std::endl;
+        LOG_ERROR_STREAM("Error scanning filament profiles: " << e.what());
     }
 
     return profiles;
@@ -2401,7 +3247,7 @@ std::vector<std::string> CliCore::getAvailableProcessProfiles() const {
             }
         }
     } catch (const std::exception& e) {
-        std::cerr << "Error scanning process profiles: " << e.what() << std::endl;
+        LOG_ERROR_STREAM("Error scanning process profiles: " << e.what());
     }
 
     return profiles;
@@ -2453,7 +3299,7 @@ CliCore::OperationResult CliCore::loadVendor(const std::string& vendor_id) {
         return OperationResult(false, "CLI Core not initialized");
     }
 #if HAVE_LIBSLIC3R
-        std::cout << "DEBUG: CliCore::loadVendor request vendor_id='" << vendor_id << "'" << std::endl;
+        LOG_DEBUG_STREAM("CliCore::loadVendor request vendor_id='" << vendor_id << "'");
 
     try {
         namespace fs = std::filesystem;
@@ -2461,10 +3307,12 @@ CliCore::OperationResult CliCore::loadVendor(const std::string& vendor_id) {
         if (!fs::exists(res_profiles)) {
             return OperationResult(false, "Resources profiles directory not found", res_profiles.string());
         }
-        std::cout << "DEBUG: [TEST TRACE] loadVendor('" << vendor_id << "') from '" << res_profiles.string() << "'" << std::endl;
-        std::cout << "DEBUG: [TEST TRACE] calling PresetBundle::load_vendor_configs_from_json with vendor '" << vendor_id << "'" << std::endl;
+        LOG_DEBUG_STREAM("[TEST TRACE] loadVendor('" << vendor_id << "') from '" << res_profiles.string() << "'");
+        LOG_DEBUG_STREAM("[TEST TRACE] calling PresetBundle::load_vendor_configs_from_json with vendor '" << vendor_id << "'");
         m_impl->preset_bundle.load_vendor_configs_from_json(res_profiles.string(), vendor_id, Slic3r::PresetBundle::LoadSystem, Slic3r::ForwardCompatibilitySubstitutionRule::EnableSystemSilent);
         m_impl->loaded_vendors.insert(vendor_id);
+        m_impl->preset_index.forgetVendor(vendor_id);
+        m_impl->presets_changed();
         try { m_impl->preset_bundle.load_installed_printers(m_impl->app_config); } catch (...) {}
         return OperationResult(true, std::string("Vendor loaded: ") + vendor_id);
     } catch (const std::exception& e) {
@@ -2475,6 +3323,178 @@ CliCore::OperationResult CliCore::loadVendor(const std::string& vendor_id) {
 #endif
 }
 
+CliCore::OperationResult CliCore::openSession(const std::string& input_file, int plate_index, uint64_t& session_id) {
+    session_id = 0;
+    if (!m_impl->initialized) {
+        return OperationResult(false, "CLI Core not initialized");
+    }
+#if HAVE_LIBSLIC3R
+    m_impl->plate_id = (plate_index >= 1 ? plate_index : 0);
+#endif
+    auto result = loadModel(input_file);
+    if (!result.success) {
+        return result;
+    }
+#if HAVE_LIBSLIC3R
+    // Start from an empty Print so the first reslice runs the full pipeline for this model
+    m_impl->print = std::make_unique<Slic3r::Print>();
+#endif
+    // Ids are unique across engines in the process so a stale id never matches a recreated engine
+    static std::atomic<uint64_t> next_session_id{1};
+    m_impl->session_id = next_session_id++;
+    m_impl->session_input_ext = Impl::normalize_format(std::filesystem::path(input_file).extension().string());
+    session_id = m_impl->session_id;
+    LOG_DEBUG_STREAM("CliCore::openSession id=" << session_id << " input='" << input_file << "'");
+    return OperationResult(true, "Session opened: " + input_file);
+}
+
+CliCore::OperationResult CliCore::reslice(uint64_t session_id, const SlicingParams& params, ResliceInfo* info) {
+    if (!m_impl->initialized) {
+        return OperationResult(false, "CLI Core not initialized");
+    }
+    if (session_id == 0 || session_id != m_impl->session_id) {
+        return OperationResult(false, "Session not open", "the session was closed or its model was replaced; open a new session");
+    }
+    // Keep the session's Model: without an input file slice() resolves profiles/overrides and reuses the Print
+    SlicingParams p = params;
+    p.input_file.clear();
+    p.input_data = nullptr;
+    p.input_size = 0;
+    m_impl->last_apply_status = -1;
+    m_impl->last_steps_run.clear();
+    auto result = slice(p);
+    if (info) {
+        info->apply_status = m_impl->last_apply_status;
+        info->steps_run = m_impl->last_steps_run;
+    }
+    return result;
+}
+
+void CliCore::closeSession(uint64_t session_id) {
+    if (session_id != 0 && session_id == m_impl->session_id) {
+        m_impl->session_id = 0;
+    }
+}
+
+CliCore::SliceTimings CliCore::getLastTimings() const {
+    return m_impl->last_timings;
+}
+
+const char* CliCore::SliceTimings::stepName(int step) {
+    static const char* const names[StepCount] = {
+        "slice", "perimeters", "prepare_infill", "infill", "ironing", "support_material", "wipe_tower", "skirt_brim"
+    };
+    return step >= 0 && step < StepCount ? names[step] : "";
+}
+
+CliCore::CacheStats CliCore::getConfigCacheStats() const {
+    CacheStats out;
+#if HAVE_LIBSLIC3R
+    const auto s = m_impl->config_cache.stats();
+    out.hits = s.hits;
+    out.misses = s.misses;
+    out.evictions = s.evictions;
+    out.entries = s.entries;
+    out.capacity = s.capacity;
+#endif
+    return out;
+}
+
+void CliCore::setConfigCacheCapacity(size_t entries) {
+#if HAVE_LIBSLIC3R
+    m_impl->config_cache.setCapacity(entries);
+#else
+    (void)entries;
+#endif
+}
+
+CliCore::CacheStats CliCore::getProjectCacheStats() const {
+    CacheStats out;
+#if HAVE_LIBSLIC3R
+    const auto s = m_impl->project_cache.stats();
+    out.hits = s.hits;
+    out.misses = s.misses;
+    out.evictions = s.evictions;
+    out.entries = s.entries;
+    out.capacity = s.capacity;
+#endif
+    return out;
+}
+
+void CliCore::clearCaches() {
+#if HAVE_LIBSLIC3R
+    m_impl->project_cache.clear();
+    m_impl->config_cache.clear();
+#endif
+}
+
+CliCore::EngineStats CliCore::getStats() const {
+    EngineStats out;
+    out.slices = m_impl->stat_slices.load();
+    out.slice_failures = m_impl->stat_slice_failures.load();
+    out.bytes_in = m_impl->stat_bytes_in.load();
+    out.bytes_out = m_impl->stat_bytes_out.load();
+    out.config_cache = getConfigCacheStats();
+    out.project_cache = getProjectCacheStats();
+#if HAVE_LIBSLIC3R
+    const auto r = m_impl->result_cache.stats();
+    out.result_cache.hits = r.hits;
+    out.result_cache.misses = r.misses;
+    out.result_cache.evictions = r.evictions;
+#endif
+#if defined(__linux__)
+    // /proc/self/statm: size resident shared ... (in pages)
+    std::ifstream statm("/proc/self/statm");
+    uint64_t size_pages = 0, resident_pages = 0;
+    if (statm >> size_pages >> resident_pages) {
+        out.rss_bytes = resident_pages * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    }
+#endif
+    return out;
+}
+
+CliCore::OperationResult CliCore::saveSnapshot(const std::string& snapshot_file) {
+    if (!m_impl->initialized) {
+        return OperationResult(false, "CLI Core not initialized");
+    }
+#if HAVE_LIBSLIC3R
+    if (m_impl->loaded_vendors.empty()) {
+        return OperationResult(false, "No vendors loaded; nothing to snapshot");
+    }
+    std::vector<std::string> vendors(m_impl->loaded_vendors.begin(), m_impl->loaded_vendors.end());
+    uint64_t key = PresetSnapshot::computeKey(m_impl->resources_path, vendors, getVersion());
+    std::string error;
+    if (!PresetSnapshot::save(snapshot_file, key, vendors, m_impl->preset_bundle, error)) {
+        return OperationResult(false, "Failed to save snapshot", error);
+    }
+    return OperationResult(true, "Snapshot saved: " + snapshot_file);
+#else
+    return OperationResult(false, "libslic3r not available");
+#endif
+}
+
+CliCore::OperationResult CliCore::loadSnapshot(const std::string& snapshot_file) {
+    if (!m_impl->initialized) {
+        return OperationResult(false, "CLI Core not initialized");
+    }
+#if HAVE_LIBSLIC3R
+    LOG_DEBUG_STREAM("CliCore::loadSnapshot('" << snapshot_file << "')");
+    std::vector<std::string> vendors;
+    std::string error;
+    if (!PresetSnapshot::load(snapshot_file, m_impl->resources_path, getVersion(), m_impl->preset_bundle, vendors, error)) {
+        return OperationResult(false, "Snapshot not loaded", error);
+    }
+    m_impl->loaded_vendors.insert(vendors.begin(), vendors.end());
+    m_impl->presets_changed();
+    try { m_impl->preset_bundle.load_installed_printers(m_impl->app_config); } catch (...) {}
+    std::string list;
+    for (const auto& v : vendors) list += (list.empty() ? "" : ",") + v;
+    return OperationResult(true, "Snapshot loaded: " + list);
+#else
+    return OperationResult(false, "libslic3r not available");
+#endif
+}
+
 } // namespace OrcaSlicerCli
 
 
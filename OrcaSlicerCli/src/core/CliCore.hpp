@@ -1,9 +1,11 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
 #include <map>
+#include <functional>
 
 // Forward declarations for OrcaSlicer types
 namespace Slic3r {
@@ -16,6 +18,8 @@ namespace Slic3r {
 
 namespace OrcaSlicerCli {
 
+class OutputBuffer;
+
 /**
  * @brief Core class that provides high-level interface to OrcaSlicer functionality
  *
@@ -53,6 +57,15 @@ public:
         std::map<std::string, std::string> custom_settings;
         bool verbose = false;
         bool dry_run = false;
+        uint64_t job_id = 0;  // caller-chosen id targeted by cancel(); 0 = anonymous
+        // Model bytes used instead of reading input_file (which then only names the object). Caller-owned, must outlive slice().
+        const uint8_t* input_data = nullptr;
+        size_t input_size = 0;
+        std::string input_format; // "stl", "obj" or "3mf" for input_data
+        int timeout_ms = 0;   // deadline measured from slice() entry; 0 = none
+        int compression_level = -1; // zlib level 0-9 for .gcode.3mf / .gcode.gz / .bgcode, zstd level for .gcode.zst; -1 = library default
+        std::string output_format;  // "gcode", "gcode.gz", "gcode.zst" or "bgcode"; empty = from the output_file extension (.3mf outputs ignore it)
+        std::string trace_file;     // write a Chrome trace JSON (SliceTrace) of this job here; empty = no tracing
     };
 
     /**
@@ -69,6 +82,61 @@ public:
         std::vector<std::string> errors;
     };
 
+    /**
+     * @brief Outcome of an incremental re-slice
+     */
+    struct ResliceInfo {
+        int apply_status = -1;              // Print::ApplyStatus (0 unchanged, 1 changed, 2 invalidated); -1 if not sliced
+        std::vector<std::string> steps_run; // pipeline steps that were computed, e.g. "perimeters", "infill", "gcode"
+    };
+
+    /**
+     * @brief Resolved-config cache counters
+     */
+    struct CacheStats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        size_t entries = 0;
+        size_t capacity = 0;
+    };
+
+    /**
+     * @brief Where the time of the last slice() went (steady_clock nanoseconds; 0 = stage did not run)
+     */
+    struct SliceTimings {
+        // Print::process() steps, in pipeline order (same order as the C API step bits)
+        enum Step { Slice, Perimeters, PrepareInfill, Infill, Ironing, SupportMaterial, WipeTower, SkirtBrim, StepCount };
+        static const char* stepName(int step);
+
+        uint64_t load_model_ns = 0;    // model load (0 when the loaded model or session model was reused)
+        uint64_t presets_ns = 0;       // profile resolution/activation and overrides
+        uint64_t apply_ns = 0;         // Print::apply
+        uint64_t process_ns = 0;       // Print::process, all steps
+        uint64_t step_ns[StepCount] = {};    // process_ns split by step, sampled at Print status updates
+        uint32_t step_count[StepCount] = {}; // objects the step was computed for (1 for print-level steps)
+        uint64_t export_gcode_ns = 0;  // Print::export_gcode
+        uint64_t package_ns = 0;       // .gcode.3mf packaging or .gz/.zst/.bgcode encoding
+        uint64_t total_ns = 0;         // whole slice() call
+        uint32_t objects = 0;          // PrintObjects sliced
+        uint32_t layers = 0;           // layers over all objects
+        bool cached = false;           // output served by the result cache (no apply/process/export)
+    };
+
+    /**
+     * @brief Lifetime counters of this engine, for monitoring (see getStats())
+     */
+    struct EngineStats {
+        uint64_t slices = 0;           // slice() calls, including sliceToBuffer()/sliceToStream()/reslice()
+        uint64_t slice_failures = 0;   // of which failed, were canceled or hit their deadline
+        uint64_t bytes_in = 0;         // model bytes read by slice() (file size or in-memory size)
+        uint64_t bytes_out = 0;        // output bytes produced by successful slices
+        CacheStats config_cache;
+        CacheStats project_cache;
+        CacheStats result_cache;       // hits include coalesced waits; entries/capacity are not tracked (0)
+        uint64_t rss_bytes = 0;        // resident set size of the whole process; 0 where unavailable (non-Linux)
+    };
+
 public:
     /**
      * @brief Constructor
@@ -105,6 +173,21 @@ public:
      */
     OperationResult loadModel(const std::string& filename);
 
+    /**
+     * @brief Load a 3D model from memory
+     *
+     * STL and OBJ are parsed straight from the buffer (MeshReader) and
+     * repaired like a file import. 3MF is staged on scratch storage (see
+     * OutputBuffer::scratchPath()) since the 3MF reader and the project
+     * config import only accept a path.
+     * @param data Model bytes; only read during the call
+     * @param size Size of data in bytes
+     * @param format "stl", "obj" or "3mf" (a leading dot is accepted)
+     * @param name Object name for STL/OBJ (a file name); defaults to "model.<format>"
+     * @return Operation result
+     */
+    OperationResult loadModelFromMemory(const uint8_t* data, size_t size, const std::string& format, const std::string& name = "");
+
     /**
      * @brief Get information about the currently loaded model
      * @return Model information structure
@@ -118,6 +201,24 @@ public:
      */
     OperationResult slice(const SlicingParams& params);
 
+    /**
+     * @brief Perform slicing into an engine-owned memory buffer instead of a file
+     * @param params Slicing parameters; output_file only selects the kind (a ".3mf"
+     *        suffix produces .gcode.3mf, anything else G-code) and may be empty
+     * @param out Receives the output on success
+     * @return Operation result
+     */
+    OperationResult sliceToBuffer(const SlicingParams& params, std::unique_ptr<OutputBuffer>& out);
+
+    /**
+     * @brief Slice and hand the output to a sink in order, in chunks of at most kStreamChunkSize bytes
+     * @param params Slicing parameters; output_file only picks the kind, as in sliceToBuffer()
+     * @param sink Called on the slicing thread; returning false stops the job ("Slicing canceled")
+     * @return Operation result
+     */
+    OperationResult sliceToStream(const SlicingParams& params, const std::function<bool(const uint8_t*, size_t)>& sink);
+    static constexpr size_t kStreamChunkSize = 256 * 1024;
+
     /**
      * @brief Load configuration from file
      * @param config_file Path to configuration file
@@ -160,6 +261,93 @@ public:
 	     */
 	    OperationResult loadVendor(const std::string& vendor_id);
 
+    /**
+     * @brief Save the presets of all loaded vendors to a binary snapshot
+     * @param snapshot_file Snapshot file path (written atomically)
+     * @return Operation result
+     */
+    OperationResult saveSnapshot(const std::string& snapshot_file);
+
+    /**
+     * @brief Restore vendor presets from a snapshot written by saveSnapshot()
+     * @param snapshot_file Snapshot file path
+     * @return Operation result (fails without side effects if the snapshot is stale)
+     */
+    OperationResult loadSnapshot(const std::string& snapshot_file);
+
+    /**
+     * @brief Stop a running slice(); it returns "Slicing canceled" at the next cancellation point
+     *
+     * Safe to call from any thread. A job id that has not reached slice() yet is remembered
+     * and that job is canceled as soon as it starts.
+     * @param job_id SlicingParams::job_id of the job to stop, or 0 for whatever is running
+     */
+    void cancel(uint64_t job_id = 0);
+
+    /**
+     * @brief Load a model and keep it (with its Print) for incremental re-slicing
+     * @param input_file Model file (STL/OBJ/3MF)
+     * @param plate_index 1-based plate index for .3mf projects
+     * @param session_id Receives the session id (0 on failure)
+     * @return Operation result
+     */
+    OperationResult openSession(const std::string& input_file, int plate_index, uint64_t& session_id);
+
+    /**
+     * @brief Re-slice the session's model; only steps invalidated by changed settings run again
+     * @param session_id Id returned by openSession()
+     * @param params Slicing parameters (input_file is ignored)
+     * @param info Optional: receives the apply status and the steps that ran
+     * @return Operation result (fails if the session was closed or its model replaced)
+     */
+    OperationResult reslice(uint64_t session_id, const SlicingParams& params, ResliceInfo* info = nullptr);
+
+    /**
+     * @brief Stage timings of the last slice(), sliceToBuffer(), sliceToStream() or reslice()
+     * @return Timings of the last call, also when it failed (stages not reached are 0)
+     */
+    SliceTimings getLastTimings() const;
+
+    /**
+     * @brief Close a re-slice session (the loaded model stays until the next load)
+     * @param session_id Id returned by openSession()
+     */
+    void closeSession(uint64_t session_id);
+
+    /**
+     * @brief Get resolved-config cache counters
+     * @return Hits, misses, evictions and current size
+     */
+    CacheStats getConfigCacheStats() const;
+
+    /**
+     * @brief Set the resolved-config cache size (entries); 0 disables caching
+     * @param entries Maximum number of cached configs
+     */
+    void setConfigCacheCapacity(size_t entries);
+
+    /**
+     * @brief Get parsed-3MF project cache counters
+     * @return Hits, misses, evictions and current size
+     */
+    CacheStats getProjectCacheStats() const;
+
+    /**
+     * @brief Drop the parsed-3MF project and resolved-config caches; counters are kept
+     *
+     * The next job parses and resolves everything again (cold-start measurements).
+     * Must not be called while a job runs on this engine.
+     */
+    void clearCaches();
+
+    /**
+     * @brief Get the engine counters and cache statistics
+     *
+     * Safe to call from another thread while a slice is running.
+     * @return Counters since construction
+     */
+    EngineStats getStats() const;
+
 
     /**
      * @brief Set a configuration option
@@ -220,6 +408,8 @@ public:
     static std::string getBuildInfo();
 
 private:
+    OperationResult runSlice(const SlicingParams& params);
+
     class Impl;
     std::unique_ptr<Impl> m_impl;
 };
@@ -0,0 +1,438 @@
+#include "GcodeEncoder.hpp"
+#include "ParallelDeflate.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <zlib.h>
+#if ORCACLI_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+namespace OrcaSlicerCli {
+
+namespace {
+
+bool ends_with_ci(const std::string& s, const std::string& suffix) {
+    if (s.size() < suffix.size()) return false;
+    return std::equal(suffix.rbegin(), suffix.rend(), s.rbegin(),
+                      [](char a, char b) { return a == std::tolower(static_cast<unsigned char>(b)); });
+}
+
+void put16(std::string& out, uint16_t v) {
+    out += static_cast<char>(v & 0xff);
+    out += static_cast<char>(v >> 8);
+}
+
+void put32(std::string& out, uint32_t v) {
+    for (int i = 0; i < 4; ++i) out += static_cast<char>((v >> (8 * i)) & 0xff);
+}
+
+// Output file that is removed again unless commit() succeeds
+class OutputFile {
+public:
+    bool open(const std::string& path, std::string& error) {
+        m_path = path;
+        std::remove(path.c_str());
+        m_file.open(path, std::ios::binary | std::ios::trunc);
+        if (!m_file) error = "cannot create " + path;
+        return static_cast<bool>(m_file);
+    }
+    void write(const void* data, size_t size) { m_file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size)); }
+    bool commit(std::string& error) {
+        m_file.close();
+        if (m_file.fail()) {
+            error = "write failed: " + m_path;
+            return false;
+        }
+        m_committed = true;
+        return true;
+    }
+    ~OutputFile() {
+        if (m_committed || m_path.empty()) return;
+        m_file.close();
+        std::remove(m_path.c_str());
+    }
+
+private:
+    std::ofstream m_file;
+    std::string m_path;
+    bool m_committed = false;
+};
+
+bool encode_gzip(const uint8_t* gcode, size_t size, int level, OutputFile& out, std::string& error) {
+    std::vector<uint8_t> deflated;
+    uint32_t crc = 0;
+    if (!ParallelDeflate::compress(gcode, size, level, 0, deflated, crc, error)) return false;
+    // RFC 1952 member: no name, no mtime (reproducible output), OS unknown
+    static const uint8_t header[10] = {0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 0xff};
+    std::string trailer;
+    put32(trailer, crc);
+    put32(trailer, static_cast<uint32_t>(size & 0xffffffffu));
+    out.write(header, sizeof(header));
+    out.write(deflated.data(), deflated.size());
+    out.write(trailer.data(), trailer.size());
+    return true;
+}
+
+bool encode_zstd(const uint8_t* gcode, size_t size, int level, OutputFile& out, std::string& error) {
+#if ORCACLI_HAS_ZSTD
+    ZSTD_CCtx* cctx = ZSTD_createCCtx();
+    if (!cctx) {
+        error = "ZSTD_createCCtx failed";
+        return false;
+    }
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, level < 0 ? ZSTD_CLEVEL_DEFAULT : std::max(1, level));
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_checksumFlag, 1);
+    // Ignored (error return) by a libzstd built without ZSTD_MULTITHREAD
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_nbWorkers, static_cast<int>(std::max(1u, std::thread::hardware_concurrency())));
+    ZSTD_CCtx_setPledgedSrcSize(cctx, size);
+    std::vector<char> buffer(ZSTD_CStreamOutSize());
+    ZSTD_inBuffer in{gcode, size, 0};
+    bool ok = true;
+    for (;;) {
+        ZSTD_outBuffer o{buffer.data(), buffer.size(), 0};
+        const size_t remaining = ZSTD_compressStream2(cctx, &o, &in, ZSTD_e_end);
+        if (ZSTD_isError(remaining)) {
+            error = std::string("zstd: ") + ZSTD_getErrorName(remaining);
+            ok = false;
+            break;
+        }
+        out.write(buffer.data(), o.pos);
+        if (remaining == 0) break;
+    }
+    ZSTD_freeCCtx(cctx);
+    return ok;
+#else
+    (void)gcode; (void)size; (void)level; (void)out;
+    error = "zstd output is not available in this build";
+    return false;
+#endif
+}
+
+// --- binary G-code (libbgcode format, version 1) ---
+
+enum BlockType : uint16_t { FileMetadata = 0, GCode = 1, SlicerMetadata = 2, PrinterMetadata = 3, PrintMetadata = 4, Thumbnail = 5 };
+enum Compression : uint16_t { None = 0, Deflate = 1 };
+constexpr size_t kMaxGcodeBlock = 65536;
+
+struct ThumbnailImage {
+    uint16_t format = 0; // 0 PNG, 1 JPG, 2 QOI
+    uint16_t width = 0;
+    uint16_t height = 0;
+    std::string data;
+};
+
+// What the exporter's comment sections contribute to the metadata blocks
+struct GcodeLayout {
+    std::vector<std::pair<std::string, std::string>> file, printer, print, slicer;
+    std::vector<ThumbnailImage> thumbnails;
+    std::vector<std::pair<size_t, size_t>> kept; // byte ranges that stay in the G-code blocks
+};
+
+std::string trim(std::string s) {
+    const auto first = s.find_first_not_of(" \t");
+    if (first == std::string::npos) return {};
+    return s.substr(first, s.find_last_not_of(" \t\r") - first + 1);
+}
+
+// "; key = value" (config block, trailer) or "; key: value" (header)
+bool split_comment(const std::string& text, std::string& key, std::string& value) {
+    auto pos = text.find(" = ");
+    size_t skip = 3;
+    if (pos == std::string::npos) {
+        pos = text.find(": ");
+        skip = 2;
+    }
+    if (pos == std::string::npos) return false;
+    key = trim(text.substr(0, pos));
+    value = trim(text.substr(pos + skip));
+    return !key.empty();
+}
+
+std::string base64_decode(const std::string& in) {
+    std::string out;
+    int bits = -8;
+    uint32_t acc = 0;
+    for (unsigned char c : in) {
+        int v;
+        if (c >= 'A' && c <= 'Z') v = c - 'A';
+        else if (c >= 'a' && c <= 'z') v = c - 'a' + 26;
+        else if (c >= '0' && c <= '9') v = c - '0' + 52;
+        else if (c == '+') v = 62;
+        else if (c == '/') v = 63;
+        else continue;
+        acc = (acc << 6) | static_cast<uint32_t>(v);
+        bits += 6;
+        if (bits >= 0) {
+            out += static_cast<char>((acc >> bits) & 0xff);
+            bits -= 8;
+        }
+    }
+    return out;
+}
+
+GcodeLayout scan_layout(const uint8_t* gcode, size_t size) {
+    enum class Section { Gcode, Header, Config, Thumbnail };
+    GcodeLayout layout;
+    Section section = Section::Gcode;
+    bool bare_thumbnail = false; // "; thumbnail begin" without THUMBNAIL_BLOCK_START around it
+    size_t kept_begin = 0;
+    ThumbnailImage thumb;
+    std::string thumb_base64;
+    std::string printing_time;
+
+    const char* text = reinterpret_cast<const char*>(gcode);
+    for (size_t begin = 0; begin < size;) {
+        const char* nl = static_cast<const char*>(std::memchr(text + begin, '\n', size - begin));
+        const size_t end = nl ? static_cast<size_t>(nl - text) + 1 : size;
+        std::string line(text + begin, end - begin);
+        while (!line.empty() && (line.back() == '\n' || line.back() == '\r')) line.pop_back();
+        const bool comment = line.size() >= 2 && line[0] == ';';
+        const std::string body = comment ? trim(line.substr(1)) : std::string();
+        std::string key, value;
+
+        // Config and thumbnail sections leave the G-code blocks; everything else stays
+        const bool leaves = comment && (body == "CONFIG_BLOCK_START" || body == "THUMBNAIL_BLOCK_START" ||
+                                        (section == Section::Gcode && body.rfind("thumbnail", 0) == 0 && body.find(" begin ") != std::string::npos));
+        if (leaves && section != Section::Config && section != Section::Thumbnail) {
+            if (begin > kept_begin) layout.kept.emplace_back(kept_begin, begin);
+        }
+
+        if (section == Section::Config) {
+            if (body == "CONFIG_BLOCK_END") {
+                section = Section::Gcode;
+                kept_begin = end;
+            } else if (comment && split_comment(body, key, value)) {
+                layout.slicer.emplace_back(key, value);
+                if (key == "printer_model" || key == "nozzle_diameter" || key == "filament_type" || key == "layer_height")
+                    layout.printer.emplace_back(key, value);
+            }
+        } else if (section == Section::Thumbnail) {
+            if (body == "THUMBNAIL_BLOCK_END") {
+                section = Section::Gcode;
+                kept_begin = end;
+            } else if (body.rfind("thumbnail", 0) == 0 && body.find(" end") != std::string::npos) {
+                thumb.data = base64_decode(thumb_base64);
+                if (!thumb.data.empty() && thumb.width && thumb.height) layout.thumbnails.push_back(std::move(thumb));
+                thumb = ThumbnailImage{};
+                thumb_base64.clear();
+                if (bare_thumbnail) {
+                    section = Section::Gcode;
+                    bare_thumbnail = false;
+                    kept_begin = end;
+                }
+            } else if (body.rfind("thumbnail", 0) == 0 && body.find(" begin ") != std::string::npos) {
+                const std::string tag = body.substr(0, body.find(' '));
+                thumb.format = tag == "thumbnail_JPG" ? 1 : tag == "thumbnail_QOI" ? 2 : 0;
+                unsigned w = 0, h = 0;
+                if (std::sscanf(body.c_str() + body.find(" begin ") + 7, "%ux%u", &w, &h) == 2) {
+                    thumb.width = static_cast<uint16_t>(w);
+                    thumb.height = static_cast<uint16_t>(h);
+                }
+            } else if (comment) {
+                thumb_base64 += body;
+            }
+        } else if (leaves) {
+            if (body == "CONFIG_BLOCK_START") {
+                section = Section::Config;
+            } else {
+                // A bare "; thumbnail begin" without the block markers ends with its own "end" line
+                section = Section::Thumbnail;
+                bare_thumbnail = body != "THUMBNAIL_BLOCK_START";
+                if (bare_thumbnail) continue; // re-read the begin line inside the section
+            }
+        } else if (body == "HEADER_BLOCK_START") {
+            section = Section::Header;
+        } else if (body == "HEADER_BLOCK_END") {
+            section = Section::Gcode;
+        } else if (section == Section::Header && comment) {
+            if (body.rfind("generated by ", 0) == 0) {
+                const std::string producer = body.substr(13);
+                layout.file.emplace_back("Producer", producer.substr(0, producer.find(" on ")));
+            }
+            // "model printing time: 30m 12s; total estimated time: 36m 54s"
+            for (size_t from = 0; from < body.size();) {
+                size_t to = body.find("; ", from);
+                if (to == std::string::npos) to = body.size();
+                if (split_comment(body.substr(from, to - from), key, value)) {
+                    layout.print.emplace_back(key, value);
+                    if (key == "total estimated time") printing_time = value;
+                }
+                from = to + 2;
+            }
+        } else if (comment && body.rfind("filament ", 0) == 0 && split_comment(body, key, value)) {
+            // Trailer totals after EXECUTABLE_BLOCK_END
+            layout.print.emplace_back(key, value);
+            if (key == "filament used [mm]" || key == "filament used [g]") layout.printer.emplace_back(key, value);
+        }
+        begin = end;
+    }
+    if (section != Section::Config && section != Section::Thumbnail && size > kept_begin) layout.kept.emplace_back(kept_begin, size);
+    if (!printing_time.empty()) {
+        layout.printer.emplace_back("estimated printing time (normal mode)", printing_time);
+        layout.print.emplace_back("estimated printing time (normal mode)", printing_time);
+    }
+    return layout;
+}
+
+class BlockWriter {
+public:
+    BlockWriter(OutputFile& out, int level) : m_out(out), m_level(level) {}
+
+    void fileHeader() {
+        std::string h = "GCDE";
+        put32(h, 1); // version
+        put16(h, 1); // checksum: CRC-32
+        m_out.write(h.data(), h.size());
+    }
+
+    bool block(uint16_t type, const std::string& params, const uint8_t* data, size_t size, bool compress, std::string& error) {
+        std::vector<uint8_t> packed;
+        if (compress && m_level != 0 && size > 0) {
+            uLongf packed_size = compressBound(static_cast<uLong>(size));
+            packed.resize(packed_size);
+            if (compress2(packed.data(), &packed_size, data, static_cast<uLong>(size), m_level < 0 ? Z_DEFAULT_COMPRESSION : m_level) != Z_OK) {
+                error = "bgcode: deflate failed";
+                return false;
+            }
+            packed.resize(packed_size);
+            if (packed.size() >= size) packed.clear(); // incompressible: store
+        }
+        std::string header;
+        put16(header, type);
+        put16(header, packed.empty() ? None : Deflate);
+        put32(header, static_cast<uint32_t>(size));
+        if (!packed.empty()) put32(header, static_cast<uint32_t>(packed.size()));
+        const uint8_t* payload = packed.empty() ? data : packed.data();
+        const size_t payload_size = packed.empty() ? size : packed.size();
+        uLong crc = crc32(0L, reinterpret_cast<const Bytef*>(header.data()), static_cast<uInt>(header.size()));
+        crc = crc32(crc, reinterpret_cast<const Bytef*>(params.data()), static_cast<uInt>(params.size()));
+        crc = crc32(crc, payload, static_cast<uInt>(payload_size));
+        std::string trailer;
+        put32(trailer, static_cast<uint32_t>(crc));
+        m_out.write(header.data(), header.size());
+        m_out.write(params.data(), params.size());
+        m_out.write(payload, payload_size);
+        m_out.write(trailer.data(), trailer.size());
+        return true;
+    }
+
+    bool metadata(uint16_t type, const std::vector<std::pair<std::string, std::string>>& entries, bool compress, std::string& error) {
+        std::string ini;
+        for (const auto& [k, v] : entries) ini += k + "=" + v + "\n";
+        std::string params;
+        put16(params, 0); // encoding: INI
+        return block(type, params, reinterpret_cast<const uint8_t*>(ini.data()), ini.size(), compress, error);
+    }
+
+private:
+    OutputFile& m_out;
+    int m_level;
+};
+
+bool encode_binary(const uint8_t* gcode, size_t size, int level, OutputFile& out, std::string& error) {
+    const GcodeLayout layout = scan_layout(gcode, size);
+    BlockWriter writer(out, level);
+    writer.fileHeader();
+    // Block order required by the specification
+    if (!layout.file.empty() && !writer.metadata(FileMetadata, layout.file, false, error)) return false;
+    if (!writer.metadata(PrinterMetadata, layout.printer, false, error)) return false;
+    for (const auto& t : layout.thumbnails) {
+        std::string params;
+        put16(params, t.format);
+        put16(params, t.width);
+        put16(params, t.height);
+        if (!writer.block(Thumbnail, params, reinterpret_cast<const uint8_t*>(t.data.data()), t.data.size(), false, error)) return false;
+    }
+    if (!writer.metadata(PrintMetadata, layout.print, false, error)) return false;
+    if (!writer.metadata(SlicerMetadata, layout.slicer, true, error)) return false;
+
+    std::string params;
+    put16(params, 0); // G-code encoding: plain text (no MeatPack)
+    std::string chunk;
+    chunk.reserve(kMaxGcodeBlock);
+    auto flush = [&]() {
+        if (chunk.empty()) return true;
+        const bool ok = writer.block(GCode, params, reinterpret_cast<const uint8_t*>(chunk.data()), chunk.size(), true, error);
+        chunk.clear();
+        return ok;
+    };
+    // Blocks end on a line boundary; only a line longer than a block is cut
+    for (const auto& [from, to] : layout.kept) {
+        for (size_t pos = from; pos < to;) {
+            const void* nl = std::memchr(gcode + pos, '\n', to - pos);
+            const size_t line_end = nl ? static_cast<size_t>(static_cast<const uint8_t*>(nl) - gcode) + 1 : to;
+            if (chunk.size() + (line_end - pos) > kMaxGcodeBlock && !flush()) return false;
+            const size_t take = std::min(line_end - pos, kMaxGcodeBlock - chunk.size());
+            chunk.append(reinterpret_cast<const char*>(gcode + pos), take);
+            pos += take;
+        }
+    }
+    return flush();
+}
+
+} // namespace
+
+GcodeEncoder::Format GcodeEncoder::formatFor(const std::string& output_file) {
+    if (ends_with_ci(output_file, ".gcode.gz")) return Format::Gzip;
+    if (ends_with_ci(output_file, ".gcode.zst")) return Format::Zstd;
+    if (ends_with_ci(output_file, ".bgcode")) return Format::Binary;
+    return Format::Plain;
+}
+
+bool GcodeEncoder::parseFormat(const std::string& name, Format& format) {
+    std::string n = name;
+    std::transform(n.begin(), n.end(), n.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (!n.empty() && n[0] == '.') n.erase(0, 1);
+    if (n == "gcode") format = Format::Plain;
+    else if (n == "gcode.gz" || n == "gz" || n == "gzip") format = Format::Gzip;
+    else if (n == "gcode.zst" || n == "zst" || n == "zstd") format = Format::Zstd;
+    else if (n == "bgcode" || n == "binary") format = Format::Binary;
+    else return false;
+    return true;
+}
+
+const char* GcodeEncoder::suffix(Format format) {
+    switch (format) {
+        case Format::Gzip: return ".gcode.gz";
+        case Format::Zstd: return ".gcode.zst";
+        case Format::Binary: return ".bgcode";
+        default: return ".gcode";
+    }
+}
+
+bool GcodeEncoder::available(Format format) {
+#if ORCACLI_HAS_ZSTD
+    (void)format;
+    return true;
+#else
+    return format != Format::Zstd;
+#endif
+}
+
+bool GcodeEncoder::encode(const uint8_t* gcode, size_t size, Format format, int level,
+                          const std::string& output_file, std::string& error) {
+    if (!available(format)) {
+        error = std::string(suffix(format)) + " output is not available in this build";
+        return false;
+    }
+    OutputFile out;
+    if (!out.open(output_file, error)) return false;
+    bool ok = false;
+    switch (format) {
+        case Format::Gzip: ok = encode_gzip(gcode, size, level, out, error); break;
+        case Format::Zstd: ok = encode_zstd(gcode, size, level, out, error); break;
+        case Format::Binary: ok = encode_binary(gcode, size, level, out, error); break;
+        case Format::Plain: out.write(gcode, size); ok = true; break;
+    }
+    return ok && out.commit(error);
+}
+
+} // namespace OrcaSlicerCli
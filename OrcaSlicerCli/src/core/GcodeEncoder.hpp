@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace OrcaSlicerCli {
+
+/**
+ * @brief Compressed encodings of an exported plain G-code
+ *
+ * libslic3r only writes plain text G-code, so compressed outputs are produced
+ * from the finished export: .gcode.gz (gzip, deflated in parallel blocks),
+ * .gcode.zst (zstd, when built with ORCACLI_HAS_ZSTD) and .bgcode (Prusa
+ * binary G-code: INI metadata blocks, PNG/JPG/QOI thumbnail blocks and
+ * deflated G-code blocks of up to 64 KiB, each with a CRC-32).
+ */
+class GcodeEncoder {
+public:
+    enum class Format { Plain, Gzip, Zstd, Binary };
+
+    /**
+     * @brief Format implied by the output file name (".gcode.gz", ".gcode.zst", ".bgcode"; anything else is Plain)
+     */
+    static Format formatFor(const std::string& output_file);
+
+    /**
+     * @brief Parse an explicit format name: "gcode", "gcode.gz" / "gz", "gcode.zst" / "zst", "bgcode"
+     * @return false if the name is not recognized
+     */
+    static bool parseFormat(const std::string& name, Format& format);
+
+    /**
+     * @brief Canonical output suffix of a format (".gcode", ".gcode.gz", ".gcode.zst", ".bgcode")
+     */
+    static const char* suffix(Format format);
+
+    /**
+     * @brief False for Zstd when the engine was built without libzstd
+     */
+    static bool available(Format format);
+
+    /**
+     * @brief Encode G-code text into output_file (replaced; removed again on failure)
+     * @param level zlib 0-9 for gzip and bgcode blocks, zstd level for zstd (0 counts as 1); -1 = library default
+     * @return false with error set if the format is unavailable or the output cannot be written
+     */
+    static bool encode(const uint8_t* gcode, size_t size, Format format, int level,
+                       const std::string& output_file, std::string& error);
+};
+
+} // namespace OrcaSlicerCli
@@ -0,0 +1,688 @@
+#include "MeshReader.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <unordered_map>
+
+namespace OrcaSlicerCli {
+
+namespace {
+
+constexpr size_t kStlHeaderSize = 84;
+constexpr size_t kStlFacetSize = 50;
+constexpr size_t kMinChunkSize = 1024 * 1024; // per-thread share below which another thread does not pay off
+
+using Vertex = std::array<float, 3>;
+
+struct VertexKey {
+    uint32_t bits[3];
+    bool operator==(const VertexKey& o) const {
+        return bits[0] == o.bits[0] && bits[1] == o.bits[1] && bits[2] == o.bits[2];
+    }
+};
+
+struct VertexKeyHash {
+    size_t operator()(const VertexKey& k) const {
+        uint64_t h = 1469598103934665603ull;
+        for (uint32_t b : k.bits) h = (h ^ b) * 1099511628211ull;
+        return static_cast<size_t>(h);
+    }
+};
+
+// Merges bit-identical vertices while triangles are appended
+class SoupIndexer {
+public:
+    explicit SoupIndexer(MeshReader::Mesh& mesh, size_t expected_facets) : m_mesh(mesh) {
+        m_index.reserve(expected_facets / 2 + 16);
+        m_mesh.vertices.reserve(expected_facets / 2 + 16);
+        m_mesh.faces.reserve(expected_facets);
+    }
+
+    void addFacet(const float v[3][3]) {
+        std::array<int32_t, 3> face;
+        for (int i = 0; i < 3; ++i) face[i] = index(v[i]);
+        // Degenerate after merging: admesh drops these too
+        if (face[0] == face[1] || face[1] == face[2] || face[0] == face[2]) return;
+        m_mesh.faces.push_back(face);
+    }
+
+private:
+    int32_t index(const float p[3]) {
+        VertexKey key;
+        std::memcpy(key.bits, p, sizeof(key.bits));
+        auto [it, inserted] = m_index.emplace(key, static_cast<int32_t>(m_mesh.vertices.size()));
+        if (inserted) m_mesh.vertices.push_back({p[0], p[1], p[2]});
+        return it->second;
+    }
+
+    MeshReader::Mesh& m_mesh;
+    std::unordered_map<VertexKey, int32_t, VertexKeyHash> m_index;
+};
+
+float read_le_float(const uint8_t* p) {
+    uint32_t u = uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+    float f;
+    std::memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+uint32_t read_le_u32(const uint8_t* p) {
+    return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+
+inline bool is_space(char c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+inline bool is_digit(char c) { return static_cast<unsigned char>(c - '0') < 10; }
+
+// SWAR digit parsing: eight ASCII digits per 64-bit word (little-endian loads)
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+constexpr bool kSwarDigits = false;
+#else
+constexpr bool kSwarDigits = true;
+#endif
+
+inline uint64_t load8(const char* p) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline bool eight_digits(uint64_t v) {
+    return (((v & 0xF0F0F0F0F0F0F0F0ull) | (((v + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull);
+}
+
+inline uint32_t parse_eight_digits(uint64_t v) {
+    v -= 0x3030303030303030ull;
+    v = (v * 10) + (v >> 8);
+    v = (((v & 0x000000FF000000FFull) * (100 + (1000000ull << 32))) +
+         (((v >> 16) & 0x000000FF000000FFull) * (1 + (10000ull << 32)))) >> 32;
+    return static_cast<uint32_t>(v);
+}
+
+// Digit run into mantissa; returns the number of digits consumed
+inline int parse_digits(const char*& p, const char* end, uint64_t& mantissa, int budget) {
+    int count = 0;
+    if (kSwarDigits) {
+        while (end - p >= 8 && count + 8 <= budget && eight_digits(load8(p))) {
+            mantissa = mantissa * 100000000ull + parse_eight_digits(load8(p));
+            p += 8;
+            count += 8;
+        }
+    }
+    while (p < end && is_digit(*p) && count < budget) {
+        mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+        ++p;
+        ++count;
+    }
+    return count;
+}
+
+bool strtof_exact(const char* s, size_t n, float& out) {
+    char buf[64];
+    if (n == 0 || n >= sizeof(buf)) return false;
+    std::memcpy(buf, s, n);
+    buf[n] = '\0';
+    char* endp = nullptr;
+    out = std::strtof(buf, &endp);
+    return endp == buf + n;
+}
+
+// Decimal float, bit-identical to strtof. Mantissas up to 2^24 with a decimal exponent within
+// +-10 need a single correctly rounded multiply or divide (both operands exact in float);
+// everything else (long mantissas, large exponents, inf/nan, hex) goes to strtof.
+bool parse_float(const char* s, size_t n, float& out) {
+    static constexpr float kPow10[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+    const char* p = s;
+    const char* end = s + n;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) negative = *p++ == '-';
+    uint64_t mantissa = 0;
+    int digits = parse_digits(p, end, mantissa, 19);
+    int exponent = 0;
+    if (p < end && *p == '.') {
+        ++p;
+        const int fraction = parse_digits(p, end, mantissa, 19 - digits);
+        digits += fraction;
+        exponent -= fraction;
+    }
+    if (digits == 0 || (p < end && is_digit(*p))) return strtof_exact(s, n, out);
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool exp_negative = false;
+        if (p < end && (*p == '-' || *p == '+')) exp_negative = *p++ == '-';
+        if (p == end || !is_digit(*p)) return strtof_exact(s, n, out);
+        int e = 0;
+        while (p < end && is_digit(*p) && e < 10000) e = e * 10 + (*p++ - '0');
+        exponent += exp_negative ? -e : e;
+    }
+    if (p != end) return strtof_exact(s, n, out);
+    if (mantissa == 0) {
+        out = negative ? -0.0f : 0.0f;
+        return true;
+    }
+    if (mantissa > (1ull << 24) || exponent < -10 || exponent > 10) return strtof_exact(s, n, out);
+    float f = static_cast<float>(mantissa);
+    f = exponent < 0 ? f / kPow10[-exponent] : f * kPow10[exponent];
+    out = negative ? -f : f;
+    return true;
+}
+
+unsigned worker_count(size_t size, unsigned threads) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    if (size < MeshReader::kParallelThreshold) return 1;
+    return static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(threads, size / kMinChunkSize)));
+}
+
+// Runs fn(0) .. fn(count - 1), fn(0) on the calling thread
+template <class Fn>
+void parallel_for(unsigned count, Fn fn) {
+    std::vector<std::thread> pool;
+    pool.reserve(count > 0 ? count - 1 : 0);
+    for (unsigned i = 1; i < count; ++i) pool.emplace_back(fn, i);
+    if (count > 0) fn(0u);
+    for (auto& t : pool) t.join();
+}
+
+inline uint64_t mix64(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    return h ^ (h >> 33);
+}
+
+// Parallel equivalent of SoupIndexer over a complete triangle soup (three corners per facet).
+// Corners are hash-partitioned, each partition is deduplicated on its own, and vertices are
+// numbered by first occurrence, so the result matches the serial indexer exactly.
+void weld_soup(const std::vector<Vertex>& soup, unsigned threads, MeshReader::Mesh& mesh) {
+    const size_t n = soup.size();
+    const unsigned partitions = threads * 8;
+    auto key_of = [&](size_t i) {
+        VertexKey key;
+        std::memcpy(key.bits, soup[i].data(), sizeof(key.bits));
+        return key;
+    };
+    auto range = [&](unsigned t, size_t total) {
+        return std::pair<size_t, size_t>(total * t / threads, total * (t + 1) / threads);
+    };
+
+    // 1. partition of every corner, counted per (thread, partition)
+    std::vector<uint32_t> part(n);
+    std::vector<size_t> counts(size_t(threads) * partitions, 0);
+    parallel_for(threads, [&](unsigned t) {
+        const auto [from, to] = range(t, n);
+        size_t* c = counts.data() + size_t(t) * partitions;
+        for (size_t i = from; i < to; ++i) {
+            part[i] = static_cast<uint32_t>(mix64(VertexKeyHash()(key_of(i))) % partitions);
+            ++c[part[i]];
+        }
+    });
+
+    // 2. scatter corner ids grouped by partition, ascending inside each partition
+    std::vector<size_t> offsets(counts.size());
+    std::vector<size_t> part_begin(partitions + 1, 0);
+    size_t running = 0;
+    for (unsigned p = 0; p < partitions; ++p) {
+        part_begin[p] = running;
+        for (unsigned t = 0; t < threads; ++t) {
+            offsets[size_t(t) * partitions + p] = running;
+            running += counts[size_t(t) * partitions + p];
+        }
+    }
+    part_begin[partitions] = running;
+    std::vector<uint32_t> order(n);
+    parallel_for(threads, [&](unsigned t) {
+        const auto [from, to] = range(t, n);
+        size_t* o = offsets.data() + size_t(t) * partitions;
+        for (size_t i = from; i < to; ++i) order[o[part[i]]++] = static_cast<uint32_t>(i);
+    });
+
+    // 3. per partition: representative (first occurrence) of every corner
+    std::vector<uint32_t> rep(n);
+    std::vector<uint8_t> first(n, 0);
+    std::atomic<unsigned> next{0};
+    parallel_for(threads, [&](unsigned) {
+        std::unordered_map<VertexKey, uint32_t, VertexKeyHash> seen;
+        for (unsigned p = next++; p < partitions; p = next++) {
+            seen.clear();
+            seen.reserve((part_begin[p + 1] - part_begin[p]) / 2 + 16);
+            for (size_t k = part_begin[p]; k < part_begin[p + 1]; ++k) {
+                const uint32_t i = order[k];
+                auto [it, inserted] = seen.emplace(key_of(i), i);
+                rep[i] = it->second;
+                first[i] = inserted;
+            }
+        }
+    });
+
+    // 4. vertex ids in order of first occurrence (prefix sum over first[])
+    std::vector<size_t> chunk_firsts(threads, 0);
+    parallel_for(threads, [&](unsigned t) {
+        const auto [from, to] = range(t, n);
+        size_t c = 0;
+        for (size_t i = from; i < to; ++i) c += first[i];
+        chunk_firsts[t] = c;
+    });
+    size_t vertex_count = 0;
+    for (auto& c : chunk_firsts) {
+        const size_t here = c;
+        c = vertex_count;
+        vertex_count += here;
+    }
+    std::vector<int32_t> id(n);
+    mesh.vertices.resize(vertex_count);
+    parallel_for(threads, [&](unsigned t) {
+        const auto [from, to] = range(t, n);
+        size_t next_id = chunk_firsts[t];
+        for (size_t i = from; i < to; ++i) {
+            if (!first[i]) continue;
+            id[i] = static_cast<int32_t>(next_id);
+            mesh.vertices[next_id++] = soup[i];
+        }
+    });
+
+    // 5. faces in facet order, dropping those degenerate after merging (as SoupIndexer does)
+    const size_t facets = n / 3;
+    std::vector<std::vector<std::array<int32_t, 3>>> faces(threads);
+    parallel_for(threads, [&](unsigned t) {
+        const auto [from, to] = range(t, facets);
+        auto& out = faces[t];
+        out.reserve(to - from);
+        for (size_t f = from; f < to; ++f) {
+            const std::array<int32_t, 3> face{id[rep[3 * f]], id[rep[3 * f + 1]], id[rep[3 * f + 2]]};
+            if (face[0] == face[1] || face[1] == face[2] || face[0] == face[2]) continue;
+            out.push_back(face);
+        }
+    });
+    size_t face_count = 0;
+    for (const auto& f : faces) face_count += f.size();
+    mesh.faces.reserve(face_count);
+    for (const auto& f : faces) mesh.faces.insert(mesh.faces.end(), f.begin(), f.end());
+}
+
+// Minimal tokenizer over a non NUL-terminated range
+class Cursor {
+public:
+    Cursor(const uint8_t* data, size_t size)
+        : m_p(reinterpret_cast<const char*>(data)), m_end(m_p + size) {}
+
+    bool atEnd() const { return m_p >= m_end; }
+
+    void skipSpaces() {
+        while (m_p < m_end && (*m_p == ' ' || *m_p == '\t' || *m_p == '\r')) ++m_p;
+    }
+
+    void skipWhitespace() {
+        while (m_p < m_end && is_space(*m_p)) ++m_p;
+    }
+
+    void skipLine() {
+        while (m_p < m_end && *m_p != '\n') ++m_p;
+        if (m_p < m_end) ++m_p;
+    }
+
+    bool atLineEnd() const { return m_p >= m_end || *m_p == '\n' || *m_p == '#'; }
+
+    // Next whitespace-delimited token; empty at end of input
+    std::pair<const char*, size_t> token() {
+        skipWhitespace();
+        const char* start = m_p;
+        while (m_p < m_end && !is_space(*m_p)) ++m_p;
+        return {start, static_cast<size_t>(m_p - start)};
+    }
+
+    // Next token on the current line; empty at end of line
+    std::pair<const char*, size_t> lineToken() {
+        skipSpaces();
+        if (atLineEnd()) return {m_p, 0};
+        const char* start = m_p;
+        while (m_p < m_end && !is_space(*m_p) && *m_p != '#') ++m_p;
+        return {start, static_cast<size_t>(m_p - start)};
+    }
+
+    bool number(float& out) {
+        auto [s, n] = token();
+        return parse_float(s, n, out);
+    }
+
+    static bool parse_float(const char* s, size_t n, float& out) {
+        return OrcaSlicerCli::parse_float(s, n, out);
+    }
+
+private:
+    const char* m_p;
+    const char* m_end;
+};
+
+bool token_is(const std::pair<const char*, size_t>& tok, const char* word) {
+    const size_t n = std::strlen(word);
+    if (tok.second != n) return false;
+    for (size_t i = 0; i < n; ++i)
+        if (std::tolower(static_cast<unsigned char>(tok.first[i])) != word[i]) return false;
+    return true;
+}
+
+bool looks_like_ascii_stl(const uint8_t* data, size_t size) {
+    size_t i = 0;
+    while (i < size && std::isspace(data[i])) ++i;
+    if (size - i < 5) return false;
+    for (int k = 0; k < 5; ++k)
+        if (std::tolower(data[i + k]) != "solid"[k]) return false;
+    // Some binary exporters also start the header with "solid"; a facet keyword settles it
+    const size_t probe = std::min<size_t>(size, 1024);
+    for (size_t j = i; j + 5 <= probe; ++j)
+        if (std::memcmp(data + j, "facet", 5) == 0) return true;
+    return false;
+}
+
+bool read_binary_stl(const uint8_t* data, size_t size, MeshReader::Mesh& mesh, std::string& error) {
+    const uint32_t count = read_le_u32(data + 80);
+    if (kStlHeaderSize + uint64_t(count) * kStlFacetSize > size) {
+        error = "Truncated binary STL: header declares " + std::to_string(count) + " facets";
+        return false;
+    }
+    SoupIndexer indexer(mesh, count);
+    const uint8_t* p = data + kStlHeaderSize;
+    float v[3][3];
+    for (uint32_t f = 0; f < count; ++f, p += kStlFacetSize) {
+        // 12 bytes normal (recomputed by the mesh), 3 x 12 bytes vertices, 2 bytes attributes
+        for (int i = 0; i < 3; ++i)
+            for (int c = 0; c < 3; ++c) v[i][c] = read_le_float(p + 12 + i * 12 + c * 4);
+        indexer.addFacet(v);
+    }
+    return true;
+}
+
+bool read_ascii_stl(const uint8_t* data, size_t size, MeshReader::Mesh& mesh, std::string& error) {
+    Cursor cur(data, size);
+    SoupIndexer indexer(mesh, size / 256);
+    float v[3][3];
+    int corner = 0;
+    while (!cur.atEnd()) {
+        auto tok = cur.token();
+        if (tok.second == 0) break;
+        if (token_is(tok, "vertex")) {
+            if (corner == 3) {
+                error = "Malformed ASCII STL: facet with more than 3 vertices";
+                return false;
+            }
+            if (!cur.number(v[corner][0]) || !cur.number(v[corner][1]) || !cur.number(v[corner][2])) {
+                error = "Malformed ASCII STL: bad vertex coordinates";
+                return false;
+            }
+            ++corner;
+        } else if (token_is(tok, "endfacet")) {
+            if (corner != 3) {
+                error = "Malformed ASCII STL: facet with " + std::to_string(corner) + " vertices";
+                return false;
+            }
+            indexer.addFacet(v);
+            corner = 0;
+        }
+    }
+    return true;
+}
+
+// OBJ index: 1-based, negative = relative to the vertices read so far
+bool obj_index(const char* s, size_t n, size_t vertex_count, int32_t& out) {
+    char buf[32];
+    size_t len = 0;
+    while (len < n && s[len] != '/') ++len;
+    if (len == 0 || len >= sizeof(buf)) return false;
+    std::memcpy(buf, s, len);
+    buf[len] = '\0';
+    char* endp = nullptr;
+    const long idx = std::strtol(buf, &endp, 10);
+    if (endp != buf + len || idx == 0) return false;
+    const long resolved = idx > 0 ? idx - 1 : static_cast<long>(vertex_count) + idx;
+    if (resolved < 0 || resolved >= static_cast<long>(vertex_count)) return false;
+    out = static_cast<int32_t>(resolved);
+    return true;
+}
+
+bool read_binary_stl_parallel(const uint8_t* data, unsigned threads, MeshReader::Mesh& mesh) {
+    const size_t count = read_le_u32(data + 80);
+    std::vector<Vertex> soup(count * 3);
+    parallel_for(threads, [&](unsigned t) {
+        const uint8_t* p = data + kStlHeaderSize + count * t / threads * kStlFacetSize;
+        for (size_t f = count * t / threads; f < count * (t + 1) / threads; ++f, p += kStlFacetSize)
+            for (int i = 0; i < 3; ++i)
+                for (int c = 0; c < 3; ++c) soup[f * 3 + i][c] = read_le_float(p + 12 + i * 12 + c * 4);
+    });
+    weld_soup(soup, threads, mesh);
+    return true;
+}
+
+// Chunk boundaries at line starts near size * k / threads; with a keyword, only after a line
+// containing it (so an ASCII STL chunk never starts inside a facet)
+std::vector<size_t> split_lines(const uint8_t* data, size_t size, unsigned threads, const char* after_keyword) {
+    std::vector<size_t> bounds{0};
+    const char* text = reinterpret_cast<const char*>(data);
+    const size_t klen = after_keyword ? std::strlen(after_keyword) : 0;
+    for (unsigned k = 1; k < threads; ++k) {
+        size_t pos = std::max(bounds.back(), size * k / threads);
+        if (klen) {
+            const char* hit = nullptr;
+            for (const char* s = text + pos; s + klen <= text + size; ++s) {
+                s = static_cast<const char*>(std::memchr(s, after_keyword[0], size - (s - text)));
+                if (!s || s + klen > text + size) break;
+                if (std::memcmp(s, after_keyword, klen) == 0) { hit = s; break; }
+            }
+            if (!hit) break;
+            pos = static_cast<size_t>(hit - text);
+        }
+        const void* nl = std::memchr(text + pos, '\n', size - pos);
+        if (!nl) break;
+        pos = static_cast<size_t>(static_cast<const char*>(nl) - text) + 1;
+        if (pos > bounds.back() && pos < size) bounds.push_back(pos);
+    }
+    bounds.push_back(size);
+    return bounds;
+}
+
+// Same grammar as read_ascii_stl without error reporting; false sends the caller to the serial reader
+bool parse_ascii_stl_chunk(const char* p, const char* end, bool last, std::vector<Vertex>& soup) {
+    Vertex v[3];
+    int corner = 0;
+    auto token = [&]() {
+        while (p < end && is_space(*p)) ++p;
+        const char* start = p;
+        while (p < end && !is_space(*p)) ++p;
+        return std::pair<const char*, size_t>(start, static_cast<size_t>(p - start));
+    };
+    for (;;) {
+        const auto tok = token();
+        if (tok.second == 0) break;
+        if (token_is(tok, "vertex")) {
+            if (corner == 3) return false;
+            for (float& c : v[corner]) {
+                const auto num = token();
+                if (!parse_float(num.first, num.second, c)) return false;
+            }
+            ++corner;
+        } else if (token_is(tok, "endfacet")) {
+            if (corner != 3) return false;
+            soup.insert(soup.end(), v, v + 3);
+            corner = 0;
+        }
+    }
+    // Only the serial reader may drop a trailing partial facet
+    return corner == 0 || last;
+}
+
+bool read_ascii_stl_parallel(const uint8_t* data, size_t size, unsigned threads, MeshReader::Mesh& mesh) {
+    const std::vector<size_t> bounds = split_lines(data, size, threads, "endfacet");
+    const unsigned chunks = static_cast<unsigned>(bounds.size() - 1);
+    std::vector<std::vector<Vertex>> soups(chunks);
+    std::vector<uint8_t> ok(chunks, 0);
+    parallel_for(chunks, [&](unsigned t) {
+        const char* text = reinterpret_cast<const char*>(data);
+        soups[t].reserve((bounds[t + 1] - bounds[t]) / 80);
+        ok[t] = parse_ascii_stl_chunk(text + bounds[t], text + bounds[t + 1], t + 1 == chunks, soups[t]);
+    });
+    if (std::find(ok.begin(), ok.end(), 0) != ok.end()) return false;
+    size_t total = 0;
+    for (const auto& s : soups) total += s.size();
+    std::vector<Vertex> soup;
+    soup.reserve(total);
+    for (auto& s : soups) {
+        soup.insert(soup.end(), s.begin(), s.end());
+        std::vector<Vertex>().swap(s);
+    }
+    weld_soup(soup, threads, mesh);
+    return true;
+}
+
+// First token of the line at p is "v" (the serial reader's lineToken rules)
+inline bool is_vertex_line(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+    if (p == end || (*p != 'v' && *p != 'V')) return false;
+    ++p;
+    return p == end || is_space(*p) || *p == '#';
+}
+
+// OBJ in two parallel passes: count vertex lines per chunk, then parse each chunk with its
+// vertex base known, so negative and forward indices resolve exactly as in the serial reader
+bool read_obj_parallel(const uint8_t* data, size_t size, unsigned threads, MeshReader::Mesh& mesh) {
+    const std::vector<size_t> bounds = split_lines(data, size, threads, nullptr);
+    const unsigned chunks = static_cast<unsigned>(bounds.size() - 1);
+    const char* text = reinterpret_cast<const char*>(data);
+    std::vector<size_t> base(chunks + 1, 0);
+    parallel_for(chunks, [&](unsigned t) {
+        size_t count = 0;
+        for (const char* p = text + bounds[t]; p < text + bounds[t + 1];) {
+            count += is_vertex_line(p, text + bounds[t + 1]);
+            const void* nl = std::memchr(p, '\n', text + bounds[t + 1] - p);
+            p = nl ? static_cast<const char*>(nl) + 1 : text + bounds[t + 1];
+        }
+        base[t + 1] = count;
+    });
+    for (unsigned t = 0; t < chunks; ++t) base[t + 1] += base[t];
+    mesh.vertices.resize(base[chunks]);
+
+    std::vector<std::vector<std::array<int32_t, 3>>> faces(chunks);
+    std::vector<uint8_t> ok(chunks, 0);
+    parallel_for(chunks, [&](unsigned t) {
+        Cursor cur(data + bounds[t], bounds[t + 1] - bounds[t]);
+        size_t vertex_count = base[t];
+        std::vector<int32_t> polygon;
+        while (!cur.atEnd()) {
+            auto kw = cur.lineToken();
+            if (token_is(kw, "v")) {
+                if (vertex_count == base[t + 1]) return;
+                Vertex& p = mesh.vertices[vertex_count++];
+                for (float& c : p) {
+                    auto tok = cur.lineToken();
+                    if (!parse_float(tok.first, tok.second, c)) return;
+                }
+            } else if (token_is(kw, "f")) {
+                polygon.clear();
+                for (auto tok = cur.lineToken(); tok.second != 0; tok = cur.lineToken()) {
+                    int32_t idx;
+                    if (!obj_index(tok.first, tok.second, vertex_count, idx)) return;
+                    polygon.push_back(idx);
+                }
+                if (polygon.size() < 3) return;
+                for (size_t i = 1; i + 1 < polygon.size(); ++i)
+                    faces[t].push_back({polygon[0], polygon[i], polygon[i + 1]});
+            }
+            cur.skipLine();
+        }
+        ok[t] = vertex_count == base[t + 1];
+    });
+    if (std::find(ok.begin(), ok.end(), 0) != ok.end()) return false;
+    size_t face_count = 0;
+    for (const auto& f : faces) face_count += f.size();
+    mesh.faces.reserve(face_count);
+    for (const auto& f : faces) mesh.faces.insert(mesh.faces.end(), f.begin(), f.end());
+    return !mesh.faces.empty();
+}
+
+} // namespace
+
+bool MeshReader::readStl(const uint8_t* data, size_t size, Mesh& mesh, std::string& error, unsigned threads) {
+    mesh = Mesh();
+    if (data == nullptr || size == 0) {
+        error = "Empty STL data";
+        return false;
+    }
+    threads = worker_count(size, threads);
+    bool ok;
+    if (looks_like_ascii_stl(data, size)) {
+        ok = threads > 1 && read_ascii_stl_parallel(data, size, threads, mesh);
+        if (!ok) {
+            mesh = Mesh();
+            ok = read_ascii_stl(data, size, mesh, error);
+        }
+    } else if (size >= kStlHeaderSize) {
+        const bool complete = kStlHeaderSize + uint64_t(read_le_u32(data + 80)) * kStlFacetSize <= size;
+        ok = threads > 1 && complete ? read_binary_stl_parallel(data, threads, mesh) : read_binary_stl(data, size, mesh, error);
+    } else {
+        error = "Not an STL file (" + std::to_string(size) + " bytes)";
+        return false;
+    }
+    if (ok && mesh.faces.empty()) {
+        error = "STL contains no facets";
+        return false;
+    }
+    return ok;
+}
+
+bool MeshReader::readObj(const uint8_t* data, size_t size, Mesh& mesh, std::string& error, unsigned threads) {
+    mesh = Mesh();
+    if (data == nullptr || size == 0) {
+        error = "Empty OBJ data";
+        return false;
+    }
+    threads = worker_count(size, threads);
+    if (threads > 1 && read_obj_parallel(data, size, threads, mesh)) return true;
+    mesh = Mesh();
+    Cursor cur(data, size);
+    size_t line = 0;
+    std::vector<int32_t> polygon;
+    while (!cur.atEnd()) {
+        ++line;
+        auto kw = cur.lineToken();
+        if (token_is(kw, "v")) {
+            std::array<float, 3> p{};
+            for (float& c : p) {
+                auto tok = cur.lineToken();
+                if (!Cursor::parse_float(tok.first, tok.second, c)) {
+                    error = "Malformed OBJ vertex at line " + std::to_string(line);
+                    return false;
+                }
+            }
+            mesh.vertices.push_back(p);
+        } else if (token_is(kw, "f")) {
+            polygon.clear();
+            for (auto tok = cur.lineToken(); tok.second != 0; tok = cur.lineToken()) {
+                int32_t idx;
+                if (!obj_index(tok.first, tok.second, mesh.vertices.size(), idx)) {
+                    error = "Invalid OBJ face index at line " + std::to_string(line);
+                    return false;
+                }
+                polygon.push_back(idx);
+            }
+            if (polygon.size() < 3) {
+                error = "OBJ face with fewer than 3 vertices at line " + std::to_string(line);
+                return false;
+            }
+            for (size_t i = 1; i + 1 < polygon.size(); ++i)
+                mesh.faces.push_back({polygon[0], polygon[i], polygon[i + 1]});
+        }
+        cur.skipLine();
+    }
+    if (mesh.faces.empty()) {
+        error = "OBJ contains no faces";
+        return false;
+    }
+    return true;
+}
+
+} // namespace OrcaSlicerCli
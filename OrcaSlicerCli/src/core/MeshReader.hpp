@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace OrcaSlicerCli {
+
+/**
+ * @brief STL / OBJ parsing from a byte range, independent of the file system
+ *
+ * Produces an indexed triangle set with bit-identical vertices merged and
+ * degenerate facets dropped. This is raw geometry: file normals are not kept
+ * and admesh's repair (normal directions, nearby-vertex welding, hole filling)
+ * is not applied. Callers that slice the result must run it through
+ * TriangleMesh::from_stl with repair, as CliCore does, to get what
+ * ReadSTLFile produces for well-formed files.
+ * OBJ support covers geometry only (v / f, negative indices, polygons
+ * fan-triangulated); materials and texture coordinates are ignored.
+ *
+ * Inputs of kParallelThreshold bytes or more are parsed in chunks on several
+ * threads and welded with a partitioned hash; the result is identical to the
+ * serial parse (same vertex order, same faces). Any parse error is reported
+ * by re-running the serial parser, so messages and line numbers match.
+ */
+class MeshReader {
+public:
+    struct Mesh {
+        std::vector<std::array<float, 3>> vertices;
+        std::vector<std::array<int32_t, 3>> faces;
+    };
+
+    static constexpr size_t kParallelThreshold = 4 * 1024 * 1024;
+
+    /**
+     * @brief Parse a binary or ASCII STL
+     * @param threads worker count for large inputs; 0 = hardware concurrency, 1 = serial
+     * @return false with error set if the data is not a readable STL
+     */
+    static bool readStl(const uint8_t* data, size_t size, Mesh& mesh, std::string& error, unsigned threads = 0);
+
+    /**
+     * @brief Parse a Wavefront OBJ
+     * @param threads worker count for large inputs; 0 = hardware concurrency, 1 = serial
+     * @return false with error set if the data has no faces or references missing vertices
+     */
+    static bool readObj(const uint8_t* data, size_t size, Mesh& mesh, std::string& error, unsigned threads = 0);
+};
+
+} // namespace OrcaSlicerCli
@@ -0,0 +1,127 @@
+#include "OutputBuffer.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "utils/Logger.hpp"
+
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace OrcaSlicerCli {
+
+namespace fs = std::filesystem;
+namespace bip = boost::interprocess;
+
+struct OutputBuffer::Mapping {
+    bip::file_mapping file;
+    bip::mapped_region region;
+};
+
+namespace {
+
+long current_pid() {
+#if defined(_WIN32)
+    return static_cast<long>(_getpid());
+#else
+    return static_cast<long>(::getpid());
+#endif
+}
+
+bool writable_dir(const fs::path& dir) {
+    std::error_code ec;
+    if (!fs::is_directory(dir, ec)) return false;
+#if defined(_WIN32)
+    return true;
+#else
+    return ::access(dir.c_str(), W_OK) == 0;
+#endif
+}
+
+fs::path scratch_dir() {
+    static const fs::path dir = [] {
+        if (const char* env = std::getenv("ORCACLI_SCRATCH_DIR"); env && *env) {
+            std::error_code ec;
+            fs::create_directories(env, ec);
+            if (writable_dir(env)) return fs::path(env);
+            LOG_WARNING_STREAM("ORCACLI_SCRATCH_DIR '" << env << "' is not writable; using defaults");
+        }
+        if (writable_dir("/dev/shm")) return fs::path("/dev/shm");
+        std::error_code ec;
+        fs::path tmp = fs::temp_directory_path(ec);
+        // Not memory-backed: in-memory outputs and staged 3MF inputs now go through the disk
+        LOG_WARNING_STREAM("No memory-backed scratch directory (set ORCACLI_SCRATCH_DIR to a tmpfs); in-memory outputs and 3MF buffers are staged in "
+                           << tmp.string() << " on disk");
+        return tmp;
+    }();
+    return dir;
+}
+
+} // namespace
+
+OutputBuffer::~OutputBuffer() {
+    m_mapping.reset();
+    if (!m_path.empty()) {
+        std::error_code ec;
+        fs::remove(m_path, ec);
+    }
+}
+
+std::string OutputBuffer::scratchPath(const std::string& suffix) {
+    static std::atomic<uint64_t> counter{0};
+    const std::string name = "orcacli-" + std::to_string(current_pid()) + "-" + std::to_string(++counter) + suffix;
+    return (scratch_dir() / name).string();
+}
+
+bool OutputBuffer::mapFile(const std::string& path, std::string& error) {
+    std::error_code ec;
+    const auto size = fs::file_size(path, ec);
+    if (ec) {
+        error = "File not found: " + path;
+        return false;
+    }
+    if (size == 0) return true; // an empty mapping is not allowed; data() stays null
+    try {
+        auto mapping = std::make_unique<Mapping>();
+        mapping->file = bip::file_mapping(path.c_str(), bip::read_only);
+        mapping->region = bip::mapped_region(mapping->file, bip::read_only);
+        m_data = static_cast<const uint8_t*>(mapping->region.get_address());
+        m_size = mapping->region.get_size();
+        m_mapping = std::move(mapping);
+    } catch (const std::exception& e) {
+        error = std::string("Failed to map ") + path + ": " + e.what();
+        return false;
+    }
+    return true;
+}
+
+std::unique_ptr<OutputBuffer> OutputBuffer::map(const std::string& path, std::string& error) {
+    std::unique_ptr<OutputBuffer> buf(new OutputBuffer());
+    if (!buf->mapFile(path, error)) return nullptr;
+#if !defined(_WIN32)
+    // Sequential parsers read the whole mapping once
+    if (buf->m_mapping) buf->m_mapping->region.advise(bip::mapped_region::advice_sequential);
+#endif
+    return buf;
+}
+
+std::unique_ptr<OutputBuffer> OutputBuffer::adopt(const std::string& path, std::string& error) {
+    std::unique_ptr<OutputBuffer> buf(new OutputBuffer());
+    buf->m_path = path;
+    if (!buf->mapFile(path, error)) return nullptr;
+    std::error_code ec;
+#if !defined(_WIN32)
+    // The mapping keeps the pages alive; the name is not needed any more
+    if (fs::remove(path, ec)) buf->m_path.clear();
+#endif
+    return buf;
+}
+
+} // namespace OrcaSlicerCli
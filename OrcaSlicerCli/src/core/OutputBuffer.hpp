@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace OrcaSlicerCli {
+
+/**
+ * @brief Read-only, engine-owned view of a slicing output (G-code or .gcode.3mf)
+ *
+ * libslic3r only exports to paths, so in-memory outputs are produced in a
+ * private scratch file that is memory-mapped and then unlinked. The bytes
+ * are handed out without copying; on a memory-backed scratch directory
+ * (/dev/shm by default) nothing touches the disk.
+ */
+class OutputBuffer {
+public:
+    ~OutputBuffer();
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    /**
+     * @brief Map a finished output file and take ownership of it (it is removed)
+     * @return nullptr with error set if the file cannot be mapped
+     */
+    static std::unique_ptr<OutputBuffer> adopt(const std::string& path, std::string& error);
+
+    /**
+     * @brief Map an existing file read-only and leave it in place (model inputs)
+     * @return nullptr with error set if the file cannot be mapped
+     */
+    static std::unique_ptr<OutputBuffer> map(const std::string& path, std::string& error);
+
+    /**
+     * @brief Unique scratch path for an output of the given kind (".gcode", ".gcode.3mf")
+     *
+     * Lives in ORCACLI_SCRATCH_DIR, else /dev/shm when writable, else the system temp directory
+     * (logged once as a warning, since the bytes then reach the disk).
+     */
+    static std::string scratchPath(const std::string& suffix);
+
+    const uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    OutputBuffer() = default;
+    bool mapFile(const std::string& path, std::string& error);
+
+    struct Mapping;
+    std::unique_ptr<Mapping> m_mapping;
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    std::string m_path; // removed on destruction where a mapped file cannot be unlinked (Windows)
+};
+
+} // namespace OrcaSlicerCli
@@ -0,0 +1,115 @@
+#include "ParallelDeflate.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#include <zlib.h>
+
+#if HAVE_LIBSLIC3R
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#endif
+
+namespace OrcaSlicerCli {
+
+namespace {
+
+struct Block {
+    std::vector<uint8_t> packed;
+    uint32_t crc = 0;
+    size_t size = 0;
+};
+
+bool deflate_block(const uint8_t* data, size_t size, size_t begin, size_t end, int level, Block& block, std::string& error) {
+    z_stream zs{};
+    if (deflateInit2(&zs, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        error = "deflateInit2 failed";
+        return false;
+    }
+    if (begin > 0) {
+        const size_t dict = std::min(begin, ParallelDeflate::kDictionarySize);
+        deflateSetDictionary(&zs, data + begin - dict, static_cast<uInt>(dict));
+    }
+    const bool last = end == size;
+    // deflateBound covers Z_FINISH; a sync flush adds an empty stored block (5 bytes)
+    block.packed.resize(deflateBound(&zs, static_cast<uLong>(end - begin)) + 16);
+    zs.next_in = const_cast<Bytef*>(data + begin);
+    zs.avail_in = static_cast<uInt>(end - begin);
+    zs.next_out = block.packed.data();
+    zs.avail_out = static_cast<uInt>(block.packed.size());
+    const int rc = deflate(&zs, last ? Z_FINISH : Z_SYNC_FLUSH);
+    const bool ok = last ? rc == Z_STREAM_END : (rc == Z_OK && zs.avail_in == 0);
+    block.packed.resize(zs.total_out);
+    deflateEnd(&zs);
+    if (!ok) {
+        error = "deflate failed at offset " + std::to_string(begin);
+        return false;
+    }
+    block.crc = crc32(0L, data + begin, static_cast<uInt>(end - begin));
+    block.size = end - begin;
+    return true;
+}
+
+} // namespace
+
+bool ParallelDeflate::compress(const uint8_t* data, size_t size, int level, unsigned threads,
+                               std::vector<uint8_t>& out, uint32_t& crc, std::string& error) {
+    out.clear();
+    crc = 0;
+    const size_t count = std::max<size_t>(1, (size + kBlockSize - 1) / kBlockSize);
+    std::vector<Block> blocks(count);
+
+    std::atomic<bool> failed{false};
+    std::mutex error_mutex;
+    auto run_block = [&](size_t i) {
+        if (failed) return;
+        std::string block_error;
+        const size_t begin = i * kBlockSize, end = std::min(size, begin + kBlockSize);
+        if (!deflate_block(data, size, begin, end, level, blocks[i], block_error)) {
+            std::lock_guard<std::mutex> lk(error_mutex);
+            if (!failed.exchange(true)) error = block_error;
+        }
+    };
+#if HAVE_LIBSLIC3R
+    // Blocks are tasks in TBB's arena, the pool libslic3r slices in, so engines packaging at the same time
+    // share the cores instead of each starting its own threads
+    auto run_all = [&] {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, count, 1), [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i != range.end(); ++i) run_block(i);
+        });
+    };
+    if (threads == 0) {
+        run_all();
+    } else {
+        tbb::task_arena arena(static_cast<int>(std::min<size_t>(threads, count)));
+        arena.execute(run_all);
+    }
+#else
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<size_t>(threads, count));
+    std::atomic<size_t> next{0};
+    auto worker = [&] {
+        for (size_t i = next++; i < count && !failed; i = next++) run_block(i);
+    };
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();
+    for (auto& t : pool) t.join();
+#endif
+    if (failed) return false;
+
+    size_t total = 0;
+    for (const auto& b : blocks) total += b.packed.size();
+    out.reserve(total);
+    for (const auto& b : blocks) {
+        out.insert(out.end(), b.packed.begin(), b.packed.end());
+        crc = static_cast<uint32_t>(crc32_combine(crc, b.crc, static_cast<z_off_t>(b.size)));
+    }
+    return true;
+}
+
+} // namespace OrcaSlicerCli
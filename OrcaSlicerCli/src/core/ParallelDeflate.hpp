@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace OrcaSlicerCli {
+
+/**
+ * @brief Multi-threaded raw deflate (pigz-style) producing one ordinary deflate stream
+ *
+ * The input is cut into kBlockSize blocks compressed concurrently. Each block
+ * is primed with the 32 KiB before it as preset dictionary and ends on a byte
+ * boundary (Z_SYNC_FLUSH, the last one Z_FINISH), so the concatenation is a
+ * valid stream any inflater reads; the ratio is within a fraction of a
+ * percent of single-threaded zlib at the same level.
+ */
+class ParallelDeflate {
+public:
+    static constexpr size_t kBlockSize = 256 * 1024;
+    static constexpr size_t kDictionarySize = 32 * 1024;
+
+    /**
+     * @brief Compress data into out (replaced) and return its CRC-32
+     * @param level zlib level 0-9, -1 for zlib's default (6)
+     * @param threads worker count; 0 = TBB's shared arena (hardware concurrency
+     *        without libslic3r/TBB, where each call uses its own threads)
+     * @return false with error set if zlib fails
+     */
+    static bool compress(const uint8_t* data, size_t size, int level, unsigned threads,
+                         std::vector<uint8_t>& out, uint32_t& crc, std::string& error);
+};
+
+} // namespace OrcaSlicerCli
@@ -0,0 +1,479 @@
+#include "PlateExtractor.hpp"
+
+#include "ZipArchive.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace OrcaSlicerCli {
+
+namespace {
+
+constexpr const char* kRootModel = "3D/3dmodel.model";
+constexpr const char* kModelSettings = "Metadata/model_settings.config";
+constexpr const char* kRootRels = "_rels/.rels";
+constexpr const char* kContentTypes = "[Content_Types].xml";
+constexpr size_t npos = std::string::npos;
+
+// Rewritten parts are small XML; favour speed, the reduced project is a scratch file
+constexpr int kRewriteLevel = 1;
+
+struct Span {
+    size_t begin = 0;
+    size_t end = 0;
+};
+
+bool is_space(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+std::string entry_name(const std::string& target) { return !target.empty() && target.front() == '/' ? target.substr(1) : target; }
+
+bool ends_with(const std::string& s, const char* suffix)
+{
+    const size_t n = std::char_traits<char>::length(suffix);
+    return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+// Start of the next <name ...> tag in [from, limit)
+size_t find_tag(const std::string& xml, const std::string& name, size_t from, size_t limit)
+{
+    const std::string open = "<" + name;
+    for (size_t pos = xml.find(open, from); pos != npos && pos < limit; pos = xml.find(open, pos + 1)) {
+        const size_t after = pos + open.size();
+        if (after < xml.size() && (is_space(xml[after]) || xml[after] == '>' || xml[after] == '/')) return pos;
+    }
+    return npos;
+}
+
+// Extent of the element opened at tag_begin: the tag itself when self-closing, else up to its
+// close tag (3MF parts never nest elements of the same name)
+bool element(const std::string& xml, const std::string& name, size_t tag_begin, Span& span, size_t& tag_end)
+{
+    tag_end = xml.find('>', tag_begin);
+    if (tag_end == npos) return false;
+    span.begin = tag_begin;
+    if (xml[tag_end - 1] == '/') {
+        span.end = tag_end + 1;
+        return true;
+    }
+    const std::string close = "</" + name + ">";
+    const size_t close_pos = xml.find(close, tag_end);
+    if (close_pos == npos) return false;
+    span.end = close_pos + close.size();
+    return true;
+}
+
+// Value of an attribute of the tag in [tag_begin, tag_end); name may carry a namespace prefix ("p:path")
+bool attribute(const std::string& xml, size_t tag_begin, size_t tag_end, const std::string& name, std::string& value)
+{
+    for (size_t pos = xml.find(name, tag_begin); pos != npos && pos < tag_end; pos = xml.find(name, pos + 1)) {
+        if (!is_space(xml[pos - 1])) continue;
+        size_t p = pos + name.size();
+        while (p < tag_end && is_space(xml[p])) ++p;
+        if (p >= tag_end || xml[p] != '=') continue;
+        ++p;
+        while (p < tag_end && is_space(xml[p])) ++p;
+        if (p >= tag_end || (xml[p] != '"' && xml[p] != '\'')) continue;
+        const size_t close = xml.find(xml[p], p + 1);
+        if (close == npos || close > tag_end) return false;
+        value = xml.substr(p + 1, close - p - 1);
+        return true;
+    }
+    return false;
+}
+
+// value="" of the <metadata key="key" .../> child of an element
+bool metadata_value(const std::string& xml, const Span& span, const std::string& key, std::string& value)
+{
+    for (size_t pos = find_tag(xml, "metadata", span.begin, span.end); pos != npos; pos = find_tag(xml, "metadata", pos + 1, span.end)) {
+        const size_t tag_end = xml.find('>', pos);
+        std::string k;
+        if (tag_end != npos && attribute(xml, pos, tag_end, "key", k) && k == key) return attribute(xml, pos, tag_end, "value", value);
+    }
+    return false;
+}
+
+// <plate> element of model_settings.config with the given 1-based id (plates without plater_id count in document order)
+bool find_plate(const std::string& settings, int plate, Span& span, std::string& reason)
+{
+    int plate_count = 0;
+    for (size_t pos = find_tag(settings, "plate", 0, npos); pos != npos; pos = find_tag(settings, "plate", span.end, npos)) {
+        size_t tag_end;
+        if (!element(settings, "plate", pos, span, tag_end)) {
+            reason = "malformed model_settings.config";
+            return false;
+        }
+        ++plate_count;
+        std::string id_text;
+        const int id = metadata_value(settings, span, "plater_id", id_text) ? std::atoi(id_text.c_str()) : plate_count;
+        if (id == plate) return true;
+    }
+    reason = "plate " + std::to_string(plate) + " not found";
+    return false;
+}
+
+// Copy of xml without the given elements, each taken out with its indentation and line break
+std::string without(const std::string& xml, std::vector<Span> spans)
+{
+    std::sort(spans.begin(), spans.end(), [](const Span& a, const Span& b) { return a.begin < b.begin; });
+    std::string out;
+    out.reserve(xml.size());
+    size_t copied = 0;
+    for (Span s : spans) {
+        if (s.begin < copied) continue; // nested in an element already removed
+        while (s.begin > copied && (xml[s.begin - 1] == ' ' || xml[s.begin - 1] == '\t')) --s.begin;
+        if (xml.compare(s.end, 2, "\r\n") == 0) s.end += 2;
+        else if (s.end < xml.size() && xml[s.end] == '\n') ++s.end;
+        out.append(xml, copied, s.begin - copied);
+        copied = s.end;
+    }
+    out.append(xml, copied, npos);
+    return out;
+}
+
+// Start of the line holding pos (where new child elements go before a close tag)
+size_t line_start(const std::string& xml, size_t pos)
+{
+    const size_t nl = xml.rfind('\n', pos);
+    return nl == npos ? pos : nl + 1;
+}
+
+// Thumbnails a BBL project keeps per plate
+std::vector<std::string> plate_asset_names(int plate)
+{
+    const std::string n = std::to_string(plate);
+    return {"Metadata/plate_" + n + ".png", "Metadata/plate_" + n + "_small.png", "Metadata/plate_no_light_" + n + ".png",
+            "Metadata/top_" + n + ".png", "Metadata/pick_" + n + ".png"};
+}
+
+struct RootObject {
+    Span span;
+    std::vector<std::string> components; // object ids in the root model
+    std::vector<std::string> files;      // external parts holding component objects
+};
+
+} // namespace
+
+bool PlateExtractor::extract(const std::string& input_3mf, int plate, const std::string& output_3mf,
+                             Stats& stats, std::string& reason)
+{
+    stats = Stats{};
+    if (plate < 1) {
+        reason = "no plate selected";
+        return false;
+    }
+
+    ZipReader zip;
+    if (!zip.open(input_3mf, reason)) return false;
+    const ZipEntry* settings_entry = zip.find(kModelSettings);
+    const ZipEntry* root_entry = zip.find(kRootModel);
+    if (settings_entry == nullptr || root_entry == nullptr) {
+        reason = "not a BBL project (no model_settings.config)";
+        return false;
+    }
+    std::string settings, root;
+    if (!zip.read(*settings_entry, settings, reason) || !zip.read(*root_entry, root, reason)) return false;
+
+    // Objects placed on the requested plate
+    Span plate_span;
+    if (!find_plate(settings, plate, plate_span, reason)) return false;
+    std::set<std::string> on_plate;
+    for (size_t mi = find_tag(settings, "model_instance", plate_span.begin, plate_span.end); mi != npos;) {
+        Span instance;
+        size_t mi_end;
+        if (!element(settings, "model_instance", mi, instance, mi_end)) break;
+        std::string object_id;
+        if (metadata_value(settings, instance, "object_id", object_id)) on_plate.insert(object_id);
+        mi = find_tag(settings, "model_instance", instance.end, plate_span.end);
+    }
+    if (on_plate.empty()) {
+        reason = "plate " + std::to_string(plate) + " is empty";
+        return false;
+    }
+
+    // Root model: object resources with their components, and build items
+    std::map<std::string, RootObject> objects;
+    std::vector<std::pair<std::string, Span>> items;
+    const size_t resources = find_tag(root, "resources", 0, npos);
+    const size_t resources_end = resources == npos ? npos : root.find("</resources>", resources);
+    const size_t build = find_tag(root, "build", 0, npos);
+    if (resources_end == npos || build == npos) {
+        reason = "unexpected root model layout";
+        return false;
+    }
+    for (size_t pos = find_tag(root, "object", resources, resources_end); pos != npos;) {
+        RootObject object;
+        size_t tag_end;
+        std::string id;
+        if (!element(root, "object", pos, object.span, tag_end) || !attribute(root, pos, tag_end, "id", id)) {
+            reason = "malformed root model object";
+            return false;
+        }
+        for (size_t c = find_tag(root, "component", tag_end, object.span.end); c != npos; c = find_tag(root, "component", c + 1, object.span.end)) {
+            const size_t c_end = root.find('>', c);
+            std::string object_id, path;
+            if (c_end == npos || !attribute(root, c, c_end, "objectid", object_id)) continue;
+            if (!attribute(root, c, c_end, "p:path", path)) attribute(root, c, c_end, "path", path);
+            path = entry_name(path);
+            if (path.empty() || path == kRootModel) object.components.push_back(object_id);
+            else object.files.push_back(path);
+        }
+        pos = find_tag(root, "object", object.span.end, resources_end);
+        objects.emplace(std::move(id), std::move(object));
+    }
+    const size_t build_end = root.find("</build>", build);
+    for (size_t pos = find_tag(root, "item", build, build_end); pos != npos;) {
+        Span span;
+        size_t tag_end;
+        std::string object_id;
+        if (!element(root, "item", pos, span, tag_end) || !attribute(root, pos, tag_end, "objectid", object_id)) {
+            reason = "malformed build item";
+            return false;
+        }
+        items.emplace_back(std::move(object_id), span);
+        pos = find_tag(root, "item", span.end, build_end);
+    }
+
+    std::set<std::string> keep_roots, drop_roots;
+    for (const auto& item : items) (on_plate.count(item.first) ? keep_roots : drop_roots).insert(item.first);
+    for (const auto& id : on_plate) {
+        if (!keep_roots.count(id) || !objects.count(id)) {
+            reason = "object " + id + " of plate " + std::to_string(plate) + " is not a build item";
+            return false;
+        }
+    }
+    if (drop_roots.empty()) {
+        reason = "plate " + std::to_string(plate) + " holds every object";
+        return false;
+    }
+
+    // Objects and mesh parts reachable from each side; shared ones stay
+    auto reach = [&objects](const std::set<std::string>& roots, std::set<std::string>& ids, std::set<std::string>& files) {
+        std::vector<std::string> pending(roots.begin(), roots.end());
+        while (!pending.empty()) {
+            const std::string id = std::move(pending.back());
+            pending.pop_back();
+            if (!ids.insert(id).second) continue;
+            const auto it = objects.find(id);
+            if (it == objects.end()) continue;
+            files.insert(it->second.files.begin(), it->second.files.end());
+            pending.insert(pending.end(), it->second.components.begin(), it->second.components.end());
+        }
+    };
+    std::set<std::string> keep_ids, keep_files, drop_ids, drop_files;
+    reach(keep_roots, keep_ids, keep_files);
+    reach(drop_roots, drop_ids, drop_files);
+
+    std::set<std::string> dropped_entries;
+    for (const auto& file : drop_files) {
+        if (!keep_files.count(file) && zip.find(file) != nullptr) dropped_entries.insert(file);
+    }
+    // Embedded plate G-code and thumbnails are never read when loading for slicing
+    for (const auto& e : zip.entries()) {
+        if (e.name.compare(0, 9, "Metadata/") == 0 &&
+            (ends_with(e.name, ".gcode") || ends_with(e.name, ".md5") || ends_with(e.name, ".png") ||
+             ends_with(e.name, ".jpg") || ends_with(e.name, ".jpeg")))
+            dropped_entries.insert(e.name);
+    }
+
+    std::map<std::string, std::string> rewritten;
+
+    std::vector<Span> root_spans;
+    for (const auto& id : drop_ids) {
+        const auto it = objects.find(id);
+        if (it != objects.end() && !keep_ids.count(id)) root_spans.push_back(it->second.span);
+    }
+    for (const auto& item : items) {
+        if (drop_roots.count(item.first)) root_spans.push_back(item.second);
+    }
+    rewritten[kRootModel] = without(root, root_spans);
+
+    // model_settings.config: per-object settings, instances on any plate, assemble items and
+    // plate metadata pointing at entries left out
+    std::vector<Span> settings_spans;
+    for (size_t pos = find_tag(settings, "object", 0, npos); pos != npos;) {
+        Span span;
+        size_t tag_end;
+        std::string id;
+        if (!element(settings, "object", pos, span, tag_end)) break;
+        if (attribute(settings, pos, tag_end, "id", id) && drop_roots.count(id)) settings_spans.push_back(span);
+        pos = find_tag(settings, "object", span.end, npos);
+    }
+    for (size_t pos = find_tag(settings, "model_instance", 0, npos); pos != npos;) {
+        Span span;
+        size_t tag_end;
+        std::string object_id;
+        if (!element(settings, "model_instance", pos, span, tag_end)) break;
+        if (metadata_value(settings, span, "object_id", object_id) && drop_roots.count(object_id)) settings_spans.push_back(span);
+        pos = find_tag(settings, "model_instance", span.end, npos);
+    }
+    for (size_t pos = find_tag(settings, "assemble_item", 0, npos); pos != npos; pos = find_tag(settings, "assemble_item", pos + 1, npos)) {
+        Span span;
+        size_t tag_end;
+        std::string object_id;
+        if (!element(settings, "assemble_item", pos, span, tag_end)) break;
+        if (attribute(settings, pos, tag_end, "object_id", object_id) && drop_roots.count(object_id)) settings_spans.push_back(span);
+    }
+    for (size_t pos = find_tag(settings, "metadata", 0, npos); pos != npos; pos = find_tag(settings, "metadata", pos + 1, npos)) {
+        Span span;
+        size_t tag_end;
+        std::string value;
+        if (!element(settings, "metadata", pos, span, tag_end)) break;
+        if (attribute(settings, pos, tag_end, "value", value) && dropped_entries.count(entry_name(value))) settings_spans.push_back(span);
+    }
+    rewritten[kModelSettings] = without(settings, settings_spans);
+
+    // Relationship parts must not point at entries left out
+    for (const auto& e : zip.entries()) {
+        if (!ends_with(e.name, ".rels") || dropped_entries.count(e.name)) continue;
+        std::string rels;
+        if (!zip.read(e, rels, reason)) return false;
+        std::vector<Span> spans;
+        for (size_t pos = find_tag(rels, "Relationship", 0, npos); pos != npos; pos = find_tag(rels, "Relationship", pos + 1, npos)) {
+            Span span;
+            size_t tag_end;
+            std::string target;
+            if (!element(rels, "Relationship", pos, span, tag_end)) break;
+            if (attribute(rels, pos, tag_end, "Target", target) && dropped_entries.count(entry_name(target))) spans.push_back(span);
+        }
+        if (!spans.empty()) rewritten[e.name] = without(rels, spans);
+    }
+
+    ZipWriter out;
+    if (!out.open(output_3mf, reason)) return false;
+    for (const auto& e : zip.entries()) {
+        if (dropped_entries.count(e.name)) {
+            ++stats.entries_dropped;
+            stats.bytes_dropped += e.uncompressed_size;
+            continue;
+        }
+        const auto it = rewritten.find(e.name);
+        const bool ok = it != rewritten.end() ? out.add(e, it->second.data(), it->second.size(), kRewriteLevel, reason)
+                                              : out.copyRaw(zip, e, reason);
+        if (!ok) return false;
+        ++(it != rewritten.end() ? stats.entries_rewritten : stats.entries_copied);
+    }
+    if (!out.finish(reason)) return false;
+
+    stats.objects_kept = keep_roots.size();
+    stats.objects_dropped = drop_roots.size();
+    return true;
+}
+
+bool PlateExtractor::readAssets(const std::string& input_3mf, int plate, PlateAssets& assets, std::string& reason)
+{
+    assets = PlateAssets{};
+    ZipReader zip;
+    if (!zip.open(input_3mf, reason)) return false;
+    std::set<std::string> names;
+    for (const auto& name : plate_asset_names(plate)) {
+        const ZipEntry* e = zip.find(name);
+        if (e == nullptr) continue;
+        ZipRawEntry raw;
+        if (!zip.readRaw(*e, raw, reason)) return false;
+        assets.entries.push_back(std::move(raw));
+        names.insert(name);
+    }
+    if (names.empty()) {
+        reason = "no thumbnails for plate " + std::to_string(plate);
+        return false;
+    }
+
+    std::string xml;
+    if (const ZipEntry* rels = zip.find(kRootRels); rels != nullptr && zip.read(*rels, xml, reason)) {
+        for (size_t pos = find_tag(xml, "Relationship", 0, npos); pos != npos; pos = find_tag(xml, "Relationship", pos + 1, npos)) {
+            Span span;
+            size_t tag_end;
+            std::string target;
+            if (!element(xml, "Relationship", pos, span, tag_end)) break;
+            if (attribute(xml, pos, tag_end, "Target", target) && names.count(entry_name(target)))
+                assets.relationships.push_back(xml.substr(span.begin, span.end - span.begin));
+        }
+    }
+    Span plate_span;
+    std::string ignored;
+    if (const ZipEntry* settings = zip.find(kModelSettings);
+        settings != nullptr && zip.read(*settings, xml, reason) && find_plate(xml, plate, plate_span, ignored)) {
+        for (size_t pos = find_tag(xml, "metadata", plate_span.begin, plate_span.end); pos != npos;
+             pos = find_tag(xml, "metadata", pos + 1, plate_span.end)) {
+            Span span;
+            size_t tag_end;
+            std::string value;
+            if (!element(xml, "metadata", pos, span, tag_end)) break;
+            if (attribute(xml, pos, tag_end, "value", value) && names.count(entry_name(value)))
+                assets.plate_metadata.push_back(xml.substr(span.begin, span.end - span.begin));
+        }
+    }
+    reason.clear();
+    return true;
+}
+
+bool PlateExtractor::addAssetReferences(const std::string& part, std::string& content, const PlateAssets& assets)
+{
+    std::string added;
+    size_t insert_at = npos;
+    if (part == kRootRels) {
+        const size_t close = content.rfind("</Relationships>");
+        if (close == npos) return false;
+        insert_at = line_start(content, close);
+        // Existing relationships as target + type, and the ids in use
+        std::set<std::string> present, ids;
+        for (size_t pos = find_tag(content, "Relationship", 0, npos); pos != npos; pos = find_tag(content, "Relationship", pos + 1, npos)) {
+            const size_t tag_end = content.find('>', pos);
+            std::string target, type, id;
+            if (tag_end == npos) break;
+            attribute(content, pos, tag_end, "Target", target);
+            attribute(content, pos, tag_end, "Type", type);
+            if (attribute(content, pos, tag_end, "Id", id)) ids.insert(id);
+            present.insert(entry_name(target) + ' ' + type);
+        }
+        int next_id = 1;
+        for (std::string rel : assets.relationships) {
+            const size_t tag_end = rel.find('>');
+            std::string target, type, id;
+            attribute(rel, 0, tag_end, "Target", target);
+            attribute(rel, 0, tag_end, "Type", type);
+            if (!present.insert(entry_name(target) + ' ' + type).second) continue;
+            if (attribute(rel, 0, tag_end, "Id", id) && ids.count(id)) {
+                std::string fresh;
+                do fresh = "rel-" + std::to_string(next_id++); while (ids.count(fresh));
+                const size_t at = rel.find("\"" + id + "\"");
+                if (at != npos && at < tag_end) rel.replace(at + 1, id.size(), fresh);
+                id = fresh;
+            }
+            ids.insert(id);
+            added += " " + rel + "\n";
+        }
+    } else if (part == kModelSettings) {
+        // An exported .gcode.3mf holds the one sliced plate
+        Span plate_span;
+        size_t tag_end;
+        const size_t first = find_tag(content, "plate", 0, npos);
+        if (first == npos || !element(content, "plate", first, plate_span, tag_end)) return false;
+        if (content.compare(plate_span.end - 8, 8, "</plate>") != 0) return false;
+        insert_at = line_start(content, plate_span.end - 8);
+        for (const std::string& md : assets.plate_metadata) {
+            std::string key, existing;
+            if (!attribute(md, 0, md.find('>'), "key", key) || metadata_value(content, plate_span, key, existing)) continue;
+            added += "    " + md + "\n";
+        }
+    } else if (part == kContentTypes) {
+        const size_t close = content.rfind("</Types>");
+        if (close == npos) return false;
+        insert_at = line_start(content, close);
+        bool has_png = false;
+        for (size_t pos = find_tag(content, "Default", 0, npos); pos != npos && !has_png; pos = find_tag(content, "Default", pos + 1, npos)) {
+            const size_t tag_end = content.find('>', pos);
+            std::string extension;
+            has_png = tag_end != npos && attribute(content, pos, tag_end, "Extension", extension) && extension == "png";
+        }
+        if (!has_png) added = " <Default Extension=\"png\" ContentType=\"image/png\"/>\n";
+    }
+    if (added.empty() || insert_at == npos) return false;
+    content.insert(insert_at, added);
+    return true;
+}
+
+} // namespace OrcaSlicerCli
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "ZipArchive.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace OrcaSlicerCli {
+
+/**
+ * @brief Reduces a multi-plate BBL/Orca 3MF project to the objects of one plate
+ *
+ * load_bbs_3mf inflates and parses every object mesh of a project even when a
+ * single plate is sliced. This reads only the zip central directory, the root
+ * model and Metadata/model_settings.config (plate -> object mapping), then
+ * writes a smaller project next to the scratch outputs that libslic3r can load
+ * in place of the original:
+ *  - mesh entries (the 3D/Objects parts) referenced only by objects of other
+ *    plates, embedded plate G-code and thumbnails are left out;
+ *  - the root model, model_settings.config and the .rels parts are rewritten
+ *    without the dropped objects, instances and references;
+ *  - everything else is copied as compressed bytes, without being inflated.
+ * All plates stay in the project, so plate numbering, plate metadata (less the
+ * references to left-out entries) and the project configuration are unchanged.
+ */
+class PlateExtractor {
+public:
+    struct Stats {
+        size_t objects_kept = 0;
+        size_t objects_dropped = 0;
+        size_t entries_copied = 0;
+        size_t entries_rewritten = 0;
+        size_t entries_dropped = 0;
+        uint64_t bytes_dropped = 0; // uncompressed size of the entries left out
+    };
+
+    /**
+     * @brief Write the reduced project for a 1-based plate to output_3mf
+     * @return false with reason set when the project cannot or need not be reduced
+     *         (not a BBL project, single plate, plate holds every object, unexpected
+     *         layout); the original file should then be loaded as is
+     */
+    static bool extract(const std::string& input_3mf, int plate, const std::string& output_3mf,
+                        Stats& stats, std::string& reason);
+
+    /**
+     * @brief Thumbnails of one plate as stored in a project, with the elements that reference them
+     */
+    struct PlateAssets {
+        std::vector<ZipRawEntry> entries;        // Metadata/plate_N.png, top_N.png, ... (compressed bytes)
+        std::vector<std::string> relationships;  // <Relationship/> elements of _rels/.rels targeting them
+        std::vector<std::string> plate_metadata; // <metadata/> elements of the plate in model_settings.config
+
+        bool empty() const { return entries.empty(); }
+    };
+
+    /**
+     * @brief Read the thumbnails of a 1-based plate without inflating them
+     * @return false with reason set if the project has none or cannot be read
+     */
+    static bool readAssets(const std::string& input_3mf, int plate, PlateAssets& assets, std::string& reason);
+
+    /**
+     * @brief Add the asset references missing from a part of an exported .gcode.3mf
+     *
+     * _rels/.rels gains the relationships, the plate of Metadata/model_settings.config the
+     * metadata and [Content_Types].xml the PNG type; other parts, and references already
+     * present, are left as they are.
+     * @return true if content was changed
+     */
+    static bool addAssetReferences(const std::string& part, std::string& content, const PlateAssets& assets);
+};
+
+} // namespace OrcaSlicerCli
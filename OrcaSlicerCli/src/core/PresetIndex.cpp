@@ -0,0 +1,159 @@
+#include "PresetIndex.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+
+#include "libslic3r/PresetBundle.hpp"
+#include "libslic3r/Preset.hpp"
+#include "nlohmann/json.hpp"
+#include "utils/Logger.hpp"
+
+namespace OrcaSlicerCli {
+
+namespace {
+
+// Exact names go to the front so a preset named like another preset's alias always wins
+void add(std::unordered_map<std::string, std::vector<std::string>>& lookup, const std::string& key, const std::string& name) {
+    if (key.empty()) return;
+    auto& names = lookup[key];
+    if (std::find(names.begin(), names.end(), name) != names.end()) return;
+    if (key == name) names.insert(names.begin(), name);
+    else names.push_back(name);
+}
+
+// Machine model name -> BBL-style model_id, read from the vendor index's machine_model_list
+std::unordered_map<std::string, std::string> read_model_ids(const std::string& resources_path, const std::string& vendor) {
+    namespace fs = std::filesystem;
+    std::unordered_map<std::string, std::string> out;
+    try {
+        fs::path vendor_dir = fs::path(resources_path) / "profiles" / vendor;
+        std::ifstream ifs(fs::path(resources_path) / "profiles" / (vendor + ".json"));
+        if (!ifs) return out;
+        nlohmann::json index; ifs >> index;
+        if (!index.contains("machine_model_list") || !index["machine_model_list"].is_array()) return out;
+        for (const auto& entry : index["machine_model_list"]) {
+            if (!entry.contains("sub_path") || !entry["sub_path"].is_string()) continue;
+            try {
+                std::ifstream mfs(vendor_dir / entry["sub_path"].get<std::string>());
+                nlohmann::json j; mfs >> j;
+                if (j.contains("name") && j["name"].is_string() && j.contains("model_id") && j["model_id"].is_string()) {
+                    out[j["name"].get<std::string>()] = j["model_id"].get<std::string>();
+                }
+            } catch (...) { /* ignore malformed json */ }
+        }
+    } catch (...) { /* ignore malformed vendor index */ }
+    return out;
+}
+
+} // namespace
+
+std::string PresetIndex::modelKey(const std::string& model, const std::string& variant) {
+    return model + '\x1f' + variant;
+}
+
+void PresetIndex::build(const Slic3r::PresetBundle& bundle, uint64_t generation, const std::string& resources_path, const std::set<std::string>& vendors) {
+    m_printers.clear();
+    m_printer_models.clear();
+    m_filaments.clear();
+    m_prints.clear();
+
+    ModelIds model_ids;
+    for (const auto& vendor : vendors) {
+        auto cached = m_vendor_model_ids.find(vendor);
+        if (cached == m_vendor_model_ids.end()) cached = m_vendor_model_ids.emplace(vendor, read_model_ids(resources_path, vendor)).first;
+        for (const auto& kv : cached->second) model_ids[kv.first] = kv.second;
+    }
+    for (const auto& p : bundle.printers) {
+        if (p.is_default) continue;
+        add(m_printers, p.name, p.name);
+        add(m_printers, p.alias, p.name);
+        const std::string model   = p.config.has("printer_model")   ? p.config.opt_string("printer_model")   : std::string();
+        std::string       variant = p.config.has("printer_variant") ? p.config.opt_string("printer_variant") : std::string();
+        // (model, "") matches any variant of the model
+        if (!model.empty()) add(m_printer_models, modelKey(model, std::string()), p.name);
+        if (model.empty() || variant.empty()) continue;
+        std::vector<std::string> variants{variant};
+        // Some presets spell the variant "0.4.0"; requests use "0.4"
+        if (variant.size() > 2 && variant.compare(variant.size() - 2, 2, ".0") == 0 && variant.find('.') != variant.size() - 2) {
+            variants.push_back(variant.substr(0, variant.size() - 2));
+        }
+        auto mid = model_ids.find(model);
+        for (const auto& v : variants) {
+            // G-code headers and 3MF metadata name printers "<model> <diameter> nozzle"
+            add(m_printers, model + " " + v + " nozzle", p.name);
+            add(m_printer_models, modelKey(model, v), p.name);
+            if (mid != model_ids.end()) add(m_printer_models, modelKey(mid->second, v), p.name);
+        }
+    }
+    for (const auto& p : bundle.filaments) {
+        if (p.is_default) continue;
+        add(m_filaments, p.name, p.name);
+        add(m_filaments, p.alias, p.name);
+    }
+    for (const auto& p : bundle.prints) {
+        if (p.is_default) continue;
+        add(m_prints, p.name, p.name);
+        add(m_prints, p.alias, p.name);
+    }
+    m_generation = generation;
+    LOG_DEBUG_STREAM("PresetIndex built: printers=" << m_printers.size() << " models=" << m_printer_models.size()
+              << " filaments=" << m_filaments.size() << " prints=" << m_prints.size());
+}
+
+const Slic3r::Preset* PresetIndex::pick(const Slic3r::PresetCollection& collection, const std::string& key, const std::vector<std::string>& names) {
+    const Slic3r::Preset* first = nullptr;
+    for (const auto& name : names) {
+        const Slic3r::Preset* p = collection.find_preset(name, /*first_visible_if_not_found=*/false, /*real=*/false, /*only_from_library=*/false);
+        if (!p) continue;
+        // Exact name wins; among alias matches prefer one compatible with the selected printer
+        if (name == key || names.size() == 1 || p->is_compatible) return p;
+        if (!first) first = p;
+    }
+    return first;
+}
+
+const Slic3r::Preset* PresetIndex::findPrinter(const Slic3r::PresetBundle& bundle, const std::string& name) const {
+    auto it = m_printers.find(name);
+    if (it != m_printers.end()) {
+        if (auto* p = pick(bundle.printers, name, it->second)) return p;
+    }
+    // "<model> <diameter> nozzle" for a model whose preset is named after the model only
+    const std::string suffix = " nozzle";
+    if (name.size() > suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0) {
+        std::string tmp = name.substr(0, name.size() - suffix.size());
+        auto sp = tmp.find_last_of(' ');
+        if (sp != std::string::npos && sp + 1 < tmp.size() && (std::isdigit((unsigned char)tmp[sp + 1]) || tmp[sp + 1] == '.')) {
+            if (auto* p = findPrinterByModel(bundle, tmp.substr(0, sp), tmp.substr(sp + 1))) return p;
+            auto base = m_printers.find(tmp.substr(0, sp));
+            if (base != m_printers.end()) return pick(bundle.printers, base->first, base->second);
+        }
+    }
+    return nullptr;
+}
+
+const Slic3r::Preset* PresetIndex::findPrinterByModel(const Slic3r::PresetBundle& bundle, const std::string& model, const std::string& variant) const {
+    auto it = m_printer_models.find(modelKey(model, variant));
+    if (it == m_printer_models.end()) return nullptr;
+    // Prefer system presets, as find_system_preset_by_model_and_variant does
+    for (const auto& name : it->second) {
+        const Slic3r::Preset* p = bundle.printers.find_preset(name, false, false, false);
+        if (p && p->is_system) return p;
+    }
+    return pick(bundle.printers, std::string(), it->second);
+}
+
+const Slic3r::Preset* PresetIndex::find(const Slic3r::PresetCollection& collection, const std::string& name) const {
+    const Lookup* lookup = nullptr;
+    switch (collection.type()) {
+        case Slic3r::Preset::TYPE_FILAMENT: lookup = &m_filaments; break;
+        case Slic3r::Preset::TYPE_PRINT:    lookup = &m_prints; break;
+        case Slic3r::Preset::TYPE_PRINTER:  lookup = &m_printers; break;
+        default: return nullptr;
+    }
+    auto it = lookup->find(name);
+    return it == lookup->end() ? nullptr : pick(collection, name, it->second);
+}
+
+} // namespace OrcaSlicerCli
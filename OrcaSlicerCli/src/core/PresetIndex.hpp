@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Slic3r {
+    class Preset;
+    class PresetBundle;
+    class PresetCollection;
+}
+
+namespace OrcaSlicerCli {
+
+/**
+ * @brief Precomputed lookup table from user-facing profile names to presets
+ *
+ * Maps every canonical preset name, alias, and for printers the
+ * "<model> <diameter> nozzle" form, (printer_model, variant) and
+ * (model_id, variant) pairs to canonical preset names. Built once after
+ * vendors are loaded so profile resolution is a hash lookup instead of
+ * repeated collection scans.
+ *
+ * Canonical names (not Preset pointers) are stored because PresetCollection
+ * inserts keep the collection sorted, which invalidates references.
+ *
+ * Staleness is tracked with a generation counter owned by the caller and
+ * bumped on every change to the bundle's preset set; model ids read from the
+ * vendor JSON are cached per vendor so rebuilds do not touch the disk.
+ */
+class PresetIndex {
+public:
+    /**
+     * @brief Rebuild the index from the presets currently in the bundle
+     * @param bundle Preset bundle
+     * @param generation Bundle generation the index is built at
+     * @param resources_path OrcaSlicer resources directory (model_id lookup)
+     * @param vendors Loaded vendor ids
+     */
+    void build(const Slic3r::PresetBundle& bundle, uint64_t generation, const std::string& resources_path, const std::set<std::string>& vendors);
+
+    /**
+     * @brief Check whether the index was built at the given bundle generation
+     */
+    bool isCurrent(uint64_t generation) const { return m_generation == generation; }
+
+    /**
+     * @brief Drop the cached model ids of a vendor so the next build re-reads its JSON (vendor reloaded)
+     */
+    void forgetVendor(const std::string& vendor) { m_vendor_model_ids.erase(vendor); }
+
+    /**
+     * @brief Resolve a printer name, alias or "<model> <diameter> nozzle" string
+     * @return Preset or nullptr when not indexed
+     */
+    const Slic3r::Preset* findPrinter(const Slic3r::PresetBundle& bundle, const std::string& name) const;
+
+    /**
+     * @brief Resolve a printer by (model, nozzle variant); model may be a model_id or a printer_model name
+     *
+     * An empty variant matches any variant of the model (first preset in collection order, system presets first).
+     * @return Preset or nullptr when not indexed
+     */
+    const Slic3r::Preset* findPrinterByModel(const Slic3r::PresetBundle& bundle, const std::string& model, const std::string& variant) const;
+
+    /**
+     * @brief Resolve a filament or process name/alias; ambiguous aliases prefer presets compatible with the selected printer
+     * @param collection bundle.filaments or bundle.prints
+     * @return Preset or nullptr when not indexed
+     */
+    const Slic3r::Preset* find(const Slic3r::PresetCollection& collection, const std::string& name) const;
+
+    bool empty() const { return m_printers.empty() && m_filaments.empty() && m_prints.empty(); }
+
+private:
+    using Lookup = std::unordered_map<std::string, std::vector<std::string>>;
+    using ModelIds = std::unordered_map<std::string, std::string>;
+
+    static std::string modelKey(const std::string& model, const std::string& variant);
+    static const Slic3r::Preset* pick(const Slic3r::PresetCollection& collection, const std::string& key, const std::vector<std::string>& names);
+
+    Lookup m_printers;
+    Lookup m_printer_models;
+    Lookup m_filaments;
+    Lookup m_prints;
+    // Machine model name -> model_id, per vendor, read once per vendor load
+    std::unordered_map<std::string, ModelIds> m_vendor_model_ids;
+    uint64_t m_generation = 0;
+};
+
+} // namespace OrcaSlicerCli
@@ -0,0 +1,303 @@
+#include "PresetSnapshot.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "libslic3r/PresetBundle.hpp"
+#include "libslic3r/Preset.hpp"
+#include "utils/Logger.hpp"
+
+namespace OrcaSlicerCli {
+namespace PresetSnapshot {
+
+namespace {
+
+constexpr char     kMagic[8]      = {'O', 'R', 'C', 'A', 'S', 'N', 'P', '1'};
+constexpr uint32_t kFormatVersion = 1;
+
+enum : uint8_t { FlagSystem = 1, FlagVisible = 2 };
+
+uint64_t fnv1a(uint64_t h, const void* data, size_t len) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < len; ++i) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+uint64_t fnv1a(uint64_t h, const std::string& s) {
+    uint64_t len = s.size();
+    h = fnv1a(h, &len, sizeof(len));
+    return fnv1a(h, s.data(), s.size());
+}
+
+class Writer {
+public:
+    explicit Writer(std::ofstream& os) : m_os(os) {}
+    void u8(uint8_t v) { m_os.write(reinterpret_cast<const char*>(&v), sizeof(v)); }
+    void u32(uint32_t v) { m_os.write(reinterpret_cast<const char*>(&v), sizeof(v)); }
+    void u64(uint64_t v) { m_os.write(reinterpret_cast<const char*>(&v), sizeof(v)); }
+    void str(const std::string& s) { u32(static_cast<uint32_t>(s.size())); m_os.write(s.data(), s.size()); }
+private:
+    std::ofstream& m_os;
+};
+
+// Bounds-checked cursor over the mapped file; any overrun flips ok() to false.
+class Reader {
+public:
+    Reader(const char* data, size_t size) : m_p(data), m_end(data + size) {}
+    bool ok() const { return m_ok; }
+    bool take(void* out, size_t n) {
+        if (!m_ok || static_cast<size_t>(m_end - m_p) < n) { m_ok = false; return false; }
+        std::memcpy(out, m_p, n);
+        m_p += n;
+        return true;
+    }
+    uint8_t  u8()  { uint8_t v = 0;  take(&v, sizeof(v)); return v; }
+    uint32_t u32() { uint32_t v = 0; take(&v, sizeof(v)); return v; }
+    uint64_t u64() { uint64_t v = 0; take(&v, sizeof(v)); return v; }
+    std::string str() {
+        uint32_t n = u32();
+        if (!m_ok || static_cast<size_t>(m_end - m_p) < n) { m_ok = false; return std::string(); }
+        std::string s(m_p, n);
+        m_p += n;
+        return s;
+    }
+private:
+    const char* m_p;
+    const char* m_end;
+    bool m_ok = true;
+};
+
+struct PresetRecord {
+    Slic3r::Preset::Type type = Slic3r::Preset::TYPE_INVALID;
+    uint8_t flags = 0;
+    std::string name, file, alias, vendor, setting_id, filament_id, base_id;
+    std::vector<std::pair<std::string, std::string>> options;
+};
+
+Slic3r::PresetCollection* collection_for(Slic3r::PresetBundle& bundle, Slic3r::Preset::Type type) {
+    switch (type) {
+        case Slic3r::Preset::TYPE_PRINT:    return &bundle.prints;
+        case Slic3r::Preset::TYPE_FILAMENT: return &bundle.filaments;
+        case Slic3r::Preset::TYPE_PRINTER:  return &bundle.printers;
+        default: return nullptr;
+    }
+}
+
+} // namespace
+
+uint64_t computeKey(const std::string& resources_path, std::vector<std::string> vendors, const std::string& engine_version) {
+    namespace fs = std::filesystem;
+    std::sort(vendors.begin(), vendors.end());
+    vendors.erase(std::unique(vendors.begin(), vendors.end()), vendors.end());
+
+    uint64_t h = 1469598103934665603ull;
+    h = fnv1a(h, &kFormatVersion, sizeof(kFormatVersion));
+    h = fnv1a(h, engine_version);
+
+    const fs::path profiles = fs::path(resources_path) / "profiles";
+    for (const auto& vendor : vendors) {
+        h = fnv1a(h, vendor);
+        // Sizes and mtimes are enough to detect a changed resources tree without reading every file
+        std::vector<fs::path> files;
+        std::error_code ec;
+        fs::path index = profiles / (vendor + ".json");
+        if (fs::is_regular_file(index, ec)) files.push_back(index);
+        fs::path dir = profiles / vendor;
+        if (fs::is_directory(dir, ec)) {
+            for (fs::recursive_directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+                if (it->is_regular_file(ec)) files.push_back(it->path());
+            }
+        }
+        std::sort(files.begin(), files.end());
+        for (const auto& f : files) {
+            h = fnv1a(h, f.lexically_relative(profiles).generic_string());
+            uint64_t size = static_cast<uint64_t>(fs::file_size(f, ec));
+            int64_t mtime = static_cast<int64_t>(fs::last_write_time(f, ec).time_since_epoch().count());
+            h = fnv1a(h, &size, sizeof(size));
+            h = fnv1a(h, &mtime, sizeof(mtime));
+        }
+    }
+    return h;
+}
+
+bool save(const std::string& file, uint64_t key, const std::vector<std::string>& vendors,
+          const Slic3r::PresetBundle& bundle, std::string& error) {
+    namespace fs = std::filesystem;
+    const fs::path target(file);
+    const fs::path tmp = target.string() + ".tmp";
+    try {
+        if (target.has_parent_path()) fs::create_directories(target.parent_path());
+        std::ofstream os(tmp, std::ios::binary | std::ios::trunc);
+        if (!os) {
+            error = "Cannot open snapshot file for writing: " + tmp.string();
+            return false;
+        }
+        Writer w(os);
+        os.write(kMagic, sizeof(kMagic));
+        w.u32(kFormatVersion);
+        w.u64(key);
+        w.u32(static_cast<uint32_t>(vendors.size()));
+        for (const auto& v : vendors) w.str(v);
+
+        std::vector<const Slic3r::Preset*> presets;
+        for (const Slic3r::PresetCollection* coll : {static_cast<const Slic3r::PresetCollection*>(&bundle.prints),
+                                                     static_cast<const Slic3r::PresetCollection*>(&bundle.filaments),
+                                                     static_cast<const Slic3r::PresetCollection*>(&bundle.printers)}) {
+            for (const auto& p : *coll) {
+                if (!p.is_default) presets.push_back(&p);
+            }
+        }
+        w.u32(static_cast<uint32_t>(presets.size()));
+        for (const Slic3r::Preset* p : presets) {
+            w.u8(static_cast<uint8_t>(p->type));
+            w.u8(static_cast<uint8_t>((p->is_system ? FlagSystem : 0) | (p->is_visible ? FlagVisible : 0)));
+            w.str(p->name);
+            w.str(p->file);
+            w.str(p->alias);
+            w.str(p->vendor ? p->vendor->id : std::string());
+            w.str(p->setting_id);
+            w.str(p->filament_id);
+            w.str(p->base_id);
+            const auto keys = p->config.keys();
+            w.u32(static_cast<uint32_t>(keys.size()));
+            for (const auto& k : keys) {
+                w.str(k);
+                w.str(p->config.opt_serialize(k));
+            }
+        }
+        os.close();
+        if (!os) {
+            error = "Failed to write snapshot file: " + tmp.string();
+            return false;
+        }
+        fs::rename(tmp, target); // atomic publish
+        LOG_DEBUG_STREAM("PresetSnapshot::save wrote " << presets.size() << " presets to '" << file << "'");
+        return true;
+    } catch (const std::exception& e) {
+        std::error_code ec;
+        fs::remove(tmp, ec);
+        error = std::string("Failed to write snapshot: ") + e.what();
+        return false;
+    }
+}
+
+bool load(const std::string& file, const std::string& resources_path, const std::string& engine_version,
+          Slic3r::PresetBundle& bundle, std::vector<std::string>& vendors_out, std::string& error) {
+    namespace bip = boost::interprocess;
+    std::vector<std::string> vendors;
+    std::vector<PresetRecord> records;
+    try {
+        if (!std::filesystem::exists(file)) {
+            error = "Snapshot file not found: " + file;
+            return false;
+        }
+        bip::file_mapping mapping(file.c_str(), bip::read_only);
+        bip::mapped_region region(mapping, bip::read_only);
+        Reader r(static_cast<const char*>(region.get_address()), region.get_size());
+
+        char magic[sizeof(kMagic)] = {};
+        if (!r.take(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 || r.u32() != kFormatVersion) {
+            error = "Not a preset snapshot (or unsupported format): " + file;
+            return false;
+        }
+        const uint64_t key = r.u64();
+        const uint32_t vendor_count = r.u32();
+        for (uint32_t i = 0; r.ok() && i < vendor_count; ++i) vendors.push_back(r.str());
+        if (!r.ok()) {
+            error = "Truncated snapshot header: " + file;
+            return false;
+        }
+        if (key != computeKey(resources_path, vendors, engine_version)) {
+            error = "Stale snapshot (resources or engine changed): " + file;
+            return false;
+        }
+
+        const uint32_t preset_count = r.u32();
+        records.reserve(r.ok() ? preset_count : 0);
+        for (uint32_t i = 0; r.ok() && i < preset_count; ++i) {
+            PresetRecord rec;
+            rec.type = static_cast<Slic3r::Preset::Type>(r.u8());
+            rec.flags = r.u8();
+            rec.name = r.str();
+            rec.file = r.str();
+            rec.alias = r.str();
+            rec.vendor = r.str();
+            rec.setting_id = r.str();
+            rec.filament_id = r.str();
+            rec.base_id = r.str();
+            const uint32_t opt_count = r.u32();
+            rec.options.reserve(r.ok() ? opt_count : 0);
+            for (uint32_t k = 0; r.ok() && k < opt_count; ++k) {
+                std::string key_name = r.str();
+                rec.options.emplace_back(std::move(key_name), r.str());
+            }
+            records.push_back(std::move(rec));
+        }
+        if (!r.ok()) {
+            error = "Truncated snapshot body: " + file;
+            return false;
+        }
+    } catch (const std::exception& e) {
+        error = std::string("Failed to read snapshot: ") + e.what();
+        return false;
+    }
+
+    // Header and body are valid: apply to a copy and swap it in only once every preset loaded, so an
+    // exception part-way (e.g. an option that fails to deserialize) leaves the caller's bundle untouched.
+    // The copy is cheap at the point snapshots are loaded (start-up, before any vendor is in the bundle).
+    try {
+        Slic3r::PresetBundle staged(bundle);
+        namespace fs = std::filesystem;
+        const std::string profiles = (fs::path(resources_path) / "profiles").string();
+        // Vendor descriptors (printer models/variants) come from the small vendor index JSON only
+        for (const auto& v : vendors) {
+            staged.load_vendor_configs_from_json(profiles, v, Slic3r::PresetBundle::LoadVendorOnly,
+                                                 Slic3r::ForwardCompatibilitySubstitutionRule::EnableSystemSilent);
+        }
+
+        Slic3r::ConfigSubstitutionContext ctx{Slic3r::ForwardCompatibilitySubstitutionRule::EnableSilent};
+        for (auto& rec : records) {
+            Slic3r::PresetCollection* coll = collection_for(staged, rec.type);
+            if (!coll) continue;
+            Slic3r::DynamicPrintConfig config = coll->default_preset().config;
+            for (const auto& kv : rec.options) {
+                config.set_deserialize(kv.first, kv.second, ctx);
+            }
+            Slic3r::Preset& preset = coll->load_preset(rec.file, rec.name, std::move(config), /*select=*/false);
+            preset.is_system   = (rec.flags & FlagSystem) != 0;
+            preset.is_visible  = (rec.flags & FlagVisible) != 0;
+            preset.alias       = rec.alias;
+            preset.setting_id  = rec.setting_id;
+            preset.filament_id = rec.filament_id;
+            preset.base_id     = rec.base_id;
+            auto vit = staged.vendors.find(rec.vendor);
+            preset.vendor = (vit != staged.vendors.end()) ? &vit->second : nullptr;
+        }
+        staged.prints.update_map_alias_to_profile_name();
+        staged.filaments.update_map_alias_to_profile_name();
+        staged.prints.update_map_system_profile_renamed();
+        staged.filaments.update_map_system_profile_renamed();
+        staged.printers.update_map_system_profile_renamed();
+        // PresetBundle's copy assignment re-points the presets' vendor pointers at its own vendors
+        bundle = staged;
+    } catch (const std::exception& e) {
+        error = std::string("Failed to apply snapshot: ") + e.what();
+        return false;
+    }
+
+    LOG_DEBUG_STREAM("PresetSnapshot::load restored " << records.size() << " presets for " << vendors.size()
+              << " vendor(s) from '" << file << "'");
+    vendors_out = std::move(vendors);
+    return true;
+}
+
+} // namespace PresetSnapshot
+} // namespace OrcaSlicerCli
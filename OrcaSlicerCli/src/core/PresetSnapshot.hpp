@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Slic3r {
+    class PresetBundle;
+}
+
+namespace OrcaSlicerCli {
+
+/**
+ * @brief Binary snapshot of the vendor presets loaded into a PresetBundle
+ *
+ * Loading a vendor parses hundreds of JSON files and resolves their
+ * "inherits" chains. A snapshot stores the already resolved presets (full
+ * config per preset) in one compact file that is read back through a memory
+ * mapping, so a warm start skips JSON parsing and inheritance resolution.
+ *
+ * The snapshot is keyed by a hash of the engine version, the vendor list
+ * and the size/mtime of every vendor profile file under resources/profiles.
+ * A snapshot written for different resources is rejected as stale.
+ * The file is a host-local cache (native byte order), not an exchange format.
+ */
+namespace PresetSnapshot {
+
+/**
+ * @brief Compute the snapshot key for the given resources and vendors
+ * @param resources_path OrcaSlicer resources directory
+ * @param vendors Vendor ids (order-insensitive)
+ * @param engine_version Engine version string (CliCore::getVersion())
+ * @return 64-bit key
+ */
+uint64_t computeKey(const std::string& resources_path, std::vector<std::string> vendors, const std::string& engine_version);
+
+/**
+ * @brief Write all non-default print/filament/printer presets to a snapshot file (atomic replace)
+ * @param file Snapshot file path
+ * @param key Key from computeKey()
+ * @param vendors Vendor ids loaded into the bundle
+ * @param bundle Source preset bundle
+ * @param error Error message on failure
+ * @return True on success
+ */
+bool save(const std::string& file, uint64_t key, const std::vector<std::string>& vendors,
+          const Slic3r::PresetBundle& bundle, std::string& error);
+
+/**
+ * @brief Restore presets from a snapshot file into the bundle
+ *
+ * The header is validated against the current resources, and the presets
+ * are applied to a copy of the bundle that replaces it only on success:
+ * a missing, corrupt or stale snapshot, or a failure while applying it,
+ * leaves the bundle as is.
+ * @param file Snapshot file path
+ * @param resources_path Current resources directory (for the staleness check)
+ * @param engine_version Current engine version
+ * @param bundle Destination preset bundle
+ * @param vendors_out Vendor ids restored from the snapshot
+ * @param error Error message on failure
+ * @return True on success
+ */
+bool load(const std::string& file, const std::string& resources_path, const std::string& engine_version,
+          Slic3r::PresetBundle& bundle, std::vector<std::string>& vendors_out, std::string& error);
+
+} // namespace PresetSnapshot
+
+} // namespace OrcaSlicerCli
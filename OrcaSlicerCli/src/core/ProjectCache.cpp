@@ -0,0 +1,92 @@
+#include "ProjectCache.hpp"
+
+#include "utils/Sha256.hpp"
+
+namespace OrcaSlicerCli {
+
+namespace {
+
+std::string finish_key(Sha256& sha, int plate, const std::string& variant) {
+    std::string key = sha.hexDigest();
+    key += '@';
+    key += std::to_string(plate);
+    if (!variant.empty()) {
+        key += '/';
+        key += variant;
+    }
+    return key;
+}
+
+} // namespace
+
+std::string ProjectCache::key(const std::string& path, int plate, const std::string& variant) {
+    Sha256 sha;
+    if (!sha.updateFromFile(path)) return std::string();
+    return finish_key(sha, plate, variant);
+}
+
+std::string ProjectCache::key(const uint8_t* data, size_t size, int plate, const std::string& variant) {
+    if (data == nullptr) return std::string();
+    Sha256 sha;
+    sha.update(data, size);
+    return finish_key(sha, plate, variant);
+}
+
+std::shared_ptr<const ProjectCache::Entry> ProjectCache::find(const std::string& key) {
+    if (m_capacity == 0 || key.empty()) {
+        ++m_misses;
+        return nullptr;
+    }
+    auto it = m_map.find(key);
+    if (it == m_map.end()) {
+        ++m_misses;
+        return nullptr;
+    }
+    m_lru.splice(m_lru.begin(), m_lru, it->second);
+    ++m_hits;
+    return it->second->entry;
+}
+
+void ProjectCache::put(const std::string& key, std::shared_ptr<const Entry> entry) {
+    if (m_capacity == 0 || key.empty() || !entry) return;
+    auto it = m_map.find(key);
+    if (it != m_map.end()) {
+        m_lru.erase(it->second);
+        m_map.erase(it);
+    }
+    m_lru.push_front(Node{key, std::move(entry)});
+    m_map[key] = m_lru.begin();
+    evictOverflow();
+}
+
+void ProjectCache::evictOverflow() {
+    while (m_lru.size() > m_capacity) {
+        m_map.erase(m_lru.back().key);
+        m_lru.pop_back();
+        ++m_evictions;
+    }
+    m_entries = m_lru.size();
+}
+
+void ProjectCache::clear() {
+    m_lru.clear();
+    m_map.clear();
+    m_entries = 0;
+}
+
+void ProjectCache::setCapacity(size_t capacity) {
+    m_capacity = capacity;
+    evictOverflow();
+}
+
+ProjectCache::Stats ProjectCache::stats() const {
+    Stats s;
+    s.hits = m_hits.load();
+    s.misses = m_misses.load();
+    s.evictions = m_evictions.load();
+    s.entries = m_entries.load();
+    s.capacity = m_capacity.load();
+    return s;
+}
+
+} // namespace OrcaSlicerCli
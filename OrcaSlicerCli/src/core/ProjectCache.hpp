@@ -0,0 +1,107 @@
+#pragma once
+
+#include "PlateExtractor.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Slic3r {
+    class DynamicPrintConfig;
+    class Model;
+    class Preset;
+    class Semver;
+}
+
+namespace OrcaSlicerCli {
+
+/**
+ * @brief LRU cache of parsed 3MF projects
+ *
+ * Keyed by the SHA-256 of the project bytes and the selected plate. An entry
+ * holds what Model::read_from_file produced for that plate (model geometry
+ * with its wipe tower, the config read from the project, the embedded
+ * presets, file version), the plate hints derived from the plate data and the
+ * plate's thumbnails, so slicing the same upload again (other profiles,
+ * overrides or output kinds) skips unzipping and parsing. Entries are
+ * immutable; the engine works on copies.
+ */
+class ProjectCache {
+public:
+    struct Entry {
+        std::shared_ptr<const Slic3r::Model> model;
+        std::shared_ptr<const Slic3r::DynamicPrintConfig> config; // working config right after read_from_file
+        std::vector<std::shared_ptr<const Slic3r::Preset>> presets; // project-embedded presets, as loaded
+        std::shared_ptr<const Slic3r::Semver> file_version;
+        bool is_bbl_3mf = false;
+        bool has_plate_data = false;        // plate hints below are only meaningful when set
+        std::string plate_printer_model_id;
+        std::string plate_nozzle_variant;
+        int total_plates_count = 0;
+        PlateExtractor::PlateAssets plate_assets; // the plate's thumbnails, still compressed
+    };
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        size_t entries = 0;
+        size_t capacity = 0;
+    };
+
+    explicit ProjectCache(size_t capacity = 4) : m_capacity(capacity) {}
+
+    bool enabled() const { return m_capacity.load() > 0; }
+
+    /**
+     * @brief Key of a project file for a plate; empty if the file cannot be read
+     * @param variant Distinguishes loads of the same plate that produce different models (e.g. full vs plate-only)
+     */
+    static std::string key(const std::string& path, int plate, const std::string& variant);
+    static std::string key(const uint8_t* data, size_t size, int plate, const std::string& variant);
+
+    /**
+     * @brief Look up a parsed project; counts a hit or a miss
+     */
+    std::shared_ptr<const Entry> find(const std::string& key);
+
+    /**
+     * @brief Insert (or replace) a parsed project, evicting the least recently used one when full
+     */
+    void put(const std::string& key, std::shared_ptr<const Entry> entry);
+
+    void clear();
+
+    /**
+     * @brief Change the maximum number of entries (0 disables the cache)
+     */
+    void setCapacity(size_t capacity);
+
+    /**
+     * @brief Snapshot of the counters; safe to call concurrently with find()/put()
+     */
+    Stats stats() const;
+
+private:
+    struct Node {
+        std::string key;
+        std::shared_ptr<const Entry> entry;
+    };
+
+    void evictOverflow();
+
+    std::atomic<size_t> m_capacity;
+    std::list<Node> m_lru; // front = most recently used
+    std::unordered_map<std::string, std::list<Node>::iterator> m_map;
+    std::atomic<uint64_t> m_hits{0};
+    std::atomic<uint64_t> m_misses{0};
+    std::atomic<uint64_t> m_evictions{0};
+    std::atomic<size_t> m_entries{0};
+};
+
+} // namespace OrcaSlicerCli
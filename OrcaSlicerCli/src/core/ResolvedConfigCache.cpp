@@ -0,0 +1,98 @@
+#include "ResolvedConfigCache.hpp"
+
+#include "libslic3r/PrintConfig.hpp"
+
+namespace OrcaSlicerCli {
+
+namespace {
+
+void append_field(std::string& out, const std::string& s) {
+    out += std::to_string(s.size());
+    out += ':';
+    out += s;
+}
+
+} // namespace
+
+std::string ResolvedConfigCache::canonical(const Key& key) {
+    std::string out;
+    append_field(out, key.printer);
+    append_field(out, key.filament);
+    append_field(out, key.process);
+    for (const auto& kv : key.overrides) { // std::map: already sorted by key
+        append_field(out, kv.first);
+        append_field(out, kv.second);
+    }
+    return out;
+}
+
+uint64_t ResolvedConfigCache::hash(const Key& key) {
+    const std::string text = canonical(key);
+    uint64_t h = 1469598103934665603ull;
+    for (unsigned char c : text) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+const ResolvedConfigCache::Entry* ResolvedConfigCache::find(const Key& key) {
+    if (m_capacity == 0) {
+        ++m_misses;
+        return nullptr;
+    }
+    const std::string text = canonical(key);
+    auto it = m_map.find(hash(key));
+    if (it == m_map.end() || it->second->canonical != text) {
+        ++m_misses;
+        return nullptr;
+    }
+    m_lru.splice(m_lru.begin(), m_lru, it->second);
+    ++m_hits;
+    return &it->second->entry;
+}
+
+void ResolvedConfigCache::put(const Key& key, Entry entry) {
+    if (m_capacity == 0) return;
+    const uint64_t h = hash(key);
+    auto it = m_map.find(h);
+    if (it != m_map.end()) {
+        m_lru.erase(it->second);
+        m_map.erase(it);
+    }
+    m_lru.push_front(Node{h, canonical(key), std::move(entry)});
+    m_map[h] = m_lru.begin();
+    evictOverflow();
+}
+
+void ResolvedConfigCache::evictOverflow() {
+    while (m_lru.size() > m_capacity) {
+        m_map.erase(m_lru.back().hash);
+        m_lru.pop_back();
+        ++m_evictions;
+    }
+    m_entries = m_lru.size();
+}
+
+void ResolvedConfigCache::clear() {
+    m_lru.clear();
+    m_map.clear();
+    m_entries = 0;
+}
+
+void ResolvedConfigCache::setCapacity(size_t capacity) {
+    m_capacity = capacity;
+    evictOverflow();
+}
+
+ResolvedConfigCache::Stats ResolvedConfigCache::stats() const {
+    Stats s;
+    s.hits = m_hits.load();
+    s.misses = m_misses.load();
+    s.evictions = m_evictions.load();
+    s.entries = m_entries.load();
+    s.capacity = m_capacity.load();
+    return s;
+}
+
+} // namespace OrcaSlicerCli
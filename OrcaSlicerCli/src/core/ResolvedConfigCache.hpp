@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace Slic3r {
+    class DynamicPrintConfig;
+}
+
+namespace OrcaSlicerCli {
+
+/**
+ * @brief LRU cache of fully resolved slicing configs
+ *
+ * Keyed by a stable 64-bit hash of the selected printer/filament/process
+ * presets and the (sorted) override map. An entry holds the working config
+ * after preset activation and overrides, so a repeated combination skips
+ * select_preset_by_name/update_compatible/full_config_secure and the
+ * per-key override parsing.
+ */
+class ResolvedConfigCache {
+public:
+    struct Key {
+        std::string printer;
+        std::string filament;
+        std::string process;
+        std::map<std::string, std::string> overrides;
+    };
+
+    struct Entry {
+        std::string printer;   // canonical preset names selected when the entry was built
+        std::string filament;
+        std::string process;
+        std::shared_ptr<const Slic3r::DynamicPrintConfig> config;
+    };
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        size_t entries = 0;
+        size_t capacity = 0;
+    };
+
+    explicit ResolvedConfigCache(size_t capacity = 32) : m_capacity(capacity) {}
+
+    /**
+     * @brief Look up a resolved config; counts a hit or a miss
+     * @return Entry or nullptr
+     */
+    const Entry* find(const Key& key);
+
+    /**
+     * @brief Insert (or replace) the resolved config for a key, evicting the least recently used entry when full
+     */
+    void put(const Key& key, Entry entry);
+
+    /**
+     * @brief Drop all entries (presets changed); counters are kept
+     */
+    void clear();
+
+    /**
+     * @brief Change the maximum number of entries (0 disables the cache); must not race with find()/put()
+     */
+    void setCapacity(size_t capacity);
+    size_t capacity() const { return m_capacity.load(); }
+
+    /**
+     * @brief Snapshot of the counters; safe to call concurrently with find()/put()
+     */
+    Stats stats() const;
+
+    /**
+     * @brief Stable hash of a key (FNV-1a over length-prefixed fields)
+     */
+    static uint64_t hash(const Key& key);
+
+private:
+    static std::string canonical(const Key& key);
+
+    struct Node {
+        uint64_t hash;
+        std::string canonical; // guards against hash collisions
+        Entry entry;
+    };
+
+    void evictOverflow();
+
+    std::atomic<size_t> m_capacity;
+    std::list<Node> m_lru; // front = most recently used
+    std::unordered_map<uint64_t, std::list<Node>::iterator> m_map;
+    // Counters are atomic so stats() may be read from another thread while the engine slices
+    std::atomic<uint64_t> m_hits{0};
+    std::atomic<uint64_t> m_misses{0};
+    std::atomic<uint64_t> m_evictions{0};
+    std::atomic<size_t> m_entries{0};
+};
+
+} // namespace OrcaSlicerCli
@@ -0,0 +1,290 @@
+#include "SliceResultCache.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "utils/Logger.hpp"
+#include "utils/Sha256.hpp"
+
+namespace OrcaSlicerCli {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr auto kPollInterval = std::chrono::milliseconds(50);
+// A claim older than this is considered abandoned even if its pid is alive (pid reuse, hung worker)
+constexpr auto kMaxClaimAge = std::chrono::hours(1);
+
+long current_pid() {
+#if defined(_WIN32)
+    return static_cast<long>(_getpid());
+#else
+    return static_cast<long>(::getpid());
+#endif
+}
+
+void hash_field(Sha256& sha, const std::string& s) {
+    const std::string len = std::to_string(s.size()) + ":";
+    sha.update(len);
+    sha.update(s);
+}
+
+bool is_internal_file(const fs::path& p) {
+    const std::string ext = p.extension().string();
+    return ext == ".lock" || ext == ".tmp";
+}
+
+void hash_job(Sha256& sha, int plate_index, const std::string& config_text, const std::string& engine_version,
+              const std::string& output_suffix, const std::string& input_name) {
+    hash_field(sha, "orcacli-slice-result/2");
+    hash_field(sha, engine_version);
+    hash_field(sha, std::to_string(plate_index));
+    hash_field(sha, output_suffix);
+    hash_field(sha, config_text);
+    hash_field(sha, input_name);
+}
+
+} // namespace
+
+void SliceResultCache::configure(const std::string& dir, uint64_t max_bytes) {
+    m_dir.clear();
+    m_max_bytes = max_bytes;
+    if (dir.empty()) return;
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+    if (ec || !fs::is_directory(dir)) {
+        LOG_WARNING_STREAM("Slice result cache disabled: cannot create '" << dir << "': " << ec.message());
+        return;
+    }
+    m_dir = dir;
+    LOG_DEBUG_STREAM("Slice result cache at '" << m_dir << "' (max " << (m_max_bytes >> 20) << " MiB)");
+}
+
+std::string SliceResultCache::computeKey(const std::string& input_file, int plate_index, const std::string& config_text,
+                                         const std::string& engine_version, const std::string& output_suffix,
+                                         const std::string& input_name) {
+    Sha256 sha;
+    hash_job(sha, plate_index, config_text, engine_version, output_suffix, input_name);
+    std::error_code ec;
+    const auto size = fs::file_size(input_file, ec);
+    if (ec) return std::string();
+    hash_field(sha, std::to_string(size));
+    if (!sha.updateFromFile(input_file)) return std::string();
+    return sha.hexDigest();
+}
+
+std::string SliceResultCache::computeKey(const uint8_t* data, size_t size, int plate_index, const std::string& config_text,
+                                         const std::string& engine_version, const std::string& output_suffix,
+                                         const std::string& input_name) {
+    if (data == nullptr) return std::string();
+    Sha256 sha;
+    hash_job(sha, plate_index, config_text, engine_version, output_suffix, input_name);
+    hash_field(sha, std::to_string(size));
+    sha.update(data, size);
+    return sha.hexDigest();
+}
+
+std::string SliceResultCache::outputSuffix(const std::string& output_file) {
+    auto ends_with = [&](const char* s) {
+        const std::string suffix(s);
+        if (output_file.size() < suffix.size()) return false;
+        return std::equal(suffix.rbegin(), suffix.rend(), output_file.rbegin(),
+                          [](char a, char b) { return a == std::tolower(static_cast<unsigned char>(b)); });
+    };
+    if (ends_with(".gcode.3mf")) return ".gcode.3mf";
+    if (ends_with(".3mf")) return ".3mf";
+    if (ends_with(".gcode.gz")) return ".gcode.gz";
+    if (ends_with(".gcode.zst")) return ".gcode.zst";
+    if (ends_with(".bgcode")) return ".bgcode";
+    return ".gcode";
+}
+
+std::string SliceResultCache::entryPath(const std::string& key, const std::string& suffix) const {
+    return (fs::path(m_dir) / (key + suffix)).string();
+}
+
+std::string SliceResultCache::lockPath(const std::string& key) const {
+    return (fs::path(m_dir) / (key + ".lock")).string();
+}
+
+bool SliceResultCache::serve(const std::string& entry, const std::string& output_file) {
+    std::error_code ec;
+    if (!fs::exists(entry, ec)) return false;
+    if (!output_file.empty()) {
+        fs::copy_file(entry, output_file, fs::copy_options::overwrite_existing, ec);
+        if (ec) return false; // evicted in between, or output not writable: fall back to slicing
+    }
+    fs::last_write_time(entry, fs::file_time_type::clock::now(), ec); // LRU touch
+    return true;
+}
+
+int SliceResultCache::tryClaim(const std::string& key) {
+    const std::string pid = std::to_string(current_pid()) + "\n";
+#if defined(_WIN32)
+    // "x": exclusive create, atomic across processes
+    errno = 0;
+    FILE* f = std::fopen(lockPath(key).c_str(), "wx");
+    if (!f) return errno ? errno : EACCES;
+    std::fputs(pid.c_str(), f);
+    std::fclose(f);
+#else
+    // O_EXCL: atomic across processes
+    const int fd = ::open(lockPath(key).c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+    if (fd < 0) return errno;
+    ssize_t ignored = ::write(fd, pid.data(), pid.size());
+    (void)ignored;
+    ::close(fd);
+#endif
+    return 0;
+}
+
+bool SliceResultCache::lockIsStale(const std::string& lock) const {
+    std::error_code ec;
+    const auto mtime = fs::last_write_time(lock, ec);
+    if (ec) return false; // released meanwhile
+    if (fs::file_time_type::clock::now() - mtime > kMaxClaimAge) return true;
+#if !defined(_WIN32)
+    long pid = 0;
+    std::ifstream ifs(lock);
+    if (ifs >> pid && pid > 0 && pid != current_pid()) {
+        if (::kill(static_cast<pid_t>(pid), 0) != 0 && errno == ESRCH) return true;
+    }
+#endif
+    return false;
+}
+
+SliceResultCache::Lookup SliceResultCache::acquire(const std::string& key, const std::string& suffix, const std::string& output_file,
+                                                   const std::function<bool()>& should_stop) {
+    if (!enabled() || key.empty()) return Lookup::Bypass;
+    const std::string entry = entryPath(key, suffix);
+    const std::string lock = lockPath(key);
+    bool waited = false;
+    for (;;) {
+        if (serve(entry, output_file)) {
+            ++m_hits;
+            if (waited) ++m_coalesced;
+            LOG_DEBUG_STREAM("Slice result cache hit " << key.substr(0, 16) << (waited ? " (coalesced)" : ""));
+            return Lookup::Hit;
+        }
+        const int claim_error = tryClaim(key);
+        if (claim_error == 0) {
+            // The owner may have published between our check and its unlock
+            if (serve(entry, output_file)) {
+                release(key);
+                ++m_hits;
+                if (waited) ++m_coalesced;
+                return Lookup::Hit;
+            }
+            ++m_misses;
+            LOG_DEBUG_STREAM("Slice result cache miss " << key.substr(0, 16) << " (claimed)");
+            return Lookup::Claimed;
+        }
+        if (claim_error != EEXIST) {
+            // Not another job's claim: the directory cannot take the lock (read-only, full, no permission)
+            if (!m_claim_error_logged.exchange(true)) {
+                LOG_WARNING_STREAM("Slice result cache: cannot create claims in '" << m_dir << "' ("
+                                   << std::generic_category().message(claim_error) << "); slicing without the cache");
+            }
+            return Lookup::Bypass;
+        }
+        std::error_code ec;
+        if (!fs::exists(lock, ec)) {
+            if (ec) return Lookup::Bypass;
+            continue; // released between tryClaim and here
+        }
+        if (lockIsStale(lock)) {
+            LOG_WARNING_STREAM("Slice result cache: taking over abandoned claim " << key.substr(0, 16));
+            fs::remove(lock, ec);
+            continue;
+        }
+        if (should_stop && should_stop()) {
+            LOG_DEBUG_STREAM("Slice result cache: stopped waiting for identical job " << key.substr(0, 16));
+            return Lookup::Stopped;
+        }
+        if (!waited) {
+            LOG_DEBUG_STREAM("Slice result cache: waiting for identical job " << key.substr(0, 16));
+            waited = true;
+        }
+        std::this_thread::sleep_for(kPollInterval);
+    }
+}
+
+void SliceResultCache::publish(const std::string& key, const std::string& suffix, const std::string& output_file) {
+    if (!enabled() || key.empty()) return;
+    std::error_code ec;
+    std::ostringstream tmp_name;
+    tmp_name << key << "." << current_pid() << "." << std::this_thread::get_id() << ".tmp";
+    const fs::path tmp = fs::path(m_dir) / tmp_name.str();
+    const std::string entry = entryPath(key, suffix);
+    fs::copy_file(output_file, tmp, fs::copy_options::overwrite_existing, ec);
+    if (!ec) fs::rename(tmp, entry, ec);
+    if (ec) {
+        LOG_WARNING_STREAM("Slice result cache: failed to store " << key.substr(0, 16) << ": " << ec.message());
+        std::error_code ignore;
+        fs::remove(tmp, ignore);
+    }
+    release(key);
+    if (!ec) evict(entry);
+}
+
+void SliceResultCache::release(const std::string& key) {
+    if (!enabled() || key.empty()) return;
+    std::error_code ec;
+    fs::remove(lockPath(key), ec);
+}
+
+void SliceResultCache::evict(const std::string& keep) {
+    struct Item { fs::path path; uint64_t size; fs::file_time_type mtime; };
+    std::vector<Item> items;
+    uint64_t total = 0;
+    std::error_code ec;
+    for (fs::directory_iterator it(m_dir, ec), end; !ec && it != end; it.increment(ec)) {
+        std::error_code fec;
+        if (!it->is_regular_file(fec) || is_internal_file(it->path())) continue;
+        Item item{it->path(), static_cast<uint64_t>(it->file_size(fec)), it->last_write_time(fec)};
+        if (fec) continue;
+        total += item.size;
+        items.push_back(std::move(item));
+    }
+    if (total <= m_max_bytes) return;
+    std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) { return a.mtime < b.mtime; });
+    for (const auto& item : items) {
+        if (total <= m_max_bytes) break;
+        if (item.path == fs::path(keep)) continue;
+        std::error_code rec;
+        if (fs::remove(item.path, rec)) {
+            total -= item.size;
+            ++m_evictions;
+        }
+    }
+}
+
+SliceResultCache::Stats SliceResultCache::stats() const {
+    Stats s;
+    s.hits = m_hits.load();
+    s.misses = m_misses.load();
+    s.coalesced = m_coalesced.load();
+    s.evictions = m_evictions.load();
+    return s;
+}
+
+} // namespace OrcaSlicerCli
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace OrcaSlicerCli {
+
+/**
+ * @brief Content-addressed on-disk cache of slicing results
+ *
+ * Entries are named by the SHA-256 of the input model bytes and name, plate index,
+ * serialized resolved config, engine version and output kind, and hold the
+ * exported .gcode / .gcode.3mf. The directory may be shared by several
+ * engines and processes:
+ *  - results are published with a temp file + rename, so readers never see
+ *    a partial entry;
+ *  - the first job for a key claims it with an exclusive "<key>.lock" file;
+ *    identical jobs arriving meanwhile wait for that result instead of
+ *    slicing again (a lock whose owner died is taken over); a lock that
+ *    cannot be created (read-only directory, disk full) bypasses the cache;
+ *  - the total size is bounded; least recently used entries (by mtime,
+ *    refreshed on every hit) are evicted after each publish.
+ */
+class SliceResultCache {
+public:
+    enum class Lookup {
+        Hit,     ///< Cached result copied to the output file
+        Claimed, ///< Caller owns the key: slice, then publish() or release()
+        Bypass,  ///< Cache unusable for this job (I/O error); slice without caching
+        Stopped  ///< should_stop() turned true while waiting for another job's claim
+    };
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t coalesced = 0; // hits served after waiting for another job's claim
+        uint64_t evictions = 0;
+    };
+
+    /**
+     * @brief Enable the cache in a directory (created if missing); an empty dir disables it
+     * @param max_bytes Size budget for all entries
+     */
+    void configure(const std::string& dir, uint64_t max_bytes);
+    bool enabled() const { return !m_dir.empty(); }
+    const std::string& directory() const { return m_dir; }
+
+    /**
+     * @brief Compute the cache key for a job
+     * @param input_file Model file whose bytes are hashed
+     * @param plate_index Plate index as passed to the slicer
+     * @param config_text Canonical serialization of the resolved config
+     * @param engine_version CliCore::getVersion()
+     * @param output_suffix Output kind (see outputSuffix())
+     * @param input_name Model name as it ends up in the output (object name, G-code header, slice_info)
+     * @return 64 hex characters, or empty if the input cannot be read
+     */
+    static std::string computeKey(const std::string& input_file, int plate_index, const std::string& config_text,
+                                  const std::string& engine_version, const std::string& output_suffix,
+                                  const std::string& input_name);
+
+    /**
+     * @brief Same key for a model held in memory; equal bytes and name give the key of the file
+     */
+    static std::string computeKey(const uint8_t* data, size_t size, int plate_index, const std::string& config_text,
+                                  const std::string& engine_version, const std::string& output_suffix,
+                                  const std::string& input_name);
+
+    /**
+     * @brief Output kind of a path: ".gcode.3mf", ".3mf", ".gcode.gz", ".gcode.zst", ".bgcode" or ".gcode" (the default)
+     */
+    static std::string outputSuffix(const std::string& output_file);
+
+    /**
+     * @brief Serve a cached result into output_file, or claim the key
+     *
+     * Blocks while another engine or process holds the claim for the same key.
+     * @param should_stop Checked on every poll while waiting (job canceled or past its deadline)
+     */
+    Lookup acquire(const std::string& key, const std::string& suffix, const std::string& output_file,
+                   const std::function<bool()>& should_stop = {});
+
+    /**
+     * @brief Store output_file as the result of a claimed key, drop the claim and evict over budget
+     */
+    void publish(const std::string& key, const std::string& suffix, const std::string& output_file);
+
+    /**
+     * @brief Drop a claim without storing a result (slicing failed)
+     */
+    void release(const std::string& key);
+
+    Stats stats() const;
+
+private:
+    std::string entryPath(const std::string& key, const std::string& suffix) const;
+    std::string lockPath(const std::string& key) const;
+    bool serve(const std::string& entry, const std::string& output_file);
+    /// 0 when the claim was created, else the errno of the exclusive create (EEXIST: another job owns the key)
+    int tryClaim(const std::string& key);
+    bool lockIsStale(const std::string& lock) const;
+    void evict(const std::string& keep);
+
+    std::string m_dir;
+    uint64_t m_max_bytes = 0;
+    std::atomic<uint64_t> m_hits{0};
+    std::atomic<uint64_t> m_misses{0};
+    std::atomic<uint64_t> m_coalesced{0};
+    std::atomic<uint64_t> m_evictions{0};
+    std::atomic<bool> m_claim_error_logged{false};
+};
+
+} // namespace OrcaSlicerCli
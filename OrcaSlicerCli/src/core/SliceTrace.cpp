@@ -0,0 +1,259 @@
+#include "SliceTrace.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace OrcaSlicerCli {
+
+namespace {
+
+constexpr size_t kDetailSize = 96;
+
+// A span as write() reads it
+struct Event {
+    uint64_t session = 0;
+    const char* name = nullptr;
+    const char* category = nullptr;
+    const char* track = nullptr; // virtual track; null = the recording thread
+    int64_t begin_ns = 0;        // steady_clock since epoch
+    int64_t end_ns = 0;
+    char detail[kDetailSize] = {};
+};
+
+// Ring slot, a seqlock: the owning thread may overwrite it while write() copies it, so every field is
+// a relaxed atomic and `seq` tells the reader whether its copy is one whole span.
+struct Slot {
+    std::atomic<uint64_t> seq{0}; // 2 * index + 1 while span `index` is written, 2 * index + 2 once complete
+    std::atomic<uint64_t> session{0};
+    std::atomic<const char*> name{nullptr};
+    std::atomic<const char*> category{nullptr};
+    std::atomic<const char*> track{nullptr};
+    std::atomic<int64_t> begin_ns{0};
+    std::atomic<int64_t> end_ns{0};
+    std::atomic<uint64_t> detail[kDetailSize / 8] = {};
+};
+
+// Ring of one thread's spans: only that thread writes
+struct ThreadBuffer {
+    std::unique_ptr<Slot[]> slots{new Slot[SliceTrace::kThreadCapacity]};
+    std::atomic<uint64_t> written{0};
+    std::atomic<const char*> name{nullptr};
+    uint32_t tid = 0;
+};
+
+std::mutex g_registry_mutex; // only taken when a thread records its first span, and by Session::write
+std::vector<std::shared_ptr<ThreadBuffer>> g_registry;
+std::atomic<uint64_t> g_next_session{1};
+
+thread_local uint64_t t_session = 0;
+thread_local std::shared_ptr<ThreadBuffer> t_buffer;
+
+ThreadBuffer& thread_buffer() {
+    if (!t_buffer) {
+        auto buffer = std::make_shared<ThreadBuffer>();
+        std::lock_guard<std::mutex> lk(g_registry_mutex);
+        buffer->tid = static_cast<uint32_t>(g_registry.size() + 1);
+        g_registry.push_back(buffer);
+        t_buffer = std::move(buffer);
+    }
+    return *t_buffer;
+}
+
+int64_t to_ns(SliceTrace::Clock::time_point t) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+}
+
+void append(uint64_t session, const char* track, const char* name, const char* category,
+            SliceTrace::Clock::time_point begin, SliceTrace::Clock::time_point end, const std::string& detail) {
+    ThreadBuffer& buffer = thread_buffer();
+    const uint64_t index = buffer.written.load(std::memory_order_relaxed);
+    Slot& slot = buffer.slots[index % SliceTrace::kThreadCapacity];
+    slot.seq.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release); // a reader seeing any field below also sees the odd seq
+    slot.session.store(session, std::memory_order_relaxed);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.category.store(category, std::memory_order_relaxed);
+    slot.track.store(track, std::memory_order_relaxed);
+    slot.begin_ns.store(to_ns(begin), std::memory_order_relaxed);
+    slot.end_ns.store(to_ns(end), std::memory_order_relaxed);
+    char text[kDetailSize] = {};
+    std::memcpy(text, detail.data(), std::min(detail.size(), kDetailSize - 1));
+    for (size_t w = 0; w < kDetailSize / 8; ++w) {
+        uint64_t word;
+        std::memcpy(&word, text + 8 * w, 8);
+        slot.detail[w].store(word, std::memory_order_relaxed);
+    }
+    slot.seq.store(2 * index + 2, std::memory_order_release);
+    buffer.written.store(index + 1, std::memory_order_release);
+}
+
+// Copy span `index` out of its slot; false if it is being or has been overwritten
+bool read_slot(const Slot& slot, uint64_t index, Event& e) {
+    const uint64_t seq = slot.seq.load(std::memory_order_acquire);
+    if (seq != 2 * index + 2) return false;
+    e.session = slot.session.load(std::memory_order_relaxed);
+    e.name = slot.name.load(std::memory_order_relaxed);
+    e.category = slot.category.load(std::memory_order_relaxed);
+    e.track = slot.track.load(std::memory_order_relaxed);
+    e.begin_ns = slot.begin_ns.load(std::memory_order_relaxed);
+    e.end_ns = slot.end_ns.load(std::memory_order_relaxed);
+    for (size_t w = 0; w < kDetailSize / 8; ++w) {
+        const uint64_t word = slot.detail[w].load(std::memory_order_relaxed);
+        std::memcpy(e.detail + 8 * w, &word, 8);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire); // orders the copies before the re-check
+    return slot.seq.load(std::memory_order_relaxed) == seq;
+}
+
+void append_json_string(std::string& out, const char* s) {
+    out += '"';
+    for (; s && *s; ++s) {
+        const unsigned char c = static_cast<unsigned char>(*s);
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += static_cast<char>(c);
+        } else if (c < 0x20) {
+            char esc[8];
+            std::snprintf(esc, sizeof(esc), "\\u%04x", c);
+            out += esc;
+        } else {
+            out += static_cast<char>(c);
+        }
+    }
+    out += '"';
+}
+
+} // namespace
+
+std::atomic<int> SliceTrace::s_sessions{0};
+
+SliceTrace::Session::Session()
+    : m_id(g_next_session.fetch_add(1)), m_previous(t_session) {
+    nameThread("slice job"); // allocates this thread's ring on first use, before the clock starts
+    t_session = m_id;
+    s_sessions.fetch_add(1);
+    m_start = Clock::now();
+}
+
+SliceTrace::Session::~Session() {
+    t_session = m_previous;
+    s_sessions.fetch_sub(1);
+}
+
+bool SliceTrace::Session::write(const std::string& file, std::string& error) const {
+    struct Span {
+        uint32_t tid;
+        Event event;
+    };
+    std::vector<Span> spans;
+    std::map<uint32_t, std::string> track_names;
+    std::map<std::string, uint32_t> virtual_tracks;
+    {
+        std::lock_guard<std::mutex> lk(g_registry_mutex);
+        for (const auto& buffer : g_registry) {
+            const uint64_t written = buffer->written.load(std::memory_order_acquire);
+            const uint64_t first = written > kThreadCapacity ? written - kThreadCapacity : 0;
+            for (uint64_t i = first; i < written; ++i) {
+                Event e;
+                if (!read_slot(buffer->slots[i % kThreadCapacity], i, e)) continue; // overwritten meanwhile
+                if (e.session != m_id) continue;
+                uint32_t tid = buffer->tid;
+                if (e.track) {
+                    // Virtual tracks after the thread ids
+                    auto it = virtual_tracks.emplace(e.track, 0).first;
+                    if (it->second == 0) it->second = 100000 + static_cast<uint32_t>(virtual_tracks.size());
+                    tid = it->second;
+                    track_names[tid] = e.track;
+                } else if (!track_names.count(tid)) {
+                    const char* name = buffer->name.load();
+                    track_names[tid] = name ? name : "thread " + std::to_string(tid);
+                }
+                spans.push_back({tid, e});
+            }
+        }
+    }
+    std::sort(spans.begin(), spans.end(), [](const Span& a, const Span& b) { return a.event.begin_ns < b.event.begin_ns; });
+
+    const int64_t origin = to_ns(m_start);
+    std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"orcaslicer slice\"}}";
+    for (const auto& [tid, name] : track_names) {
+        out += ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + std::to_string(tid) + ",\"args\":{\"name\":";
+        append_json_string(out, name.c_str());
+        out += "}}";
+    }
+    char times[96];
+    for (const auto& span : spans) {
+        const Event& e = span.event;
+        out += ",\n{\"name\":";
+        append_json_string(out, e.name);
+        out += ",\"cat\":";
+        append_json_string(out, e.category);
+        // Chrome trace times are microseconds
+        std::snprintf(times, sizeof(times), ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f", span.tid,
+                      static_cast<double>(e.begin_ns - origin) / 1000.0, static_cast<double>(e.end_ns - e.begin_ns) / 1000.0);
+        out += times;
+        if (e.detail[0]) {
+            out += ",\"args\":{\"detail\":";
+            append_json_string(out, e.detail);
+            out += '}';
+        }
+        out += '}';
+    }
+    out += "\n]}\n";
+
+    const std::string tmp = file + ".tmp";
+    {
+        std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+        if (!f || !(f << out)) {
+            error = "cannot write " + tmp;
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, file, ec);
+    if (ec) {
+        error = "cannot write " + file + ": " + ec.message();
+        return false;
+    }
+    return true;
+}
+
+void SliceTrace::Scope::start(const char* name, const char* category, const std::string& detail) {
+    if (t_session == 0) return;
+    m_name = name;
+    m_category = category;
+    m_detail = detail;
+    m_begin = Clock::now();
+}
+
+void SliceTrace::Scope::finish() {
+    append(t_session, nullptr, m_name, m_category, m_begin, Clock::now(), m_detail);
+}
+
+uint64_t SliceTrace::currentSession() {
+    return t_session;
+}
+
+void SliceTrace::record(const char* name, const char* category, Clock::time_point begin, Clock::time_point end,
+                        const std::string& detail) {
+    if (enabled() && t_session != 0) append(t_session, nullptr, name, category, begin, end, detail);
+}
+
+void SliceTrace::recordFor(uint64_t session, const char* track, const char* name, const char* category,
+                           Clock::time_point begin, Clock::time_point end, const std::string& detail) {
+    if (session != 0) append(session, track, name, category, begin, end, detail);
+}
+
+void SliceTrace::nameThread(const char* name) {
+    thread_buffer().name.store(name);
+}
+
+} // namespace OrcaSlicerCli
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace OrcaSlicerCli {
+
+/**
+ * @brief Opt-in timeline of one slice job, written as Chrome trace JSON
+ *
+ * A Session makes the creating thread record spans (Scope, record()) until
+ * it ends; other threads (TBB workers, status callbacks) add spans for the
+ * session through recordFor(). Each thread appends to its own fixed-size
+ * ring (single writer, no lock); write() reads all rings once the job is
+ * done. Ring slots are seqlocks of atomic fields, so a thread still
+ * recording for another job while write() runs is not a data race: a span
+ * overwritten during the copy is dropped. The file opens in chrome://tracing or https://ui.perfetto.dev.
+ *
+ * While no session is active anywhere in the process, a Scope costs one
+ * relaxed atomic load.
+ */
+class SliceTrace {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Spans kept per thread; older spans of a long job are overwritten
+    static constexpr size_t kThreadCapacity = 4096;
+
+    class Session {
+    public:
+        Session();
+        ~Session();
+        Session(const Session&) = delete;
+        Session& operator=(const Session&) = delete;
+
+        uint64_t id() const { return m_id; }
+
+        /**
+         * @brief Write the spans of this session (atomically: temp file + rename)
+         * @return False with error set if the file cannot be written
+         */
+        bool write(const std::string& file, std::string& error) const;
+
+    private:
+        uint64_t m_id;
+        uint64_t m_previous; // session of this thread before (sessions nest)
+        Clock::time_point m_start;
+    };
+
+    /**
+     * @brief Span on the current thread, from construction to destruction
+     *
+     * No-op unless the thread belongs to a session. detail is only copied when recording.
+     */
+    class Scope {
+    public:
+        explicit Scope(const char* name, const char* category = "core", const std::string& detail = std::string())
+        {
+            if (enabled()) start(name, category, detail);
+        }
+        ~Scope()
+        {
+            if (m_name) finish();
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        void start(const char* name, const char* category, const std::string& detail);
+        void finish();
+
+        const char* m_name = nullptr; // null = not recording
+        const char* m_category = nullptr;
+        std::string m_detail;
+        Clock::time_point m_begin;
+    };
+
+    static bool enabled() { return s_sessions.load(std::memory_order_relaxed) > 0; }
+
+    /// Session of the current thread; 0 if it is not tracing
+    static uint64_t currentSession();
+
+    /// Span of the current thread's session (no-op without one)
+    static void record(const char* name, const char* category, Clock::time_point begin, Clock::time_point end,
+                       const std::string& detail = std::string());
+
+    /**
+     * @brief Span for a given session, recorded from any thread
+     * @param track Static name of a virtual track (e.g. "Print steps"); null = the calling thread's own track
+     */
+    static void recordFor(uint64_t session, const char* track, const char* name, const char* category,
+                          Clock::time_point begin, Clock::time_point end, const std::string& detail = std::string());
+
+    /// Name shown for the calling thread's track (static string), e.g. "tbb worker"
+    static void nameThread(const char* name);
+
+private:
+    static std::atomic<int> s_sessions;
+};
+
+} // namespace OrcaSlicerCli
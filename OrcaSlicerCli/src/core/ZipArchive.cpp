@@ -0,0 +1,370 @@
+#include "ZipArchive.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+#include <zlib.h>
+
+namespace OrcaSlicerCli {
+
+namespace {
+
+constexpr uint32_t kLocalHeaderSig = 0x04034b50;
+constexpr uint32_t kCentralHeaderSig = 0x02014b50;
+constexpr uint32_t kEndSig = 0x06054b50;
+constexpr uint32_t kEnd64Sig = 0x06064b50;
+constexpr uint32_t kEnd64LocatorSig = 0x07064b50;
+constexpr uint16_t kZip64ExtraId = 0x0001;
+constexpr uint32_t kMax32 = 0xFFFFFFFFu;
+constexpr uint16_t kMax16 = 0xFFFFu;
+constexpr uint16_t kFlagDataDescriptor = 0x0008;
+constexpr size_t kCopyChunk = 1 << 20;
+
+uint16_t get16(const uint8_t* p) { return uint16_t(p[0] | (p[1] << 8)); }
+uint32_t get32(const uint8_t* p) { return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24); }
+uint64_t get64(const uint8_t* p) { return uint64_t(get32(p)) | (uint64_t(get32(p + 4)) << 32); }
+
+// Little-endian record builder
+class Record {
+public:
+    Record& u16(uint16_t v) { for (int i = 0; i < 2; ++i) m_bytes.push_back(uint8_t(v >> (8 * i))); return *this; }
+    Record& u32(uint32_t v) { for (int i = 0; i < 4; ++i) m_bytes.push_back(uint8_t(v >> (8 * i))); return *this; }
+    Record& u64(uint64_t v) { for (int i = 0; i < 8; ++i) m_bytes.push_back(uint8_t(v >> (8 * i))); return *this; }
+    Record& bytes(const void* p, size_t n) { m_bytes.insert(m_bytes.end(), (const uint8_t*)p, (const uint8_t*)p + n); return *this; }
+    const std::vector<uint8_t>& data() const { return m_bytes; }
+
+private:
+    std::vector<uint8_t> m_bytes;
+};
+
+uint32_t clamp32(uint64_t v) { return v >= kMax32 ? kMax32 : uint32_t(v); }
+
+} // namespace
+
+// ---------------------------------------------------------------------------------------------
+// ZipReader
+
+bool ZipReader::readAt(uint64_t offset, void* out, size_t size) {
+    if (offset + size > m_size) return false;
+    m_file.clear();
+    m_file.seekg(static_cast<std::streamoff>(offset));
+    m_file.read(static_cast<char*>(out), static_cast<std::streamsize>(size));
+    return static_cast<size_t>(m_file.gcount()) == size;
+}
+
+bool ZipReader::open(const std::string& path, std::string& error) {
+    m_entries.clear();
+    m_file.close();
+    m_file.open(path, std::ios::binary);
+    std::error_code ec;
+    m_size = std::filesystem::file_size(path, ec);
+    if (!m_file || ec) {
+        error = "Cannot open ZIP archive: " + path;
+        return false;
+    }
+
+    // End of central directory: last 22 bytes plus a comment of up to 64 KiB
+    const uint64_t tail_size = std::min<uint64_t>(m_size, 22 + 0xFFFF);
+    std::vector<uint8_t> tail(static_cast<size_t>(tail_size));
+    if (tail_size < 22 || !readAt(m_size - tail_size, tail.data(), tail.size())) {
+        error = "Not a ZIP archive (too short): " + path;
+        return false;
+    }
+    size_t eocd = std::string::npos;
+    for (size_t i = tail.size() - 22 + 1; i-- > 0;) {
+        if (get32(&tail[i]) == kEndSig) { eocd = i; break; }
+    }
+    if (eocd == std::string::npos) {
+        error = "Not a ZIP archive (no end of central directory): " + path;
+        return false;
+    }
+    const uint64_t eocd_offset = m_size - tail_size + eocd;
+    uint64_t count = get16(&tail[eocd + 10]);
+    uint64_t cd_size = get32(&tail[eocd + 12]);
+    uint64_t cd_offset = get32(&tail[eocd + 16]);
+
+    if (count == kMax16 || cd_size == kMax32 || cd_offset == kMax32) {
+        uint8_t locator[20], end64[56];
+        if (eocd_offset < 20 || !readAt(eocd_offset - 20, locator, sizeof(locator)) || get32(locator) != kEnd64LocatorSig ||
+            !readAt(get64(locator + 8), end64, sizeof(end64)) || get32(end64) != kEnd64Sig) {
+            error = "Corrupt Zip64 end of central directory: " + path;
+            return false;
+        }
+        count = get64(end64 + 32);
+        cd_size = get64(end64 + 40);
+        cd_offset = get64(end64 + 48);
+    }
+
+    std::vector<uint8_t> cd(static_cast<size_t>(cd_size));
+    if (cd_offset + cd_size > m_size || !readAt(cd_offset, cd.data(), cd.size())) {
+        error = "Truncated central directory: " + path;
+        return false;
+    }
+    m_entries.reserve(static_cast<size_t>(count));
+    size_t p = 0;
+    for (uint64_t i = 0; i < count; ++i) {
+        if (p + 46 > cd.size() || get32(&cd[p]) != kCentralHeaderSig) {
+            error = "Corrupt central directory entry " + std::to_string(i) + ": " + path;
+            return false;
+        }
+        const uint8_t* h = &cd[p];
+        ZipEntry e;
+        e.flags = get16(h + 8);
+        e.method = get16(h + 10);
+        e.mod_time = get16(h + 12);
+        e.mod_date = get16(h + 14);
+        e.crc32 = get32(h + 16);
+        e.compressed_size = get32(h + 20);
+        e.uncompressed_size = get32(h + 24);
+        const size_t name_len = get16(h + 28), extra_len = get16(h + 30), comment_len = get16(h + 32);
+        e.external_attributes = get32(h + 38);
+        e.local_header_offset = get32(h + 42);
+        if (p + 46 + name_len + extra_len + comment_len > cd.size()) {
+            error = "Corrupt central directory entry " + std::to_string(i) + ": " + path;
+            return false;
+        }
+        e.name.assign(reinterpret_cast<const char*>(h + 46), name_len);
+        // Zip64 extra: only the fields saturated in the fixed header are present, in this order
+        for (size_t x = 46 + name_len; x + 4 <= 46 + name_len + extra_len;) {
+            const uint16_t id = get16(h + x), len = get16(h + x + 2);
+            if (id == kZip64ExtraId) {
+                size_t f = x + 4;
+                if (e.uncompressed_size == kMax32 && f + 8 <= x + 4 + len) { e.uncompressed_size = get64(h + f); f += 8; }
+                if (e.compressed_size == kMax32 && f + 8 <= x + 4 + len) { e.compressed_size = get64(h + f); f += 8; }
+                if (e.local_header_offset == kMax32 && f + 8 <= x + 4 + len) { e.local_header_offset = get64(h + f); f += 8; }
+            }
+            x += 4 + len;
+        }
+        m_entries.push_back(std::move(e));
+        p += 46 + name_len + extra_len + comment_len;
+    }
+    return true;
+}
+
+const ZipEntry* ZipReader::find(const std::string& name) const {
+    for (const auto& e : m_entries)
+        if (e.name == name) return &e;
+    return nullptr;
+}
+
+bool ZipReader::dataOffset(const ZipEntry& entry, uint64_t& offset, std::string& error) {
+    uint8_t h[30];
+    if (!readAt(entry.local_header_offset, h, sizeof(h)) || get32(h) != kLocalHeaderSig) {
+        error = "Corrupt local header for " + entry.name;
+        return false;
+    }
+    offset = entry.local_header_offset + 30 + get16(h + 26) + get16(h + 28);
+    if (offset + entry.compressed_size > m_size) {
+        error = "Truncated data for " + entry.name;
+        return false;
+    }
+    return true;
+}
+
+bool ZipReader::read(const ZipEntry& entry, std::string& out, std::string& error) {
+    uint64_t offset;
+    if (!dataOffset(entry, offset, error)) return false;
+    std::string packed(static_cast<size_t>(entry.compressed_size), '\0');
+    if (!readAt(offset, packed.data(), packed.size())) {
+        error = "Truncated data for " + entry.name;
+        return false;
+    }
+    if (entry.method == 0) {
+        out = std::move(packed);
+    } else if (entry.method == 8) {
+        out.assign(static_cast<size_t>(entry.uncompressed_size), '\0');
+        z_stream zs{};
+        if (inflateInit2(&zs, -MAX_WBITS) != Z_OK) {
+            error = "inflateInit2 failed";
+            return false;
+        }
+        zs.next_in = reinterpret_cast<Bytef*>(packed.data());
+        zs.avail_in = static_cast<uInt>(packed.size());
+        zs.next_out = reinterpret_cast<Bytef*>(out.data());
+        zs.avail_out = static_cast<uInt>(out.size());
+        const int rc = inflate(&zs, Z_FINISH);
+        inflateEnd(&zs);
+        if (rc != Z_STREAM_END || zs.total_out != out.size()) {
+            error = "Corrupt deflate data for " + entry.name;
+            return false;
+        }
+    } else {
+        error = "Unsupported compression method " + std::to_string(entry.method) + " for " + entry.name;
+        return false;
+    }
+    if (crc32(0L, reinterpret_cast<const Bytef*>(out.data()), static_cast<uInt>(out.size())) != entry.crc32) {
+        error = "CRC mismatch for " + entry.name;
+        return false;
+    }
+    return true;
+}
+
+bool ZipReader::readRaw(const ZipEntry& entry, ZipRawEntry& out, std::string& error) {
+    uint64_t offset;
+    if (!dataOffset(entry, offset, error)) return false;
+    out.entry = entry;
+    out.data.resize(static_cast<size_t>(entry.compressed_size));
+    if (!readAt(offset, out.data.data(), out.data.size())) {
+        error = "Truncated data for " + entry.name;
+        return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------
+// ZipWriter
+
+ZipWriter::~ZipWriter() {
+    if (m_file.is_open() && !m_finished) {
+        m_file.close();
+        std::error_code ec;
+        std::filesystem::remove(m_path, ec); // abandoned: never leave a truncated archive behind
+    }
+}
+
+bool ZipWriter::open(const std::string& path, std::string& error) {
+    m_path = path;
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_file) {
+        error = "Cannot create ZIP archive: " + path;
+        return false;
+    }
+    return true;
+}
+
+void ZipWriter::put(const void* data, size_t size) {
+    m_file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    m_offset += size;
+}
+
+bool ZipWriter::writeLocalHeader(ZipEntry& entry, std::string& error) {
+    entry.flags &= ~kFlagDataDescriptor; // sizes are known up front
+    entry.local_header_offset = m_offset;
+    const bool zip64 = entry.compressed_size >= kMax32 || entry.uncompressed_size >= kMax32;
+    Record r;
+    r.u32(kLocalHeaderSig).u16(zip64 ? 45 : 20).u16(entry.flags).u16(entry.method)
+     .u16(entry.mod_time).u16(entry.mod_date).u32(entry.crc32)
+     .u32(zip64 ? kMax32 : uint32_t(entry.compressed_size)).u32(zip64 ? kMax32 : uint32_t(entry.uncompressed_size))
+     .u16(uint16_t(entry.name.size())).u16(zip64 ? 20 : 0)
+     .bytes(entry.name.data(), entry.name.size());
+    if (zip64) r.u16(kZip64ExtraId).u16(16).u64(entry.uncompressed_size).u64(entry.compressed_size);
+    put(r.data().data(), r.data().size());
+    if (!m_file) {
+        error = "Write failed: " + m_path;
+        return false;
+    }
+    return true;
+}
+
+bool ZipWriter::copyRaw(ZipReader& source, const ZipEntry& entry, std::string& error) {
+    uint64_t offset;
+    if (!source.dataOffset(entry, offset, error)) return false;
+    ZipEntry copy = entry;
+    if (!writeLocalHeader(copy, error)) return false;
+    std::vector<char> buf(static_cast<size_t>(std::min<uint64_t>(entry.compressed_size, kCopyChunk)));
+    for (uint64_t done = 0; done < entry.compressed_size;) {
+        const size_t n = static_cast<size_t>(std::min<uint64_t>(buf.size(), entry.compressed_size - done));
+        if (!source.readAt(offset + done, buf.data(), n)) {
+            error = "Truncated data for " + entry.name;
+            return false;
+        }
+        put(buf.data(), n);
+        done += n;
+    }
+    m_written.push_back(std::move(copy));
+    return true;
+}
+
+bool ZipWriter::addRaw(const ZipRawEntry& raw, std::string& error) {
+    if (raw.data.size() != raw.entry.compressed_size) {
+        error = "Size mismatch for " + raw.entry.name;
+        return false;
+    }
+    ZipEntry entry = raw.entry;
+    if (!writeLocalHeader(entry, error)) return false;
+    put(raw.data.data(), raw.data.size());
+    m_written.push_back(std::move(entry));
+    return true;
+}
+
+bool ZipWriter::addDeflated(const ZipEntry& meta, const uint8_t* deflated, size_t deflated_size,
+                            uint64_t uncompressed_size, uint32_t crc, std::string& error) {
+    ZipEntry entry = meta;
+    entry.method = 8;
+    entry.crc32 = crc;
+    entry.compressed_size = deflated_size;
+    entry.uncompressed_size = uncompressed_size;
+    if (!writeLocalHeader(entry, error)) return false;
+    put(deflated, deflated_size);
+    m_written.push_back(std::move(entry));
+    return true;
+}
+
+bool ZipWriter::add(const ZipEntry& meta, const void* data, size_t size, int level, std::string& error) {
+    z_stream zs{};
+    if (deflateInit2(&zs, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        error = "deflateInit2 failed";
+        return false;
+    }
+    std::vector<uint8_t> packed(deflateBound(&zs, static_cast<uLong>(size)));
+    zs.next_in = const_cast<Bytef*>(static_cast<const Bytef*>(data));
+    zs.avail_in = static_cast<uInt>(size);
+    zs.next_out = packed.data();
+    zs.avail_out = static_cast<uInt>(packed.size());
+    const int rc = deflate(&zs, Z_FINISH);
+    const size_t packed_size = zs.total_out;
+    deflateEnd(&zs);
+    if (rc != Z_STREAM_END) {
+        error = "deflate failed for " + meta.name;
+        return false;
+    }
+    const uint32_t crc = crc32(0L, static_cast<const Bytef*>(data), static_cast<uInt>(size));
+    return addDeflated(meta, packed.data(), packed_size, size, crc, error);
+}
+
+bool ZipWriter::finish(std::string& error) {
+    const uint64_t cd_offset = m_offset;
+    for (const auto& e : m_written) {
+        const bool big_u = e.uncompressed_size >= kMax32, big_c = e.compressed_size >= kMax32, big_o = e.local_header_offset >= kMax32;
+        const uint16_t extra_len = uint16_t((big_u + big_c + big_o) * 8);
+        Record r;
+        r.u32(kCentralHeaderSig).u16(extra_len ? 45 : 20).u16(extra_len ? 45 : 20).u16(e.flags).u16(e.method)
+         .u16(e.mod_time).u16(e.mod_date).u32(e.crc32)
+         .u32(clamp32(e.compressed_size)).u32(clamp32(e.uncompressed_size))
+         .u16(uint16_t(e.name.size())).u16(extra_len ? uint16_t(extra_len + 4) : 0).u16(0)
+         .u16(0).u16(0).u32(e.external_attributes).u32(clamp32(e.local_header_offset))
+         .bytes(e.name.data(), e.name.size());
+        if (extra_len) {
+            r.u16(kZip64ExtraId).u16(extra_len);
+            if (big_u) r.u64(e.uncompressed_size);
+            if (big_c) r.u64(e.compressed_size);
+            if (big_o) r.u64(e.local_header_offset);
+        }
+        put(r.data().data(), r.data().size());
+    }
+    const uint64_t cd_size = m_offset - cd_offset;
+    const uint64_t count = m_written.size();
+    if (count >= kMax16 || cd_offset >= kMax32 || cd_size >= kMax32) {
+        const uint64_t end64_offset = m_offset;
+        Record r;
+        r.u32(kEnd64Sig).u64(44).u16(45).u16(45).u32(0).u32(0)
+         .u64(count).u64(count).u64(cd_size).u64(cd_offset);
+        r.u32(kEnd64LocatorSig).u32(0).u64(end64_offset).u32(1);
+        put(r.data().data(), r.data().size());
+    }
+    Record end;
+    end.u32(kEndSig).u16(0).u16(0)
+       .u16(count >= kMax16 ? kMax16 : uint16_t(count)).u16(count >= kMax16 ? kMax16 : uint16_t(count))
+       .u32(clamp32(cd_size)).u32(clamp32(cd_offset)).u16(0);
+    put(end.data().data(), end.data().size());
+    m_file.close();
+    if (m_file.fail()) {
+        error = "Write failed: " + m_path;
+        return false;
+    }
+    m_finished = true;
+    return true;
+}
+
+} // namespace OrcaSlicerCli
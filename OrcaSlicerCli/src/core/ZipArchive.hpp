@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace OrcaSlicerCli {
+
+/**
+ * @brief Central-directory record of a ZIP entry (sizes and offset already widened from Zip64 extras)
+ */
+struct ZipEntry {
+    std::string name;
+    uint16_t flags = 0;
+    uint16_t method = 0;      // 0 stored, 8 deflate
+    uint16_t mod_time = 0;    // MS-DOS time/date
+    uint16_t mod_date = 0x21; // 1980-01-01
+    uint32_t crc32 = 0;
+    uint64_t compressed_size = 0;
+    uint64_t uncompressed_size = 0;
+    uint64_t local_header_offset = 0;
+    uint32_t external_attributes = 0;
+};
+
+/**
+ * @brief An entry's compressed bytes held in memory, to be written to another archive unchanged
+ */
+struct ZipRawEntry {
+    ZipEntry entry;
+    std::vector<uint8_t> data;
+};
+
+/**
+ * @brief Minimal ZIP / Zip64 reader for the archives libslic3r writes (3MF)
+ *
+ * Lists entries from the central directory and gives access to their
+ * compressed bytes, so entries can be copied into another archive without
+ * being inflated and deflated again. Single-disk archives only.
+ */
+class ZipReader {
+public:
+    /**
+     * @brief Open an archive and read its central directory
+     * @return false with error set if the file is not a readable ZIP
+     */
+    bool open(const std::string& path, std::string& error);
+
+    const std::vector<ZipEntry>& entries() const { return m_entries; }
+    const ZipEntry* find(const std::string& name) const;
+
+    /**
+     * @brief Decompressed content of a stored or deflated entry
+     */
+    bool read(const ZipEntry& entry, std::string& out, std::string& error);
+
+    /**
+     * @brief Compressed bytes of an entry as stored (for ZipWriter::addRaw)
+     */
+    bool readRaw(const ZipEntry& entry, ZipRawEntry& out, std::string& error);
+
+private:
+    friend class ZipWriter;
+
+    // File offset of the entry's compressed bytes (past its local header)
+    bool dataOffset(const ZipEntry& entry, uint64_t& offset, std::string& error);
+    bool readAt(uint64_t offset, void* out, size_t size);
+
+    std::ifstream m_file;
+    uint64_t m_size = 0;
+    std::vector<ZipEntry> m_entries;
+};
+
+/**
+ * @brief Sequential ZIP writer with Zip64 records where sizes or offsets need them
+ *
+ * Entries are written with their sizes in the local header (no data
+ * descriptors), which is what 3MF consumers expect.
+ */
+class ZipWriter {
+public:
+    ~ZipWriter();
+
+    bool open(const std::string& path, std::string& error);
+
+    /**
+     * @brief Copy an entry's compressed bytes verbatim from another archive
+     */
+    bool copyRaw(ZipReader& source, const ZipEntry& entry, std::string& error);
+
+    /**
+     * @brief Write an entry read with ZipReader::readRaw (method, CRC and sizes are kept)
+     */
+    bool addRaw(const ZipRawEntry& raw, std::string& error);
+
+    /**
+     * @brief Add an entry whose data is already a raw deflate stream
+     *
+     * Name, time and attributes come from meta; CRC and sizes are the given ones.
+     */
+    bool addDeflated(const ZipEntry& meta, const uint8_t* deflated, size_t deflated_size,
+                     uint64_t uncompressed_size, uint32_t crc32, std::string& error);
+
+    /**
+     * @brief Deflate (single-threaded, zlib level) and add a small entry
+     */
+    bool add(const ZipEntry& meta, const void* data, size_t size, int level, std::string& error);
+
+    /**
+     * @brief Write the central directory and close the file
+     */
+    bool finish(std::string& error);
+
+private:
+    bool writeLocalHeader(ZipEntry& entry, std::string& error);
+    void put(const void* data, size_t size);
+
+    std::ofstream m_file;
+    std::string m_path;
+    uint64_t m_offset = 0;
+    std::vector<ZipEntry> m_written;
+    bool m_finished = false;
+};
+
+} // namespace OrcaSlicerCli
@@ -4,19 +4,21 @@
 #include <memory>
 #include <cstdlib>
 
-#include <iostream>
 #include <algorithm>
 #include <cctype>
 #include <cstring>
 
 #include "core/CliCore.hpp"
+#include "core/OutputBuffer.hpp"
 #include "Application.hpp"
+#include "utils/Logger.hpp"
 #ifdef HAVE_LIBSLIC3R
 namespace Slic3r { unsigned int level_string_to_boost(std::string level); void set_logging_level(unsigned int level); }
 #endif
 
 
 using OrcaSlicerCli::CliCore;
+using OrcaSlicerCli::OutputBuffer;
 
 namespace {
 struct Engine {
@@ -57,7 +59,10 @@ static orcacli_operation_result make_result(const OrcaSlicerCli::CliCore::Operat
 }
 
 orcacli_operation_result orcacli_initialize(orcacli_handle h, const char* resources_path) {
-    std::cout << "DEBUG: [C API] orcacli_initialize(resources_path=" << (resources_path?resources_path:"(null)") << ")" << std::endl;
+    // Same variables drive the engine's own log lines (debug output is off unless asked for)
+    OrcaSlicerCli::Logger::getInstance().setLogLevel(
+        OrcaSlicerCli::Logger::levelFromEnvironment(OrcaSlicerCli::Logger::getInstance().getLogLevel()));
+    LOG_DEBUG_STREAM("[C API] orcacli_initialize(resources_path=" << (resources_path?resources_path:"(null)") << ")");
 
     if (!h) {
         return orcacli_operation_result{false, dup_cstr("invalid handle"), nullptr};
@@ -90,7 +95,7 @@ orcacli_operation_result orcacli_initialize(orcacli_handle h, const char* resour
 
     Engine* e = static_cast<Engine*>(h);
     auto res = e->core.initialize(resources_path ? std::string(resources_path) : std::string());
-    std::cout << "DEBUG: [C API] orcacli_initialize result success=" << (res.success?1:0) << ", msg='" << res.message << "'" << std::endl;
+    LOG_DEBUG_STREAM("[C API] orcacli_initialize result success=" << (res.success?1:0) << ", msg='" << res.message << "'");
 
     return make_result(res);
 
@@ -105,6 +110,15 @@ orcacli_operation_result orcacli_load_model(orcacli_handle h, const char* filena
     return make_result(res);
 }
 
+orcacli_operation_result orcacli_load_model_from_memory(orcacli_handle h, const uint8_t* data, uint64_t size, const char* format, const char* name) {
+    if (!h || !data || !format) {
+        return orcacli_operation_result{false, dup_cstr("invalid args"), nullptr};
+    }
+    Engine* e = static_cast<Engine*>(h);
+    auto res = e->core.loadModelFromMemory(data, static_cast<size_t>(size), format, name ? name : "");
+    return make_result(res);
+}
+
 orcacli_model_info orcacli_get_model_info(orcacli_handle h) {
     orcacli_model_info out{};
     if (!h) return out;
@@ -119,19 +133,7 @@ orcacli_model_info orcacli_get_model_info(orcacli_handle h) {
     return out;
 }
 
-orcacli_operation_result orcacli_slice(orcacli_handle h, const orcacli_slice_params* params) {
-    // Early diagnostic logging to catch pre-core crashes
-    if (params && params->verbose) {
-        try {
-            const char* in = (params && params->input_file) ? params->input_file : "(null)";
-            int plate = params ? params->plate_index : -1;
-            std::cout << "DEBUG: [C API] orcacli_slice enter: input='" << in << "' plate=" << plate << std::endl;
-        } catch (...) { /* ignore logging failures */ }
-    }
-    if (!h || !params) {
-        return orcacli_operation_result{false, dup_cstr("invalid args"), nullptr};
-    }
-    Engine* e = static_cast<Engine*>(h);
+static CliCore::SlicingParams to_slicing_params(const orcacli_slice_params* params) {
     CliCore::SlicingParams p;
     if (params->input_file)   p.input_file = params->input_file;
     if (params->output_file)  p.output_file = params->output_file;
@@ -143,29 +145,167 @@ orcacli_operation_result orcacli_slice(orcacli_handle h, const orcacli_slice_par
     p.plate_index = params->plate_index;
     p.verbose = params->verbose;
     p.dry_run = params->dry_run;
+    p.job_id = params->job_id;
+    p.timeout_ms = params->timeout_ms;
+    // C API: 0 = default (zero-initialized structs), ORCACLI_COMPRESSION_STORE = level 0
+    if (params->compression_level == ORCACLI_COMPRESSION_STORE) p.compression_level = 0;
+    else if (params->compression_level > 0) p.compression_level = std::min(9, static_cast<int>(params->compression_level));
+    if (params->output_format) p.output_format = params->output_format;
+    if (params->trace_file) p.trace_file = params->trace_file;
+    if (params->input_data) {
+        p.input_data = params->input_data;
+        p.input_size = static_cast<size_t>(params->input_size);
+        if (params->input_format) p.input_format = params->input_format;
+    }
     // Forward overrides into SlicingParams.custom_settings; validation will happen inside CliCore::slice()
     if (params->overrides && params->overrides_count > 0) {
         if (params->verbose) {
             try {
-                std::cout << "DEBUG: [C API] overrides_count=" << params->overrides_count << std::endl;
+                LOG_DEBUG_STREAM("[C API] overrides_count=" << params->overrides_count);
             } catch (...) {}
         }
         for (int32_t i = 0; i < params->overrides_count; ++i) {
             const orcacli_kv& kv = params->overrides[i];
             if (kv.key && kv.value) {
                 if (params->verbose) {
-                    try { std::cout << "DEBUG: [C API] override[" << i << "]: '" << kv.key << "'='" << kv.value << "'" << std::endl; } catch (...) {}
+                    try { LOG_DEBUG_STREAM("[C API] override[" << i << "]: '" << kv.key << "'='" << kv.value << "'"); } catch (...) {}
                 }
                 p.custom_settings[std::string(kv.key)] = std::string(kv.value);
             }
         }
     } else if (params && params->verbose) {
-        try { std::cout << "DEBUG: [C API] overrides_count=0 or overrides=null" << std::endl; } catch (...) {}
+        try { LOG_DEBUG_STREAM("[C API] overrides_count=0 or overrides=null"); } catch (...) {}
     }
-    auto res = e->core.slice(p);
+    return p;
+}
+
+orcacli_operation_result orcacli_slice(orcacli_handle h, const orcacli_slice_params* params) {
+    // Early diagnostic logging to catch pre-core crashes
+    if (params && params->verbose) {
+        try {
+            const char* in = (params && params->input_file) ? params->input_file : "(null)";
+            int plate = params ? params->plate_index : -1;
+            LOG_DEBUG_STREAM("[C API] orcacli_slice enter: input='" << in << "' plate=" << plate);
+        } catch (...) { /* ignore logging failures */ }
+    }
+    if (!h || !params) {
+        return orcacli_operation_result{false, dup_cstr("invalid args"), nullptr};
+    }
+    Engine* e = static_cast<Engine*>(h);
+    auto res = e->core.slice(to_slicing_params(params));
     return make_result(res);
 }
 
+static orcacli_slice_timings make_timings(const CliCore::SliceTimings& t) {
+    static_assert(CliCore::SliceTimings::StepCount == ORCACLI_STEP_COUNT, "step order must match ORCACLI_STEP_*");
+    orcacli_slice_timings o{};
+    o.load_model_ns = t.load_model_ns;
+    o.presets_ns = t.presets_ns;
+    o.apply_ns = t.apply_ns;
+    o.process_ns = t.process_ns;
+    for (int i = 0; i < ORCACLI_STEP_COUNT; ++i) {
+        o.step_ns[i] = t.step_ns[i];
+        o.step_count[i] = t.step_count[i];
+    }
+    o.export_gcode_ns = t.export_gcode_ns;
+    o.package_ns = t.package_ns;
+    o.total_ns = t.total_ns;
+    o.objects = t.objects;
+    o.layers = t.layers;
+    o.cached = t.cached;
+    return o;
+}
+
+orcacli_slice_result_ex orcacli_slice_ex(orcacli_handle h, const orcacli_slice_params* params) {
+    orcacli_slice_result_ex out{};
+    out.result = orcacli_slice(h, params);
+    if (h && params) out.timings = make_timings(static_cast<Engine*>(h)->core.getLastTimings());
+    return out;
+}
+
+orcacli_slice_timings orcacli_get_last_timings(orcacli_handle h) {
+    if (!h) return orcacli_slice_timings{};
+    Engine* e = static_cast<Engine*>(h);
+    return make_timings(e->core.getLastTimings());
+}
+
+orcacli_operation_result orcacli_slice_to_buffer(orcacli_handle h, const orcacli_slice_params* params, orcacli_buffer* out) {
+    if (out) *out = orcacli_buffer{nullptr, 0, nullptr};
+    if (!h || !params || !out) {
+        return orcacli_operation_result{false, dup_cstr("invalid args"), nullptr};
+    }
+    Engine* e = static_cast<Engine*>(h);
+    std::unique_ptr<OutputBuffer> buf;
+    auto res = e->core.sliceToBuffer(to_slicing_params(params), buf);
+    if (res.success && buf) {
+        out->data = buf->data();
+        out->size = buf->size();
+        out->opaque = buf.release();
+    }
+    return make_result(res);
+}
+
+orcacli_operation_result orcacli_slice_to_stream(orcacli_handle h, const orcacli_slice_params* params, orcacli_write_fn write, void* user) {
+    if (!h || !params || !write) {
+        return orcacli_operation_result{false, dup_cstr("invalid args"), nullptr};
+    }
+    Engine* e = static_cast<Engine*>(h);
+    auto res = e->core.sliceToStream(to_slicing_params(params), [&](const uint8_t* data, size_t size) {
+        return write(user, data, static_cast<uint64_t>(size)) == 0;
+    });
+    return make_result(res);
+}
+
+void orcacli_cancel(orcacli_handle h, uint64_t job_id) {
+    if (!h) return;
+    Engine* e = static_cast<Engine*>(h);
+    e->core.cancel(job_id);
+}
+
+orcacli_operation_result orcacli_session_open(orcacli_handle h, const char* input_file, int32_t plate_index, uint64_t* session_id) {
+    if (session_id) *session_id = 0;
+    if (!h || !input_file || !session_id) {
+        return orcacli_operation_result{false, dup_cstr("invalid args"), nullptr};
+    }
+    Engine* e = static_cast<Engine*>(h);
+    uint64_t id = 0;
+    auto res = e->core.openSession(std::string(input_file), plate_index, id);
+    *session_id = id;
+    return make_result(res);
+}
+
+orcacli_operation_result orcacli_session_reslice(orcacli_handle h, uint64_t session_id, const orcacli_slice_params* params, orcacli_reslice_info* info) {
+    if (info) *info = orcacli_reslice_info{-1, 0u};
+    if (!h || !params) {
+        return orcacli_operation_result{false, dup_cstr("invalid args"), nullptr};
+    }
+    Engine* e = static_cast<Engine*>(h);
+    CliCore::ResliceInfo ri;
+    auto res = e->core.reslice(session_id, to_slicing_params(params), &ri);
+    if (info) {
+        static const std::pair<const char*, uint32_t> step_bits[] = {
+            {"slice", ORCACLI_STEP_SLICE}, {"perimeters", ORCACLI_STEP_PERIMETERS}, {"prepare_infill", ORCACLI_STEP_PREPARE_INFILL},
+            {"infill", ORCACLI_STEP_INFILL}, {"ironing", ORCACLI_STEP_IRONING}, {"support_material", ORCACLI_STEP_SUPPORT_MATERIAL},
+            {"wipe_tower", ORCACLI_STEP_WIPE_TOWER}, {"skirt_brim", ORCACLI_STEP_SKIRT_BRIM}, {"gcode", ORCACLI_STEP_GCODE}
+        };
+        info->apply_status = ri.apply_status;
+        for (const auto& step : ri.steps_run) {
+            for (const auto& sb : step_bits) {
+                if (step == sb.first) info->steps_run |= sb.second;
+            }
+        }
+    }
+    LOG_DEBUG_STREAM("[C API] orcacli_session_reslice(" << session_id << ") success=" << (res.success?1:0)
+              << " apply_status=" << ri.apply_status << " steps=" << ri.steps_run.size());
+    return make_result(res);
+}
+
+void orcacli_session_close(orcacli_handle h, uint64_t session_id) {
+    if (!h) return;
+    Engine* e = static_cast<Engine*>(h);
+    e->core.closeSession(session_id);
+}
+
 orcacli_operation_result orcacli_load_vendor(orcacli_handle h, const char* vendor_id) {
     if (!h || !vendor_id) {
 
@@ -174,10 +314,30 @@ orcacli_operation_result orcacli_load_vendor(orcacli_handle h, const char* vendo
     Engine* e = static_cast<Engine*>(h);
 
     auto res = e->core.loadVendor(std::string(vendor_id));
-    std::cout << "DEBUG: [C API] orcacli_load_vendor('" << vendor_id << "') success=" << (res.success?1:0) << ", msg='" << res.message << "'" << std::endl;
+    LOG_DEBUG_STREAM("[C API] orcacli_load_vendor('" << vendor_id << "') success=" << (res.success?1:0) << ", msg='" << res.message << "'");
+
+    return make_result(res);
 
+}
+
+orcacli_operation_result orcacli_save_snapshot(orcacli_handle h, const char* snapshot_file) {
+    if (!h || !snapshot_file) {
+        return orcacli_operation_result{false, dup_cstr("invalid args"), nullptr};
+    }
+    Engine* e = static_cast<Engine*>(h);
+    auto res = e->core.saveSnapshot(std::string(snapshot_file));
+    LOG_DEBUG_STREAM("[C API] orcacli_save_snapshot('" << snapshot_file << "') success=" << (res.success?1:0) << ", msg='" << res.message << "'");
     return make_result(res);
+}
 
+orcacli_operation_result orcacli_load_snapshot(orcacli_handle h, const char* snapshot_file) {
+    if (!h || !snapshot_file) {
+        return orcacli_operation_result{false, dup_cstr("invalid args"), nullptr};
+    }
+    Engine* e = static_cast<Engine*>(h);
+    auto res = e->core.loadSnapshot(std::string(snapshot_file));
+    LOG_DEBUG_STREAM("[C API] orcacli_load_snapshot('" << snapshot_file << "') success=" << (res.success?1:0) << ", msg='" << res.message << "'");
+    return make_result(res);
 }
 
 
@@ -188,7 +348,7 @@ orcacli_operation_result orcacli_load_printer_profile(orcacli_handle h, const ch
     }
     Engine* e = static_cast<Engine*>(h);
     auto res = e->core.loadPrinterProfile(std::string(printer_name));
-    std::cout << "DEBUG: [C API] orcacli_load_printer_profile('" << printer_name << "') success=" << (res.success?1:0) << ", msg='" << res.message << "'" << std::endl;
+    LOG_DEBUG_STREAM("[C API] orcacli_load_printer_profile('" << printer_name << "') success=" << (res.success?1:0) << ", msg='" << res.message << "'");
 
     return make_result(res);
 
@@ -203,7 +363,7 @@ orcacli_operation_result orcacli_load_filament_profile(orcacli_handle h, const c
     Engine* e = static_cast<Engine*>(h);
 
     auto res = e->core.loadFilamentProfile(std::string(filament_name));
-    std::cout << "DEBUG: [C API] orcacli_load_filament_profile('" << filament_name << "') success=" << (res.success?1:0) << ", msg='" << res.message << "'" << std::endl;
+    LOG_DEBUG_STREAM("[C API] orcacli_load_filament_profile('" << filament_name << "') success=" << (res.success?1:0) << ", msg='" << res.message << "'");
 
 
     return make_result(res);
@@ -216,12 +376,50 @@ orcacli_operation_result orcacli_load_process_profile(orcacli_handle h, const ch
     }
     Engine* e = static_cast<Engine*>(h);
     auto res = e->core.loadProcessProfile(std::string(process_name));
-    std::cout << "DEBUG: [C API] orcacli_load_process_profile('" << process_name << "') success=" << (res.success?1:0) << ", msg='" << res.message << "'" << std::endl;
+    LOG_DEBUG_STREAM("[C API] orcacli_load_process_profile('" << process_name << "') success=" << (res.success?1:0) << ", msg='" << res.message << "'");
 
     return make_result(res);
 
 }
 
+static orcacli_cache_stats make_cache_stats(const CliCore::CacheStats& s) {
+    orcacli_cache_stats out{};
+    out.hits = s.hits;
+    out.misses = s.misses;
+    out.evictions = s.evictions;
+    out.entries = static_cast<uint32_t>(s.entries);
+    out.capacity = static_cast<uint32_t>(s.capacity);
+    return out;
+}
+
+orcacli_cache_stats orcacli_get_config_cache_stats(orcacli_handle h) {
+    if (!h) return orcacli_cache_stats{};
+    Engine* e = static_cast<Engine*>(h);
+    return make_cache_stats(e->core.getConfigCacheStats());
+}
+
+void orcacli_set_config_cache_capacity(orcacli_handle h, uint32_t entries) {
+    if (!h) return;
+    Engine* e = static_cast<Engine*>(h);
+    e->core.setConfigCacheCapacity(entries);
+}
+
+orcacli_stats orcacli_get_stats(orcacli_handle h) {
+    orcacli_stats out{};
+    if (!h) return out;
+    Engine* e = static_cast<Engine*>(h);
+    const auto s = e->core.getStats();
+    out.slices = s.slices;
+    out.slice_failures = s.slice_failures;
+    out.bytes_in = s.bytes_in;
+    out.bytes_out = s.bytes_out;
+    out.config_cache = make_cache_stats(s.config_cache);
+    out.project_cache = make_cache_stats(s.project_cache);
+    out.result_cache = make_cache_stats(s.result_cache);
+    out.rss_bytes = s.rss_bytes;
+    return out;
+}
+
 #ifndef ORCACLI_VERSION_STRING
 #define ORCACLI_VERSION_STRING "0.0.0-dev"
 #endif
@@ -249,5 +447,11 @@ void orcacli_free_result(orcacli_operation_result* r) {
     r->error_details = nullptr;
 }
 
+void orcacli_free_buffer(orcacli_buffer* buf) {
+    if (!buf) return;
+    delete static_cast<OutputBuffer*>(buf->opaque);
+    *buf = orcacli_buffer{nullptr, 0, nullptr};
+}
+
 } // extern "C"
 
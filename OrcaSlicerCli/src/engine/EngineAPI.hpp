@@ -48,8 +48,95 @@ typedef struct {
     // Optional config overrides (applied after profiles). The memory is owned by caller and must live through the call.
     const orcacli_kv* overrides;  // optional
     int32_t     overrides_count;  // number of entries in overrides
+    // Cancellation: orcacli_cancel(h, job_id) stops this job; 0 = anonymous (only orcacli_cancel(h, 0) reaches it)
+    uint64_t    job_id;
+    int32_t     timeout_ms;       // deadline from the start of the call; 0 = none. Fails with "Slicing deadline exceeded"
+    // Optional in-memory model: when input_data is set it is sliced instead of reading input_file,
+    // which then only names the object. Caller-owned, must live through the call.
+    const uint8_t* input_data;
+    uint64_t    input_size;
+    const char* input_format;     // "stl", "obj" or "3mf"; required with input_data
+    // Compression level of .gcode.3mf / .gcode.gz / .bgcode / .gcode.zst outputs: 1-9, 0 = default, ORCACLI_COMPRESSION_STORE = none
+    int32_t     compression_level;
+    // "gcode", "gcode.gz", "gcode.zst" or "bgcode"; NULL = from the output_file extension
+    const char* output_format;
+    // Chrome trace JSON (chrome://tracing, ui.perfetto.dev) of this job is written here; NULL = no tracing
+    const char* trace_file;
 } orcacli_slice_params;
 
+#define ORCACLI_COMPRESSION_STORE (-1)
+
+// Engine-owned output bytes (orcacli_slice_to_buffer); release with orcacli_free_buffer
+typedef struct {
+    const uint8_t* data;
+    uint64_t       size;
+    void*          opaque; // owner, passed back to orcacli_free_buffer
+} orcacli_buffer;
+
+// Receives output bytes in order (orcacli_slice_to_stream); return non-zero to stop the job
+typedef int (*orcacli_write_fn)(void* user, const uint8_t* data, uint64_t size);
+
+// Resolved-config cache counters
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    uint32_t entries;
+    uint32_t capacity;
+} orcacli_cache_stats;
+
+// Engine counters for monitoring (orcacli_get_stats); counts are since orcacli_create
+typedef struct {
+    uint64_t slices;                   // slice calls (file, buffer, stream and session reslices)
+    uint64_t slice_failures;           // of which failed, were canceled or hit their deadline
+    uint64_t bytes_in;                 // model bytes read
+    uint64_t bytes_out;                // output bytes produced
+    orcacli_cache_stats config_cache;  // resolved-config cache
+    orcacli_cache_stats project_cache; // parsed-3MF project cache
+    orcacli_cache_stats result_cache;  // on-disk result cache (entries/capacity are 0)
+    uint64_t rss_bytes;                // resident set size of the process; 0 where unavailable
+} orcacli_stats;
+
+// Incremental re-slice: pipeline steps reported in orcacli_reslice_info.steps_run
+#define ORCACLI_STEP_SLICE            (1u << 0)
+#define ORCACLI_STEP_PERIMETERS       (1u << 1)
+#define ORCACLI_STEP_PREPARE_INFILL   (1u << 2)
+#define ORCACLI_STEP_INFILL           (1u << 3)
+#define ORCACLI_STEP_IRONING          (1u << 4)
+#define ORCACLI_STEP_SUPPORT_MATERIAL (1u << 5)
+#define ORCACLI_STEP_WIPE_TOWER       (1u << 6)
+#define ORCACLI_STEP_SKIRT_BRIM       (1u << 7)
+#define ORCACLI_STEP_GCODE            (1u << 8)
+
+typedef struct {
+    int32_t  apply_status; // Print::ApplyStatus: 0 unchanged, 1 changed, 2 invalidated; -1 if slicing did not run
+    uint32_t steps_run;    // ORCACLI_STEP_* bitmask of the steps that were computed
+} orcacli_reslice_info;
+
+// Where the time of a slice went: steady-clock nanoseconds per stage, 0 = stage did not run
+#define ORCACLI_STEP_COUNT 8 // timed process steps: index i of step_ns/step_count is ORCACLI_STEP_* bit i (SLICE..SKIRT_BRIM)
+
+typedef struct {
+    uint64_t load_model_ns;                  // model load (0 when the loaded/session model was reused)
+    uint64_t presets_ns;                     // profile resolution and overrides
+    uint64_t apply_ns;                       // Print::apply
+    uint64_t process_ns;                     // Print::process, all steps
+    uint64_t step_ns[ORCACLI_STEP_COUNT];    // process_ns split by step (sampled at Print status updates)
+    uint32_t step_count[ORCACLI_STEP_COUNT]; // objects each step was computed for (1 for WIPE_TOWER/SKIRT_BRIM)
+    uint64_t export_gcode_ns;                // Print::export_gcode
+    uint64_t package_ns;                     // .gcode.3mf packaging or .gz/.zst/.bgcode encoding
+    uint64_t total_ns;                       // whole call
+    uint32_t objects;
+    uint32_t layers;                         // over all objects
+    bool     cached;                         // served by the result cache
+} orcacli_slice_timings;
+
+// orcacli_slice result with timings; release with orcacli_free_result(&r.result)
+typedef struct {
+    orcacli_operation_result result;
+    orcacli_slice_timings    timings;
+} orcacli_slice_result_ex;
+
 // Lifecycle
 orcacli_handle orcacli_create();
 void orcacli_destroy(orcacli_handle h);
@@ -57,10 +144,41 @@ void orcacli_destroy(orcacli_handle h);
 // Operations
 orcacli_operation_result orcacli_initialize(orcacli_handle h, const char* resources_path);
 orcacli_operation_result orcacli_load_model(orcacli_handle h, const char* filename);
+// Load a model from bytes (format "stl", "obj" or "3mf"; name is optional). The buffer is only read during the call.
+orcacli_operation_result orcacli_load_model_from_memory(orcacli_handle h, const uint8_t* data, uint64_t size, const char* format, const char* name);
 orcacli_model_info       orcacli_get_model_info(orcacli_handle h);
 orcacli_operation_result orcacli_slice(orcacli_handle h, const orcacli_slice_params* params);
+orcacli_slice_result_ex  orcacli_slice_ex(orcacli_handle h, const orcacli_slice_params* params);
+// Timings of the last orcacli_slice*/orcacli_session_reslice call on this engine (also after a failure)
+orcacli_slice_timings    orcacli_get_last_timings(orcacli_handle h);
+// Stop a running (or not yet started) slice on this engine; it fails with "Slicing canceled".
+// Thread-safe: may be called while another thread is inside orcacli_slice on the same handle.
+void                     orcacli_cancel(orcacli_handle h, uint64_t job_id);
+// Slice into memory: params->output_file only picks the kind (".3mf" suffix => .gcode.3mf, else G-code) and may be null.
+// On success *out holds the bytes until orcacli_free_buffer; it does not depend on the handle staying alive.
+orcacli_operation_result orcacli_slice_to_buffer(orcacli_handle h, const orcacli_slice_params* params, orcacli_buffer* out);
+// Slice and push the output through write (on the calling thread, chunks of at most 256 KiB) instead of returning it;
+// params->output_file only picks the kind, as in orcacli_slice_to_buffer. A non-zero return fails with "Slicing canceled".
+orcacli_operation_result orcacli_slice_to_stream(orcacli_handle h, const orcacli_slice_params* params, orcacli_write_fn write, void* user);
 // Lazy loading of vendors/presets
 orcacli_operation_result orcacli_load_vendor(orcacli_handle h, const char* vendor_id);
+// Warm start: binary snapshot of the loaded vendor presets (memory-mapped on load, rejected if stale)
+orcacli_operation_result orcacli_save_snapshot(orcacli_handle h, const char* snapshot_file);
+orcacli_operation_result orcacli_load_snapshot(orcacli_handle h, const char* snapshot_file);
+
+// Re-slice sessions: the model and its Print stay loaded in the engine, so a reslice with changed settings
+// only recomputes the invalidated steps. Loading another model on the same engine (orcacli_slice with an
+// input file, orcacli_load_model) ends the session; reslice then fails and the caller re-opens it.
+orcacli_operation_result orcacli_session_open(orcacli_handle h, const char* input_file, int32_t plate_index, uint64_t* session_id);
+orcacli_operation_result orcacli_session_reslice(orcacli_handle h, uint64_t session_id, const orcacli_slice_params* params, orcacli_reslice_info* info);
+void                     orcacli_session_close(orcacli_handle h, uint64_t session_id);
+
+// Resolved-config cache (ORCACLI_CONFIG_CACHE_SIZE sets the initial size; 0 disables)
+orcacli_cache_stats      orcacli_get_config_cache_stats(orcacli_handle h);
+void                     orcacli_set_config_cache_capacity(orcacli_handle h, uint32_t entries);
+
+// Monitoring counters; thread-safe (may be called while a slice runs on the handle)
+orcacli_stats            orcacli_get_stats(orcacli_handle h);
 
 // Metadata
 const char* orcacli_version(); // static string, no free required
@@ -74,6 +192,7 @@ orcacli_operation_result orcacli_load_process_profile(orcacli_handle h, const ch
 void orcacli_free_string(const char* s);
 void orcacli_free_model_info(orcacli_model_info* mi);
 void orcacli_free_result(orcacli_operation_result* r);
+void orcacli_free_buffer(orcacli_buffer* buf);
 
 #ifdef __cplusplus
 } // extern "C"
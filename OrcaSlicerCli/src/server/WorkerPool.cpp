@@ -0,0 +1,362 @@
+#include "WorkerPool.hpp"
+#include "utils/Logger.hpp"
+
+#include <map>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <csignal>
+#include <cstring>
+#include <cerrno>
+#include <filesystem>
+
+#ifndef _WIN32
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace OrcaSlicerCli {
+
+namespace {
+
+volatile std::sig_atomic_t g_stop_requested = 0;
+
+constexpr unsigned long long kMaxInlineInput = 2ull << 30; // 2 GiB
+
+void onStopSignal(int) { g_stop_requested = 1; }
+
+std::string escapeValue(const std::string& v) {
+    std::string out;
+    out.reserve(v.size());
+    for (char c : v) {
+        if (c == '\\') out += "\\\\";
+        else if (c == '\n') out += "\\n";
+        else if (c != '\r') out += c;
+    }
+    return out;
+}
+
+std::string unescapeValue(const std::string& v) {
+    std::string out;
+    out.reserve(v.size());
+    for (size_t i = 0; i < v.size(); ++i) {
+        if (v[i] == '\\' && i + 1 < v.size()) {
+            char n = v[++i];
+            out += (n == 'n') ? '\n' : n;
+        } else {
+            out += v[i];
+        }
+    }
+    return out;
+}
+
+// Ordered key/value frame; ordering keeps overrides in the order the client sent them
+using Frame = std::vector<std::pair<std::string, std::string>>;
+
+#ifndef _WIN32
+// Reads one frame (terminated by an empty line). Returns false on EOF/error before the terminator.
+// Bytes read past the terminator (the start of an inline model) are left in rest.
+bool readFrame(int fd, Frame& frame, std::string& rest) {
+    std::string buf;
+    char chunk[4096];
+    for (;;) {
+        size_t end = buf.find("\n\n");
+        if (end != std::string::npos) {
+            rest = buf.substr(end + 2);
+            buf.resize(end + 1);
+            break;
+        }
+        ssize_t n = ::read(fd, chunk, sizeof(chunk));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        buf.append(chunk, static_cast<size_t>(n));
+        if (buf.size() > (1u << 20)) return false; // refuse absurd requests
+    }
+    size_t start = 0;
+    while (start < buf.size()) {
+        size_t nl = buf.find('\n', start);
+        std::string line = buf.substr(start, nl - start);
+        start = nl + 1;
+        size_t eq = line.find('=');
+        if (eq == std::string::npos || eq == 0) continue;
+        frame.emplace_back(line.substr(0, eq), unescapeValue(line.substr(eq + 1)));
+    }
+    return true;
+}
+
+// Reads exactly size bytes into data, after the ones already in it
+bool readPayload(int fd, std::string& data, size_t size) {
+    if (data.size() > size) return false; // more bytes than announced
+    size_t off = data.size();
+    data.resize(size);
+    while (off < size) {
+        ssize_t n = ::read(fd, &data[off], size - off);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        off += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool writeAll(int fd, const std::string& data) {
+    size_t off = 0;
+    while (off < data.size()) {
+        ssize_t n = ::write(fd, data.data() + off, data.size() - off);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        off += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool writeFrame(int fd, const Frame& frame) {
+    std::string out;
+    for (const auto& kv : frame) {
+        out += kv.first;
+        out += '=';
+        out += escapeValue(kv.second);
+        out += '\n';
+    }
+    out += '\n';
+    return writeAll(fd, out);
+}
+#endif
+
+} // namespace
+
+WorkerPool::WorkerPool(CliCore& core, const Options& options)
+    : m_core(core), m_options(options) {
+    if (m_options.workers < 1) m_options.workers = 1;
+}
+
+WorkerPool::~WorkerPool() {
+#ifndef _WIN32
+    if (m_listen_fd >= 0) ::close(m_listen_fd);
+#endif
+}
+
+void WorkerPool::requestStop() {
+    g_stop_requested = 1;
+}
+
+#ifdef _WIN32
+
+CliCore::OperationResult WorkerPool::run() {
+    return CliCore::OperationResult(false, "Worker pool mode is not supported on Windows");
+}
+
+int WorkerPool::spawnWorker() { return -1; }
+void WorkerPool::workerMain() {}
+void WorkerPool::handleConnection(int) {}
+
+#else
+
+CliCore::OperationResult WorkerPool::run() {
+    if (!m_core.isInitialized()) {
+        return CliCore::OperationResult(false, "CLI core not initialized");
+    }
+    if (m_options.socket_path.empty()) {
+        return CliCore::OperationResult(false, "Socket path is required");
+    }
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (m_options.socket_path.size() >= sizeof(addr.sun_path)) {
+        return CliCore::OperationResult(false, "Socket path too long", m_options.socket_path);
+    }
+    std::strncpy(addr.sun_path, m_options.socket_path.c_str(), sizeof(addr.sun_path) - 1);
+
+    m_listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (m_listen_fd < 0) {
+        return CliCore::OperationResult(false, "Failed to create socket", std::strerror(errno));
+    }
+    ::unlink(m_options.socket_path.c_str()); // stale socket from a previous run
+    if (::bind(m_listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        ::listen(m_listen_fd, 128) < 0) {
+        std::string err = std::strerror(errno);
+        ::close(m_listen_fd);
+        m_listen_fd = -1;
+        return CliCore::OperationResult(false, "Failed to listen on " + m_options.socket_path, err);
+    }
+
+    // No SA_RESTART: waitpid() must return EINTR so the supervisor notices the stop request
+    struct sigaction sa{};
+    sa.sa_handler = onStopSignal;
+    sigemptyset(&sa.sa_mask);
+    ::sigaction(SIGINT, &sa, nullptr);
+    ::sigaction(SIGTERM, &sa, nullptr);
+
+    // Live workers with their own start time and crash streak; a respawned worker inherits the streak of the one it replaces
+    struct Worker {
+        std::chrono::steady_clock::time_point spawned;
+        int fast_failures = 0;
+    };
+    std::map<pid_t, Worker> workers;
+    for (int i = 0; i < m_options.workers; ++i) {
+        pid_t pid = spawnWorker();
+        if (pid > 0) workers[pid] = Worker{std::chrono::steady_clock::now(), 0};
+    }
+    if (workers.empty()) {
+        ::close(m_listen_fd);
+        m_listen_fd = -1;
+        ::unlink(m_options.socket_path.c_str());
+        return CliCore::OperationResult(false, "Failed to fork workers", std::strerror(errno));
+    }
+    LOG_INFO("Worker pool listening on " + m_options.socket_path + " with " + std::to_string(workers.size()) + " worker(s)");
+
+    // Supervise: respawn workers that exit or crash. Back off when a worker dies within a second of its own
+    // start (e.g. a broken profile) so a crash loop does not pin the CPU; a long-lived worker that dies is
+    // respawned at once even if another one was just started.
+    while (!g_stop_requested) {
+        int status = 0;
+        pid_t pid = ::waitpid(-1, &status, 0);
+        if (pid < 0) {
+            if (errno == EINTR) continue;
+            break; // ECHILD: nothing left to supervise
+        }
+        auto dead = workers.find(pid);
+        if (dead == workers.end()) continue; // not a worker of this pool
+        const Worker previous = dead->second;
+        workers.erase(dead);
+        if (WIFSIGNALED(status)) {
+            LOG_WARNING("Worker " + std::to_string(pid) + " killed by signal " + std::to_string(WTERMSIG(status)) + "; respawning");
+        } else {
+            LOG_INFO("Worker " + std::to_string(pid) + " exited with code " + std::to_string(WEXITSTATUS(status)) + "; respawning");
+        }
+        if (g_stop_requested) break;
+
+        const auto lifetime = std::chrono::steady_clock::now() - previous.spawned;
+        const int fast_failures = lifetime < std::chrono::seconds(1) ? std::min(previous.fast_failures + 1, 50) : 0;
+        if (fast_failures > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100 * fast_failures));
+        }
+        pid_t fresh = spawnWorker();
+        if (fresh > 0) workers[fresh] = Worker{std::chrono::steady_clock::now(), fast_failures};
+    }
+
+    LOG_INFO("Worker pool shutting down");
+    for (const auto& [pid, worker] : workers) ::kill(pid, SIGTERM);
+    for (const auto& [pid, worker] : workers) {
+        int status = 0;
+        while (::waitpid(pid, &status, 0) < 0 && errno == EINTR) {}
+    }
+    ::close(m_listen_fd);
+    m_listen_fd = -1;
+    ::unlink(m_options.socket_path.c_str());
+    return CliCore::OperationResult(true, "Worker pool stopped");
+}
+
+int WorkerPool::spawnWorker() {
+    pid_t pid = ::fork();
+    if (pid != 0) {
+        if (pid < 0) LOG_ERROR(std::string("fork() failed: ") + std::strerror(errno));
+        return pid;
+    }
+    // Child: default signal dispositions so the supervisor can terminate us
+    ::signal(SIGINT, SIG_DFL);
+    ::signal(SIGTERM, SIG_DFL);
+    ::signal(SIGPIPE, SIG_IGN); // a disconnected client must not kill the worker
+    workerMain();
+    Logger::getInstance().flush(); // _exit() skips the logger's shutdown
+    ::_exit(0);
+}
+
+void WorkerPool::workerMain() {
+    int jobs = 0;
+    for (;;) {
+        int fd = ::accept(m_listen_fd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            LOG_ERROR(std::string("accept() failed: ") + std::strerror(errno));
+            ::_exit(1);
+        }
+        handleConnection(fd);
+        ::close(fd);
+        if (m_options.max_jobs_per_worker > 0 && ++jobs >= m_options.max_jobs_per_worker) {
+            return; // supervisor respawns a fresh copy from the warm parent
+        }
+    }
+}
+
+void WorkerPool::handleConnection(int fd) {
+    Frame request;
+    std::string payload;
+    if (!readFrame(fd, request, payload)) return;
+
+    CliCore::SlicingParams params;
+    long long input_size = -1;
+    for (const auto& kv : request) {
+        const std::string& key = kv.first;
+        const std::string& value = kv.second;
+        if (key == "input") params.input_file = value;
+        else if (key == "output") params.output_file = value;
+        else if (key == "config") params.config_file = value;
+        else if (key == "preset") params.preset_name = value;
+        else if (key == "printer") params.printer_profile = value;
+        else if (key == "filament") params.filament_profile = value;
+        else if (key == "process") params.process_profile = value;
+        else if (key == "plate") { try { params.plate_index = std::max(1, std::stoi(value)); } catch (...) {} }
+        else if (key == "verbose") params.verbose = (value == "1" || value == "true");
+        else if (key == "dry_run") params.dry_run = (value == "1" || value == "true");
+        else if (key == "timeout_ms") { try { params.timeout_ms = std::max(0, std::stoi(value)); } catch (...) {} }
+        else if (key == "compression_level") { try { params.compression_level = std::clamp(std::stoi(value), 0, 9); } catch (...) {} }
+        else if (key == "output_format") params.output_format = value;
+        else if (key == "trace") params.trace_file = value;
+        else if (key == "input_format") params.input_format = value;
+        else if (key == "input_size") { try { input_size = std::stoll(value); } catch (...) {} }
+        else if (key.rfind("set.", 0) == 0 && key.size() > 4) params.custom_settings[key.substr(4)] = value;
+    }
+
+    // Inline model: input_size raw bytes follow the frame, and input then only names the object
+    const bool inline_input = input_size >= 0;
+    CliCore::OperationResult result;
+    if (inline_input && (input_size == 0 || static_cast<unsigned long long>(input_size) > kMaxInlineInput)) {
+        result = CliCore::OperationResult(false, "Invalid input_size", std::to_string(input_size));
+    } else if (inline_input && !readPayload(fd, payload, static_cast<size_t>(input_size))) {
+        return; // client went away mid-request
+    } else if ((!inline_input && params.input_file.empty()) || params.output_file.empty()) {
+        result = CliCore::OperationResult(false, "input and output are required");
+    } else {
+        if (inline_input) {
+            params.input_data = reinterpret_cast<const uint8_t*>(payload.data());
+            params.input_size = payload.size();
+            if (params.input_format.empty()) params.input_format = std::filesystem::path(params.input_file).extension().string();
+        }
+        // The client closing its end means nobody waits for this result any more: cancel the slice
+        std::atomic<bool> done{false};
+        std::thread watcher([&] {
+            while (!done) {
+                pollfd pfd{fd, POLLIN, 0};
+                if (::poll(&pfd, 1, 100) <= 0) continue;
+                char probe;
+                const ssize_t n = ::recv(fd, &probe, 1, MSG_PEEK | MSG_DONTWAIT);
+                if (n == 0 || (pfd.revents & (POLLHUP | POLLERR))) {
+                    LOG_INFO("Client disconnected; canceling its slice");
+                    m_core.cancel();
+                    return;
+                }
+                if (n > 0) return; // unexpected bytes after the request: stop watching
+            }
+        });
+        result = m_core.slice(params);
+        done = true;
+        watcher.join();
+    }
+
+    Frame response{
+        {"ok", result.success ? "1" : "0"},
+        {"message", result.message},
+        {"details", result.error_details},
+        {"worker", std::to_string(::getpid())}
+    };
+    writeFrame(fd, response);
+}
+
+#endif
+
+} // namespace OrcaSlicerCli
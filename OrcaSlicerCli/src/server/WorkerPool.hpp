@@ -0,0 +1,69 @@
+#pragma once
+
+#include "core/CliCore.hpp"
+
+#include <string>
+
+namespace OrcaSlicerCli {
+
+/**
+ * @brief Pre-forked slicing worker pool served over a Unix domain socket
+ *
+ * The supervisor process owns an already initialized CliCore (vendors and
+ * profiles loaded) and forks N workers from it, so every worker starts warm
+ * and shares the loaded presets copy-on-write. Workers accept jobs on a
+ * shared listening socket, one job per connection. A worker that crashes
+ * only loses the job it was running; the supervisor respawns it.
+ *
+ * Wire format (request and response): UTF-8 lines "key=value" terminated by
+ * an empty line. Backslash and newline in values are escaped as "\\" and "\n".
+ *
+ * Request keys:  input, output, plate, printer, filament, process, config,
+ *                preset, verbose, dry_run, timeout_ms, set.<option>=<value> (overrides),
+ *                input_size, input_format (inline model, see below)
+ * Response keys: ok (1/0), message, details, worker (pid)
+ *
+ * With input_size=N the model is sent inline: N raw bytes follow the empty
+ * line, input_format ("stl", "obj", "3mf") names its kind and input only
+ * names the object. The worker loads it with CliCore's in-memory path.
+ *
+ * Closing the connection before the response cancels the job.
+ *
+ * POSIX only; on other platforms run() fails with an explanatory message.
+ */
+class WorkerPool {
+public:
+    struct Options {
+        std::string socket_path;
+        int workers = 2;
+        int max_jobs_per_worker = 0; // recycle a worker after N jobs (0 = never)
+    };
+
+    WorkerPool(CliCore& core, const Options& options);
+    ~WorkerPool();
+
+    /**
+     * @brief Bind the socket, fork the workers and supervise them
+     *
+     * Blocks until SIGINT/SIGTERM or requestStop(), then terminates the
+     * workers and removes the socket file.
+     * @return Operation result
+     */
+    CliCore::OperationResult run();
+
+    /**
+     * @brief Ask a running supervisor to shut down (async-signal-safe)
+     */
+    static void requestStop();
+
+private:
+    int spawnWorker();
+    void workerMain();
+    void handleConnection(int fd);
+
+    CliCore& m_core;
+    Options m_options;
+    int m_listen_fd = -1;
+};
+
+} // namespace OrcaSlicerCli
@@ -41,6 +41,8 @@ std::string ErrorHandler::errorCodeToString(ErrorCode code) {
             return "Initialization Error";
         case ErrorCode::InternalError:
             return "Internal Error";
+        case ErrorCode::PerformanceRegression:
+            return "Performance Regression";
         case ErrorCode::UnknownError:
             return "Unknown Error";
         default:
@@ -73,6 +75,7 @@ void ErrorHandler::defaultErrorHandler(const CliException& exception) {
         case ErrorCode::SlicingError:
         case ErrorCode::InitializationError:
         case ErrorCode::InternalError:
+        case ErrorCode::PerformanceRegression:
         case ErrorCode::UnknownError:
             logger.fatal(exception.getMessage());
             if (!exception.getDetails().empty()) {
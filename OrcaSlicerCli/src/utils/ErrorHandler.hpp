@@ -18,6 +18,7 @@ enum class ErrorCode {
     SlicingError = 5,
     InitializationError = 6,
     InternalError = 7,
+    PerformanceRegression = 8, // bench: slower than the baseline beyond the allowed margin
     UnknownError = 99
 };
 
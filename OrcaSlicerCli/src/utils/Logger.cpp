@@ -3,77 +3,263 @@
 #include <iostream>
 #include <iomanip>
 #include <chrono>
-#include <sstream>
+#include <condition_variable>
+#include <ctime>
+#include <cstdio>
+#include <cstdlib>
 #include <mutex>
 #include <map>
+#include <new>
+#include <thread>
 #include <algorithm>
 #include <cctype>
 
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
 namespace OrcaSlicerCli {
 
+std::atomic<int> Logger::s_min_level{static_cast<int>(LogLevel::Info)};
+
 /**
  * @brief Private implementation for Logger
+ *
+ * Bounded MPSC ring (Vyukov): a producer claims a slot by advancing
+ * enqueue_pos, fills it and publishes it through the slot's sequence number;
+ * the flusher thread takes published slots in order and hands them back.
  */
 class Logger::Impl {
 public:
-    LogLevel min_level = LogLevel::Info;
-    std::ostream* output_stream = &std::cout;
-    bool timestamp_enabled = true;
-    bool color_enabled = true;
-    std::mutex log_mutex;
+    static constexpr size_t kCapacity = 8192; // power of two
+    static constexpr auto kIdleWait = std::chrono::milliseconds(100);
+
+    struct Entry {
+        std::atomic<uint64_t> seq{0};
+        LogLevel level = LogLevel::Info;
+        std::chrono::system_clock::time_point time;
+        std::string message;
+    };
+
+    std::unique_ptr<Entry[]> ring{new Entry[kCapacity]};
+    std::atomic<uint64_t> enqueue_pos{0};
+    uint64_t dequeue_pos = 0;          // flusher thread only
+    std::atomic<uint64_t> dropped{0};  // messages lost to a full ring, reported by the flusher
+
+    std::atomic<std::ostream*> output_stream{&std::cout};
+    std::atomic<bool> timestamp_enabled{true};
+    std::atomic<bool> color_enabled{true};
+
+    // Flusher state; producers only take the mutex to wake an idle flusher or in flush()
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable drained;
+    uint64_t written = 0;              // messages written so far (guarded by mutex)
+    bool stopping = false;
+    std::atomic<bool> flusher_idle{false};
+    std::atomic<bool> flusher_started{false};
+    std::thread* flusher = nullptr;    // pointer: a forked child drops it without joining
+    bool synchronous = false;          // no flusher thread could be started: write in the caller
+
+    // Last formatted second (flusher thread, or callers in synchronous mode)
+    std::time_t stamp_time = -1;
+    char stamp[32] = {};
+    size_t stamp_len = 0;
 
     // ANSI color codes
     static const std::map<LogLevel, std::string> color_codes;
     static const std::string reset_code;
 
-    void writeLog(LogLevel level, const std::string& message) {
-        if (level < min_level) {
-            return;
+    Impl() {
+        for (size_t i = 0; i < kCapacity; ++i) ring[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    ~Impl() {
+        {
+            std::lock_guard<std::mutex> lk(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        if (flusher) {
+            flusher->join(); // the flusher drains the ring before it returns
+            delete flusher;
+        }
+    }
+
+    bool enqueue(LogLevel level, std::string&& message, uint64_t& pos) {
+        pos = enqueue_pos.load(std::memory_order_relaxed);
+        Entry* e;
+        for (;;) {
+            e = &ring[pos & (kCapacity - 1)];
+            const uint64_t seq = e->seq.load(std::memory_order_acquire);
+            const int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false; // full: the flusher is behind by kCapacity messages
+            } else {
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
         }
+        e->level = level;
+        e->time = std::chrono::system_clock::now();
+        e->message = std::move(message);
+        e->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
 
-        std::lock_guard<std::mutex> lock(log_mutex);
+    bool pending() const {
+        return ring[dequeue_pos & (kCapacity - 1)].seq.load(std::memory_order_acquire) == dequeue_pos + 1;
+    }
 
-        std::ostringstream log_line;
+    void push(LogLevel level, std::string&& message) {
+        if (!flusher_started.load(std::memory_order_acquire)) startFlusher();
+        if (synchronous) {
+            std::lock_guard<std::mutex> lk(mutex);
+            std::string line;
+            format(line, level, std::chrono::system_clock::now(), message);
+            write(line);
+            return;
+        }
+        uint64_t pos = 0;
+        while (!enqueue(level, std::move(message), pos)) {
+            if (level < LogLevel::Error) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            std::this_thread::yield(); // errors wait for room instead of being dropped
+        }
+        // Pairs with the fence in run(): either the flusher sees the entry or we see it idle
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (flusher_idle.load(std::memory_order_relaxed) && flusher_idle.exchange(false)) {
+            { std::lock_guard<std::mutex> lk(mutex); } // the flusher is in wait(), not between check and wait
+            wake.notify_one();
+        }
+        if (level >= LogLevel::Error) waitWritten(pos + 1);
+    }
 
-        // Add timestamp
-        if (timestamp_enabled) {
-            auto now = std::chrono::system_clock::now();
-            auto time_t = std::chrono::system_clock::to_time_t(now);
-            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-                now.time_since_epoch()) % 1000;
+    void waitWritten(uint64_t count) {
+        std::unique_lock<std::mutex> lk(mutex);
+        if (synchronous || !flusher) return;
+        wake.notify_one();
+        drained.wait(lk, [&] { return written >= count || stopping; });
+    }
 
-            log_line << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-            log_line << "." << std::setfill('0') << std::setw(3) << ms.count();
-            log_line << " ";
+    void startFlusher() {
+        std::lock_guard<std::mutex> lk(mutex);
+        if (flusher_started.load(std::memory_order_relaxed)) return;
+        try {
+            flusher = new std::thread([this] { run(); });
+        } catch (...) {
+            synchronous = true;
         }
+        flusher_started.store(true, std::memory_order_release);
+    }
 
-        // Add color code
-        if (color_enabled && isTerminal()) {
-            auto color_it = color_codes.find(level);
-            if (color_it != color_codes.end()) {
-                log_line << color_it->second;
+    void run() {
+        std::string batch;
+        for (;;) {
+            batch.clear();
+            uint64_t count = 0;
+            while (pending() && count < kCapacity) {
+                Entry& e = ring[dequeue_pos & (kCapacity - 1)];
+                format(batch, e.level, e.time, e.message);
+                e.message.clear();
+                e.seq.store(dequeue_pos + kCapacity, std::memory_order_release);
+                ++dequeue_pos;
+                ++count;
+            }
+            if (const uint64_t lost = dropped.exchange(0, std::memory_order_relaxed)) {
+                format(batch, LogLevel::Warning, std::chrono::system_clock::now(),
+                       std::to_string(lost) + " log message(s) dropped: logging faster than the output is written");
             }
+            if (!batch.empty()) write(batch);
+
+            std::unique_lock<std::mutex> lk(mutex);
+            written += count;
+            if (count > 0) {
+                drained.notify_all();
+                continue;
+            }
+            if (stopping) return;
+            flusher_idle.store(true);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!pending()) wake.wait_for(lk, kIdleWait);
+            flusher_idle.store(false);
         }
+    }
 
-        // Add level
-        log_line << "[" << std::setw(7) << levelToString(level) << "]";
+    void write(const std::string& text) {
+        std::ostream* out = output_stream.load();
+        *out << text;
+        out->flush();
+    }
 
-        // Reset color
-        if (color_enabled && isTerminal()) {
-            log_line << reset_code;
+    void format(std::string& out, LogLevel level, std::chrono::system_clock::time_point time, const std::string& message) {
+        if (timestamp_enabled.load(std::memory_order_relaxed)) {
+            const std::time_t t = std::chrono::system_clock::to_time_t(time);
+            const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count() % 1000;
+            if (t != stamp_time) {
+                // Batches are mostly within the same second: convert once per second
+                std::tm tm{};
+#ifdef _WIN32
+                localtime_s(&tm, &t);
+#else
+                localtime_r(&t, &tm);
+#endif
+                stamp_len = std::strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", &tm);
+                stamp_time = t;
+            }
+            out.append(stamp, stamp_len);
+            char millis[8];
+            std::snprintf(millis, sizeof(millis), ".%03d ", static_cast<int>(ms));
+            out += millis;
         }
 
-        log_line << " " << message << std::endl;
-
-        *output_stream << log_line.str();
-        output_stream->flush();
+        const bool color = color_enabled.load(std::memory_order_relaxed) && isTerminal();
+        if (color) {
+            auto color_it = color_codes.find(level);
+            if (color_it != color_codes.end()) out += color_it->second;
+        }
+        char tag[16];
+        std::snprintf(tag, sizeof(tag), "[%7s]", levelToString(level).c_str());
+        out += tag;
+        if (color) out += reset_code;
+
+        out += ' ';
+        out += message;
+        out += '\n';
     }
 
     bool isTerminal() const {
         // Simple check if output is a terminal
-        return output_stream == &std::cout || output_stream == &std::cerr;
+        std::ostream* out = output_stream.load(std::memory_order_relaxed);
+        return out == &std::cout || out == &std::cerr;
     }
 
+#ifndef _WIN32
+    // A forked child has no flusher thread. Its ring still holds the parent's unwritten messages,
+    // which the parent writes itself: start empty, and start a flusher on the child's first message.
+    static Impl* s_instance;
+
+    static void beforeFork() { s_instance->mutex.lock(); }
+    static void afterForkParent() { s_instance->mutex.unlock(); }
+    static void afterForkChild() {
+        Impl& impl = *s_instance;
+        impl.mutex.unlock();
+        new (&impl.wake) std::condition_variable();
+        new (&impl.drained) std::condition_variable();
+        impl.flusher = nullptr;
+        impl.flusher_started.store(false);
+        impl.flusher_idle.store(false);
+        const uint64_t base = impl.enqueue_pos.load();
+        for (size_t i = 0; i < kCapacity; ++i) impl.ring[(base + i) & (kCapacity - 1)].seq.store(base + i);
+        impl.dequeue_pos = base;
+        impl.written = base;
+        impl.dropped.store(0);
+    }
+#endif
+
     static std::string levelToString(LogLevel level) {
         switch (level) {
             case LogLevel::Debug:   return "DEBUG";
@@ -99,6 +285,10 @@ public:
     }
 };
 
+#ifndef _WIN32
+Logger::Impl* Logger::Impl::s_instance = nullptr;
+#endif
+
 // Color code definitions
 const std::map<LogLevel, std::string> Logger::Impl::color_codes = {
     {LogLevel::Debug,   "\033[36m"},  // Cyan
@@ -113,6 +303,10 @@ const std::string Logger::Impl::reset_code = "\033[0m";
 // Logger implementation
 
 Logger::Logger() : m_impl(std::make_unique<Impl>()) {
+#ifndef _WIN32
+    Impl::s_instance = m_impl.get();
+    pthread_atfork(&Impl::beforeFork, &Impl::afterForkParent, &Impl::afterForkChild);
+#endif
 }
 
 Logger::~Logger() = default;
@@ -123,15 +317,16 @@ Logger& Logger::getInstance() {
 }
 
 void Logger::setLogLevel(LogLevel level) {
-    m_impl->min_level = level;
+    s_min_level.store(static_cast<int>(level), std::memory_order_relaxed);
 }
 
 LogLevel Logger::getLogLevel() const {
-    return m_impl->min_level;
+    return static_cast<LogLevel>(s_min_level.load(std::memory_order_relaxed));
 }
 
 void Logger::setOutputStream(std::ostream& stream) {
-    m_impl->output_stream = &stream;
+    flush(); // earlier messages still go to the previous stream
+    m_impl->output_stream.store(&stream);
 }
 
 void Logger::setTimestampEnabled(bool enable) {
@@ -162,8 +357,16 @@ void Logger::fatal(const std::string& message) {
     log(LogLevel::Fatal, message);
 }
 
-void Logger::log(LogLevel level, const std::string& message) {
-    m_impl->writeLog(level, message);
+void Logger::log(LogLevel level, std::string message) {
+    if (!isEnabled(level)) {
+        return;
+    }
+    m_impl->push(level, std::move(message));
+}
+
+void Logger::flush() {
+    if (!m_impl->flusher_started.load(std::memory_order_acquire)) return;
+    m_impl->waitWritten(m_impl->enqueue_pos.load());
 }
 
 std::string Logger::levelToString(LogLevel level) {
@@ -174,4 +377,22 @@ LogLevel Logger::stringToLevel(const std::string& level_str) {
     return Impl::stringToLevel(level_str);
 }
 
+LogLevel Logger::levelFromEnvironment(LogLevel fallback) {
+    LogLevel level = fallback;
+    const char* lvl = std::getenv("ORCACLI_LOG_LEVEL");
+    if (lvl && *lvl) {
+        const std::string s(lvl);
+        if (std::all_of(s.begin(), s.end(), [](unsigned char c) { return std::isdigit(c); })) {
+            // libslic3r scale: 0=fatal, 1=error, 2=warning, 3=info, 4=debug, 5=trace
+            static const LogLevel by_number[] = {LogLevel::Fatal, LogLevel::Error, LogLevel::Warning, LogLevel::Info, LogLevel::Debug};
+            level = by_number[std::min<long>(std::strtol(lvl, nullptr, 10), 4)];
+        } else {
+            level = s == "trace" || s == "TRACE" ? LogLevel::Debug : stringToLevel(s);
+        }
+    }
+    const char* quiet = std::getenv("ORCACLI_QUIET");
+    if (quiet && *quiet && std::string(quiet) != "0") level = std::max(level, LogLevel::Error);
+    return level;
+}
+
 } // namespace OrcaSlicerCli
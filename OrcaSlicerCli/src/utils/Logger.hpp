@@ -1,8 +1,18 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <memory>
 #include <ostream>
+#include <sstream>
+
+/**
+ * Levels below this are compiled out of the LOG_* macros (0 = debug ... 4 = fatal).
+ * Set by the ORCACLI_LOG_MIN_LEVEL CMake cache variable.
+ */
+#ifndef ORCACLI_LOG_MIN_LEVEL
+#define ORCACLI_LOG_MIN_LEVEL 0
+#endif
 
 namespace OrcaSlicerCli {
 
@@ -18,10 +28,17 @@ enum class LogLevel {
 };
 
 /**
- * @brief Simple logging system for OrcaSlicerCli
- * 
- * Provides structured logging with different levels and output targets.
- * Thread-safe and lightweight implementation.
+ * @brief Asynchronous logging system for OrcaSlicerCli
+ *
+ * Messages go into a fixed-size lock-free ring (multiple producers, one
+ * consumer) and a background thread formats and writes them in batches, so
+ * logging threads never wait on the output stream. When the ring is full,
+ * messages are dropped and counted instead of blocking. Error and Fatal
+ * messages are written before log() returns.
+ *
+ * The LOG_* macros check the level before building the message: a disabled
+ * level costs one relaxed atomic load, and levels below ORCACLI_LOG_MIN_LEVEL
+ * are removed at compile time.
  */
 class Logger {
 public:
@@ -31,6 +48,15 @@ public:
      */
     static Logger& getInstance();
 
+    /**
+     * @brief Whether a message of this level would be logged
+     * @param level Level to check
+     */
+    static bool isEnabled(LogLevel level) {
+        return static_cast<int>(level) >= ORCACLI_LOG_MIN_LEVEL &&
+               static_cast<int>(level) >= s_min_level.load(std::memory_order_relaxed);
+    }
+
     /**
      * @brief Set the minimum log level
      * @param level Minimum level to log
@@ -96,7 +122,14 @@ public:
      * @param level Log level
      * @param message Message to log
      */
-    void log(LogLevel level, const std::string& message);
+    void log(LogLevel level, std::string message);
+
+    /**
+     * @brief Wait until every message logged so far has been written
+     *
+     * Call before _exit() or before writing to the log stream directly.
+     */
+    void flush();
 
     /**
      * @brief Convert log level to string
@@ -112,21 +145,51 @@ public:
      */
     static LogLevel stringToLevel(const std::string& level_str);
 
+    /**
+     * @brief Log level requested by ORCACLI_LOG_LEVEL / ORCACLI_QUIET
+     *
+     * ORCACLI_LOG_LEVEL uses the libslic3r scale (0=fatal, 1=error, 2=warning,
+     * 3=info, 4=debug, 5=trace) or a level name; ORCACLI_QUIET=1 means error.
+     * @param fallback Level when neither variable is set
+     */
+    static LogLevel levelFromEnvironment(LogLevel fallback);
+
 private:
     Logger();
     ~Logger();
 
+    static std::atomic<int> s_min_level;
+
     class Impl;
     std::unique_ptr<Impl> m_impl;
 };
 
 /**
  * @brief Convenience macros for logging
+ *
+ * The message is only evaluated when the level is enabled. The *_STREAM
+ * variants take an ostream chain: LOG_DEBUG_STREAM("origin=(" << x << "," << y << ")").
  */
-#define LOG_DEBUG(msg) OrcaSlicerCli::Logger::getInstance().debug(msg)
-#define LOG_INFO(msg) OrcaSlicerCli::Logger::getInstance().info(msg)
-#define LOG_WARNING(msg) OrcaSlicerCli::Logger::getInstance().warning(msg)
-#define LOG_ERROR(msg) OrcaSlicerCli::Logger::getInstance().error(msg)
-#define LOG_FATAL(msg) OrcaSlicerCli::Logger::getInstance().fatal(msg)
+#define ORCACLI_LOG(level, msg) \
+    do { if (OrcaSlicerCli::Logger::isEnabled(level)) OrcaSlicerCli::Logger::getInstance().log(level, msg); } while (0)
+#define ORCACLI_LOG_STREAM(level, ...) \
+    do { \
+        if (OrcaSlicerCli::Logger::isEnabled(level)) { \
+            std::ostringstream orcacli_log_os_; \
+            orcacli_log_os_ << __VA_ARGS__; \
+            OrcaSlicerCli::Logger::getInstance().log(level, orcacli_log_os_.str()); \
+        } \
+    } while (0)
+
+#define LOG_DEBUG(msg) ORCACLI_LOG(OrcaSlicerCli::LogLevel::Debug, msg)
+#define LOG_INFO(msg) ORCACLI_LOG(OrcaSlicerCli::LogLevel::Info, msg)
+#define LOG_WARNING(msg) ORCACLI_LOG(OrcaSlicerCli::LogLevel::Warning, msg)
+#define LOG_ERROR(msg) ORCACLI_LOG(OrcaSlicerCli::LogLevel::Error, msg)
+#define LOG_FATAL(msg) ORCACLI_LOG(OrcaSlicerCli::LogLevel::Fatal, msg)
+
+#define LOG_DEBUG_STREAM(...) ORCACLI_LOG_STREAM(OrcaSlicerCli::LogLevel::Debug, __VA_ARGS__)
+#define LOG_INFO_STREAM(...) ORCACLI_LOG_STREAM(OrcaSlicerCli::LogLevel::Info, __VA_ARGS__)
+#define LOG_WARNING_STREAM(...) ORCACLI_LOG_STREAM(OrcaSlicerCli::LogLevel::Warning, __VA_ARGS__)
+#define LOG_ERROR_STREAM(...) ORCACLI_LOG_STREAM(OrcaSlicerCli::LogLevel::Error, __VA_ARGS__)
 
 } // namespace OrcaSlicerCli
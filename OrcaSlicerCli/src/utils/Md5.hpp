@@ -0,0 +1,44 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace OrcaSlicerCli {
+
+/**
+ * @brief Incremental MD5 (RFC 1321)
+ *
+ * Only for interoperability: Bambu-style .gcode.3mf packages carry an MD5 of
+ * each embedded G-code that printers check. Use Sha256 for anything keyed.
+ */
+class Md5 {
+public:
+    Md5();
+
+    /**
+     * @brief Feed bytes into the hash
+     */
+    void update(const void* data, size_t len);
+
+    /**
+     * @brief Finish and return the digest; the object must not be updated afterwards
+     */
+    std::array<uint8_t, 16> digest();
+
+    /**
+     * @brief Finish and return the digest as 32 hex characters
+     */
+    std::string hexDigest(bool uppercase = false);
+
+private:
+    void transform(const uint8_t* block);
+
+    std::array<uint32_t, 4> m_state;
+    std::array<uint8_t, 64> m_buffer{};
+    size_t m_buffered = 0;
+    uint64_t m_length = 0; // total bytes fed
+};
+
+} // namespace OrcaSlicerCli
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace OrcaSlicerCli {
+
+/**
+ * @brief Incremental SHA-256 (FIPS 180-4)
+ *
+ * Self-contained so content hashing does not depend on which crypto
+ * library libslic3r happens to link on a given platform.
+ */
+class Sha256 {
+public:
+    Sha256();
+
+    /**
+     * @brief Feed bytes into the hash
+     */
+    void update(const void* data, size_t len);
+    void update(const std::string& s) { update(s.data(), s.size()); }
+
+    /**
+     * @brief Finish and return the digest; the object must not be updated afterwards
+     */
+    std::array<uint8_t, 32> digest();
+
+    /**
+     * @brief Finish and return the digest as 64 lowercase hex characters
+     */
+    std::string hexDigest();
+
+    /**
+     * @brief Hash a whole file by streaming it
+     * @return false if the file cannot be read
+     */
+    bool updateFromFile(const std::string& path);
+
+private:
+    void transform(const uint8_t* block);
+
+    std::array<uint32_t, 8> m_state;
+    std::array<uint8_t, 64> m_buffer{};
+    size_t m_buffered = 0;
+    uint64_t m_length = 0; // total bytes fed
+};
+
+} // namespace OrcaSlicerCli
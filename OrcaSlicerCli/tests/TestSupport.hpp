@@ -0,0 +1,63 @@
+#pragma once
+
+// Minimal check macros for the standalone tests: each test file is its own
+// executable, reports every failed check and exits non-zero if any failed.
+
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <system_error>
+
+namespace OrcaSlicerCli {
+namespace Test {
+
+inline int& failures() {
+    static int count = 0;
+    return count;
+}
+
+inline void fail(const char* file, int line, const std::string& what) {
+    std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, what.c_str());
+    ++failures();
+}
+
+inline int finish(const char* name) {
+    if (failures() == 0) std::printf("%s: all checks passed\n", name);
+    else std::fprintf(stderr, "%s: %d check(s) failed\n", name, failures());
+    return failures() == 0 ? 0 : 1;
+}
+
+/**
+ * @brief Fresh directory under the system temp dir, removed with the object
+ */
+class TempDir {
+public:
+    explicit TempDir(const std::string& prefix) {
+        std::random_device rd;
+        m_path = std::filesystem::temp_directory_path() / (prefix + "_" + std::to_string(rd()));
+        std::filesystem::create_directories(m_path);
+    }
+    ~TempDir() {
+        std::error_code ec;
+        std::filesystem::remove_all(m_path, ec);
+    }
+    std::string file(const std::string& name) const { return (m_path / name).string(); }
+    const std::filesystem::path& path() const { return m_path; }
+
+private:
+    std::filesystem::path m_path;
+};
+
+} // namespace Test
+} // namespace OrcaSlicerCli
+
+#define CHECK(cond) \
+    do { if (!(cond)) ::OrcaSlicerCli::Test::fail(__FILE__, __LINE__, #cond); } while (0)
+
+#define CHECK_EQ(a, b) \
+    do { \
+        const auto& check_a_ = (a); \
+        const auto& check_b_ = (b); \
+        if (!(check_a_ == check_b_)) ::OrcaSlicerCli::Test::fail(__FILE__, __LINE__, #a " == " #b); \
+    } while (0)
@@ -0,0 +1,178 @@
+// GcodeEncoder: .gcode.gz inflates back to the G-code, and .bgcode follows the Prusa
+// binary layout (file header, metadata/thumbnail blocks in specification order,
+// G-code blocks of at most 64 KiB with valid CRC-32s that inflate to the kept text).
+
+#include "TestSupport.hpp"
+
+#include "core/GcodeEncoder.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <zlib.h>
+
+using namespace OrcaSlicerCli;
+
+namespace {
+
+std::string read_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+uint16_t get16(const std::string& s, size_t at) {
+    return static_cast<uint16_t>(uint8_t(s[at]) | (uint8_t(s[at + 1]) << 8));
+}
+
+uint32_t get32(const std::string& s, size_t at) {
+    return uint32_t(get16(s, at)) | (uint32_t(get16(s, at + 2)) << 16);
+}
+
+// A small export as libslic3r writes it: header, thumbnail, moves (over several 64 KiB blocks), trailer, config
+struct Sample {
+    std::string gcode;
+    std::string kept; // what the G-code blocks must contain
+};
+
+Sample make_sample() {
+    Sample s;
+    const std::string header =
+        "; HEADER_BLOCK_START\n"
+        "; generated by OrcaSlicer 2.3.0 on 2025-01-01 at 12:00:00\n"
+        "; model printing time: 30m 12s; total estimated time: 36m 54s\n"
+        "; HEADER_BLOCK_END\n\n";
+    const std::string thumbnail =
+        "; THUMBNAIL_BLOCK_START\n"
+        "; thumbnail begin 2x2 8\n"
+        "; iVBORw0K\n"
+        "; thumbnail end\n"
+        "; THUMBNAIL_BLOCK_END\n\n";
+    std::string moves = "; EXECUTABLE_BLOCK_START\n";
+    for (int i = 0; moves.size() < 200 * 1024; ++i) moves += "G1 X" + std::to_string(i % 200) + ".125 Y" + std::to_string(i % 180) + ".5 E0.0321\n";
+    moves += "; EXECUTABLE_BLOCK_END\n; filament used [mm] = 1234.5\n; filament used [g] = 3.7\n";
+    const std::string config =
+        "; CONFIG_BLOCK_START\n"
+        "; layer_height = 0.2\n"
+        "; nozzle_diameter = 0.4\n"
+        "; printer_model = Test Printer\n"
+        "; CONFIG_BLOCK_END\n";
+    s.gcode = header + thumbnail + moves + config;
+    s.kept = header + "\n" + moves; // the blank line after the thumbnail block stays
+    return s;
+}
+
+void test_gzip(const Sample& sample, const Test::TempDir& dir) {
+    for (int level : {-1, 1, 9}) {
+        const std::string path = dir.file("out.gcode.gz");
+        std::string error;
+        CHECK(GcodeEncoder::encode(reinterpret_cast<const uint8_t*>(sample.gcode.data()), sample.gcode.size(),
+                                   GcodeEncoder::Format::Gzip, level, path, error));
+        const std::string gz = read_file(path);
+        CHECK(gz.size() > 18 && uint8_t(gz[0]) == 0x1f && uint8_t(gz[1]) == 0x8b);
+        z_stream zs{};
+        CHECK_EQ(inflateInit2(&zs, 16 + MAX_WBITS), Z_OK);
+        std::string out(sample.gcode.size() + 1, '\0');
+        zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(gz.data()));
+        zs.avail_in = static_cast<uInt>(gz.size());
+        zs.next_out = reinterpret_cast<Bytef*>(&out[0]);
+        zs.avail_out = static_cast<uInt>(out.size());
+        CHECK_EQ(inflate(&zs, Z_FINISH), Z_STREAM_END); // also checks the gzip CRC and length trailer
+        out.resize(zs.total_out);
+        inflateEnd(&zs);
+        CHECK(out == sample.gcode);
+    }
+}
+
+void test_bgcode(const Sample& sample, const Test::TempDir& dir) {
+    const std::string path = dir.file("out.bgcode");
+    std::string error;
+    CHECK(GcodeEncoder::encode(reinterpret_cast<const uint8_t*>(sample.gcode.data()), sample.gcode.size(),
+                               GcodeEncoder::Format::Binary, 6, path, error));
+    const std::string bg = read_file(path);
+
+    // File header: magic, version 1, CRC-32 checksums
+    CHECK(bg.size() > 10);
+    if (bg.size() <= 10) return;
+    CHECK_EQ(bg.substr(0, 4), std::string("GCDE"));
+    CHECK_EQ(get32(bg, 4), uint32_t(1));
+    CHECK_EQ(get16(bg, 8), uint16_t(1));
+
+    std::vector<uint16_t> types;
+    std::string gcode, printer_ini, slicer_ini;
+    size_t pos = 10;
+    while (pos + 8 <= bg.size()) {
+        const uint16_t type = get16(bg, pos);
+        const uint16_t compression = get16(bg, pos + 2);
+        const uint32_t size = get32(bg, pos + 4);
+        const size_t header_size = compression == 0 ? 8 : 12;
+        const uint32_t stored = compression == 0 ? size : get32(bg, pos + 8);
+        const size_t params_size = type == 5 ? 6 : 2;
+        const size_t block_size = header_size + params_size + stored + 4;
+        CHECK(pos + block_size <= bg.size());
+        if (pos + block_size > bg.size()) return;
+        const uLong crc = crc32(0L, reinterpret_cast<const Bytef*>(bg.data() + pos), static_cast<uInt>(block_size - 4));
+        CHECK_EQ(get32(bg, pos + block_size - 4), static_cast<uint32_t>(crc));
+
+        std::string payload = bg.substr(pos + header_size + params_size, stored);
+        if (compression == 1) {
+            std::string raw(size, '\0');
+            uLongf raw_size = size;
+            CHECK_EQ(uncompress(reinterpret_cast<Bytef*>(&raw[0]), &raw_size,
+                                reinterpret_cast<const Bytef*>(payload.data()), static_cast<uLong>(payload.size())), Z_OK);
+            CHECK_EQ(raw_size, uLongf(size));
+            payload = raw;
+        } else {
+            CHECK_EQ(compression, uint16_t(0));
+        }
+        if (type == 1) {
+            CHECK(size <= 65536);
+            gcode += payload;
+        }
+        if (type == 3) printer_ini = payload;
+        if (type == 2) slicer_ini = payload;
+        if (type == 5) {
+            CHECK_EQ(get16(bg, pos + header_size + 2), uint16_t(2)); // width
+            CHECK_EQ(get16(bg, pos + header_size + 4), uint16_t(2)); // height
+        }
+        types.push_back(type);
+        pos += block_size;
+    }
+    CHECK_EQ(pos, bg.size());
+
+    // File, printer, thumbnail, print and slicer metadata, then G-code blocks
+    const std::vector<uint16_t> prefix{0, 3, 5, 4, 2};
+    CHECK(types.size() > prefix.size() + 1);
+    CHECK(std::vector<uint16_t>(types.begin(), types.begin() + std::min(types.size(), prefix.size())) == prefix);
+    for (size_t i = prefix.size(); i < types.size(); ++i) CHECK_EQ(types[i], uint16_t(1));
+
+    CHECK(gcode == sample.kept);
+    CHECK(printer_ini.find("printer_model=Test Printer\n") != std::string::npos);
+    CHECK(printer_ini.find("estimated printing time (normal mode)=36m 54s\n") != std::string::npos);
+    CHECK(slicer_ini.find("layer_height=0.2\n") != std::string::npos);
+}
+
+void test_formats() {
+    using Format = GcodeEncoder::Format;
+    CHECK(GcodeEncoder::formatFor("a.GCODE.GZ") == Format::Gzip);
+    CHECK(GcodeEncoder::formatFor("a.bgcode") == Format::Binary);
+    CHECK(GcodeEncoder::formatFor("a.gcode") == Format::Plain);
+    Format f = Format::Plain;
+    CHECK(GcodeEncoder::parseFormat("zst", f) && f == Format::Zstd);
+    CHECK(GcodeEncoder::parseFormat(".bgcode", f) && f == Format::Binary);
+    CHECK(!GcodeEncoder::parseFormat("gcode.xz", f));
+}
+
+} // namespace
+
+int main() {
+    Test::TempDir dir("orcacli_encoder");
+    const Sample sample = make_sample();
+    test_formats();
+    test_gzip(sample, dir);
+    test_bgcode(sample, dir);
+    return Test::finish("test_gcode_encoder");
+}
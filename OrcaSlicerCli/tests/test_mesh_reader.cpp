@@ -0,0 +1,225 @@
+// MeshReader: ASCII / binary STL and OBJ parsing, vertex welding, serial vs parallel
+// parse of a large mesh, and (with libslic3r) the same mesh as TriangleMesh::ReadSTLFile.
+
+#include "TestSupport.hpp"
+
+#include "core/MeshReader.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if HAVE_LIBSLIC3R
+#include "libslic3r/TriangleMesh.hpp"
+#endif
+
+using namespace OrcaSlicerCli;
+
+namespace {
+
+using Vertex = std::array<float, 3>;
+using Triangle = std::array<Vertex, 3>;
+
+const uint8_t* bytes(const std::string& s) { return reinterpret_cast<const uint8_t*>(s.data()); }
+
+void put_float(std::string& out, float v) {
+    char b[4];
+    std::memcpy(b, &v, 4);
+    out.append(b, 4);
+}
+
+std::string binary_stl(const std::vector<Triangle>& triangles) {
+    std::string out(80, ' ');
+    out.replace(0, 11, "binary test");
+    const uint32_t count = static_cast<uint32_t>(triangles.size());
+    out.append(reinterpret_cast<const char*>(&count), 4);
+    for (const auto& t : triangles) {
+        for (int i = 0; i < 3; ++i) put_float(out, 0.f);
+        for (const auto& v : t) for (float c : v) put_float(out, c);
+        out.append(2, '\0');
+    }
+    return out;
+}
+
+std::string ascii_stl(const std::vector<Triangle>& triangles) {
+    std::string out = "solid test\n";
+    for (const auto& t : triangles) {
+        out += " facet normal 0 0 0\n  outer loop\n";
+        for (const auto& v : t) out += "   vertex " + std::to_string(v[0]) + " " + std::to_string(v[1]) + " " + std::to_string(v[2]) + "\n";
+        out += "  endloop\n endfacet\n";
+    }
+    return out + "endsolid test\n";
+}
+
+std::vector<Triangle> tetrahedron() {
+    const Vertex a{0, 0, 0}, b{1, 0, 0}, c{0, 1, 0}, d{0, 0, 1};
+    return {{a, c, b}, {a, b, d}, {a, d, c}, {b, c, d}};
+}
+
+// Closed torus of rings x segments quads; vertices are computed once so shared corners are bit-identical
+std::vector<Triangle> torus(int rings, int segments) {
+    constexpr double kPi = 3.14159265358979323846;
+    std::vector<Vertex> grid(static_cast<size_t>(rings) * segments);
+    for (int i = 0; i < rings; ++i) {
+        for (int j = 0; j < segments; ++j) {
+            const double u = 2 * kPi * i / rings, v = 2 * kPi * j / segments;
+            grid[i * segments + j] = {float((20 + 5 * std::cos(v)) * std::cos(u)), float((20 + 5 * std::cos(v)) * std::sin(u)), float(5 * std::sin(v))};
+        }
+    }
+    std::vector<Triangle> out;
+    for (int i = 0; i < rings; ++i) {
+        for (int j = 0; j < segments; ++j) {
+            const Vertex& p00 = grid[i * segments + j];
+            const Vertex& p10 = grid[((i + 1) % rings) * segments + j];
+            const Vertex& p01 = grid[i * segments + (j + 1) % segments];
+            const Vertex& p11 = grid[((i + 1) % rings) * segments + (j + 1) % segments];
+            out.push_back({p00, p10, p11});
+            out.push_back({p00, p11, p01});
+        }
+    }
+    return out;
+}
+
+std::vector<Triangle> triangles_of(const MeshReader::Mesh& mesh) {
+    std::vector<Triangle> out;
+    for (const auto& f : mesh.faces) out.push_back({mesh.vertices[f[0]], mesh.vertices[f[1]], mesh.vertices[f[2]]});
+    return out;
+}
+
+void test_stl() {
+    const std::vector<Triangle> tetra = tetrahedron();
+    std::string error;
+    MeshReader::Mesh binary, ascii;
+    CHECK(MeshReader::readStl(bytes(binary_stl(tetra)), binary_stl(tetra).size(), binary, error));
+    CHECK(MeshReader::readStl(bytes(ascii_stl(tetra)), ascii_stl(tetra).size(), ascii, error));
+    CHECK_EQ(binary.vertices.size(), size_t(4)); // shared corners are welded
+    CHECK_EQ(binary.faces.size(), size_t(4));
+    CHECK(triangles_of(binary) == tetra);
+    CHECK(binary.vertices == ascii.vertices);
+    CHECK(binary.faces == ascii.faces);
+
+    // A facet with two identical corners is dropped
+    std::vector<Triangle> with_degenerate = tetra;
+    with_degenerate.push_back({tetra[0][0], tetra[0][0], tetra[0][1]});
+    MeshReader::Mesh cleaned;
+    const std::string stl = binary_stl(with_degenerate);
+    CHECK(MeshReader::readStl(bytes(stl), stl.size(), cleaned, error));
+    CHECK_EQ(cleaned.faces.size(), size_t(4));
+
+    MeshReader::Mesh bad;
+    const std::string garbage = "solid broken\n facet normal 0 0 0\n  outer loop\n   vertex 0 0\n";
+    CHECK(!MeshReader::readStl(bytes(garbage), garbage.size(), bad, error));
+    CHECK(!error.empty());
+}
+
+void test_obj() {
+    // A unit square as one quad and a triangle using negative (relative) indices
+    const std::string obj =
+        "# square\n"
+        "mtllib square.mtl\n"
+        "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+        "vt 0 0\nvn 0 0 1\n"
+        "f 1/1/1 2/1/1 3/1/1 4/1/1\n"
+        "v 0 0 1\n"
+        "f -5 -4 -1\n";
+    std::string error;
+    MeshReader::Mesh mesh;
+    CHECK(MeshReader::readObj(bytes(obj), obj.size(), mesh, error));
+    CHECK_EQ(mesh.vertices.size(), size_t(5));
+    CHECK_EQ(mesh.faces.size(), size_t(3)); // quad fan-triangulated into two
+    if (mesh.faces.size() == 3) {
+        CHECK((mesh.faces[0] == std::array<int32_t, 3>{0, 1, 2}));
+        CHECK((mesh.faces[1] == std::array<int32_t, 3>{0, 2, 3}));
+        CHECK((mesh.faces[2] == std::array<int32_t, 3>{0, 1, 4}));
+    }
+
+    const std::string dangling = "v 0 0 0\nv 1 0 0\nf 1 2 3\n";
+    MeshReader::Mesh bad;
+    CHECK(!MeshReader::readObj(bytes(dangling), dangling.size(), bad, error));
+    const std::string empty = "v 0 0 0\n";
+    CHECK(!MeshReader::readObj(bytes(empty), empty.size(), bad, error));
+}
+
+// Above kParallelThreshold the chunked parse must give exactly the serial result
+void test_parallel() {
+    const std::vector<Triangle> mesh = torus(400, 200);
+    const std::string stl = binary_stl(mesh);
+    CHECK(stl.size() >= MeshReader::kParallelThreshold);
+    std::string error;
+    MeshReader::Mesh serial, parallel;
+    CHECK(MeshReader::readStl(bytes(stl), stl.size(), serial, error, 1));
+    CHECK(MeshReader::readStl(bytes(stl), stl.size(), parallel, error, 4));
+    CHECK_EQ(serial.vertices.size(), size_t(400 * 200));
+    CHECK_EQ(serial.faces.size(), mesh.size());
+    CHECK(serial.vertices == parallel.vertices);
+    CHECK(serial.faces == parallel.faces);
+
+    std::string obj;
+    for (const auto& v : serial.vertices) obj += "v " + std::to_string(v[0]) + " " + std::to_string(v[1]) + " " + std::to_string(v[2]) + "\n";
+    for (const auto& f : serial.faces) obj += "f " + std::to_string(f[0] + 1) + " " + std::to_string(f[1] + 1) + " " + std::to_string(f[2] + 1) + "\n";
+    CHECK(obj.size() >= MeshReader::kParallelThreshold);
+    MeshReader::Mesh obj_serial, obj_parallel;
+    CHECK(MeshReader::readObj(bytes(obj), obj.size(), obj_serial, error, 1));
+    CHECK(MeshReader::readObj(bytes(obj), obj.size(), obj_parallel, error, 4));
+    CHECK_EQ(obj_serial.faces.size(), mesh.size());
+    CHECK(obj_serial.vertices == obj_parallel.vertices);
+    CHECK(obj_serial.faces == obj_parallel.faces);
+}
+
+#if HAVE_LIBSLIC3R
+// libslic3r's loader on the same file: same welded vertices and the same facets
+void test_against_read_stl_file() {
+    Test::TempDir dir("orcacli_mesh");
+    for (const auto& triangles : {tetrahedron(), torus(64, 32)}) {
+        const std::string stl = binary_stl(triangles);
+        const std::string path = dir.file("model.stl");
+        std::ofstream(path, std::ios::binary) << stl;
+
+        Slic3r::TriangleMesh reference;
+        CHECK(reference.ReadSTLFile(path.c_str(), true));
+        MeshReader::Mesh mesh;
+        std::string error;
+        CHECK(MeshReader::readStl(bytes(stl), stl.size(), mesh, error));
+        CHECK_EQ(mesh.vertices.size(), reference.its.vertices.size());
+        CHECK_EQ(mesh.faces.size(), reference.its.indices.size());
+
+        std::vector<Vertex> expected;
+        for (const auto& v : reference.its.vertices) expected.push_back({v.x(), v.y(), v.z()});
+        std::vector<Vertex> actual = mesh.vertices;
+        std::sort(expected.begin(), expected.end());
+        std::sort(actual.begin(), actual.end());
+        CHECK(actual == expected);
+
+        std::vector<Triangle> reference_triangles;
+        for (const auto& f : reference.its.indices) {
+            Triangle t;
+            for (int i = 0; i < 3; ++i) {
+                const auto& v = reference.its.vertices[f[i]];
+                t[i] = {v.x(), v.y(), v.z()};
+            }
+            reference_triangles.push_back(t);
+        }
+        std::vector<Triangle> ours = triangles_of(mesh);
+        std::sort(reference_triangles.begin(), reference_triangles.end());
+        std::sort(ours.begin(), ours.end());
+        CHECK(ours == reference_triangles);
+    }
+}
+#endif
+
+} // namespace
+
+int main() {
+    test_stl();
+    test_obj();
+    test_parallel();
+#if HAVE_LIBSLIC3R
+    test_against_read_stl_file();
+#endif
+    return Test::finish("test_mesh_reader");
+}
@@ -0,0 +1,218 @@
+// ParallelDeflate: every level and thread count inflates back to the input with the right CRC.
+// ZipWriter / ZipReader: added, pre-deflated and copied entries round-trip, including a Zip64 entry
+// larger than 4 GiB (streamed, so the test never holds it in memory).
+
+#include "TestSupport.hpp"
+
+#include "core/ParallelDeflate.hpp"
+#include "core/ZipArchive.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <zlib.h>
+
+using namespace OrcaSlicerCli;
+
+namespace {
+
+// Text-like input: compressible, but not so repetitive that every block degenerates to matches
+std::vector<uint8_t> sample(size_t size, uint32_t seed) {
+    std::mt19937 rng(seed);
+    static const char* words[] = {"G1 ", "X12.345 ", "Y67.890 ", "E0.0421 ", "F1800\n", ";LAYER_CHANGE\n", "M204 S500\n"};
+    std::vector<uint8_t> out;
+    out.reserve(size);
+    while (out.size() < size) {
+        const char* w = words[rng() % (sizeof(words) / sizeof(words[0]))];
+        for (const char* c = w; *c && out.size() < size; ++c) out.push_back(static_cast<uint8_t>(*c));
+        if (rng() % 16 == 0 && out.size() < size) out.push_back(static_cast<uint8_t>(rng()));
+    }
+    return out;
+}
+
+bool inflate_raw(const std::vector<uint8_t>& in, std::vector<uint8_t>& out, size_t expected) {
+    z_stream zs{};
+    if (inflateInit2(&zs, -MAX_WBITS) != Z_OK) return false;
+    out.resize(expected + 1);
+    zs.next_in = const_cast<Bytef*>(in.data());
+    zs.avail_in = static_cast<uInt>(in.size());
+    zs.next_out = out.data();
+    zs.avail_out = static_cast<uInt>(out.size());
+    const int rc = inflate(&zs, Z_FINISH);
+    out.resize(zs.total_out);
+    const bool consumed = zs.avail_in == 0;
+    inflateEnd(&zs);
+    return rc == Z_STREAM_END && consumed;
+}
+
+void test_levels() {
+    const size_t sizes[] = {0, 1, 1000, ParallelDeflate::kBlockSize - 1, ParallelDeflate::kBlockSize,
+                            3 * ParallelDeflate::kBlockSize + 12345};
+    for (size_t size : sizes) {
+        const std::vector<uint8_t> input = sample(size, static_cast<uint32_t>(size));
+        const uint32_t expected_crc = static_cast<uint32_t>(crc32(0L, input.data(), static_cast<uInt>(input.size())));
+        for (int level = -1; level <= 9; ++level) {
+            for (unsigned threads : {1u, 3u, 0u}) {
+                std::vector<uint8_t> deflated, inflated;
+                uint32_t crc = 0;
+                std::string error;
+                const bool ok = ParallelDeflate::compress(input.data(), input.size(), level, threads, deflated, crc, error);
+                CHECK(ok);
+                CHECK(error.empty());
+                CHECK_EQ(crc, expected_crc);
+                CHECK(inflate_raw(deflated, inflated, input.size()));
+                CHECK(inflated == input);
+            }
+        }
+    }
+}
+
+void test_zip_round_trip() {
+    Test::TempDir dir("orcacli_zip");
+    const std::string first = dir.file("first.zip"), second = dir.file("second.zip");
+    const std::vector<uint8_t> small = sample(5000, 1);
+    const std::vector<uint8_t> large = sample(2 * ParallelDeflate::kBlockSize + 7, 2);
+    std::string error;
+
+    ZipWriter writer;
+    CHECK(writer.open(first, error));
+    ZipEntry meta;
+    meta.name = "Metadata/level0.txt";
+    CHECK(writer.add(meta, small.data(), small.size(), 0, error));
+    meta.name = "Metadata/deflated.txt";
+    CHECK(writer.add(meta, small.data(), small.size(), 6, error));
+    std::vector<uint8_t> deflated;
+    uint32_t crc = 0;
+    CHECK(ParallelDeflate::compress(large.data(), large.size(), 1, 0, deflated, crc, error));
+    meta.name = "Metadata/plate_1.gcode";
+    CHECK(writer.addDeflated(meta, deflated.data(), deflated.size(), large.size(), crc, error));
+    CHECK(writer.finish(error));
+
+    ZipReader reader;
+    CHECK(reader.open(first, error));
+    CHECK_EQ(reader.entries().size(), size_t(3));
+    const std::string small_text(small.begin(), small.end()), large_text(large.begin(), large.end());
+    for (const char* name : {"Metadata/level0.txt", "Metadata/deflated.txt", "Metadata/plate_1.gcode"}) {
+        const ZipEntry* entry = reader.find(name);
+        CHECK(entry != nullptr);
+        if (!entry) continue;
+        std::string content;
+        CHECK(reader.read(*entry, content, error));
+        CHECK(content == (std::strcmp(name, "Metadata/plate_1.gcode") == 0 ? large_text : small_text));
+    }
+    // Level 0 is still a deflate stream (stored blocks)
+    for (const auto& entry : reader.entries()) CHECK_EQ(entry.method, uint16_t(8));
+
+    // Entries copied without recompression keep their bytes
+    ZipWriter copy;
+    CHECK(copy.open(second, error));
+    for (const auto& entry : reader.entries()) CHECK(copy.copyRaw(reader, entry, error));
+    CHECK(copy.finish(error));
+    ZipReader copied;
+    CHECK(copied.open(second, error));
+    CHECK_EQ(copied.entries().size(), size_t(3));
+    for (const auto& entry : reader.entries()) {
+        const ZipEntry* other = copied.find(entry.name);
+        CHECK(other != nullptr);
+        if (!other) continue;
+        CHECK_EQ(other->crc32, entry.crc32);
+        CHECK_EQ(other->compressed_size, entry.compressed_size);
+        std::string a, b;
+        CHECK(reader.read(entry, a, error));
+        CHECK(copied.read(*other, b, error));
+        CHECK(a == b);
+    }
+}
+
+// An entry whose uncompressed size needs the Zip64 extra field. Zeros deflate about 1000:1,
+// so the stored stream stays a few MiB; it is produced and checked in chunks.
+void test_zip64_entry() {
+    const uint64_t size = (uint64_t(1) << 32) + 4096;
+    std::vector<uint8_t> zeros(1 << 20, 0);
+
+    z_stream zs{};
+    CHECK_EQ(deflateInit2(&zs, 1, Z_DEFLATED, -MAX_WBITS, 8, Z_RLE), Z_OK);
+    std::vector<uint8_t> deflated;
+    uint8_t buffer[1 << 16];
+    uLong crc = crc32(0L, Z_NULL, 0);
+    for (uint64_t done = 0; done < size;) {
+        const size_t chunk = static_cast<size_t>(std::min<uint64_t>(zeros.size(), size - done));
+        done += chunk;
+        crc = crc32(crc, zeros.data(), static_cast<uInt>(chunk));
+        zs.next_in = zeros.data();
+        zs.avail_in = static_cast<uInt>(chunk);
+        const int flush = done == size ? Z_FINISH : Z_NO_FLUSH;
+        do {
+            zs.next_out = buffer;
+            zs.avail_out = sizeof(buffer);
+            deflate(&zs, flush);
+            deflated.insert(deflated.end(), buffer, buffer + (sizeof(buffer) - zs.avail_out));
+        } while (zs.avail_out == 0);
+    }
+    deflateEnd(&zs);
+
+    Test::TempDir dir("orcacli_zip64");
+    const std::string path = dir.file("large.zip");
+    std::string error;
+    ZipWriter writer;
+    CHECK(writer.open(path, error));
+    ZipEntry meta;
+    meta.name = "Metadata/plate_1.gcode";
+    CHECK(writer.addDeflated(meta, deflated.data(), deflated.size(), size, static_cast<uint32_t>(crc), error));
+    meta.name = "Metadata/after.txt";
+    CHECK(writer.add(meta, "tail", 4, 6, error));
+    CHECK(writer.finish(error));
+
+    ZipReader reader;
+    CHECK(reader.open(path, error));
+    const ZipEntry* entry = reader.find("Metadata/plate_1.gcode");
+    CHECK(entry != nullptr);
+    if (!entry) return;
+    CHECK_EQ(entry->uncompressed_size, size);
+    CHECK_EQ(entry->compressed_size, uint64_t(deflated.size()));
+    CHECK_EQ(entry->crc32, static_cast<uint32_t>(crc));
+    const ZipEntry* after = reader.find("Metadata/after.txt");
+    CHECK(after != nullptr);
+    std::string tail;
+    if (after) CHECK(reader.read(*after, tail, error));
+    CHECK_EQ(tail, std::string("tail"));
+
+    ZipRawEntry raw;
+    CHECK(reader.readRaw(*entry, raw, error));
+    CHECK(raw.data == deflated);
+
+    // Inflate in chunks and check length and CRC
+    z_stream is{};
+    CHECK_EQ(inflateInit2(&is, -MAX_WBITS), Z_OK);
+    is.next_in = raw.data.data();
+    is.avail_in = static_cast<uInt>(raw.data.size());
+    uLong check = crc32(0L, Z_NULL, 0);
+    uint64_t total = 0;
+    int rc = Z_OK;
+    std::vector<uint8_t> out(1 << 20);
+    while (rc == Z_OK) {
+        is.next_out = out.data();
+        is.avail_out = static_cast<uInt>(out.size());
+        rc = inflate(&is, Z_NO_FLUSH);
+        const size_t produced = out.size() - is.avail_out;
+        check = crc32(check, out.data(), static_cast<uInt>(produced));
+        total += produced;
+    }
+    inflateEnd(&is);
+    CHECK_EQ(rc, Z_STREAM_END);
+    CHECK_EQ(total, size);
+    CHECK_EQ(check, crc);
+}
+
+} // namespace
+
+int main() {
+    test_levels();
+    test_zip_round_trip();
+    test_zip64_entry();
+    return Test::finish("test_parallel_deflate");
+}
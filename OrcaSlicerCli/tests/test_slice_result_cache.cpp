@@ -0,0 +1,188 @@
+// Sha256 against FIPS 180-4 vectors, and SliceResultCache keys, hits, misses,
+// eviction and claims contended by several engines.
+
+#include "TestSupport.hpp"
+
+#include "core/SliceResultCache.hpp"
+#include "utils/Sha256.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace OrcaSlicerCli;
+namespace fs = std::filesystem;
+
+namespace {
+
+using Lookup = SliceResultCache::Lookup;
+
+void write_file(const std::string& path, const std::string& content) {
+    std::ofstream(path, std::ios::binary) << content;
+}
+
+std::string read_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+std::string sha256(const std::string& s) {
+    Sha256 h;
+    h.update(s);
+    return h.hexDigest();
+}
+
+void test_sha256() {
+    CHECK_EQ(sha256(""), std::string("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"));
+    CHECK_EQ(sha256("abc"), std::string("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"));
+    const std::string two_blocks = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    CHECK_EQ(sha256(two_blocks), std::string("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"));
+    CHECK_EQ(sha256(std::string(1000000, 'a')), std::string("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"));
+
+    // Feeding byte by byte gives the same digest as one update
+    Sha256 h;
+    for (char c : two_blocks) h.update(&c, 1);
+    CHECK_EQ(h.hexDigest(), sha256(two_blocks));
+
+    Test::TempDir dir("orcacli_sha");
+    const std::string path = dir.file("abc.txt");
+    write_file(path, "abc");
+    Sha256 f;
+    CHECK(f.updateFromFile(path));
+    CHECK_EQ(f.hexDigest(), sha256("abc"));
+    Sha256 missing;
+    CHECK(!missing.updateFromFile(dir.file("missing")));
+}
+
+void test_keys() {
+    Test::TempDir dir("orcacli_keys");
+    const std::string model = dir.file("cube.stl");
+    write_file(model, "solid cube\nendsolid cube\n");
+    const std::string bytes = read_file(model);
+    const auto* data = reinterpret_cast<const uint8_t*>(bytes.data());
+
+    const std::string key = SliceResultCache::computeKey(model, 0, "layer_height = 0.2", "1.0", ".gcode", "cube");
+    CHECK_EQ(key.size(), size_t(64));
+    CHECK_EQ(key, SliceResultCache::computeKey(data, bytes.size(), 0, "layer_height = 0.2", "1.0", ".gcode", "cube"));
+    CHECK(key != SliceResultCache::computeKey(model, 1, "layer_height = 0.2", "1.0", ".gcode", "cube"));
+    CHECK(key != SliceResultCache::computeKey(model, 0, "layer_height = 0.3", "1.0", ".gcode", "cube"));
+    CHECK(key != SliceResultCache::computeKey(model, 0, "layer_height = 0.2", "1.1", ".gcode", "cube"));
+    CHECK(key != SliceResultCache::computeKey(model, 0, "layer_height = 0.2", "1.0", ".gcode.3mf", "cube"));
+    CHECK(key != SliceResultCache::computeKey(model, 0, "layer_height = 0.2", "1.0", ".gcode", "other"));
+    CHECK(SliceResultCache::computeKey(dir.file("missing.stl"), 0, "", "1.0", ".gcode", "missing").empty());
+
+    CHECK_EQ(SliceResultCache::outputSuffix("out/plate.GCODE.3MF"), std::string(".gcode.3mf"));
+    CHECK_EQ(SliceResultCache::outputSuffix("out/plate.bgcode"), std::string(".bgcode"));
+    CHECK_EQ(SliceResultCache::outputSuffix("out/plate"), std::string(".gcode"));
+}
+
+void test_hit_miss_evict() {
+    Test::TempDir dir("orcacli_cache");
+    SliceResultCache cache;
+    cache.configure(dir.file("cache"), 64);
+    CHECK(cache.enabled());
+
+    const std::string key_a(64, 'a'), key_b(64, 'b');
+    const std::string out = dir.file("out.gcode"), again = dir.file("again.gcode");
+
+    CHECK(cache.acquire(key_a, ".gcode", out) == Lookup::Claimed);
+    write_file(out, std::string(40, 'A'));
+    cache.publish(key_a, ".gcode", out);
+    CHECK(cache.acquire(key_a, ".gcode", again) == Lookup::Hit);
+    CHECK_EQ(read_file(again), std::string(40, 'A'));
+
+    // A failed job drops its claim; the next job claims the key again
+    CHECK(cache.acquire(key_b, ".gcode", out) == Lookup::Claimed);
+    cache.release(key_b);
+    CHECK(cache.acquire(key_b, ".gcode", out) == Lookup::Claimed);
+    write_file(out, std::string(40, 'B'));
+    cache.publish(key_b, ".gcode", out);
+
+    // Both entries (80 bytes) exceed the 64-byte budget: the older one is evicted
+    CHECK(cache.acquire(key_b, ".gcode", again) == Lookup::Hit);
+    CHECK(cache.acquire(key_a, ".gcode", again) == Lookup::Claimed);
+    cache.release(key_a);
+
+    const SliceResultCache::Stats stats = cache.stats();
+    CHECK_EQ(stats.hits, uint64_t(2));
+    CHECK_EQ(stats.misses, uint64_t(4));
+    CHECK_EQ(stats.coalesced, uint64_t(0));
+    CHECK(stats.evictions >= 1);
+
+    SliceResultCache disabled;
+    CHECK(!disabled.enabled());
+    CHECK(disabled.acquire(key_a, ".gcode", out) == Lookup::Bypass);
+}
+
+// Identical jobs on other engines wait for the claim and are served its result
+void test_contention() {
+    Test::TempDir dir("orcacli_contention");
+    SliceResultCache cache;
+    cache.configure(dir.file("cache"), 1 << 20);
+    const std::string key(64, 'c');
+    const std::string owner_out = dir.file("owner.gcode");
+
+    CHECK(cache.acquire(key, ".gcode", owner_out) == Lookup::Claimed);
+    constexpr int kWaiters = 4;
+    std::vector<Lookup> results(kWaiters, Lookup::Bypass);
+    std::vector<std::thread> waiters;
+    for (int i = 0; i < kWaiters; ++i) {
+        waiters.emplace_back([&, i] { results[i] = cache.acquire(key, ".gcode", dir.file("waiter" + std::to_string(i) + ".gcode")); });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    write_file(owner_out, "G1 X1\n");
+    cache.publish(key, ".gcode", owner_out);
+    for (auto& t : waiters) t.join();
+    for (int i = 0; i < kWaiters; ++i) {
+        CHECK(results[i] == Lookup::Hit);
+        CHECK_EQ(read_file(dir.file("waiter" + std::to_string(i) + ".gcode")), std::string("G1 X1\n"));
+    }
+    CHECK_EQ(cache.stats().coalesced, uint64_t(kWaiters));
+    CHECK_EQ(cache.stats().misses, uint64_t(1));
+
+    // A waiter whose job is canceled stops waiting; after a release a waiter claims the key
+    const std::string other(64, 'd');
+    CHECK(cache.acquire(other, ".gcode", owner_out) == Lookup::Claimed);
+    std::atomic<bool> stop{false};
+    Lookup stopped = Lookup::Bypass;
+    std::thread canceled([&] { stopped = cache.acquire(other, ".gcode", dir.file("canceled.gcode"), [&] { return stop.load(); }); });
+    Lookup next = Lookup::Bypass;
+    std::thread successor([&] { next = cache.acquire(other, ".gcode", dir.file("next.gcode")); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    stop = true;
+    canceled.join();
+    CHECK(stopped == Lookup::Stopped);
+    cache.release(other);
+    successor.join();
+    CHECK(next == Lookup::Claimed);
+    cache.release(other);
+}
+
+// A directory that cannot take claims bypasses the cache instead of blocking
+void test_unusable_directory() {
+    Test::TempDir dir("orcacli_unusable");
+    SliceResultCache cache;
+    const std::string cache_dir = dir.file("cache");
+    cache.configure(cache_dir, 1 << 20);
+    fs::remove_all(cache_dir);
+    write_file(cache_dir, "not a directory");
+    const auto start = std::chrono::steady_clock::now();
+    CHECK(cache.acquire(std::string(64, 'e'), ".gcode", dir.file("out.gcode")) == Lookup::Bypass);
+    CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(1));
+}
+
+} // namespace
+
+int main() {
+    test_sha256();
+    test_keys();
+    test_hit_miss_evict();
+    test_contention();
+    test_unusable_directory();
+    return Test::finish("test_slice_result_cache");
+}
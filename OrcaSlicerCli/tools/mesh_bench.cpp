@@ -0,0 +1,88 @@
+// Model ingestion benchmark: libslic3r's STL loader vs MeshReader (serial and parallel) on the same file.
+//
+//   orcacli_mesh_bench <model.stl|model.obj> [runs]
+//
+// Prints the best wall time of each loader and checks that serial and parallel
+// MeshReader produce the same mesh.
+
+#include "core/MeshReader.hpp"
+#include "core/OutputBuffer.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <thread>
+
+#if HAVE_LIBSLIC3R
+#include "libslic3r/TriangleMesh.hpp"
+#endif
+
+using namespace OrcaSlicerCli;
+
+namespace {
+
+double best_ms(int runs, const std::function<bool()>& fn) {
+    double best = 0;
+    for (int i = 0; i < runs; ++i) {
+        const auto t0 = std::chrono::steady_clock::now();
+        if (!fn()) return -1;
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        best = i == 0 ? ms : std::min(best, ms);
+    }
+    return best;
+}
+
+void report(const char* name, double ms, size_t vertices, size_t faces) {
+    if (ms < 0) std::printf("  %-28s failed\n", name);
+    else std::printf("  %-28s %10.1f ms  %zu vertices, %zu facets\n", name, ms, vertices, faces);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <model.stl|model.obj> [runs]\n", argv[0]);
+        return 2;
+    }
+    const std::string path = argv[1];
+    const int runs = argc > 2 ? std::max(1, std::atoi(argv[2])) : 3;
+    std::string ext = path.size() >= 4 ? path.substr(path.size() - 4) : std::string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    const bool obj = ext == ".obj";
+
+    std::printf("%s, %d run(s), %u hardware threads\n", path.c_str(), runs, std::thread::hardware_concurrency());
+
+#if HAVE_LIBSLIC3R
+    if (!obj) {
+        Slic3r::TriangleMesh mesh;
+        const double ms = best_ms(runs, [&] { mesh = Slic3r::TriangleMesh(); return mesh.ReadSTLFile(path.c_str(), true); });
+        report("TriangleMesh::ReadSTLFile", ms, mesh.its.vertices.size(), mesh.its.indices.size());
+    }
+#endif
+
+    std::string error;
+    MeshReader::Mesh serial, parallel;
+    auto load = [&](MeshReader::Mesh& mesh, unsigned threads) {
+        std::unique_ptr<OutputBuffer> file = OutputBuffer::map(path, error);
+        if (!file) return false;
+        return obj ? MeshReader::readObj(file->data(), file->size(), mesh, error, threads)
+                   : MeshReader::readStl(file->data(), file->size(), mesh, error, threads);
+    };
+    const double serial_ms = best_ms(runs, [&] { return load(serial, 1); });
+    report("MeshReader (mmap, serial)", serial_ms, serial.vertices.size(), serial.faces.size());
+    const double parallel_ms = best_ms(runs, [&] { return load(parallel, 0); });
+    report("MeshReader (mmap, parallel)", parallel_ms, parallel.vertices.size(), parallel.faces.size());
+    if (serial_ms < 0 || parallel_ms < 0) {
+        std::fprintf(stderr, "error: %s\n", error.c_str());
+        return 1;
+    }
+    if (serial.vertices != parallel.vertices || serial.faces != parallel.faces) {
+        std::fprintf(stderr, "error: parallel mesh differs from the serial one\n");
+        return 1;
+    }
+    return 0;
+}
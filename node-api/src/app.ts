@@ -5,10 +5,12 @@ import { koa, rest, errorHandler, parseAuthentication, cors, serveStatic } from
 import koaBody from 'koa-body'
 
 import { configurationValidator } from './configuration'
-import type { Application } from './declarations'
+import type { Application, RawResponse } from './declarations'
 import { logError } from './hooks/log-error'
 import { services } from './services/index'
 import loadOrca from './orca'
+import { memoryUploadStream, memoryUploadsEnabled } from './memory-uploads'
+import { observeHttpBytes, renderMetrics } from './metrics'
 
 const app: Application = koa(feathers())
 
@@ -17,7 +19,29 @@ app.configure(configuration(configurationValidator))
 
 // Set up Koa middleware
 app.use(cors())
-app.use(koaBody({ multipart: true, formidable: { keepExtensions: true } }))
+
+// GET /metrics no formato do Prometheus (ver metrics.ts); as demais rotas contam bytes por service
+app.use(async (ctx, next) => {
+  if (ctx.method === 'GET' && ctx.path === '/metrics') {
+    ctx.type = 'text/plain; version=0.0.4; charset=utf-8'
+    ctx.body = renderMetrics(app.get('orca'))
+    return
+  }
+  const socket = ctx.req.socket
+  const writtenBefore = socket.bytesWritten
+  ctx.res.once('finish', () => {
+    const servicePath = ctx.path.replace(/^\/+|\/+$/g, '')
+    const endpoint = Object.keys((app as any).services).find(p => servicePath === p || servicePath.startsWith(`${p}/`)) ?? 'other'
+    observeHttpBytes(endpoint, Number(ctx.request.length) || 0, socket.bytesWritten - writtenBefore)
+  })
+  await next()
+})
+app.use(
+  koaBody({
+    multipart: true,
+    formidable: { keepExtensions: true, ...(memoryUploadsEnabled() ? { fileWriteStreamHandler: memoryUploadStream } : {}) }
+  })
+)
 
 // Mapear arquivos do koa-body para params (ctx.feathers)
 app.use(async (ctx, next) => {
@@ -30,6 +54,43 @@ app.use(async (ctx, next) => {
 // app.use(serveStatic(app.get('public')))
 
 
+// Cliente HTTP desconectou antes da resposta: aborta o slice (params.signal nos services)
+app.use(async (ctx, next) => {
+  const controller = new AbortController()
+  const onClose = () => {
+    if (!ctx.res.writableFinished) controller.abort()
+  }
+  ctx.res.once('close', onClose)
+  ;(ctx.feathers as any).signal = controller.signal
+  await next()
+})
+
+// 503 da fila de slicing: converte data.retryAfterMs no header Retry-After (segundos)
+app.use(async (ctx, next) => {
+  await next()
+  const retryAfterMs = ctx.status === 503 ? (ctx.body as any)?.data?.retryAfterMs : undefined
+  if (typeof retryAfterMs === 'number') ctx.set('Retry-After', String(Math.max(1, Math.ceil(retryAfterMs / 1000))))
+})
+
+// Respostas binárias (Accept: text/x-gcode no /slicer/stl, Accept: model/3mf no /slicer/3mf): o service deixa
+// em params.rawResponse o corpo (Buffer ou stream) e os metadados em headers; o JSON dele é descartado
+app.use(async (ctx, next) => {
+  const raw: RawResponse = {}
+  ;(ctx.feathers as any).rawResponse = raw
+  await next()
+  if (!raw.body) return
+  if (ctx.status >= 300) {
+    if (!Buffer.isBuffer(raw.body)) raw.body.destroy() // um hook posterior falhou: cancela o slice/leitura
+    return
+  }
+  const headers = raw.headers ?? {}
+  ctx.set(headers)
+  if (Object.keys(headers).length) ctx.set('Access-Control-Expose-Headers', Object.keys(headers).join(', '))
+  ctx.body = raw.body
+  if (raw.type) ctx.type = raw.type
+  if (raw.length !== undefined) ctx.length = raw.length
+})
+
 app.use(errorHandler())
 app.use(parseAuthentication())
 // Eagerly load the Orca addon at API startup and log the configuration
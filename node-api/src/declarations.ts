@@ -1,6 +1,7 @@
 // For more information about this file see https://dove.feathersjs.com/guides/cli/typescript.html
 import { HookContext as FeathersHookContext, NextFunction } from '@feathersjs/feathers'
 import { Application as FeathersApplication } from '@feathersjs/koa'
+import type { Readable } from 'node:stream'
 import { ApplicationConfiguration } from './configuration'
 
 export type { NextFunction }
@@ -18,5 +19,14 @@ export interface ServiceTypes {}
 // The application instance type that will be used everywhere else
 export type Application = FeathersApplication<ServiceTypes, Configuration>
 
+// Binary response left by a service in params.rawResponse (see app.ts): replaces the JSON result,
+// the service metadata goes in headers
+export interface RawResponse {
+  body?: Buffer | Readable
+  type?: string
+  length?: number
+  headers?: Record<string, string>
+}
+
 // The context for hook functions - can be typed with a service class
 export type HookContext<S = any> = FeathersHookContext<Application, S>
@@ -0,0 +1,22 @@
+import { Writable } from 'node:stream'
+
+// Uploads multipart em memória: o formidable (koa-body) entrega os bytes a este stream em vez de gravar
+// o arquivo temporário, e o conteúdo fica em file.buffer. Os services passam o buffer direto ao engine
+// (params.input como Buffer), então o modelo enviado nunca passa pelo disco.
+// Desligue com ORCACLI_MEMORY_UPLOADS=0 (volta ao arquivo em file.filepath).
+export const memoryUploadsEnabled = () => process.env.ORCACLI_MEMORY_UPLOADS !== '0'
+
+export function memoryUploadStream(file: any): Writable {
+  const chunks: Buffer[] = []
+  return new Writable({
+    write(chunk: Buffer, _encoding, callback) {
+      chunks.push(chunk)
+      callback()
+    },
+    // Antes do 'finish': quando o formidable emite 'file', file.buffer já está preenchido
+    final(callback) {
+      file.buffer = Buffer.concat(chunks)
+      callback()
+    }
+  })
+}
@@ -0,0 +1,190 @@
+// Métricas no formato de texto do Prometheus (GET /metrics, ver app.ts), sem dependências.
+// Latência e bytes HTTP são medidos aqui; fila, engines, caches e RSS vêm do addon a cada coleta
+// (schedulerStats/engineStats, este último lendo orcacli_get_stats de cada engine).
+// No modo worker (engineMode === 'worker') as engines são processos do pool: essas séries são omitidas
+// e orca_info{mode="worker"} avisa quem monta os painéis.
+
+type Labels = Record<string, string>
+
+const labelKey = (labels: Labels) =>
+  Object.keys(labels)
+    .sort()
+    .map(k => `${k}="${String(labels[k]).replace(/\\/g, '\\\\').replace(/\n/g, '\\n').replace(/"/g, '\\"')}"`)
+    .join(',')
+
+const sample = (name: string, key: string, value: number) => `${name}${key ? `{${key}}` : ''} ${value}`
+
+export class Counter {
+  private values = new Map<string, number>()
+
+  constructor(
+    readonly name: string,
+    readonly help: string
+  ) {}
+
+  inc(labels: Labels = {}, n = 1) {
+    const key = labelKey(labels)
+    this.values.set(key, (this.values.get(key) ?? 0) + n)
+  }
+
+  render(): string[] {
+    const lines = [`# HELP ${this.name} ${this.help}`, `# TYPE ${this.name} counter`]
+    for (const [key, value] of this.values) lines.push(sample(this.name, key, value))
+    return lines
+  }
+}
+
+export class Histogram {
+  private series = new Map<string, { labels: Labels; counts: number[]; sum: number; count: number }>()
+
+  constructor(
+    readonly name: string,
+    readonly help: string,
+    readonly buckets: number[]
+  ) {}
+
+  observe(labels: Labels, value: number) {
+    const key = labelKey(labels)
+    let s = this.series.get(key)
+    if (!s) {
+      s = { labels, counts: this.buckets.map(() => 0), sum: 0, count: 0 }
+      this.series.set(key, s)
+    }
+    for (let i = 0; i < this.buckets.length; i++) if (value <= this.buckets[i]) s.counts[i]++
+    s.sum += value
+    s.count++
+  }
+
+  render(): string[] {
+    const lines = [`# HELP ${this.name} ${this.help}`, `# TYPE ${this.name} histogram`]
+    for (const [key, s] of this.series) {
+      this.buckets.forEach((le, i) => {
+        lines.push(sample(`${this.name}_bucket`, labelKey({ ...s.labels, le: String(le) }), s.counts[i]))
+      })
+      lines.push(sample(`${this.name}_bucket`, labelKey({ ...s.labels, le: '+Inf' }), s.count))
+      lines.push(sample(`${this.name}_sum`, key, s.sum))
+      lines.push(sample(`${this.name}_count`, key, s.count))
+    }
+    return lines
+  }
+}
+
+// Valores lidos no momento da coleta
+const gauge = (name: string, help: string, values: [Labels, number][], type = 'gauge') => [
+  `# HELP ${name} ${help}`,
+  `# TYPE ${name} ${type}`,
+  ...values.map(([labels, value]) => sample(name, labelKey(labels), value))
+]
+
+// Segundos: de um STL pequeno com config em cache a um 3MF grande
+const SLICE_BUCKETS = [0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10, 30, 60, 120, 300]
+
+const sliceDuration = new Histogram(
+  'orca_slice_duration_seconds',
+  'Slice latency by endpoint and phase (total = whole request incl. queue wait; others = engine stages)',
+  SLICE_BUCKETS
+)
+const slices = new Counter('orca_slices_total', 'Slices requested through the HTTP services, by outcome')
+const httpBytesIn = new Counter('orca_http_request_bytes_total', 'Request body bytes received (Content-Length)')
+const httpBytesOut = new Counter('orca_http_response_bytes_total', 'Response bytes written to the socket, headers included')
+
+// Fases de SliceTimings (addon) no rótulo phase
+const PHASES: [string, string][] = [
+  ['loadModelNs', 'load_model'],
+  ['presetsNs', 'presets'],
+  ['applyNs', 'apply'],
+  ['processNs', 'process'],
+  ['exportGcodeNs', 'export_gcode'],
+  ['packageNs', 'package']
+]
+// Seguidores do single-flight recebem o mesmo objeto timings do líder: o trabalho da engine conta uma vez
+const observedTimings = new WeakSet<object>()
+
+export function observeSlice(endpoint: string, startedAt: number, result?: { timings?: Record<string, any> }, error?: unknown) {
+  sliceDuration.observe({ endpoint, phase: 'total' }, (performance.now() - startedAt) / 1000)
+  slices.inc({ endpoint, outcome: error ? ((error as any)?.name === 'AbortError' ? 'aborted' : 'error') : 'ok' })
+  const timings = result?.timings
+  if (!timings || typeof timings !== 'object' || observedTimings.has(timings)) return
+  observedTimings.add(timings)
+  for (const [field, phase] of PHASES) {
+    const ns = Number(timings[field])
+    if (ns > 0) sliceDuration.observe({ endpoint, phase }, ns / 1e9)
+  }
+}
+
+export function observeHttpBytes(endpoint: string, bytesIn: number, bytesOut: number) {
+  if (bytesIn > 0) httpBytesIn.inc({ endpoint }, bytesIn)
+  if (bytesOut > 0) httpBytesOut.inc({ endpoint }, bytesOut)
+}
+
+const ratio = (hits: number, misses: number) => (hits + misses > 0 ? hits / (hits + misses) : 0)
+
+// Texto completo do /metrics; o engine (app.get('orca')) pode ser o addon, o overlay de workers ou o single-flight
+export function renderMetrics(orca: any): string {
+  const workerMode = orca?.engineMode === 'worker'
+  const lines: string[] = [
+    ...gauge('orca_info', 'Where the slices run: addon (engines in this process) or worker (orcaslicer-cli serve pool)', [
+      [{ mode: workerMode ? 'worker' : 'addon' }, 1]
+    ]),
+    ...sliceDuration.render(),
+    ...slices.render(),
+    ...httpBytesIn.render(),
+    ...httpBytesOut.render()
+  ]
+
+  if (typeof orca?.schedulerStats === 'function') {
+    const s = orca.schedulerStats()
+    lines.push(
+      ...gauge('orca_queue_depth', 'Slices waiting for an engine, by priority', [
+        [{ priority: 'interactive' }, s.interactive.queued],
+        [{ priority: 'batch' }, s.batch.queued]
+      ]),
+      ...gauge('orca_queue_max_depth', 'Queue bound; further slices are rejected with 503', [[{}, s.maxQueueDepth]]),
+      ...gauge(
+        'orca_queue_rejected_total',
+        'Slices rejected because the queue was full',
+        [
+          [{ priority: 'interactive' }, s.interactive.rejected],
+          [{ priority: 'batch' }, s.batch.rejected]
+        ],
+        'counter'
+      )
+    )
+  }
+
+  const rss: [Labels, number][] = []
+  const caches: [string, { hits: number; misses: number; evictions: number }][] = []
+  if (typeof orca?.engineStats === 'function') {
+    const e = orca.engineStats()
+    caches.push(['config', e.configCache], ['project', e.projectCache], ['result', e.resultCache])
+    lines.push(
+      ...gauge('orca_engines', 'Engines in the addon pool, by state', [
+        [{ state: 'busy' }, e.busy],
+        [{ state: 'idle' }, e.idle]
+      ]),
+      ...gauge('orca_engine_slices_total', 'Slices run by the engines', [[{}, e.slices]], 'counter'),
+      ...gauge('orca_engine_slice_failures_total', 'Engine slices that failed, were canceled or timed out', [[{}, e.sliceFailures]], 'counter'),
+      ...gauge('orca_engine_bytes_in_total', 'Model bytes read by the engines', [[{}, e.bytesIn]], 'counter'),
+      ...gauge('orca_engine_bytes_out_total', 'Output bytes produced by the engines', [[{}, e.bytesOut]], 'counter')
+    )
+    if (e.rssBytes > 0) rss.push([{}, e.rssBytes])
+  }
+  // O single-flight roda neste processo, então vale também no modo worker
+  if (typeof orca?.singleFlightStats === 'function') {
+    const sf = orca.singleFlightStats()
+    caches.push(['single_flight', { hits: sf.followers, misses: sf.leaders, evictions: 0 }])
+  }
+  if (caches.length) {
+    lines.push(
+      ...gauge('orca_cache_hits_total', 'Cache hits, by cache', caches.map(([cache, c]) => [{ cache }, c.hits]), 'counter'),
+      ...gauge('orca_cache_misses_total', 'Cache misses, by cache', caches.map(([cache, c]) => [{ cache }, c.misses]), 'counter'),
+      ...gauge('orca_cache_hit_ratio', 'hits / (hits + misses) since start, by cache', caches.map(([cache, c]) => [{ cache }, ratio(c.hits, c.misses)]))
+    )
+  }
+  // As engines do addon rodam neste processo: sem o RSS da engine (fora do Linux), o do processo é o mesmo número.
+  // No modo worker o RSS deste processo não é o das engines.
+  if (!rss.length && !workerMode) rss.push([{}, process.memoryUsage().rss])
+  if (rss.length) lines.push(...gauge('orca_engine_rss_bytes', 'Resident set size of the process hosting the engines', rss))
+
+  return lines.join('\n') + '\n'
+}
@@ -0,0 +1,194 @@
+import * as net from 'node:net'
+import * as fs from 'node:fs'
+import * as os from 'node:os'
+import * as path from 'node:path'
+import { randomUUID } from 'node:crypto'
+import { Readable } from 'node:stream'
+
+// Cliente do pool de workers pré-forkados (`orcaslicer-cli serve --socket <path>`).
+// Cada job abre uma conexão no socket Unix; o protocolo é "chave=valor" por linha, terminado por linha vazia.
+// Se o worker cair durante o slice, apenas este job falha (o supervisor recria o worker).
+// Abortar (signal) fecha a conexão; o worker percebe e cancela o slice em andamento.
+// Modelo em memória (params.input como Buffer) segue no próprio pedido: input_size=N e os N bytes depois da linha vazia.
+
+export interface WorkerSliceParams {
+  input: string | Uint8Array | ArrayBuffer
+  inputFormat?: string
+  inputName?: string
+  output?: string
+  plate?: number
+  printerProfile?: string
+  filamentProfile?: string
+  processProfile?: string
+  verbose?: boolean
+  dryRun?: boolean
+  signal?: AbortSignal
+  timeoutMs?: number
+  compressionLevel?: number
+  // Trace Chrome do job: caminho do arquivo, ou true para '<output>.trace.json' (volta como tracePath)
+  trace?: string | boolean
+  options?: Record<string, string | number | boolean>
+  custom?: Record<string, string>
+}
+
+type WorkerSliceResult = { output: string; tracePath?: string }
+
+const tracePathOf = (params: WorkerSliceParams) => (params.trace === true ? `${params.output}.trace.json` : params.trace || undefined)
+
+const escapeValue = (v: string) => v.replace(/\\/g, '\\\\').replace(/\r/g, '').replace(/\n/g, '\\n')
+const unescapeValue = (v: string) => v.replace(/\\(.)/g, (_m, c: string) => (c === 'n' ? '\n' : c))
+
+const encodeRequest = (params: WorkerSliceParams, bytes?: Uint8Array): string => {
+  const lines: string[] = []
+  const put = (key: string, value: unknown) => {
+    if (value === undefined || value === null || value === '') return
+    lines.push(`${key}=${escapeValue(String(value))}`)
+  }
+  if (bytes) {
+    // Modelo inline: input só dá nome ao objeto
+    put('input', params.inputName)
+    put('input_format', (params.inputFormat || path.extname(params.inputName ?? '').slice(1) || 'stl').toLowerCase())
+    put('input_size', bytes.byteLength)
+  } else {
+    put('input', params.input)
+  }
+  put('output', params.output)
+  put('plate', params.plate)
+  put('printer', params.printerProfile)
+  put('filament', params.filamentProfile)
+  put('process', params.processProfile)
+  if (params.verbose) put('verbose', 1)
+  if (params.dryRun) put('dry_run', 1)
+  put('timeout_ms', params.timeoutMs)
+  put('compression_level', params.compressionLevel)
+  put('trace', tracePathOf(params))
+  for (const map of [params.options, params.custom]) {
+    if (!map || typeof map !== 'object') continue
+    for (const [k, v] of Object.entries(map)) {
+      // Mesma coerção do addon: boolean -> 1/0, number/string -> texto
+      if (typeof v === 'boolean') put(`set.${k}`, v ? '1' : '0')
+      else if (typeof v === 'number' || typeof v === 'string') put(`set.${k}`, v)
+    }
+  }
+  return lines.join('\n') + '\n\n'
+}
+
+const decodeResponse = (raw: string): Record<string, string> => {
+  const out: Record<string, string> = {}
+  for (const line of raw.split('\n')) {
+    const eq = line.indexOf('=')
+    if (eq <= 0) continue
+    out[line.slice(0, eq)] = unescapeValue(line.slice(eq + 1))
+  }
+  return out
+}
+
+// Mesmo formato do AbortError do addon
+const abortError = () => Object.assign(new Error('The operation was aborted'), { name: 'AbortError', code: 'ABORT_ERR' })
+
+export function createWorkerClient(socketPath: string) {
+  const slice = (params: WorkerSliceParams): Promise<WorkerSliceResult> =>
+    new Promise((resolve, reject) => {
+      if (!params || !params.input) {
+        reject(new TypeError('params.input is required'))
+        return
+      }
+      const bytes =
+        typeof params.input === 'string' ? undefined : params.input instanceof ArrayBuffer ? new Uint8Array(params.input) : params.input
+      if (bytes && bytes.byteLength === 0) {
+        reject(new TypeError('params.input is empty'))
+        return
+      }
+      if (!params.output) {
+        reject(new TypeError('params.output is required in worker mode'))
+        return
+      }
+      if (params.signal?.aborted) {
+        reject(abortError())
+        return
+      }
+      const sock = net.createConnection(socketPath)
+      let raw = ''
+      let done = false
+      const onAbort = () => finish(abortError())
+      const finish = (err: Error | null, value?: WorkerSliceResult) => {
+        if (done) return
+        done = true
+        params.signal?.removeEventListener('abort', onAbort)
+        sock.destroy()
+        if (err) reject(err)
+        else resolve(value!)
+      }
+      params.signal?.addEventListener('abort', onAbort)
+      sock.setEncoding('utf8')
+      sock.on('connect', () => {
+        sock.write(encodeRequest(params, bytes))
+        if (bytes) sock.write(bytes)
+      })
+      sock.on('data', chunk => {
+        raw += chunk
+        if (!raw.includes('\n\n')) return
+        const res = decodeResponse(raw.slice(0, raw.indexOf('\n\n')))
+        const tracePath = tracePathOf(params)
+        if (res.ok === '1') finish(null, tracePath && fs.existsSync(tracePath) ? { output: params.output!, tracePath } : { output: params.output! })
+        else if (res.message === 'Slicing deadline exceeded') finish(Object.assign(new Error(res.message), { code: 'ORCACLI_DEADLINE_EXCEEDED' }))
+        else finish(new Error(res.message || 'slice failed'))
+      })
+      sock.on('error', err => finish(new Error(`Worker pool unavailable (${socketPath}): ${err.message}`)))
+      sock.on('close', () => finish(new Error('Slicing worker terminated before replying (crashed?)')))
+    })
+
+  // Workers são outros processos: a saída volta por um arquivo temporário, lido e apagado aqui
+  const tempOutput = (params: WorkerSliceParams) => {
+    const kind = (params?.output ?? '').toLowerCase().endsWith('.3mf') ? '.gcode.3mf' : '.gcode'
+    return path.join(os.tmpdir(), `orca-${randomUUID()}${kind}`)
+  }
+
+  const sliceToBuffer = async (params: WorkerSliceParams): Promise<{ buffer: ArrayBuffer; tracePath?: string }> => {
+    const output = tempOutput(params)
+    try {
+      const { tracePath } = await slice({ ...params, output })
+      const content = await fs.promises.readFile(output)
+      const buffer = content.buffer.slice(content.byteOffset, content.byteOffset + content.byteLength) as ArrayBuffer
+      return tracePath ? { buffer, tracePath } : { buffer }
+    } finally {
+      fs.promises.unlink(output).catch(() => {})
+    }
+  }
+
+  // Mesmo arquivo temporário, lido em blocos depois do slice; destruir o stream (ou params.signal) cancela o job
+  const sliceStream = (params: WorkerSliceParams): Readable => {
+    const controller = new AbortController()
+    const output = tempOutput(params)
+    let file: fs.ReadStream | undefined
+    const stream = new Readable({
+      read() {
+        file?.resume()
+      },
+      destroy(err, cb) {
+        controller.abort()
+        file?.destroy()
+        fs.promises.unlink(output).catch(() => {})
+        cb(err)
+      }
+    })
+    if (params.signal?.aborted) stream.destroy(abortError())
+    else params.signal?.addEventListener('abort', () => stream.destroy(abortError()), { once: true })
+    slice({ ...params, output, signal: controller.signal }).then(
+      ({ tracePath }) => {
+        if (stream.destroyed) return
+        if (tracePath) stream.emit('trace', tracePath) // como o sliceStream do addon
+        file = fs.createReadStream(output)
+        file.on('data', chunk => {
+          if (!stream.push(chunk)) file!.pause()
+        })
+        file.on('end', () => stream.push(null))
+        file.on('error', err => stream.destroy(err))
+      },
+      err => stream.destroy(err)
+    )
+    return stream
+  }
+
+  return { slice, sliceToBuffer, sliceStream }
+}
@@ -1,9 +1,22 @@
 import * as path from 'node:path'
+import { createWorkerClient } from './orca-workers'
+import { overlay } from './overlay'
+import { withSingleFlight } from './single-flight'
 
 const addonDir = process.env.ORCACLI_ADDON_DIR || path.resolve(__dirname, '../../../OrcaSlicerCli/bindings/node')
 
 const orca = require(addonDir)
 const resourcesPath = process.env.ORCACLI_RESOURCES || path.resolve(__dirname, '../../../OrcaSlicer/resources')
+// Modo pool de processos: slices vão para `orcaslicer-cli serve --socket <path>` (isolamento de crash)
+const workerSocket = process.env.ORCACLI_WORKER_SOCKET
+// Snapshot binário dos presets: evita reprocessar os JSONs dos vendors a cada start
+const snapshotPath = process.env.ORCACLI_SNAPSHOT
+// Vendors carregados no start quando não há snapshot utilizável (e gravados nele)
+const vendors = (process.env.ORCACLI_VENDORS || 'BBL').split(',').map(v => v.trim()).filter(Boolean)
+// Pedidos idênticos simultâneos compartilham um único slice (ORCACLI_SINGLE_FLIGHT=0 desliga)
+const singleFlight = process.env.ORCACLI_SINGLE_FLIGHT !== '0'
+// Prazo padrão por slice em ms, contando a espera na fila (0/ausente = sem prazo)
+const sliceTimeoutMs = Number(process.env.ORCACLI_SLICE_TIMEOUT_MS) || 0
 
 export default function(app: any) {
     try {
@@ -30,6 +43,24 @@ export default function(app: any) {
             })
             console.log(`[Orca] Addon loaded. addonDir=${addonDir} resourcesPath=${resourcesPath}`)
 
+            let fromSnapshot = false
+            if (snapshotPath && typeof orca.loadSnapshot === 'function') {
+                fromSnapshot = orca.loadSnapshot(snapshotPath)
+                console.log(`[Orca] Snapshot ${fromSnapshot ? 'loaded' : 'not usable (missing/stale)'}: ${snapshotPath}`)
+            }
+            let vendorsLoaded = 0
+            if (!fromSnapshot) {
+                for (const vendor of vendors) {
+                    try {
+                        orca.loadVendor(vendor)
+                        vendorsLoaded++
+                        console.log(`[Orca] Loaded vendor: ${vendor}`)
+                    } catch (e) {
+                        console.warn(`[Orca] Could not load vendor ${vendor}:`, e)
+                    }
+                }
+            }
+
             // Load a generic/default profile set (best-effort): printer, filament, and process
             // We attempt a small set of common candidates and stop on the first success of each category.
             const printerCandidates = [
@@ -56,12 +87,46 @@ export default function(app: any) {
                 return null
             }
 
-            // Vendor 'BBL' is already requested in initialize; proceed to load generic presets
+            // Vendors come from the snapshot or loadVendor above; proceed to load generic presets
             tryLoad('printer profile', orca.loadPrinterProfile, printerCandidates)
             tryLoad('filament profile', orca.loadFilamentProfile, filamentCandidates)
             tryLoad('process profile', orca.loadProcessProfile, processCandidates)
 
-            app.set('orca', orca)
+            // Só grava com todos os vendors carregados: um snapshot parcial seria reutilizado nos próximos starts
+            if (snapshotPath && !fromSnapshot && vendorsLoaded === vendors.length && vendorsLoaded > 0 && typeof orca.saveSnapshot === 'function') {
+                try {
+                    orca.saveSnapshot(snapshotPath)
+                    console.log(`[Orca] Snapshot saved: ${snapshotPath}`)
+                } catch (e) {
+                    console.warn(`[Orca] Could not save snapshot ${snapshotPath}:`, e)
+                }
+            }
+
+            let engine = orca
+            if (workerSocket) {
+                // Mantém o addon para version/getModelInfo/load*; apenas slice() vai para os workers.
+                // Fila e engines do addon ficam ociosas neste modo: o /metrics não as publica (ver metrics.ts)
+                engine = overlay(orca, {
+                    ...createWorkerClient(workerSocket),
+                    engineMode: 'worker',
+                    engineStats: undefined,
+                    schedulerStats: undefined
+                })
+                console.log(`[Orca] Worker pool mode: slices go to ${workerSocket}`)
+            }
+            if (sliceTimeoutMs > 0) {
+                const base = engine
+                engine = overlay(base, {
+                    slice: (params: any) => base.slice({ timeoutMs: sliceTimeoutMs, ...params }),
+                    ...(typeof base.sliceToBuffer === 'function'
+                        ? { sliceToBuffer: (params: any) => base.sliceToBuffer({ timeoutMs: sliceTimeoutMs, ...params }) }
+                        : {}),
+                    ...(typeof base.sliceStream === 'function'
+                        ? { sliceStream: (params: any) => base.sliceStream({ timeoutMs: sliceTimeoutMs, ...params }) }
+                        : {})
+                })
+            }
+            app.set('orca', singleFlight ? withSingleFlight(engine) : engine)
         } finally {
             try { process.chdir(prevCwd) } catch {}
         }
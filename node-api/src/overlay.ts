@@ -0,0 +1,9 @@
+// Sobrepõe métodos a um engine sem alterá-lo. O addon define as funções via N-API como somente leitura,
+// então Object.assign(Object.create(orca), ...) falharia; aqui as propriedades são definidas no objeto novo.
+export function overlay<T extends object>(base: T, props: Record<string, unknown>): T {
+  const descriptors: PropertyDescriptorMap = {}
+  for (const [key, value] of Object.entries(props)) {
+    descriptors[key] = { value, writable: true, enumerable: true, configurable: true }
+  }
+  return Object.create(base, descriptors)
+}
@@ -154,15 +154,17 @@ async function loadPresetFromInputs(
   }
 
   if (fileObj) {
+    // Upload em memória (memory-uploads.ts): bytes em fileObj.buffer, sem arquivo no disco
+    const inMemory: Buffer | undefined = Buffer.isBuffer(fileObj.buffer) ? fileObj.buffer : undefined
     const filePath = fileObj.filepath || fileObj.path || fileObj.tempFilePath
-    if (!filePath) throw new BadRequest('Invalid uploaded file')
-    const ext = path.extname(filePath).toLowerCase()
+    if (!filePath && !inMemory) throw new BadRequest('Invalid uploaded file')
+    const ext = path.extname((inMemory ? fileObj.originalFilename : undefined) || filePath || '').toLowerCase()
     if (ext === '.json') {
-      const content = await fs.readFile(filePath, 'utf8')
+      const content = inMemory ? inMemory.toString('utf8') : await fs.readFile(filePath, 'utf8')
       return JSON.parse(content)
     }
     if (ext === '.zip' || ext === '.orca' || ext === '.orca_profile' || ext === '.orca_printer' || ext === '.orca_filament') {
-      const buf = await fs.readFile(filePath)
+      const buf = inMemory ?? (await fs.readFile(filePath))
       return loadJsonFromZipBuffer(buf, kind)
     }
     throw new BadRequest(`Unsupported file extension: ${ext}`)
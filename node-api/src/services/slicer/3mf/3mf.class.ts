@@ -7,7 +7,9 @@ import { randomUUID } from 'node:crypto'
 
 import type { Application } from '../../../declarations'
 import type { Slicer3Mf, Slicer3MfData, Slicer3MfPatch, Slicer3MfQuery } from './3mf.schema'
-import { BadRequest } from '@feathersjs/errors'
+import { BadRequest, Timeout, Unavailable } from '@feathersjs/errors'
+import { observeSlice } from '../../../metrics'
+import { newTracePath } from '../../../trace-files'
 
 export type { Slicer3Mf, Slicer3MfData, Slicer3MfPatch, Slicer3MfQuery }
 export interface Slicer3MfServiceOptions {
@@ -44,8 +46,6 @@ export class Slicer3MfService<ServiceParams extends Slicer3MfParams = Slicer3MfP
     }
 
     const orca = await this.options.app.get('orca')
-    console.log(orca)
-
 
     const reqField = data.field ?? 'file'
     const anyParams: any = params ?? {}
@@ -61,42 +61,71 @@ export class Slicer3MfService<ServiceParams extends Slicer3MfParams = Slicer3MfP
         fileObj = Array.isArray(first) ? first[0] : first
       }
     }
-    console.log(3)
 
     let inputPath: string | undefined = data.filePath
     let originalFilename: string | undefined
+    // Upload em memória (ver memory-uploads.ts): os bytes vão direto ao engine, sem arquivo temporário
+    let inputBuffer: Buffer | undefined
 
     if (fileObj) {
-      inputPath = fileObj.filepath || fileObj.path || fileObj.tempFilePath || inputPath
+      if (Buffer.isBuffer(fileObj.buffer)) inputBuffer = fileObj.buffer
+      else inputPath = fileObj.filepath || fileObj.path || fileObj.tempFilePath || inputPath
       originalFilename = fileObj.originalFilename || fileObj.name || fileObj.filename || originalFilename
     }
-    console.log(4)
 
-    if (!inputPath) {
+    if (!inputPath && !inputBuffer) {
       throw new Error('Nenhum arquivo recebido. Envie um multipart field "file" ou informe "filePath".')
     }
 
+    // Sem data.output o .gcode.3mf volta em memória (sliceToBuffer), sem arquivo para ler e apagar
+    const inMemory = !data.output && typeof orca.sliceToBuffer === 'function'
+    // Accept: model/3mf: os bytes vão no corpo da resposta (middleware em app.ts) e os metadados em headers, sem base64
+    const binary = !!anyParams.rawResponse && String(anyParams.headers?.accept ?? '').includes('model/3mf')
+
     // Define caminho de saída padrão com extensão .gcode.3mf
     const defaultOut = path.join(os.tmpdir(), `orca-${randomUUID()}.gcode.3mf`)
     const outPath = data.output ?? defaultOut
 
-    let output: string
+    const id = randomUUID()
+    // data.trace: o caminho é escolhido aqui para ir também no header da resposta binária (local do servidor, ver trace-files.ts)
+    const tracePath = data.trace ? newTracePath(id) : undefined
+
+    let output = ''
+    let content: Buffer | undefined
+    const startedAt = performance.now()
     try {
-    console.log(5)
-      const res = await orca.slice({
-        input: inputPath,
-        output: outPath,
+      const params = {
+        ...(inputBuffer
+          ? { input: inputBuffer, inputFormat: '3mf', inputName: originalFilename }
+          : { input: inputPath! }),
+        output: inMemory ? '.gcode.3mf' : outPath,
         plate: data.plate,
         printerProfile: data.printerProfile,
         filamentProfile: data.filamentProfile,
         processProfile: data.processProfile,
+        priority: data.priority,
+        compressionLevel: data.compressionLevel,
+        trace: tracePath,
+        signal: anyParams.signal,
         options: (data as any).options
-      })
-      output = res.output
-    console.log(6)
+      }
+      if (inMemory) {
+        const res = await orca.sliceToBuffer(params)
+        observeSlice('slicer/3mf', startedAt, res)
+        content = Buffer.from(res.buffer)
+      } else {
+        const res = await orca.slice(params)
+        observeSlice('slicer/3mf', startedAt, res)
+        output = res.output
+      }
     } catch (err: any) {
-    console.log(err)
+      observeSlice('slicer/3mf', startedAt, undefined, err)
       const msg = String(err?.message || err)
+      if (err?.code === 'ORCACLI_QUEUE_FULL') {
+        // Fila do addon cheia: 503 + Retry-After (ver middleware em app.ts)
+        throw new Unavailable(msg, { retryAfterMs: err.retryAfterMs })
+      }
+      if (err?.code === 'ORCACLI_DEADLINE_EXCEEDED') throw new Timeout(msg)
       const lower = msg.toLowerCase()
       if (lower.includes('unknown') || lower.includes('invalid') || lower.includes('unrecognized') || lower.includes('failed to set')) {
         throw new BadRequest(`Invalid override option(s): ${msg}`)
@@ -104,21 +133,39 @@ export class Slicer3MfService<ServiceParams extends Slicer3MfParams = Slicer3MfP
       throw err
     }
 
-    // Garante existência do arquivo antes de responder.
-    if (!fs.existsSync(output)) {
-      throw new Error('Falha ao gerar .gcode.3mf')
+    if (!content) {
+      // Garante existência do arquivo antes de responder.
+      if (!fs.existsSync(output)) {
+        throw new Error('Falha ao gerar .gcode.3mf')
+      }
+      if (!binary) content = await fs.promises.readFile(output)
     }
 
-    const content = await fs.promises.readFile(output)
-    const dataBase64 = content.toString('base64')
+    const traced = tracePath && fs.existsSync(tracePath) ? { tracePath } : undefined
+    if (binary) {
+      // Buffer da engine (sem cópia) ou o arquivo de saída lido em stream; Content-Length nos dois casos
+      const raw = anyParams.rawResponse
+      raw.body = content ?? fs.createReadStream(output)
+      raw.length = content ? content.length : (await fs.promises.stat(output)).size
+      raw.type = 'model/3mf'
+      raw.headers = {
+        'X-Orca-Id': id,
+        'X-Orca-Output-Path': output,
+        ...(originalFilename ? { 'X-Orca-Filename': encodeURIComponent(originalFilename) } : {}),
+        ...(traced ? { 'X-Orca-Trace-Path': traced.tracePath } : {})
+      }
+      return { id, filename: originalFilename, outputPath: output, contentType: 'model/3mf', size: raw.length, ...traced }
+    }
+    const dataBase64 = content!.toString('base64')
 
     return {
-      id: randomUUID(),
+      id,
       filename: originalFilename,
-      outputPath: output,
+      outputPath: output, // vazio quando a saída veio em memória
       contentType: 'model/3mf',
-      size: content.length,
-      dataBase64
+      size: content!.length,
+      dataBase64,
+      ...traced
     }
   }
 
@@ -57,7 +57,6 @@ export const slicer3Mf = (app: Application) => {
                 throw new Error('Failed to parse "options" as JSON')
               }
             }
-            console.log(2, Object.keys(data.options))
           }
         },
         schemaHooks.validateData(slicer3MfDataValidator),
@@ -13,7 +13,9 @@ export const slicerStlSchema = Type.Object(
     id: Type.String(),
     filename: Type.Optional(Type.String()),
     outputPath: Type.String(),
-    gcode: Type.String()
+    gcode: Type.String(),
+    // Trace Chrome do slice (data.trace): caminho local do servidor, apagado após ORCACLI_TRACE_TTL_MS
+    tracePath: Type.Optional(Type.String())
   },
   { $id: 'SlicerStl', additionalProperties: false }
 )
@@ -36,6 +38,10 @@ export const slicerStlDataSchema = Type.Object(
     printerProfile: Type.Optional(Type.String()),
     filamentProfile: Type.Optional(Type.String()),
     processProfile: Type.Optional(Type.String()),
+    // Opcional: classe de prioridade na fila do addon (padrão: interactive)
+    priority: Type.Optional(Type.Union([Type.Literal('interactive'), Type.Literal('batch')])),
+    // Opcional: grava o trace Chrome das etapas do slice (tracePath na resposta; header X-Orca-Trace-Path em stream)
+    trace: Type.Optional(Type.Boolean()),
     // Opcional: overrides de configuração (coerção p/ string no addon)
     options: Type.Optional(
       Type.Record(
@@ -0,0 +1,178 @@
+import * as crypto from 'node:crypto'
+import * as fs from 'node:fs'
+import * as path from 'node:path'
+import { overlay } from './overlay'
+
+// Single-flight de slices: pedidos idênticos em andamento (mesmo arquivo, placa, perfis e opções)
+// não fatiam de novo. O primeiro (líder) fatia; os demais aguardam a mesma promise e recebem
+// uma cópia da saída no próprio caminho de output (em sliceToBuffer, o mesmo ArrayBuffer). Retries/refresh em rajada viram um único slice.
+// Desligue com ORCACLI_SINGLE_FLIGHT=0.
+// Cancelamento: cada pedido pode abortar (params.signal) sem afetar os demais; o slice compartilhado
+// só é abortado quando não resta nenhum pedido esperando por ele.
+// Prazo (timeoutMs) e prioridade entram na chave: o seguidor nunca herda o prazo ou a fila do líder.
+
+export interface SingleFlightSliceParams {
+  input: string | Uint8Array | ArrayBuffer
+  inputFormat?: string
+  inputName?: string
+  output?: string
+  plate?: number
+  printerProfile?: string
+  filamentProfile?: string
+  processProfile?: string
+  verbose?: boolean
+  dryRun?: boolean
+  priority?: 'interactive' | 'batch'
+  signal?: AbortSignal
+  timeoutMs?: number
+  trace?: string | boolean
+  options?: Record<string, string | number | boolean>
+  custom?: Record<string, string>
+}
+
+type SliceFn = (params: SingleFlightSliceParams) => Promise<{ output: string }>
+type SliceToBufferFn = (params: SingleFlightSliceParams) => Promise<{ buffer: ArrayBuffer }>
+
+const hashFile = (file: string): Promise<string> =>
+  new Promise((resolve, reject) => {
+    const hash = crypto.createHash('sha256')
+    fs.createReadStream(file)
+      .on('error', reject)
+      .on('data', chunk => hash.update(chunk))
+      .on('end', () => resolve(hash.digest('hex')))
+  })
+
+// Mesma coerção do addon (boolean -> 1/0), chaves ordenadas para a ordem do JSON não importar
+const canonicalOptions = (params: SingleFlightSliceParams): [string, string][] => {
+  const out = new Map<string, string>()
+  for (const map of [params.options, params.custom]) {
+    if (!map || typeof map !== 'object') continue
+    for (const [k, v] of Object.entries(map)) {
+      if (typeof v === 'boolean') out.set(k, v ? '1' : '0')
+      else if (typeof v === 'number' || typeof v === 'string') out.set(k, String(v))
+    }
+  }
+  return [...out.entries()].sort(([a], [b]) => (a < b ? -1 : a > b ? 1 : 0))
+}
+
+// Tipo de saída (.gcode vs .gcode.3mf) entra na chave: o conteúdo gerado é diferente
+const outputKind = (output?: string) => {
+  const lower = (output ?? '').toLowerCase()
+  return lower.endsWith('.3mf') ? (lower.endsWith('.gcode.3mf') ? '.gcode.3mf' : '.3mf') : path.extname(lower) || '.gcode'
+}
+
+// Modelo em memória (params.input como Buffer): mesmo hash do arquivo com os mesmos bytes
+const hashInput = async (input: SingleFlightSliceParams['input']): Promise<string> => {
+  if (typeof input === 'string') return hashFile(input)
+  const bytes = input instanceof ArrayBuffer ? new Uint8Array(input) : input
+  return crypto.createHash('sha256').update(bytes).digest('hex')
+}
+
+export const sliceJobKey = async (params: SingleFlightSliceParams): Promise<string> => {
+  const fileHash = await hashInput(params.input)
+  return crypto
+    .createHash('sha256')
+    .update(
+      JSON.stringify([
+        fileHash,
+        params.plate ?? 1,
+        params.printerProfile ?? '',
+        params.filamentProfile ?? '',
+        params.processProfile ?? '',
+        outputKind(params.output),
+        canonicalOptions(params),
+        params.timeoutMs ?? 0,
+        params.priority ?? 'interactive'
+      ])
+    )
+    .digest('hex')
+}
+
+const abortError = () => Object.assign(new Error('The operation was aborted'), { name: 'AbortError', code: 'ABORT_ERR' })
+
+interface Flight<R = any> {
+  job: Promise<R>
+  controller: AbortController
+  waiters: number
+}
+
+export function withSingleFlight<T extends { slice: SliceFn; sliceToBuffer?: SliceToBufferFn }>(engine: T): T {
+  const inflight = new Map<string, Flight>()
+  const stats = { leaders: 0, followers: 0, aborted: 0 }
+
+  // Espera o slice compartilhado; o abort deste pedido só solta a sua referência
+  const join = <R>(key: string, flight: Flight<R>, signal?: AbortSignal): Promise<R> => {
+    flight.waiters++
+    if (!signal) return flight.job.finally(() => flight.waiters--)
+    return new Promise((resolve, reject) => {
+      const onAbort = () => {
+        signal.removeEventListener('abort', onAbort)
+        stats.aborted++
+        if (--flight.waiters === 0) {
+          if (inflight.get(key) === flight) inflight.delete(key)
+          flight.controller.abort()
+        }
+        reject(abortError())
+      }
+      if (signal.aborted) return onAbort()
+      signal.addEventListener('abort', onAbort)
+      flight.job.then(
+        res => { if (signal.aborted) return; signal.removeEventListener('abort', onAbort); flight.waiters--; resolve(res) },
+        err => { if (signal.aborted) return; signal.removeEventListener('abort', onAbort); flight.waiters--; reject(err) }
+      )
+    })
+  }
+
+  // Líder inicia o job com o seu próprio AbortController; seguidores entram no mesmo Flight
+  const share = <R>(key: string, params: SingleFlightSliceParams, start: (p: SingleFlightSliceParams) => Promise<R>): Promise<R> => {
+    const leader = inflight.get(key)
+    if (leader) {
+      stats.followers++
+      return join(key, leader as Flight<R>, params.signal)
+    }
+    stats.leaders++
+    const controller = new AbortController()
+    const flight: Flight<R> = { job: start({ ...params, signal: controller.signal }), controller, waiters: 0 }
+    const done = () => { if (inflight.get(key) === flight) inflight.delete(key) }
+    flight.job.then(done, done)
+    inflight.set(key, flight)
+    return join(key, flight, params.signal)
+  }
+
+  const slice = async (params: SingleFlightSliceParams): Promise<{ output: string }> => {
+    // dryRun/verbose não geram saída compartilhável; trace é a linha do tempo deste slice; sem output o caminho é do próprio engine
+    if (!params || !params.input || !params.output || params.dryRun || params.verbose || params.trace) return engine.slice(params)
+
+    let key: string
+    try {
+      key = await sliceJobKey(params)
+    } catch {
+      return engine.slice(params) // arquivo ilegível: deixa o engine reportar o erro
+    }
+
+    const res = await share(key, params, p => engine.slice(p))
+    if (path.resolve(res.output) !== path.resolve(params.output)) {
+      await fs.promises.copyFile(res.output, params.output)
+    }
+    // timings é o mesmo objeto para líder e seguidores (o /metrics conta o trabalho da engine uma vez)
+    return { ...res, output: params.output }
+  }
+
+  // Seguidores recebem o mesmo ArrayBuffer do líder (somente leitura para os services)
+  const sliceToBuffer = async (params: SingleFlightSliceParams): Promise<{ buffer: ArrayBuffer }> => {
+    if (!params || !params.input || params.dryRun || params.verbose || params.trace) return engine.sliceToBuffer!(params)
+    let key: string
+    try {
+      key = 'buffer:' + (await sliceJobKey(params))
+    } catch {
+      return engine.sliceToBuffer!(params)
+    }
+    return share(key, params, p => engine.sliceToBuffer!(p))
+  }
+
+  return overlay(engine, {
+    slice,
+    ...(typeof engine.sliceToBuffer === 'function' ? { sliceToBuffer } : {}),
+    singleFlightStats: () => ({ ...stats, inflight: inflight.size })
+  })
+}
@@ -0,0 +1,45 @@
+import * as fs from 'node:fs'
+import * as os from 'node:os'
+import * as path from 'node:path'
+
+// Traces Chrome pedidos com data.trace. O tracePath devolvido é um caminho local do servidor: clientes
+// remotos não o leem, servem para quem opera o host (ou monta o diretório). Os arquivos ficam num
+// diretório próprio e são apagados depois de ORCACLI_TRACE_TTL_MS (padrão 15 min), a cada novo trace.
+export const traceDir = () => process.env.ORCACLI_TRACE_DIR || path.join(os.tmpdir(), 'orca-traces')
+const traceTtlMs = () => {
+  const ttl = Number(process.env.ORCACLI_TRACE_TTL_MS)
+  return Number.isFinite(ttl) && ttl >= 0 ? ttl : 15 * 60 * 1000
+}
+
+// Apaga os traces mais antigos que o TTL; erros (arquivo já removido por outro processo) são ignorados
+export const pruneTraces = (now = Date.now()) => {
+  const dir = traceDir()
+  let names: string[]
+  try {
+    names = fs.readdirSync(dir)
+  } catch {
+    return 0
+  }
+  let removed = 0
+  for (const name of names) {
+    if (!name.endsWith('.trace.json')) continue
+    const file = path.join(dir, name)
+    try {
+      if (now - fs.statSync(file).mtimeMs > traceTtlMs()) {
+        fs.unlinkSync(file)
+        removed++
+      }
+    } catch {
+      // removido entre o readdir e o stat
+    }
+  }
+  return removed
+}
+
+// Caminho do trace de um pedido; aproveita para limpar os vencidos
+export const newTracePath = (id: string) => {
+  const dir = traceDir()
+  fs.mkdirSync(dir, { recursive: true })
+  pruneTraces()
+  return path.join(dir, `orca-${id}.trace.json`)
+}
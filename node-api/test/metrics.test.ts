@@ -0,0 +1,77 @@
+// /metrics: formato de texto do Prometheus a partir dos contadores do addon e das latências observadas
+import assert from 'assert'
+import { Histogram, observeSlice, renderMetrics } from '../src/metrics'
+
+describe('métricas Prometheus', () => {
+  const fakeEngine = () => ({
+    schedulerStats: () => ({
+      maxQueueDepth: 64,
+      interactive: { queued: 2, rejected: 1 },
+      batch: { queued: 3, rejected: 0 }
+    }),
+    engineStats: () => ({
+      engines: 4,
+      busy: 3,
+      idle: 1,
+      slices: 10,
+      sliceFailures: 1,
+      bytesIn: 1000,
+      bytesOut: 5000,
+      rssBytes: 123456,
+      configCache: { hits: 3, misses: 1, evictions: 0 },
+      projectCache: { hits: 0, misses: 0, evictions: 0 },
+      resultCache: { hits: 1, misses: 3, evictions: 0 }
+    })
+  })
+
+  it('acumula os buckets do histograma', () => {
+    const h = new Histogram('t_seconds', 'test', [1, 5])
+    h.observe({ phase: 'a' }, 0.5)
+    h.observe({ phase: 'a' }, 3)
+    h.observe({ phase: 'a' }, 10)
+    const text = h.render().join('\n')
+    assert.ok(text.includes('t_seconds_bucket{le="1",phase="a"} 1'))
+    assert.ok(text.includes('t_seconds_bucket{le="5",phase="a"} 2'))
+    assert.ok(text.includes('t_seconds_bucket{le="+Inf",phase="a"} 3'))
+    assert.ok(text.includes('t_seconds_sum{phase="a"} 13.5'))
+  })
+
+  it('publica fila, engines, caches e RSS do engine', () => {
+    const text = renderMetrics(fakeEngine())
+    assert.ok(text.includes('orca_queue_depth{priority="batch"} 3'))
+    assert.ok(text.includes('orca_engines{state="busy"} 3'))
+    assert.ok(text.includes('orca_engines{state="idle"} 1'))
+    assert.ok(text.includes('orca_cache_hit_ratio{cache="config"} 0.75'))
+    assert.ok(text.includes('orca_cache_hit_ratio{cache="project"} 0'))
+    assert.ok(text.includes('orca_engine_bytes_out_total 5000'))
+    assert.ok(text.includes('orca_engine_rss_bytes 123456'))
+    assert.ok(text.includes('orca_info{mode="addon"} 1'))
+  })
+
+  it('omite fila, engines e RSS das engines no modo worker', () => {
+    const engine = Object.create(fakeEngine(), {
+      engineMode: { value: 'worker' },
+      engineStats: { value: undefined },
+      schedulerStats: { value: undefined },
+      singleFlightStats: { value: () => ({ leaders: 3, followers: 1 }) }
+    })
+    const text = renderMetrics(engine)
+    assert.ok(text.includes('orca_info{mode="worker"} 1'))
+    assert.ok(!text.includes('orca_queue_depth'))
+    assert.ok(!text.includes('orca_engines{'))
+    assert.ok(!text.includes('orca_engine_rss_bytes'))
+    assert.ok(text.includes('orca_cache_hit_ratio{cache="single_flight"} 0.25'))
+  })
+
+  it('conta as fases da engine uma vez por objeto timings', () => {
+    const timings = { loadModelNs: 2e6, applyNs: 0, processNs: 3e9, totalNs: 3.1e9 }
+    const started = performance.now()
+    observeSlice('slicer/test', started, { timings })
+    observeSlice('slicer/test', started, { timings }) // seguidor do single-flight
+    const text = renderMetrics({})
+    assert.ok(text.includes('orca_slice_duration_seconds_count{endpoint="slicer/test",phase="total"} 2'))
+    assert.ok(text.includes('orca_slice_duration_seconds_count{endpoint="slicer/test",phase="process"} 1'))
+    assert.ok(!text.includes('phase="apply"')) // etapa que não rodou
+    assert.ok(text.includes('orca_slices_total{endpoint="slicer/test",outcome="ok"} 2'))
+  })
+})
@@ -0,0 +1,94 @@
+// Carga do addon no start: modo pool de workers e snapshot de presets, com um addon no formato do binding real
+import assert from 'assert'
+import * as fs from 'node:fs'
+import * as os from 'node:os'
+import * as path from 'node:path'
+
+// Mesmo formato do index.js do addon: uma função (middleware Koa) com as funções N-API copiadas com
+// os descritores originais (napi_default: não graváveis, não enumeráveis, não configuráveis).
+// As chamadas ficam em `calls`; como na engine, saveSnapshot falha sem vendors carregados.
+const fakeAddon = `
+const fs = require('fs')
+const calls = []
+const vendors = []
+const mw = async function orcaMiddleware(ctx, next) { return await next() }
+const api = {
+  calls,
+  initialize: () => undefined,
+  version: () => 'fake-addon',
+  getModelInfo: () => ({}),
+  loadVendor: v => { calls.push('loadVendor:' + v); vendors.push(v) },
+  loadSnapshot: p => {
+    calls.push('loadSnapshot')
+    if (!fs.existsSync(p)) return false
+    vendors.push(...fs.readFileSync(p, 'utf8').split(','))
+    return true
+  },
+  saveSnapshot: p => {
+    calls.push('saveSnapshot')
+    if (!vendors.length) throw new Error('No vendors loaded; nothing to snapshot')
+    fs.writeFileSync(p, vendors.join(','))
+  },
+  loadPrinterProfile: () => undefined,
+  loadFilamentProfile: () => undefined,
+  loadProcessProfile: () => undefined,
+  slice: async () => ({ output: 'addon' })
+}
+for (const [k, v] of Object.entries(api)) {
+  Object.defineProperty(mw, k, { value: v, writable: false, enumerable: false, configurable: false })
+}
+module.exports = mw
+`
+
+describe('carga do addon (orca)', () => {
+  const savedEnv = { ...process.env }
+  const fresh = () => {
+    for (const m of ['../src/app', '../src/orca']) delete require.cache[require.resolve(m)]
+  }
+  const fakeAddonDir = () => {
+    const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'orca-addon-'))
+    fs.writeFileSync(path.join(dir, 'index.js'), fakeAddon)
+    return dir
+  }
+  // Roda o loader do orca.ts com um addon novo e as variáveis de ambiente dadas
+  const loadOrca = (env: Record<string, string>) => {
+    const dir = fakeAddonDir()
+    process.env = { ...savedEnv, ORCACLI_ADDON_DIR: dir, ...env }
+    fresh()
+    const settings = new Map<string, any>()
+    require('../src/orca').default({ set: (k: string, v: any) => settings.set(k, v), get: (k: string) => settings.get(k) })
+    return { engine: settings.get('orca'), addon: require(dir) }
+  }
+
+  afterEach(() => {
+    process.env = { ...savedEnv }
+    fresh()
+  })
+
+  it('sobe o app em modo pool de workers com as funções do addon somente leitura', () => {
+    const dir = fakeAddonDir()
+    process.env.ORCACLI_ADDON_DIR = dir
+    process.env.ORCACLI_WORKER_SOCKET = path.join(dir, 'workers.sock')
+    fresh()
+
+    // eslint-disable-next-line @typescript-eslint/no-var-requires
+    const { app } = require('../src/app') as { app: any }
+    const engine = app.get('orca')
+    const addon = require(dir)
+    assert.strictEqual(engine.version(), 'fake-addon') // demais funções continuam sendo do addon
+    assert.strictEqual(typeof engine.slice, 'function')
+    assert.notStrictEqual(engine.slice, addon.slice) // slice() vai para o socket dos workers
+    assert.strictEqual(addon.slice, Object.getOwnPropertyDescriptor(addon, 'slice')!.value) // addon intacto
+  })
+
+  it('carrega os vendors antes de gravar o snapshot e o reutiliza no próximo start', () => {
+    const snapshot = path.join(fs.mkdtempSync(path.join(os.tmpdir(), 'orca-snap-')), 'presets.snap')
+
+    const first = loadOrca({ ORCACLI_SNAPSHOT: snapshot, ORCACLI_VENDORS: 'BBL,Creality' })
+    assert.deepStrictEqual(first.addon.calls, ['loadSnapshot', 'loadVendor:BBL', 'loadVendor:Creality', 'saveSnapshot'])
+    assert.strictEqual(fs.readFileSync(snapshot, 'utf8'), 'BBL,Creality')
+
+    const second = loadOrca({ ORCACLI_SNAPSHOT: snapshot, ORCACLI_VENDORS: 'BBL,Creality' })
+    assert.deepStrictEqual(second.addon.calls, ['loadSnapshot']) // vendors vieram do snapshot
+  })
+})
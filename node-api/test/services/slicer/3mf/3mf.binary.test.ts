@@ -0,0 +1,58 @@
+/* Axios test: Accept: model/3mf devolve os bytes do .gcode.3mf no corpo, sem base64 */
+// eslint-disable-next-line @typescript-eslint/no-var-requires
+const assert = require('assert') as typeof import('assert')
+// eslint-disable-next-line @typescript-eslint/no-var-requires
+const { app } = require('../../../../src/app') as { app: any }
+// eslint-disable-next-line @typescript-eslint/no-var-requires
+const axios = require('axios') as typeof import('axios')
+// eslint-disable-next-line @typescript-eslint/no-var-requires
+const fs = require('node:fs') as typeof import('node:fs')
+// eslint-disable-next-line @typescript-eslint/no-var-requires
+const path = require('node:path') as typeof import('node:path')
+
+describe('slicer/3mf service (binary response)', () => {
+  let server: any
+  let baseURL: string
+
+  before(async () => {
+    server = await app.listen(0)
+    const address = server.address()
+    const port = typeof address === 'string' || address === null ? 0 : address.port
+    baseURL = `http://127.0.0.1:${port}`
+  })
+
+  after(async () => {
+    await app.teardown()
+  })
+
+  it('Accept: model/3mf retorna o .gcode.3mf cru com metadados nos headers', async function () {
+    this.timeout(180000)
+
+    const input3mf = path.resolve(__dirname, '../../../../../example_files/3DBenchy.3mf')
+    assert.ok(fs.existsSync(input3mf), 'Arquivo de exemplo 3DBenchy.3mf não encontrado')
+
+    const body = {
+      filePath: input3mf,
+      plate: 1,
+      printerProfile: 'Bambu Lab X1 Carbon 0.4 nozzle',
+      filamentProfile: 'Bambu PLA Basic @BBL X1C',
+      processProfile: '0.20mm Standard @BBL X1C'
+    }
+
+    const resp = await axios.post(`${baseURL}/slicer/3mf`, body, {
+      headers: { 'content-type': 'application/json', accept: 'model/3mf' },
+      responseType: 'arraybuffer',
+      maxContentLength: Infinity,
+      validateStatus: () => true
+    })
+
+    const bytes = Buffer.from(resp.data)
+    assert.strictEqual(resp.status, 201, `Status inesperado: ${resp.status} - ${bytes.toString('utf8', 0, 500)}`)
+    assert.ok(String(resp.headers['content-type']).startsWith('model/3mf'))
+    assert.strictEqual(Number(resp.headers['content-length']), bytes.length)
+    assert.ok(bytes.length > 1000, '.gcode.3mf muito pequeno')
+    // 3MF é um ZIP: assinatura PK\x03\x04
+    assert.strictEqual(bytes.readUInt32LE(0), 0x04034b50)
+    assert.ok(typeof resp.headers['x-orca-id'] === 'string' && resp.headers['x-orca-id'].length > 0, 'X-Orca-Id ausente')
+  })
+})
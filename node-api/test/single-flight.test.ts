@@ -0,0 +1,113 @@
+// Single-flight: pedidos idênticos simultâneos devem gerar um único slice no engine
+import assert from 'assert'
+import * as fs from 'node:fs'
+import * as os from 'node:os'
+import * as path from 'node:path'
+import { withSingleFlight } from '../src/single-flight'
+
+describe('single-flight de slices', () => {
+  const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'orca-sf-'))
+  const input = path.join(dir, 'model.stl')
+  fs.writeFileSync(input, 'solid t\nendsolid t\n')
+
+  const fakeEngine = () => {
+    const engine = {
+      calls: 0,
+      aborted: 0,
+      slice: async (p: { output?: string; signal?: AbortSignal }) => {
+        engine.calls++
+        await new Promise(r => setTimeout(r, 50))
+        if (p.signal?.aborted) {
+          engine.aborted++
+          throw Object.assign(new Error('The operation was aborted'), { name: 'AbortError' })
+        }
+        fs.writeFileSync(p.output!, `; slice #${engine.calls}\n`)
+        return { output: p.output! }
+      }
+    }
+    return engine
+  }
+
+  it('compartilha o resultado do líder entre pedidos idênticos', async () => {
+    const engine = fakeEngine()
+    const orca = withSingleFlight(engine)
+    const outs = Array.from({ length: 10 }, (_, i) => path.join(dir, `same-${i}.gcode`))
+    const results = await Promise.all(outs.map(output => orca.slice({ input, output, options: { a: 1, b: true } })))
+    assert.strictEqual(engine.calls, 1)
+    results.forEach((r, i) => {
+      assert.strictEqual(r.output, outs[i])
+      assert.strictEqual(fs.readFileSync(r.output, 'utf8'), '; slice #1\n')
+    })
+  })
+
+  it('fatia separadamente quando opções diferem ou o líder já terminou', async () => {
+    const engine = fakeEngine()
+    const orca = withSingleFlight(engine)
+    await Promise.all([
+      orca.slice({ input, output: path.join(dir, 'a.gcode'), options: { a: 1 } }),
+      orca.slice({ input, output: path.join(dir, 'b.gcode'), options: { a: 2 } })
+    ])
+    assert.strictEqual(engine.calls, 2)
+    await orca.slice({ input, output: path.join(dir, 'c.gcode'), options: { a: 1 } })
+    assert.strictEqual(engine.calls, 3)
+  })
+
+  it('não junta pedidos com prazo ou prioridade diferentes', async () => {
+    const engine = fakeEngine()
+    const orca = withSingleFlight(engine)
+    await Promise.all([
+      orca.slice({ input, output: path.join(dir, 'p-1.gcode'), timeoutMs: 100 }),
+      orca.slice({ input, output: path.join(dir, 'p-2.gcode'), timeoutMs: 60000 }),
+      orca.slice({ input, output: path.join(dir, 'p-3.gcode'), timeoutMs: 60000, priority: 'batch' }),
+      orca.slice({ input, output: path.join(dir, 'p-4.gcode'), timeoutMs: 60000, priority: 'interactive' })
+    ])
+    assert.strictEqual(engine.calls, 3) // p-2 e p-4 são o mesmo pedido (interactive é o padrão)
+  })
+
+  it('envolve um engine com funções somente leitura (formato do addon N-API)', async () => {
+    const base = fakeEngine()
+    // napi_default: não graváveis, não enumeráveis, não configuráveis
+    const engine = Object.defineProperties({}, {
+      slice: { value: base.slice },
+      version: { value: () => 'addon' }
+    }) as { slice: typeof base.slice; version: () => string }
+    const orca = withSingleFlight(engine)
+    assert.strictEqual(orca.version(), 'addon')
+    await orca.slice({ input, output: path.join(dir, 'ro.gcode') })
+    assert.strictEqual(base.calls, 1)
+  })
+
+  it('pedidos com trace não se juntam a outro slice', async () => {
+    const engine = fakeEngine()
+    const orca = withSingleFlight(engine)
+    await Promise.all([
+      orca.slice({ input, output: path.join(dir, 'tr-1.gcode') }),
+      orca.slice({ input, output: path.join(dir, 'tr-2.gcode'), trace: true })
+    ])
+    assert.strictEqual(engine.calls, 2)
+  })
+
+  it('abortar um pedido não cancela o slice enquanto outro ainda espera', async () => {
+    const engine = fakeEngine()
+    const orca = withSingleFlight(engine)
+    const ac = new AbortController()
+    const first = orca.slice({ input, output: path.join(dir, 'ab-1.gcode'), signal: ac.signal })
+    const second = orca.slice({ input, output: path.join(dir, 'ab-2.gcode') })
+    setTimeout(() => ac.abort(), 10)
+    await assert.rejects(first, (e: any) => e.name === 'AbortError')
+    assert.strictEqual((await second).output, path.join(dir, 'ab-2.gcode'))
+    assert.strictEqual(engine.aborted, 0)
+  })
+
+  it('aborta o slice compartilhado quando todos os pedidos desistem', async () => {
+    const engine = fakeEngine()
+    const orca = withSingleFlight(engine)
+    const controllers = [new AbortController(), new AbortController()]
+    const jobs = controllers.map((ac, i) => orca.slice({ input, output: path.join(dir, `all-${i}.gcode`), signal: ac.signal }))
+    setTimeout(() => controllers.forEach(ac => ac.abort()), 10)
+    for (const job of jobs) await assert.rejects(job, (e: any) => e.name === 'AbortError')
+    await new Promise(r => setTimeout(r, 80))
+    assert.strictEqual(engine.calls, 1)
+    assert.strictEqual(engine.aborted, 1)
+  })
+})
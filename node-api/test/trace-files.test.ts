@@ -0,0 +1,37 @@
+// Traces do node-api: diretório próprio e limpeza dos arquivos vencidos
+import assert from 'assert'
+import * as fs from 'node:fs'
+import * as os from 'node:os'
+import * as path from 'node:path'
+import { newTracePath, pruneTraces } from '../src/trace-files'
+
+describe('arquivos de trace', () => {
+  const savedEnv = { ...process.env }
+  afterEach(() => {
+    process.env = { ...savedEnv }
+  })
+
+  it('grava no diretório de traces e apaga os vencidos ao criar um novo', () => {
+    const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'orca-traces-'))
+    process.env.ORCACLI_TRACE_DIR = dir
+    process.env.ORCACLI_TRACE_TTL_MS = '60000'
+    const old = path.join(dir, 'orca-old.trace.json')
+    const recent = path.join(dir, 'orca-recent.trace.json')
+    const other = path.join(dir, 'notes.txt')
+    for (const file of [old, recent, other]) fs.writeFileSync(file, '{}')
+    const hourAgo = new Date(Date.now() - 3600 * 1000)
+    fs.utimesSync(old, hourAgo, hourAgo)
+    fs.utimesSync(other, hourAgo, hourAgo)
+
+    const tracePath = newTracePath('abc')
+    assert.strictEqual(tracePath, path.join(dir, 'orca-abc.trace.json'))
+    assert.ok(!fs.existsSync(old))
+    assert.ok(fs.existsSync(recent))
+    assert.ok(fs.existsSync(other)) // só arquivos de trace são apagados
+  })
+
+  it('não falha sem o diretório', () => {
+    process.env.ORCACLI_TRACE_DIR = path.join(os.tmpdir(), 'orca-traces-inexistente', String(Date.now()))
+    assert.strictEqual(pruneTraces(), 0)
+  })
+})